@@ -40,6 +40,7 @@ Sandia National Laboratories, New Mexico, USA
 
 #include "Tines_Givens.hpp"
 
+#include "Tines_Balance.hpp"
 #include "Tines_Hessenberg.hpp"
 #include "Tines_HessenbergFormQ.hpp"
 
@@ -52,26 +53,45 @@ Sandia National Laboratories, New Mexico, USA
 #include "Tines_SolveUTV.hpp"
 #include "Tines_UTV.hpp"
 
+#include "Tines_LU.hpp"
+#include "Tines_SolveLU.hpp"
+
 #include "Tines_ComputeConditionNumber.hpp"
 #include "Tines_InvertMatrix.hpp"
 #include "Tines_SolveLinearSystem.hpp"
+#include "Tines_Interleaved_Device.hpp"
 
 #include "Tines_RightEigenvectorSchur.hpp"
 #include "Tines_Schur.hpp"
 
+#include "Tines_EigenvalueSelect.hpp"
 #include "Tines_SolveEigenvaluesNonSymmetricProblem.hpp"
+#include "Tines_SolveEigenvaluesSymmetricProblem.hpp"
 
 #include "Tines_EigendecompositionToComplex.hpp"
 #include "Tines_EigendecompositionValidateLeftEigenPairs.hpp"
 #include "Tines_EigendecompositionValidateRightEigenPairs.hpp"
 
+#include "Tines_NumericalJacobianColoring.hpp"
 #include "Tines_NumericalJacobianCentralDifference.hpp"
 #include "Tines_NumericalJacobianForwardDifference.hpp"
+#include "Tines_NumericalJacobianForwardDifferenceTeamThread.hpp"
 #include "Tines_NumericalJacobianRichardsonExtrapolation.hpp"
+#include "Tines_SacadoJacobian.hpp"
+#include "Tines_JacobianVectorProduct.hpp"
 
 #include "Tines_NewtonSolver.hpp"
+#include "Tines_NewtonKrylovSolver.hpp"
+#include "Tines_TimeStepSizeController.hpp"
 #include "Tines_TrBDF2.hpp"
+#include "Tines_TimeIntegratorStatistics.hpp"
 #include "Tines_TimeIntegratorTrBDF2.hpp"
+#include "Tines_ESDIRK.hpp"
+#include "Tines_TimeIntegratorESDIRK.hpp"
+#include "Tines_RosenbrockW.hpp"
+#include "Tines_TimeIntegratorRosenbrockW.hpp"
+#include "Tines_BDF.hpp"
+#include "Tines_TimeIntegratorBDF.hpp"
 
 
 #endif
@@ -100,6 +100,33 @@ namespace Tines {
   };
 #endif
 
+  ///
+  /// Team mapping of a batch of np dense problems of size m where a team
+  /// solves a problem. When the batch parallelism alone can occupy a GPU,
+  /// team_size and vector_size are zero and Kokkos::AUTO should be used;
+  /// otherwise, a team has a thread for a few rows and the vector lanes run
+  /// along a row.
+  ///
+#if !defined(TINES_BATCHED_TEAM_AUTO_MIN_BATCH_SIZE)
+#define TINES_BATCHED_TEAM_AUTO_MIN_BATCH_SIZE 100000
+#endif
+#if !defined(TINES_BATCHED_TEAM_VECTOR_SIZE)
+#define TINES_BATCHED_TEAM_VECTOR_SIZE 16
+#endif
+  inline void getBatchedTeamSize(const int np, const int m, int &team_size,
+                                 int &vector_size) {
+    if (np > TINES_BATCHED_TEAM_AUTO_MIN_BATCH_SIZE) {
+      team_size = 0;
+      vector_size = 0;
+    } else {
+      /// a warp is the smallest team; small problems do not need more
+      const int total_team_size =
+        m <= 32 ? 32 : m <= 128 ? 128 : m <= 256 ? 256 : m <= 512 ? 512 : 768;
+      vector_size = m <= 32 ? 8 : TINES_BATCHED_TEAM_VECTOR_SIZE;
+      team_size = total_team_size / vector_size;
+    }
+  }
+
   ///
   /// Kokkos view
   ///
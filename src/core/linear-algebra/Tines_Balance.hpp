@@ -0,0 +1,83 @@
+/*----------------------------------------------------------------------------------
+Tines - Time Integrator, Newton and Eigen Solver -  version 1.0
+Copyright (2021) NTESS
+https://github.com/sandialabs/Tines
+
+Copyright 2021 National Technology & Engineering Solutions of Sandia, LLC (NTESS). 
+Under the terms of Contract DE-NA0003525 with NTESS, the U.S. Government retains 
+certain rights in this software.
+
+This file is part of Tines. Tines is open-source software: you can redistribute it
+and/or modify it under the terms of BSD 2-Clause License
+(https://opensource.org/licenses/BSD-2-Clause). A copy of the license is also
+provided under the main directory
+Questions? Kyungjoo Kim <kyukim@sandia.gov>, or
+	   Oscar Diaz-Ibarra at <odiazib@sandia.gov>, or
+	   Cosmin Safta at <csafta@sandia.gov>, or
+	   Habib Najm at <hnnajm@sandia.gov>
+
+Sandia National Laboratories, New Mexico, USA
+----------------------------------------------------------------------------------*/
+#ifndef __TINES_BALANCE_HPP__
+#define __TINES_BALANCE_HPP__
+
+#include "Tines_Balance_Internal.hpp"
+#include "Tines_Internal.hpp"
+
+namespace Tines {
+
+  struct Balance {
+    template <typename MemberType, typename AViewType, typename SViewType>
+    KOKKOS_INLINE_FUNCTION static int invoke(const MemberType &member,
+                                             const AViewType &A,
+                                             const SViewType &scale, int &ilo,
+                                             int &ihi) {
+      static_assert(AViewType::rank == 2, "A is not rank-2 view");
+      static_assert(SViewType::rank == 1, "scale is not rank-1 view");
+
+      const int m = A.extent(0), as0 = A.stride(0), as1 = A.stride(1);
+      const int ss = scale.stride(0);
+      assert(int(A.extent(1)) == m);
+
+      return BalanceInternal::invoke(member, m, A.data(), as0, as1,
+                                     scale.data(), ss, ilo, ihi);
+    }
+  };
+
+  struct BalanceBackTransform {
+    template <typename MemberType, typename SViewType, typename VViewType>
+    KOKKOS_INLINE_FUNCTION static int
+    invoke(const MemberType &member, const int ilo, const int ihi,
+           const SViewType &scale, const VViewType &V) {
+      static_assert(SViewType::rank == 1, "scale is not rank-1 view");
+      static_assert(VViewType::rank == 2, "V is not rank-2 view");
+
+      const int m = V.extent(0), n = V.extent(1);
+      const int vs0 = V.stride(0), vs1 = V.stride(1);
+      const int ss = scale.stride(0);
+
+      return BalanceBackTransformInternal::invoke(
+        member, m, ilo, ihi, scale.data(), ss, n, V.data(), vs0, vs1);
+    }
+
+    /// Side::Right for right eigenvectors and Side::Left for left ones
+    template <typename MemberType, typename SideType, typename SViewType,
+              typename VViewType>
+    KOKKOS_INLINE_FUNCTION static int
+    invoke(const MemberType &member, const SideType &side, const int ilo,
+           const int ihi, const SViewType &scale, const VViewType &V) {
+      static_assert(SViewType::rank == 1, "scale is not rank-1 view");
+      static_assert(VViewType::rank == 2, "V is not rank-2 view");
+
+      const int m = V.extent(0), n = V.extent(1);
+      const int vs0 = V.stride(0), vs1 = V.stride(1);
+      const int ss = scale.stride(0);
+
+      return BalanceBackTransformInternal::invoke(
+        member, side, m, ilo, ihi, scale.data(), ss, n, V.data(), vs0, vs1);
+    }
+  };
+
+} // namespace Tines
+
+#endif
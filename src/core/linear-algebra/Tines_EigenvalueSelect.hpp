@@ -0,0 +1,150 @@
+/*----------------------------------------------------------------------------------
+Tines - Time Integrator, Newton and Eigen Solver -  version 1.0
+Copyright (2021) NTESS
+https://github.com/sandialabs/Tines
+
+Copyright 2021 National Technology & Engineering Solutions of Sandia, LLC (NTESS). 
+Under the terms of Contract DE-NA0003525 with NTESS, the U.S. Government retains 
+certain rights in this software.
+
+This file is part of Tines. Tines is open-source software: you can redistribute it
+and/or modify it under the terms of BSD 2-Clause License
+(https://opensource.org/licenses/BSD-2-Clause). A copy of the license is also
+provided under the main directory
+Questions? Kyungjoo Kim <kyukim@sandia.gov>, or
+	   Oscar Diaz-Ibarra at <odiazib@sandia.gov>, or
+	   Cosmin Safta at <csafta@sandia.gov>, or
+	   Habib Najm at <hnnajm@sandia.gov>
+
+Sandia National Laboratories, New Mexico, USA
+----------------------------------------------------------------------------------*/
+#ifndef __TINES_EIGENVALUE_SELECT_HPP__
+#define __TINES_EIGENVALUE_SELECT_HPP__
+
+#include "Tines_Internal.hpp"
+
+namespace Tines {
+
+  ///
+  /// Eigenvalue selectors for the selective eigenvector solve. A selector is
+  /// invoked serially on the eigenvalues of the Schur form,
+  ///   n = select(m, er, ers, ei, eis, blks, bs, sel, ss)
+  /// and writes n distinct eigenvalue indices into sel. A complex pair is
+  /// selected as a whole by the index of its first eigenvalue.
+  ///
+  struct EigenvalueSelectBase {
+    /// the first index of the block that the eigenvalue i belongs to
+    KOKKOS_INLINE_FUNCTION static int blockStart(const int i, const int *blks,
+                                                 const int bs) {
+      return (i > 0 && blks[i * bs] == 0) ? i - 1 : i;
+    }
+    KOKKOS_INLINE_FUNCTION static int blockSize(const int i, const int *blks,
+                                                const int bs) {
+      const int blk = blks[i * bs];
+      return blk < 0 ? -blk : blk;
+    }
+    KOKKOS_INLINE_FUNCTION static bool isSelected(const int j, const int n,
+                                                  const int *sel,
+                                                  const int ss) {
+      for (int i = 0; i < n; ++i)
+        if (sel[i * ss] == j)
+          return true;
+      return false;
+    }
+  };
+
+  ///
+  /// An explicit list of eigenvalue indices (in the order of er and ei)
+  ///
+  struct EigenvalueSelectIndices : EigenvalueSelectBase {
+    const int *_idx;
+    int _n, _is;
+
+    KOKKOS_INLINE_FUNCTION
+    EigenvalueSelectIndices(const int *idx, const int n, const int is = 1)
+      : _idx(idx), _n(n), _is(is) {}
+
+    template <typename RealType>
+    KOKKOS_INLINE_FUNCTION int
+    operator()(const int m, const RealType *er, const int ers,
+               const RealType *ei, const int eis, const int *blks,
+               const int bs, int *sel, const int ss) const {
+      int n(0);
+      for (int i = 0; i < _n; ++i) {
+        const int idx = _idx[i * _is];
+        if (idx >= 0 && idx < m) {
+          const int j = blockStart(idx, blks, bs);
+          if (!isSelected(j, n, sel, ss))
+            sel[(n++) * ss] = j;
+        }
+      }
+      return n;
+    }
+  };
+
+  ///
+  /// k eigenvalues with the largest real parts in descending order; when a
+  /// complex pair straddles the k-th position, both are selected.
+  ///
+  struct EigenvalueSelectLargestRealPart : EigenvalueSelectBase {
+    int _k;
+
+    KOKKOS_INLINE_FUNCTION
+    EigenvalueSelectLargestRealPart(const int k) : _k(k) {}
+
+    template <typename RealType>
+    KOKKOS_INLINE_FUNCTION int
+    operator()(const int m, const RealType *er, const int ers,
+               const RealType *ei, const int eis, const int *blks,
+               const int bs, int *sel, const int ss) const {
+      int n(0);
+      for (int cnt = 0; cnt < _k;) {
+        int jmax(-1);
+        for (int j = 0; j < m; ++j) {
+          const int blk = blockSize(j, blks, bs);
+          if (blk > 0 && !isSelected(j, n, sel, ss))
+            if (jmax < 0 || er[j * ers] > er[jmax * ers])
+              jmax = j;
+        }
+        if (jmax < 0)
+          break;
+        sel[(n++) * ss] = jmax;
+        cnt += blockSize(jmax, blks, bs);
+      }
+      return n;
+    }
+  };
+
+  ///
+  /// Eigenvalues with |lambda| > threshold
+  ///
+  template <typename RealType>
+  struct EigenvalueSelectMagnitudeAbove : EigenvalueSelectBase {
+    RealType _threshold;
+
+    KOKKOS_INLINE_FUNCTION
+    EigenvalueSelectMagnitudeAbove(const RealType threshold)
+      : _threshold(threshold) {}
+
+    KOKKOS_INLINE_FUNCTION int operator()(const int m, const RealType *er,
+                                          const int ers, const RealType *ei,
+                                          const int eis, const int *blks,
+                                          const int bs, int *sel,
+                                          const int ss) const {
+      const RealType threshold2 = _threshold * _threshold;
+      int n(0);
+      for (int j = 0; j < m; ++j) {
+        const int blk = blockSize(j, blks, bs);
+        if (blk > 0) {
+          const RealType r = er[j * ers], i = ei[j * eis];
+          if ((r * r + i * i) > threshold2)
+            sel[(n++) * ss] = j;
+        }
+      }
+      return n;
+    }
+  };
+
+} // namespace Tines
+
+#endif
@@ -21,6 +21,7 @@ Sandia National Laboratories, New Mexico, USA
 #ifndef __TINES_HESSENBER_HPP__
 #define __TINES_HESSENBER_HPP__
 
+#include "Tines_Hessenberg_Blocked_Internal.hpp"
 #include "Tines_Hessenberg_Internal.hpp"
 #include "Tines_Internal.hpp"
 
@@ -30,6 +31,17 @@ namespace Tines {
                          double *tau);
 
   struct Hessenberg {
+    template <typename AViewType>
+    KOKKOS_INLINE_FUNCTION static int workspace(const AViewType &A, int &wlen) {
+      const int m = A.extent(0);
+      /// the blocked algorithm is used only when w is large enough to hold
+      /// its workspace; otherwise, m is sufficient
+      int wlen_blocked(0);
+      HessenbergBlockedInternal::workspace(m, wlen_blocked);
+      wlen = m > TINES_BLOCKED_HOUSEHOLDER_MIN_SIZE ? wlen_blocked : m;
+      return 0;
+    }
+
     template <typename MemberType, typename AViewType, typename tViewType,
               typename wViewType>
     KOKKOS_INLINE_FUNCTION static int
@@ -59,9 +71,18 @@ namespace Tines {
       const int ts = t.stride(0);
 
       value_type *wptr = w.data();
-
-      return HessenbergInternal::invoke(member, m, Aptr, as0, as1, tptr, ts,
-                                        wptr);
+      const int wlen = w.extent(0);
+
+      /// level 3 blocked householder for large matrices
+      int wlen_blocked(0);
+      HessenbergBlockedInternal::workspace(m, wlen_blocked);
+      const bool use_blocked =
+        (m > TINES_BLOCKED_HOUSEHOLDER_MIN_SIZE && wlen >= wlen_blocked);
+
+      return (use_blocked ? HessenbergBlockedInternal::invoke(
+                              member, m, Aptr, as0, as1, tptr, ts, wptr)
+                          : HessenbergInternal::invoke(member, m, Aptr, as0,
+                                                       as1, tptr, ts, wptr));
     }
 
     template <typename MemberType, typename AViewType, typename tViewType,
@@ -103,35 +103,12 @@ namespace Tines {
     Kokkos::Profiling::pushRegion("Tines::HessenbergCuda");
     const int league_size = A.extent(0);
     using policy_type = Kokkos::TeamPolicy<Kokkos::Cuda>;
-    policy_type policy(exec_instance, league_size, Kokkos::AUTO);
-
-    /// let's guess....
-    {
-      const int np = A.extent(0), m = A.extent(1);
-      if (np > 100000) {
-        /// we have enough batch parallelism... use AUTO
-      } else {
-        /// batch parallelsim itself cannot occupy the whole device
-        int vector_size(0), team_size(0);
-        if (m <= 256) {
-          const int total_team_size = 256;
-          vector_size = 16;
-          team_size = total_team_size / vector_size;
-        } else if (m <= 512) {
-          const int total_team_size = 512;
-          vector_size = 16;
-          team_size = total_team_size / vector_size;
-        } else {
-          const int total_team_size = 768;
-          vector_size = 16;
-          team_size = total_team_size / vector_size;
-        }
-        policy =
-          policy_type(exec_instance, league_size, team_size, vector_size);
-      }
-    }
-    // this is for testing only
-    // policy = policy_type(exec_instance, league_size, 32, 32);
+    int team_size(0), vector_size(0);
+    getBatchedTeamSize(league_size, A.extent(1), team_size, vector_size);
+    const auto policy =
+      team_size > 0
+        ? policy_type(exec_instance, league_size, team_size, vector_size)
+        : policy_type(exec_instance, league_size, Kokkos::AUTO);
     Kokkos::parallel_for(
       "Tines::HessenbergCuda::parallel_for", policy,
       KOKKOS_LAMBDA(const typename policy_type::member_type &member) {
@@ -0,0 +1,217 @@
+/*----------------------------------------------------------------------------------
+Tines - Time Integrator, Newton and Eigen Solver -  version 1.0
+Copyright (2021) NTESS
+https://github.com/sandialabs/Tines
+
+Copyright 2021 National Technology & Engineering Solutions of Sandia, LLC (NTESS). 
+Under the terms of Contract DE-NA0003525 with NTESS, the U.S. Government retains 
+certain rights in this software.
+
+This file is part of Tines. Tines is open-source software: you can redistribute it
+and/or modify it under the terms of BSD 2-Clause License
+(https://opensource.org/licenses/BSD-2-Clause). A copy of the license is also
+provided under the main directory
+Questions? Kyungjoo Kim <kyukim@sandia.gov>, or
+	   Oscar Diaz-Ibarra at <odiazib@sandia.gov>, or
+	   Cosmin Safta at <csafta@sandia.gov>, or
+	   Habib Najm at <hnnajm@sandia.gov>
+
+Sandia National Laboratories, New Mexico, USA
+----------------------------------------------------------------------------------*/
+#ifndef __TINES_INTERLEAVED_DEVICE_HPP__
+#define __TINES_INTERLEAVED_DEVICE_HPP__
+
+#include "Tines_Internal.hpp"
+#include "Tines_Interleaved_Internal.hpp"
+
+namespace Tines {
+
+  ///
+  /// Batched dense kernels in the interleaved layout where N samples are
+  /// packed in the innermost (contiguous) dimension
+  ///   matrices : npack x m x n x N
+  ///   vectors  : npack x m x N
+  /// A thread processes a pack and the loops over the N lanes are
+  /// vectorized; this fills SIMD registers with independent samples when m
+  /// is too small to use vector lanes within a sample. The pack and unpack
+  /// functions convert the standard batch layout (np x m x n) to and from
+  /// the interleaved layout; unused lanes of the last pack are filled with
+  /// identity matrices and zero vectors so that they are solvable.
+  ///
+  template <typename SpT> struct InterleavedDevice {
+    static constexpr int vector_length = TINES_INTERLEAVED_VECTOR_LENGTH;
+
+    using exec_space = SpT;
+    using device_type = typename UseThisDevice<exec_space>::type;
+    using real_type = double;
+
+    using real_type_2d_view_type = value_type_2d_view<real_type, device_type>;
+    using real_type_3d_view_type = value_type_3d_view<real_type, device_type>;
+    using real_type_4d_view_type = value_type_4d_view<real_type, device_type>;
+    using int_type_3d_view_type = value_type_3d_view<int, device_type>;
+
+    using range_policy_type = Kokkos::RangePolicy<exec_space>;
+
+    inline static int getNumberOfPacks(const int np) {
+      return (np + vector_length - 1) / vector_length;
+    }
+
+    /// A (np x m x n) -> Ai (npack x m x n x N)
+    inline static int pack(const exec_space &exec_instance,
+                           const real_type_3d_view_type &A,
+                           const real_type_4d_view_type &Ai) {
+      constexpr int N = vector_length;
+      const int np = A.extent(0), m = A.extent(1), n = A.extent(2);
+      const int npack = getNumberOfPacks(np);
+      assert(int(Ai.extent(0)) >= npack && int(Ai.extent(1)) == m &&
+             int(Ai.extent(2)) == n && int(Ai.extent(3)) == N);
+      Kokkos::parallel_for(
+        "Tines::InterleavedDevice::pack::matrix",
+        range_policy_type(exec_instance, 0, npack * m * n),
+        KOKKOS_LAMBDA(const int &idx) {
+          const int k = idx / (m * n), ij = idx % (m * n), i = ij / n,
+                    j = ij % n;
+          for (int l = 0; l < N; ++l) {
+            const int s = k * N + l;
+            Ai(k, i, j, l) =
+              s < np ? A(s, i, j) : (i == j ? real_type(1) : real_type(0));
+          }
+        });
+      return 0;
+    }
+
+    /// b (np x m) -> bi (npack x m x N)
+    inline static int pack(const exec_space &exec_instance,
+                           const real_type_2d_view_type &b,
+                           const real_type_3d_view_type &bi) {
+      constexpr int N = vector_length;
+      const int np = b.extent(0), m = b.extent(1);
+      const int npack = getNumberOfPacks(np);
+      assert(int(bi.extent(0)) >= npack && int(bi.extent(1)) == m &&
+             int(bi.extent(2)) == N);
+      Kokkos::parallel_for(
+        "Tines::InterleavedDevice::pack::vector",
+        range_policy_type(exec_instance, 0, npack * m),
+        KOKKOS_LAMBDA(const int &idx) {
+          const int k = idx / m, i = idx % m;
+          for (int l = 0; l < N; ++l) {
+            const int s = k * N + l;
+            bi(k, i, l) = s < np ? b(s, i) : real_type(0);
+          }
+        });
+      return 0;
+    }
+
+    /// Ai (npack x m x n x N) -> A (np x m x n)
+    inline static int unpack(const exec_space &exec_instance,
+                             const real_type_4d_view_type &Ai,
+                             const real_type_3d_view_type &A) {
+      constexpr int N = vector_length;
+      const int np = A.extent(0), m = A.extent(1), n = A.extent(2);
+      Kokkos::parallel_for(
+        "Tines::InterleavedDevice::unpack::matrix",
+        range_policy_type(exec_instance, 0, np * m * n),
+        KOKKOS_LAMBDA(const int &idx) {
+          const int s = idx / (m * n), ij = idx % (m * n), i = ij / n,
+                    j = ij % n;
+          A(s, i, j) = Ai(s / N, i, j, s % N);
+        });
+      return 0;
+    }
+
+    /// bi (npack x m x N) -> b (np x m)
+    inline static int unpack(const exec_space &exec_instance,
+                             const real_type_3d_view_type &bi,
+                             const real_type_2d_view_type &b) {
+      constexpr int N = vector_length;
+      const int np = b.extent(0), m = b.extent(1);
+      Kokkos::parallel_for(
+        "Tines::InterleavedDevice::unpack::vector",
+        range_policy_type(exec_instance, 0, np * m),
+        KOKKOS_LAMBDA(const int &idx) {
+          const int s = idx / m, i = idx % m;
+          b(s, i) = bi(s / N, i, s % N);
+        });
+      return 0;
+    }
+
+    /// y = beta y + alpha A x
+    inline static int gemv(const exec_space &exec_instance,
+                           const real_type alpha,
+                           const real_type_4d_view_type &A,
+                           const real_type_3d_view_type &x,
+                           const real_type beta,
+                           const real_type_3d_view_type &y) {
+      constexpr int N = vector_length;
+      const int npack = A.extent(0), m = A.extent(1), n = A.extent(2);
+      assert(int(A.stride(3)) == 1 && int(x.stride(2)) == 1 &&
+             int(y.stride(2)) == 1);
+      Kokkos::parallel_for(
+        "Tines::InterleavedDevice::gemv",
+        range_policy_type(exec_instance, 0, npack),
+        KOKKOS_LAMBDA(const int &k) {
+          GemvInterleavedInternal<N>::invoke(
+            m, n, alpha, &A(k, 0, 0, 0), int(A.stride(1)), int(A.stride(2)),
+            &x(k, 0, 0), int(x.stride(1)), beta, &y(k, 0, 0),
+            int(y.stride(1)));
+        });
+      return 0;
+    }
+
+    /// A x = b using LU with partial pivoting; A is overwritten by its
+    /// factors, p stores pivots (npack x m x N) and b is overwritten by x
+    ///  - the lane-wise LU does not fall back to UTV for singular matrices
+    inline static int solveLU(const exec_space &exec_instance,
+                              const real_type_4d_view_type &A,
+                              const int_type_3d_view_type &p,
+                              const real_type_3d_view_type &b) {
+      constexpr int N = vector_length;
+      const int npack = A.extent(0), m = A.extent(1);
+      assert(int(A.extent(2)) == m);
+      assert(int(A.stride(3)) == 1 && int(p.stride(2)) == 1 &&
+             int(b.stride(2)) == 1);
+      Kokkos::parallel_for(
+        "Tines::InterleavedDevice::solveLU",
+        range_policy_type(exec_instance, 0, npack),
+        KOKKOS_LAMBDA(const int &k) {
+          real_type *Aptr = &A(k, 0, 0, 0);
+          const int as0 = A.stride(1), as1 = A.stride(2);
+          int *pptr = &p(k, 0, 0);
+          const int ps0 = p.stride(1);
+          LU_InterleavedInternal<N>::invoke(m, Aptr, as0, as1, pptr, ps0);
+          SolveLU_InterleavedInternal<N>::invoke(m, Aptr, as0, as1, pptr, ps0,
+                                                 &b(k, 0, 0), int(b.stride(1)));
+        });
+      return 0;
+    }
+
+    /// A x = b using householder QR; A is overwritten by its factors, t
+    /// stores tau (npack x m x N) and b is overwritten by x
+    inline static int solveQR(const exec_space &exec_instance,
+                              const real_type_4d_view_type &A,
+                              const real_type_3d_view_type &t,
+                              const real_type_3d_view_type &b) {
+      constexpr int N = vector_length;
+      const int npack = A.extent(0), m = A.extent(1);
+      assert(int(A.extent(2)) == m);
+      assert(int(A.stride(3)) == 1 && int(t.stride(2)) == 1 &&
+             int(b.stride(2)) == 1);
+      Kokkos::parallel_for(
+        "Tines::InterleavedDevice::solveQR",
+        range_policy_type(exec_instance, 0, npack),
+        KOKKOS_LAMBDA(const int &k) {
+          real_type *Aptr = &A(k, 0, 0, 0);
+          const int as0 = A.stride(1), as1 = A.stride(2);
+          real_type *tptr = &t(k, 0, 0);
+          const int ts0 = t.stride(1);
+          QR_InterleavedInternal<N>::invoke(m, m, Aptr, as0, as1, tptr, ts0);
+          SolveQR_InterleavedInternal<N>::invoke(m, Aptr, as0, as1, tptr, ts0,
+                                                 &b(k, 0, 0), int(b.stride(1)));
+        });
+      return 0;
+    }
+  };
+
+} // namespace Tines
+
+#endif
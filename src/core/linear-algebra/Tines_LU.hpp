@@ -0,0 +1,74 @@
+/*----------------------------------------------------------------------------------
+Tines - Time Integrator, Newton and Eigen Solver -  version 1.0
+Copyright (2021) NTESS
+https://github.com/sandialabs/Tines
+
+Copyright 2021 National Technology & Engineering Solutions of Sandia, LLC (NTESS). 
+Under the terms of Contract DE-NA0003525 with NTESS, the U.S. Government retains 
+certain rights in this software.
+
+This file is part of Tines. Tines is open-source software: you can redistribute it
+and/or modify it under the terms of BSD 2-Clause License
+(https://opensource.org/licenses/BSD-2-Clause). A copy of the license is also
+provided under the main directory
+Questions? Kyungjoo Kim <kyukim@sandia.gov>, or
+	   Oscar Diaz-Ibarra at <odiazib@sandia.gov>, or
+	   Cosmin Safta at <csafta@sandia.gov>, or
+	   Habib Najm at <hnnajm@sandia.gov>
+
+Sandia National Laboratories, New Mexico, USA
+----------------------------------------------------------------------------------*/
+#ifndef __TINES_LU_HPP__
+#define __TINES_LU_HPP__
+
+#include "Tines_Internal.hpp"
+#include "Tines_LU_Internal.hpp"
+
+namespace Tines {
+
+  /// pivots are converted into the relative zero-base index as LU_Internal
+  int LU_HostTPL(const int m, const int n, double *A, const int as0,
+                 const int as1, int *ipiv, int &matrix_rank,
+                 double &pivot_growth);
+
+  struct LU {
+    template <typename MemberType, typename AViewType, typename pViewType>
+    KOKKOS_INLINE_FUNCTION static int
+    device_invoke(const MemberType &member, const AViewType &A,
+                  const pViewType &p, int &matrix_rank,
+                  typename ats<typename AViewType::non_const_value_type>::
+                    magnitude_type &pivot_growth) {
+      return LU_Internal::invoke(member, A.extent(0), A.extent(1), A.data(),
+                                 A.stride(0), A.stride(1), p.data(),
+                                 p.stride(0), matrix_rank, pivot_growth);
+    }
+
+    template <typename MemberType, typename AViewType, typename pViewType>
+    KOKKOS_INLINE_FUNCTION static int
+    invoke(const MemberType &member, const AViewType &A, const pViewType &p,
+           int &matrix_rank,
+           typename ats<typename AViewType::non_const_value_type>::
+             magnitude_type &pivot_growth) {
+      int r_val(0);
+#if defined(TINES_ENABLE_TPL_LAPACKE_ON_HOST) && !defined(__CUDA_ARCH__)
+      if ((std::is_same<Kokkos::Impl::ActiveExecutionMemorySpace,
+                        Kokkos::HostSpace>::value) &&
+          (A.stride(0) == 1 || A.stride(1) == 1) && (p.stride(0) == 1)) {
+        Kokkos::single(Kokkos::PerTeam(member), [&]() {
+          r_val =
+            LU_HostTPL(A.extent(0), A.extent(1), A.data(), A.stride(0),
+                       A.stride(1), p.data(), matrix_rank, pivot_growth);
+        });
+      } else {
+        r_val = device_invoke(member, A, p, matrix_rank, pivot_growth);
+      }
+#else
+      r_val = device_invoke(member, A, p, matrix_rank, pivot_growth);
+#endif
+      return r_val;
+    }
+  };
+
+} // namespace Tines
+
+#endif
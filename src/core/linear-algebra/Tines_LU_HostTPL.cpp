@@ -0,0 +1,75 @@
+/*----------------------------------------------------------------------------------
+Tines - Time Integrator, Newton and Eigen Solver -  version 1.0
+Copyright (2021) NTESS
+https://github.com/sandialabs/Tines
+
+Copyright 2021 National Technology & Engineering Solutions of Sandia, LLC (NTESS). 
+Under the terms of Contract DE-NA0003525 with NTESS, the U.S. Government retains 
+certain rights in this software.
+
+This file is part of Tines. Tines is open-source software: you can redistribute it
+and/or modify it under the terms of BSD 2-Clause License
+(https://opensource.org/licenses/BSD-2-Clause). A copy of the license is also
+provided under the main directory
+Questions? Kyungjoo Kim <kyukim@sandia.gov>, or
+	   Oscar Diaz-Ibarra at <odiazib@sandia.gov>, or
+	   Cosmin Safta at <csafta@sandia.gov>, or
+	   Habib Najm at <hnnajm@sandia.gov>
+
+Sandia National Laboratories, New Mexico, USA
+----------------------------------------------------------------------------------*/
+#include "Tines_Interface.hpp"
+#include "Tines_Internal.hpp"
+
+namespace Tines {
+
+  ///
+  /// Compute LU with partial pivoting
+  ///
+  int LU_HostTPL(const int m, const int n, double *A, const int as0,
+                 const int as1, int *ipiv, int &matrix_rank,
+                 double &pivot_growth) {
+#if defined(TINES_ENABLE_TPL_LAPACKE_ON_HOST)
+    const auto layout_lapacke = as0 == 1 ? LAPACK_COL_MAJOR : LAPACK_ROW_MAJOR;
+
+    const int lda = (as0 == 1 ? as1 : as0);
+    const int min_mn = m < n ? m : n;
+
+    double max_abs_a(0);
+    for (int i = 0; i < m; ++i)
+      for (int j = 0; j < n; ++j) {
+        const double val = ats<double>::abs(A[i * as0 + j * as1]);
+        max_abs_a = val > max_abs_a ? val : max_abs_a;
+      }
+
+    const int r_val = LAPACKE_dgetrf(layout_lapacke, m, n, A, lda, ipiv);
+
+    /// lapack pivots are one-base absolute indices
+    for (int i = 0; i < min_mn; ++i)
+      ipiv[i] = ipiv[i] - 1 - i;
+
+    /// find numeric rank of the matrix and pivot growth
+    {
+      const double threshold(max_abs_a * ats<double>::epsilon());
+      matrix_rank = min_mn;
+      double max_abs_u(0);
+      for (int i = 0; i < min_mn; ++i) {
+        if (matrix_rank == min_mn &&
+            ats<double>::abs(A[i * as0 + i * as1]) <= threshold)
+          matrix_rank = i;
+        for (int j = i; j < n; ++j) {
+          const double val = ats<double>::abs(A[i * as0 + j * as1]);
+          max_abs_u = val > max_abs_u ? val : max_abs_u;
+        }
+      }
+      pivot_growth = max_abs_a > 0 ? max_abs_u / max_abs_a : 0;
+    }
+    return r_val < 0 ? r_val : 0;
+#else
+    TINES_CHECK_ERROR(true, "Error: LAPACKE is not enabled");
+
+    return -1;
+#endif
+  }
+
+} // namespace Tines
@@ -22,6 +22,7 @@ Sandia National Laboratories, New Mexico, USA
 #define __TINES_QR_HPP__
 
 #include "Tines_Internal.hpp"
+#include "Tines_QR_Blocked_Internal.hpp"
 #include "Tines_QR_Internal.hpp"
 
 namespace Tines {
@@ -30,6 +31,18 @@ namespace Tines {
                  const int as1, double *tau);
 
   struct QR {
+    template <typename AViewType>
+    KOKKOS_INLINE_FUNCTION static int workspace(const AViewType &A, int &wlen) {
+      const int m = A.extent(0), n = A.extent(1);
+      /// the blocked algorithm is used only when w is large enough to hold
+      /// its workspace; otherwise, n is sufficient
+      int wlen_blocked(0);
+      QR_BlockedInternal::workspace(m, n, wlen_blocked);
+      const int min_mn = m < n ? m : n;
+      wlen = min_mn > TINES_BLOCKED_HOUSEHOLDER_MIN_SIZE ? wlen_blocked : n;
+      return 0;
+    }
+
     template <typename MemberType, typename AViewType, typename tViewType,
               typename wViewType>
     KOKKOS_INLINE_FUNCTION static int
@@ -58,8 +71,19 @@ namespace Tines {
       const int ts = t.stride(0);
 
       value_type *wptr = w.data();
-
-      return QR_Internal::invoke(member, m, n, Aptr, as0, as1, tptr, ts, wptr);
+      const int wlen = w.extent(0);
+
+      /// level 3 blocked householder for large matrices
+      int wlen_blocked(0);
+      QR_BlockedInternal::workspace(m, n, wlen_blocked);
+      const int min_mn = m < n ? m : n;
+      const bool use_blocked =
+        (min_mn > TINES_BLOCKED_HOUSEHOLDER_MIN_SIZE && wlen >= wlen_blocked);
+
+      return (use_blocked ? QR_BlockedInternal::invoke(member, m, n, Aptr, as0,
+                                                       as1, tptr, ts, wptr)
+                          : QR_Internal::invoke(member, m, n, Aptr, as0, as1,
+                                                tptr, ts, wptr));
     }
 
     template <typename MemberType, typename AViewType, typename tViewType,
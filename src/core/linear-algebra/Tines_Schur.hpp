@@ -23,6 +23,7 @@ Sandia National Laboratories, New Mexico, USA
 
 #include "Tines_Internal.hpp"
 #include "Tines_Schur_Internal.hpp"
+#include "Tines_Schur_MultiShift_Internal.hpp"
 
 namespace Tines {
 
@@ -48,6 +49,40 @@ namespace Tines {
       return r_val;
     }
 
+    template <typename HViewType>
+    KOKKOS_INLINE_FUNCTION static int workspace(const HViewType &H, int &wlen) {
+      const int m = H.extent(0);
+      /// the multishift QR is used only when w is large enough to hold its
+      /// workspace
+      wlen = 0;
+      if (m > TINES_SCHUR_MULTISHIFT_MIN_SIZE)
+        SchurMultiShiftInternal::workspace(m, wlen);
+      return 0;
+    }
+
+    /// with workspace, large matrices use the multishift QR with aggressive
+    /// early deflation
+    template <typename MemberType, typename HViewType, typename ZViewType,
+              typename EViewType, typename BViewType, typename WViewType>
+    KOKKOS_INLINE_FUNCTION static int
+    device_invoke(const MemberType &member, const HViewType &H,
+                  const ZViewType &Z, const EViewType &er, const EViewType &ei,
+                  const BViewType &b, const WViewType &w) {
+      const bool is_w_unit_stride = (int(w.stride(0)) == int(1));
+      assert(is_w_unit_stride);
+
+      const int m = H.extent(0), hs0 = H.stride(0), hs1 = H.stride(1);
+      const int zs0 = Z.stride(0), zs1 = Z.stride(1);
+      const int ers = er.stride(0), eis = ei.stride(0);
+      const int bs = b.stride(0);
+      const int wlen = w.extent(0);
+
+      const int r_val = SchurMultiShiftInternal ::invoke(
+        member, m, H.data(), hs0, hs1, Z.data(), zs0, zs1, er.data(), ers,
+        ei.data(), eis, b.data(), bs, w.data(), wlen);
+      return r_val;
+    }
+
     template <typename MemberType, typename HViewType, typename ZViewType,
               typename EViewType, typename BViewType>
     KOKKOS_INLINE_FUNCTION static int
@@ -66,6 +101,21 @@ namespace Tines {
 #endif
       return r_val;
     }
+
+    template <typename MemberType, typename HViewType, typename ZViewType,
+              typename EViewType, typename BViewType, typename WViewType>
+    KOKKOS_INLINE_FUNCTION static int
+    invoke(const MemberType &member, const HViewType &H, const ZViewType &Z,
+           const EViewType &er, const EViewType &ei, const BViewType &b,
+           const WViewType &w) {
+      static_assert(HViewType::rank == 2, "H is not rank-2 view");
+      static_assert(ZViewType::rank == 2, "Z is not rank-2 view");
+      static_assert(EViewType::rank == 1, "E is not rank-1 view");
+      static_assert(BViewType::rank == 1, "B is not rank-1 view");
+      static_assert(WViewType::rank == 1, "W is not rank-1 view");
+
+      return device_invoke(member, H, Z, er, ei, b, w);
+    }
   };
 
 } // namespace Tines
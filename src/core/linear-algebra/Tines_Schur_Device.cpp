@@ -39,20 +39,21 @@ namespace Tines {
     Kokkos::Profiling::pushRegion("Tines::SchurSerial");
     const auto member = Tines::HostSerialTeamMember();
     const int iend = H.extent(0);
+    int r_val(0);
     for (int i = 0; i < iend; ++i) {
       const auto _H = Kokkos::subview(H, i, Kokkos::ALL(), Kokkos::ALL());
       const auto _Z = Kokkos::subview(Z, i, Kokkos::ALL(), Kokkos::ALL());
       const auto _er = Kokkos::subview(er, i, Kokkos::ALL());
       const auto _ei = Kokkos::subview(ei, i, Kokkos::ALL());
       const auto _b = Kokkos::subview(b, i, Kokkos::ALL());
-      Tines::Schur::invoke(member, _H, _Z, _er, _ei, _b);
+      r_val += (Tines::Schur::invoke(member, _H, _Z, _er, _ei, _b) != 0);
       /// this is not really necessary
       const double zero(0);
       Tines::SetTriangularMatrix<Uplo::Lower>::invoke(member, 2, zero, _H);
     }
 
     Kokkos::Profiling::popRegion();
-    return 0;
+    return r_val;
   }
 #endif
 
@@ -73,23 +74,29 @@ namespace Tines {
     Kokkos::Profiling::pushRegion("Tines::SchurOpenMP");
     using policy_type = Kokkos::TeamPolicy<Kokkos::OpenMP>;
     policy_type policy(exec_instance, H.extent(0), 1);
-    Kokkos::parallel_for(
-      "Tines::SchurOpenMP::parallel_for", policy,
-      KOKKOS_LAMBDA(const typename policy_type::member_type &member) {
+    int r_val(0);
+    Kokkos::parallel_reduce(
+      "Tines::SchurOpenMP::parallel_reduce", policy,
+      KOKKOS_LAMBDA(const typename policy_type::member_type &member,
+                    int &update) {
         const int i = member.league_rank();
         const auto _H = Kokkos::subview(H, i, Kokkos::ALL(), Kokkos::ALL());
         const auto _Z = Kokkos::subview(Z, i, Kokkos::ALL(), Kokkos::ALL());
         const auto _er = Kokkos::subview(er, i, Kokkos::ALL());
         const auto _ei = Kokkos::subview(ei, i, Kokkos::ALL());
         const auto _b = Kokkos::subview(b, i, Kokkos::ALL());
-        Tines::Schur::invoke(member, _H, _Z, _er, _ei, _b);
+        const int r_val_at_i =
+          Tines::Schur::invoke(member, _H, _Z, _er, _ei, _b);
+        Kokkos::single(Kokkos::PerTeam(member),
+                       [&]() { update += (r_val_at_i != 0); });
         /// this is not really necessary
         const double zero(0);
         Tines::SetTriangularMatrix<Uplo::Lower>::invoke(member, 2, zero, _H);
-      });
+      },
+      r_val);
 
     Kokkos::Profiling::popRegion();
-    return 0;
+    return r_val;
   }
 #endif
 
@@ -110,52 +117,35 @@ namespace Tines {
     Kokkos::Profiling::pushRegion("Tines::SchurCuda");
     const int league_size = H.extent(0);
     using policy_type = Kokkos::TeamPolicy<Kokkos::Cuda>;
-    policy_type policy(exec_instance, league_size, Kokkos::AUTO);
-
-    /// let's guess....
-    {
-      const int np = H.extent(0), m = H.extent(1);
-      if (np > 100000) {
-        /// we have enough batch parallelism... use AUTO
-      } else {
-        /// batch parallelsim itself cannot occupy the whole device
-        int vector_size(0), team_size(0);
-        if (m <= 256) {
-          const int total_team_size = 256;
-          vector_size = 16;
-          team_size = total_team_size / vector_size;
-        } else if (m <= 512) {
-          const int total_team_size = 512;
-          vector_size = 16;
-          team_size = total_team_size / vector_size;
-        } else {
-          const int total_team_size = 768;
-          vector_size = 16;
-          team_size = total_team_size / vector_size;
-        }
-        policy =
-          policy_type(exec_instance, league_size, team_size, vector_size);
-      }
-    }
-    // this is for testing only
-    policy = policy_type(exec_instance, league_size, 1, 1);
-    Kokkos::parallel_for(
-      "Tines::SchurCuda::parallel_for", policy,
-      KOKKOS_LAMBDA(const typename policy_type::member_type &member) {
+    int team_size(0), vector_size(0);
+    getBatchedTeamSize(league_size, H.extent(1), team_size, vector_size);
+    const auto policy =
+      team_size > 0
+        ? policy_type(exec_instance, league_size, team_size, vector_size)
+        : policy_type(exec_instance, league_size, Kokkos::AUTO);
+    int r_val(0);
+    Kokkos::parallel_reduce(
+      "Tines::SchurCuda::parallel_reduce", policy,
+      KOKKOS_LAMBDA(const typename policy_type::member_type &member,
+                    int &update) {
         const int i = member.league_rank();
         const auto _H = Kokkos::subview(H, i, Kokkos::ALL(), Kokkos::ALL());
         const auto _Z = Kokkos::subview(Z, i, Kokkos::ALL(), Kokkos::ALL());
         const auto _er = Kokkos::subview(er, i, Kokkos::ALL());
         const auto _ei = Kokkos::subview(ei, i, Kokkos::ALL());
         const auto _b = Kokkos::subview(b, i, Kokkos::ALL());
-        Tines::Schur::invoke(member, _H, _Z, _er, _ei, _b);
+        const int r_val_at_i =
+          Tines::Schur::invoke(member, _H, _Z, _er, _ei, _b);
+        Kokkos::single(Kokkos::PerTeam(member),
+                       [&]() { update += (r_val_at_i != 0); });
         /// this is not really necessary
         const double zero(0);
         Tines::SetTriangularMatrix<Uplo::Lower>::invoke(member, 2, zero, _H);
-      });
+      },
+      r_val);
 
     Kokkos::Profiling::popRegion();
-    return 0;
+    return r_val;
   }
 #endif
 
@@ -23,6 +23,12 @@ Sandia National Laboratories, New Mexico, USA
 
 namespace Tines {
 
+  ///
+  /// Batched Schur decomposition of Hessenberg matrices. The return value is
+  /// the number of problems whose QR iteration does not converge; for those
+  /// problems, the diagonal of the unconverged block is stored as real
+  /// eigenvalues (see SchurInternal).
+  ///
   template <typename SpT> struct SchurDevice {
     static int invoke(
       const SpT &exec_instance,
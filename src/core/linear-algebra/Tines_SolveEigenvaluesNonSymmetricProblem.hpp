@@ -21,7 +21,12 @@ Sandia National Laboratories, New Mexico, USA
 #ifndef __TINES_SOLVE_EIGENVALUES_NONSYMMETRIC_PROBLEM_HPP__
 #define __TINES_SOLVE_EIGENVALUES_NONSYMMETRIC_PROBLEM_HPP__
 
+#include "Tines_EigenvalueSelect.hpp"
+#include "Tines_Gemm.hpp"
+#include "Tines_Hessenberg.hpp"
 #include "Tines_Internal.hpp"
+#include "Tines_RightEigenvectorSchur.hpp"
+#include "Tines_Schur.hpp"
 #include "Tines_SolveEigenvaluesNonSymmetricProblem_Internal.hpp"
 
 namespace Tines {
@@ -35,6 +40,10 @@ namespace Tines {
     const int m, double *A, const int as0, const int as1, double *er,
     double *ei, double *UR, const int urs0, const int urs1);
 
+  int SolveEigenvaluesNonSymmetricProblemWithoutEigenvectors_HostTPL(
+    const int m, double *A, const int as0, const int as1, double *er,
+    double *ei);
+
   struct SolveEigenvaluesNonSymmetricProblem {
     template <typename MemberType, typename AViewType, typename EViewType,
               typename UViewType, typename WViewType>
@@ -83,6 +92,166 @@ namespace Tines {
       }
 #else
       r_val = device_invoke(member, A, er, ei, UR, W);
+#endif
+      return r_val;
+    }
+
+    ///
+    /// Left and right eigenvectors normalized as a biorthogonal pair,
+    /// UL^H UR = I; the workspace is the same as the solve for the right
+    /// eigenvectors.
+    ///
+    template <typename MemberType, typename AViewType, typename EViewType,
+              typename ULViewType, typename URViewType, typename WViewType>
+    KOKKOS_INLINE_FUNCTION static int
+    device_invoke(const MemberType &member, const AViewType &A,
+                  const EViewType &er, const EViewType &ei,
+                  const ULViewType &UL, const URViewType &UR,
+                  const WViewType &W) {
+      const int m = A.extent(0), as0 = A.stride(0), as1 = A.stride(1);
+      const int ers = er.stride(0), eis = ei.stride(0);
+      const int uls0 = UL.stride(0), uls1 = UL.stride(1);
+      const int urs0 = UR.stride(0), urs1 = UR.stride(1);
+      const int wlen = W.extent(0);
+      const int r_val = SolveEigenvaluesNonSymmetricProblemInternal::invoke(
+        member, m, A.data(), as0, as1, er.data(), ers, ei.data(), eis,
+        UL.data(), uls0, uls1, UR.data(), urs0, urs1, W.data(), wlen);
+      return r_val;
+    }
+
+    template <typename MemberType, typename AViewType, typename EViewType,
+              typename ULViewType, typename URViewType, typename WViewType>
+    KOKKOS_INLINE_FUNCTION static int
+    invoke(const MemberType &member, const AViewType &A, const EViewType &er,
+           const EViewType &ei, const ULViewType &UL, const URViewType &UR,
+           const WViewType &W, const bool use_tpl_if_avail = true) {
+      int r_val(0);
+      static_assert(AViewType::rank == 2, "A is not rank-2 view");
+      static_assert(EViewType::rank == 1, "er and ei are not rank-1 view");
+      static_assert(ULViewType::rank == 2, "UL is not rank-2 view");
+      static_assert(URViewType::rank == 2, "UR is not rank-2 view");
+      static_assert(WViewType::rank == 1, "W is not rank-1 view");
+
+#if defined(TINES_ENABLE_TPL_LAPACKE_ON_HOST) && !defined(__CUDA_ARCH__)
+      if ((std::is_same<Kokkos::Impl::ActiveExecutionMemorySpace,
+                        Kokkos::HostSpace>::value) &&
+          (A.stride(0) == 1 || A.stride(1) == 1) && (er.stride(0) == 1) &&
+          (ei.stride(0) == 1) && (UL.stride(0) == 1 || UL.stride(1) == 1) &&
+          (UR.stride(0) == 1 || UR.stride(1) == 1) && use_tpl_if_avail) {
+        Kokkos::single(Kokkos::PerTeam(member), [&]() {
+          const int m = A.extent(0), as0 = A.stride(0), as1 = A.stride(1);
+          const int uls0 = UL.stride(0), uls1 = UL.stride(1);
+          const int urs0 = UR.stride(0), urs1 = UR.stride(1);
+          r_val = SolveEigenvaluesNonSymmetricProblem_HostTPL(
+            m, A.data(), as0, as1, er.data(), ei.data(), UL.data(), uls0,
+            uls1, UR.data(), urs0, urs1);
+        });
+        member.team_barrier();
+        /// lapack normalizes each eigenvector; rescale UL for UL^H UR = I
+        {
+          const int m = A.extent(0), eis = ei.stride(0);
+          const int uls0 = UL.stride(0), uls1 = UL.stride(1);
+          const int urs0 = UR.stride(0), urs1 = UR.stride(1);
+          SolveEigenvaluesNonSymmetricProblemInternal::biorthonormalize(
+            member, m, ei.data(), eis, UL.data(), uls0, uls1, UR.data(), urs0,
+            urs1);
+        }
+      } else {
+        r_val = device_invoke(member, A, er, ei, UL, UR, W);
+      }
+#else
+      r_val = device_invoke(member, A, er, ei, UL, UR, W);
+#endif
+      return r_val;
+    }
+
+    ///
+    /// Selected right eigenvectors only; the selector picks eigenvalues of
+    /// interest (see Tines_EigenvalueSelect.hpp). On exit, UR(:,i) is the
+    /// eigenvector of the eigenvalue sel(i) for i < nsel; a complex pair is
+    /// stored in two consecutive columns. sel needs m entries and the
+    /// workspace is the same as the solve for all eigenvectors.
+    ///
+    template <typename MemberType, typename AViewType, typename EViewType,
+              typename SelectorType, typename SViewType, typename UViewType,
+              typename WViewType>
+    KOKKOS_INLINE_FUNCTION static int
+    invoke(const MemberType &member, const AViewType &A, const EViewType &er,
+           const EViewType &ei, const SelectorType &select,
+           const SViewType &sel, int &nsel, const UViewType &UR,
+           const WViewType &W) {
+      static_assert(AViewType::rank == 2, "A is not rank-2 view");
+      static_assert(EViewType::rank == 1, "er and ei are not rank-1 view");
+      static_assert(SViewType::rank == 1, "sel is not rank-1 view");
+      static_assert(UViewType::rank == 2, "UR is not rank-2 view");
+      static_assert(WViewType::rank == 1, "W is not rank-1 view");
+
+      const int m = A.extent(0), as0 = A.stride(0), as1 = A.stride(1);
+      const int ers = er.stride(0), eis = ei.stride(0), ss = sel.stride(0);
+      const int urs0 = UR.stride(0), urs1 = UR.stride(1), urn = UR.extent(1);
+      const int wlen = W.extent(0);
+      TINES_CHECK_ERROR(int(sel.extent(0)) < m,
+                        "Error: sel should have m entries");
+      const int r_val = SolveEigenvaluesNonSymmetricProblemInternal::invoke(
+        member, m, A.data(), as0, as1, er.data(), ers, ei.data(), eis, select,
+        sel.data(), ss, nsel, UR.data(), urs0, urs1, urn, W.data(), wlen);
+      return r_val;
+    }
+
+    ///
+    /// Eigenvalues only; eigenvectors are not computed and the workspace
+    /// needs 3m (see workspace). A is overwritten.
+    ///
+    template <typename AViewType>
+    KOKKOS_INLINE_FUNCTION static int workspace(const AViewType &A,
+                                                int &wlen) {
+      const int m = A.extent(0);
+      wlen = 3 * m;
+      return 0;
+    }
+
+    template <typename MemberType, typename AViewType, typename EViewType,
+              typename WViewType>
+    KOKKOS_INLINE_FUNCTION static int
+    device_invoke(const MemberType &member, const AViewType &A,
+                  const EViewType &er, const EViewType &ei,
+                  const WViewType &W) {
+      const int m = A.extent(0), as0 = A.stride(0), as1 = A.stride(1);
+      const int ers = er.stride(0), eis = ei.stride(0);
+      const int wlen = W.extent(0);
+      const int r_val = SolveEigenvaluesNonSymmetricProblemInternal::invoke(
+        member, m, A.data(), as0, as1, er.data(), ers, ei.data(), eis,
+        W.data(), wlen);
+      return r_val;
+    }
+
+    template <typename MemberType, typename AViewType, typename EViewType,
+              typename WViewType>
+    KOKKOS_INLINE_FUNCTION static int
+    invoke(const MemberType &member, const AViewType &A, const EViewType &er,
+           const EViewType &ei, const WViewType &W,
+           const bool use_tpl_if_avail = true) {
+      int r_val(0);
+      static_assert(AViewType::rank == 2, "A is not rank-2 view");
+      static_assert(EViewType::rank == 1, "er and ei are not rank-1 view");
+      static_assert(WViewType::rank == 1, "W is not rank-1 view");
+
+#if defined(TINES_ENABLE_TPL_LAPACKE_ON_HOST) && !defined(__CUDA_ARCH__)
+      if ((std::is_same<Kokkos::Impl::ActiveExecutionMemorySpace,
+                        Kokkos::HostSpace>::value) &&
+          (A.stride(0) == 1 || A.stride(1) == 1) && (er.stride(0) == 1) &&
+          (ei.stride(0) == 1) && use_tpl_if_avail) {
+        Kokkos::single(Kokkos::PerTeam(member), [&]() {
+          const int m = A.extent(0), as0 = A.stride(0), as1 = A.stride(1);
+          r_val =
+            SolveEigenvaluesNonSymmetricProblemWithoutEigenvectors_HostTPL(
+              m, A.data(), as0, as1, er.data(), ei.data());
+        });
+      } else {
+        r_val = device_invoke(member, A, er, ei, W);
+      }
+#else
+      r_val = device_invoke(member, A, er, ei, W);
 #endif
       return r_val;
     }
@@ -20,6 +20,16 @@ Sandia National Laboratories, New Mexico, USA
 ----------------------------------------------------------------------------------*/
 #include "Tines.hpp"
 
+///
+/// Cuda implementation of the right eigenvectors
+///   0 - a team solves a whole problem
+///   1 - batched stages resident on device
+///   2 - batched stages with the Schur decomposition on host
+///
+#if !defined(TINES_EIG_NONSYM_IMPL_OPTION)
+#define TINES_EIG_NONSYM_IMPL_OPTION 1
+#endif
+
 namespace Tines {
 
 #if defined(KOKKOS_ENABLE_SERIAL)
@@ -46,6 +56,58 @@ namespace Tines {
                                                    use_tpl_if_avail);
     }
 
+    Kokkos::Profiling::popRegion();
+    return 0;
+  }
+  int SolveEigenvaluesNonSymmetricProblemDevice<Kokkos::Serial>::invoke(
+    const Kokkos::Serial &,
+    const value_type_3d_view<double, UseThisDevice<Kokkos::Serial>::type> &A,
+    const value_type_2d_view<double, UseThisDevice<Kokkos::Serial>::type> &er,
+    const value_type_2d_view<double, UseThisDevice<Kokkos::Serial>::type> &ei,
+    const value_type_3d_view<double, UseThisDevice<Kokkos::Serial>::type> &UL,
+    const value_type_3d_view<double, UseThisDevice<Kokkos::Serial>::type> &UR,
+    const value_type_2d_view<double, UseThisDevice<Kokkos::Serial>::type> &w,
+    const bool use_tpl_if_avail) {
+    Kokkos::Profiling::pushRegion(
+      "Tines::SolveEigenvaluesNonSymmetricProbelmLeftRightSerial");
+    const auto member = Tines::HostSerialTeamMember();
+    const int iend = A.extent(0);
+    for (int i = 0; i < iend; ++i) {
+      const auto _A = Kokkos::subview(A, i, Kokkos::ALL(), Kokkos::ALL());
+      const auto _er = Kokkos::subview(er, i, Kokkos::ALL());
+      const auto _ei = Kokkos::subview(ei, i, Kokkos::ALL());
+      const auto _UL = Kokkos::subview(UL, i, Kokkos::ALL(), Kokkos::ALL());
+      const auto _UR = Kokkos::subview(UR, i, Kokkos::ALL(), Kokkos::ALL());
+      const auto _w = Kokkos::subview(w, i, Kokkos::ALL());
+
+      SolveEigenvaluesNonSymmetricProblem ::invoke(member, _A, _er, _ei, _UL,
+                                                   _UR, _w, use_tpl_if_avail);
+    }
+
+    Kokkos::Profiling::popRegion();
+    return 0;
+  }
+  int SolveEigenvaluesNonSymmetricProblemDevice<Kokkos::Serial>::invoke(
+    const Kokkos::Serial &,
+    const value_type_3d_view<double, UseThisDevice<Kokkos::Serial>::type> &A,
+    const value_type_2d_view<double, UseThisDevice<Kokkos::Serial>::type> &er,
+    const value_type_2d_view<double, UseThisDevice<Kokkos::Serial>::type> &ei,
+    const value_type_2d_view<double, UseThisDevice<Kokkos::Serial>::type> &w,
+    const bool use_tpl_if_avail) {
+    Kokkos::Profiling::pushRegion(
+      "Tines::SolveEigenvaluesNonSymmetricProbelmEigenvaluesOnlySerial");
+    const auto member = Tines::HostSerialTeamMember();
+    const int iend = A.extent(0);
+    for (int i = 0; i < iend; ++i) {
+      const auto _A = Kokkos::subview(A, i, Kokkos::ALL(), Kokkos::ALL());
+      const auto _er = Kokkos::subview(er, i, Kokkos::ALL());
+      const auto _ei = Kokkos::subview(ei, i, Kokkos::ALL());
+      const auto _w = Kokkos::subview(w, i, Kokkos::ALL());
+
+      SolveEigenvaluesNonSymmetricProblem ::invoke(member, _A, _er, _ei, _w,
+                                                   use_tpl_if_avail);
+    }
+
     Kokkos::Profiling::popRegion();
     return 0;
   }
@@ -81,6 +143,65 @@ namespace Tines {
     Kokkos::Profiling::popRegion();
     return 0;
   }
+  int SolveEigenvaluesNonSymmetricProblemDevice<Kokkos::OpenMP>::invoke(
+    const Kokkos::OpenMP &exec_instance,
+    const value_type_3d_view<double, UseThisDevice<Kokkos::OpenMP>::type> &A,
+    const value_type_2d_view<double, UseThisDevice<Kokkos::OpenMP>::type> &er,
+    const value_type_2d_view<double, UseThisDevice<Kokkos::OpenMP>::type> &ei,
+    const value_type_3d_view<double, UseThisDevice<Kokkos::OpenMP>::type> &UL,
+    const value_type_3d_view<double, UseThisDevice<Kokkos::OpenMP>::type> &UR,
+    const value_type_2d_view<double, UseThisDevice<Kokkos::OpenMP>::type> &w,
+    const bool use_tpl_if_avail) {
+    Kokkos::Profiling::pushRegion(
+      "Tines::SolveEigenvaluesNonSymmetricProbelmLeftRightOpenMP");
+    using policy_type = Kokkos::TeamPolicy<Kokkos::OpenMP>;
+    policy_type policy(exec_instance, A.extent(0), 1);
+    Kokkos::parallel_for(
+      "Tines::SolveEigenvaluesNonsymmetricProblemLeftRightOpenMP::parallel_for",
+      policy, KOKKOS_LAMBDA(const typename policy_type::member_type &member) {
+        const int i = member.league_rank();
+        const auto _A = Kokkos::subview(A, i, Kokkos::ALL(), Kokkos::ALL());
+        const auto _er = Kokkos::subview(er, i, Kokkos::ALL());
+        const auto _ei = Kokkos::subview(ei, i, Kokkos::ALL());
+        const auto _UL = Kokkos::subview(UL, i, Kokkos::ALL(), Kokkos::ALL());
+        const auto _UR = Kokkos::subview(UR, i, Kokkos::ALL(), Kokkos::ALL());
+        const auto _w = Kokkos::subview(w, i, Kokkos::ALL());
+
+        SolveEigenvaluesNonSymmetricProblem ::invoke(
+          member, _A, _er, _ei, _UL, _UR, _w, use_tpl_if_avail);
+      });
+
+    Kokkos::Profiling::popRegion();
+    return 0;
+  }
+  int SolveEigenvaluesNonSymmetricProblemDevice<Kokkos::OpenMP>::invoke(
+    const Kokkos::OpenMP &exec_instance,
+    const value_type_3d_view<double, UseThisDevice<Kokkos::OpenMP>::type> &A,
+    const value_type_2d_view<double, UseThisDevice<Kokkos::OpenMP>::type> &er,
+    const value_type_2d_view<double, UseThisDevice<Kokkos::OpenMP>::type> &ei,
+    const value_type_2d_view<double, UseThisDevice<Kokkos::OpenMP>::type> &w,
+    const bool use_tpl_if_avail) {
+    Kokkos::Profiling::pushRegion(
+      "Tines::SolveEigenvaluesNonSymmetricProbelmEigenvaluesOnlyOpenMP");
+    using policy_type = Kokkos::TeamPolicy<Kokkos::OpenMP>;
+    policy_type policy(exec_instance, A.extent(0), 1);
+    Kokkos::parallel_for(
+      "Tines::SolveEigenvaluesNonsymmetricProblemEigenvaluesOnlyOpenMP::"
+      "parallel_for",
+      policy, KOKKOS_LAMBDA(const typename policy_type::member_type &member) {
+        const int i = member.league_rank();
+        const auto _A = Kokkos::subview(A, i, Kokkos::ALL(), Kokkos::ALL());
+        const auto _er = Kokkos::subview(er, i, Kokkos::ALL());
+        const auto _ei = Kokkos::subview(ei, i, Kokkos::ALL());
+        const auto _w = Kokkos::subview(w, i, Kokkos::ALL());
+
+        SolveEigenvaluesNonSymmetricProblem ::invoke(member, _A, _er, _ei, _w,
+                                                     use_tpl_if_avail);
+      });
+
+    Kokkos::Profiling::popRegion();
+    return 0;
+  }
 #endif
 
 #if defined(KOKKOS_ENABLE_CUDA)
@@ -94,44 +215,18 @@ namespace Tines {
     const bool use_tpl_if_avail) {
     Kokkos::Profiling::pushRegion(
       "Tines::SolveEigenvaluesNonSymmetricProbelmCuda");
-#define TINES_EIG_NONSYM_IMPL_OPTION 2
+    int r_val(0);
 #if TINES_EIG_NONSYM_IMPL_OPTION == 0
     {
+      /// a team solves a whole problem including balancing
       const int league_size = A.extent(0);
       using policy_type = Kokkos::TeamPolicy<Kokkos::Cuda>;
-      policy_type policy(exec_instance, league_size, Kokkos::AUTO);
-
-      /// let's guess....
-      {
-        const int np = A.extent(0), m = A.extent(1);
-        if (np > 100000) {
-          /// we have enough batch parallelism... use AUTO
-        } else {
-          /// batch parallelsim itself cannot occupy the whole device
-          int vector_size(0), team_size(0);
-          if (m <= 128) {
-            const int total_team_size = 128;
-            vector_size = 16;
-            team_size = total_team_size / vector_size;
-          } else if (m <= 256) {
-            const int total_team_size = 256;
-            vector_size = 16;
-            team_size = total_team_size / vector_size;
-          } else if (m <= 512) {
-            const int total_team_size = 512;
-            vector_size = 16;
-            team_size = total_team_size / vector_size;
-          } else {
-            const int total_team_size = 768;
-            vector_size = 16;
-            team_size = total_team_size / vector_size;
-          }
-          policy =
-            policy_type(exec_instance, league_size, team_size, vector_size);
-        }
-      }
-      // this is for testing only
-      // policy = policy_type(exec_instance, league_size, 1,1);
+      int team_size(0), vector_size(0);
+      getBatchedTeamSize(league_size, A.extent(1), team_size, vector_size);
+      const auto policy =
+        team_size > 0
+          ? policy_type(exec_instance, league_size, team_size, vector_size)
+          : policy_type(exec_instance, league_size, Kokkos::AUTO);
       Kokkos::parallel_for(
         "Tines::SolveEigenvaluesNonsymmetricProblemCuda::parallel_for", policy,
         KOKKOS_LAMBDA(const typename policy_type::member_type &member) {
@@ -148,145 +243,79 @@ namespace Tines {
     }
 #elif TINES_EIG_NONSYM_IMPL_OPTION == 1
     {
-      const int np = A.extent(0), m = A.extent(1);
-      double *wptr = w.data();
-      int wlen = w.span();
-      value_type_3d_view<double, UseThisDevice<Kokkos::Cuda>::type> Z(wptr, np,
-                                                                      m, m);
-      wptr += Z.span();
-      wlen -= Z.span();
-      TINES_CHECK_ERROR(wlen < 0, "Error: workspace is too small");
-
-      value_type_2d_view<double, UseThisDevice<Kokkos::Cuda>::type> t(wptr, np,
-                                                                      m);
-      wptr += t.span();
-      wlen -= t.span();
-      TINES_CHECK_ERROR(wlen < 0, "Error: workspace is too small");
-
-      value_type_2d_view<double, UseThisDevice<Kokkos::Cuda>::type> w(wptr, np,
-                                                                      m);
-      wptr += w.span();
-      wlen -= w.span();
-      TINES_CHECK_ERROR(wlen < 0, "Error: workspace is too small");
-
-      HessenbergDevice<Kokkos::Cuda>::invoke(exec_instance, A, Z, t, w);
-
-      value_type_2d_view<int, UseThisDevice<Kokkos::Cuda>::type> b(
-        (int *)t.data(), np, m);
-
-      SchurDevice<Kokkos::Cuda>::invoke(exec_instance, A, Z, er, ei, b);
-
-      value_type_3d_view<double, UseThisDevice<Kokkos::Cuda>::type> U(wptr, np,
-                                                                      m, m);
-      wptr += U.span();
-      wlen -= U.span();
-      TINES_CHECK_ERROR(wlen < 0, "Error: workspace is too small");
-
-      RightEigenvectorSchurDevice<Kokkos::Cuda>::invoke(exec_instance, A, b, U,
-                                                        w);
-
-      const double one(1), zero(0);
-      GemmDevice<Trans::NoTranspose, Trans::NoTranspose, Kokkos::Cuda>::invoke(
-        exec_instance, one, Z, U, zero, V);
+      /// device resident stages
+      r_val = SolveEigenvaluesNonSymmetricProblemStagedDevice<
+        Kokkos::Cuda>::invoke(exec_instance, A, er, ei, V, w);
     }
 #else
     {
-      const int np = A.extent(0), m = A.extent(1);
-      double *wptr = w.data();
-      int wlen = w.span();
-      value_type_3d_view<double, UseThisDevice<Kokkos::Cuda>::type> Z(wptr, np,
-                                                                      m, m);
-      wptr += Z.span();
-      wlen -= Z.span();
-      TINES_CHECK_ERROR(wlen < 0, "Error: workspace is too small");
-
-      value_type_2d_view<double, UseThisDevice<Kokkos::Cuda>::type> t(wptr, np,
-                                                                      m);
-      wptr += t.span();
-      wlen -= t.span();
-      TINES_CHECK_ERROR(wlen < 0, "Error: workspace is too small");
-
-      value_type_2d_view<double, UseThisDevice<Kokkos::Cuda>::type> w(wptr, np,
-                                                                      m);
-      wptr += w.span();
-      wlen -= w.span();
-      TINES_CHECK_ERROR(wlen < 0, "Error: workspace is too small");
-
-      HessenbergDevice<Kokkos::Cuda>::invoke(exec_instance, A, Z, t, w);
-
-      const auto A_host = Kokkos::create_mirror_view(Kokkos::HostSpace(), A);
-      const auto Z_host = Kokkos::create_mirror_view(Kokkos::HostSpace(), Z);
-      const auto er_host = Kokkos::create_mirror_view(Kokkos::HostSpace(), er);
-      const auto ei_host = Kokkos::create_mirror_view(Kokkos::HostSpace(), er);
-
-      value_type_2d_view<int, UseThisDevice<Kokkos::Cuda>::type> b(
-        (int *)t.data(), np, m);
-      const auto b_host = Kokkos::create_mirror_view(Kokkos::HostSpace(), b);
-
-      Kokkos::deep_copy(exec_instance, A_host, A);
-      Kokkos::deep_copy(exec_instance, Z_host, Z);
-
-      {
-        using host_space = Kokkos::DefaultHostExecutionSpace;
-        using policy_type = Kokkos::TeamPolicy<host_space>;
-        using scratch_type = ScratchViewType<
-          value_type_1d_view<double, UseThisDevice<host_space>::type>>;
-        const int level = 1,
-                  per_team_scratch = scratch_type::shmem_size(2 * m * m);
-
-        policy_type policy(np, 1);
-        policy.set_scratch_size(level, Kokkos::PerTeam(per_team_scratch));
-#if !defined(__CUDA_ARCH__)
-        Kokkos::parallel_for(
-          policy,
-          KOKKOS_LAMBDA(const typename policy_type::member_type &member) {
-            const int p = member.league_rank();
-            scratch_type work(member.team_scratch(level), 2 * m * m);
-
-            double *__restrict__ _A = work.data();
-            double *__restrict__ _Z = work.data() + m * m;
-
-            /// change data column major
-            for (int i = 0; i < m; ++i)
-              for (int j = 0; j < m; ++j) {
-                _A[i + j * m] = A_host(p, i, j);
-                _Z[i + j * m] = Z_host(p, i, j);
-              }
-
-            Schur_HostTPL(m, _A, 1, m, _Z, 1, m, &er_host(p, 0), &ei_host(p, 0),
-                          &b_host(p, 0), 1);
-
-            for (int i = 0; i < m; ++i)
-              for (int j = 0; j < m; ++j) {
-                A_host(p, i, j) = _A[i + j * m];
-                Z_host(p, i, j) = _Z[i + j * m];
-              }
-          });
-#else
-        TINES_CHECK_ERROR(
-          true, "Error: cuda code is executed whereas host code is expected");
+      /// the schur decomposition is computed on host
+      const bool schur_on_host = true;
+      r_val = SolveEigenvaluesNonSymmetricProblemStagedDevice<
+        Kokkos::Cuda>::invoke(exec_instance, A, er, ei, V, w, schur_on_host);
+    }
 #endif
-        Kokkos::deep_copy(exec_instance, A, A_host);
-        Kokkos::deep_copy(exec_instance, Z, Z_host);
-        Kokkos::deep_copy(exec_instance, er, er_host);
-        Kokkos::deep_copy(exec_instance, ei, ei_host);
-        Kokkos::deep_copy(exec_instance, b, b_host);
-      }
+    Kokkos::Profiling::popRegion();
+    return r_val;
+  }
+  int SolveEigenvaluesNonSymmetricProblemDevice<Kokkos::Cuda>::invoke(
+    const Kokkos::Cuda &exec_instance,
+    const value_type_3d_view<double, UseThisDevice<Kokkos::Cuda>::type> &A,
+    const value_type_2d_view<double, UseThisDevice<Kokkos::Cuda>::type> &er,
+    const value_type_2d_view<double, UseThisDevice<Kokkos::Cuda>::type> &ei,
+    const value_type_3d_view<double, UseThisDevice<Kokkos::Cuda>::type> &UL,
+    const value_type_3d_view<double, UseThisDevice<Kokkos::Cuda>::type> &UR,
+    const value_type_2d_view<double, UseThisDevice<Kokkos::Cuda>::type> &w,
+    const bool use_tpl_if_avail) {
+    Kokkos::Profiling::pushRegion(
+      "Tines::SolveEigenvaluesNonSymmetricProbelmLeftRightCuda");
+    /// the left and right eigenvectors are computed on device
+    using policy_type = Kokkos::TeamPolicy<Kokkos::Cuda>;
+    policy_type policy(exec_instance, A.extent(0), Kokkos::AUTO);
+    Kokkos::parallel_for(
+      "Tines::SolveEigenvaluesNonsymmetricProblemLeftRightCuda::parallel_for",
+      policy, KOKKOS_LAMBDA(const typename policy_type::member_type &member) {
+        const int i = member.league_rank();
+        const auto _A = Kokkos::subview(A, i, Kokkos::ALL(), Kokkos::ALL());
+        const auto _er = Kokkos::subview(er, i, Kokkos::ALL());
+        const auto _ei = Kokkos::subview(ei, i, Kokkos::ALL());
+        const auto _UL = Kokkos::subview(UL, i, Kokkos::ALL(), Kokkos::ALL());
+        const auto _UR = Kokkos::subview(UR, i, Kokkos::ALL(), Kokkos::ALL());
+        const auto _w = Kokkos::subview(w, i, Kokkos::ALL());
 
-      value_type_3d_view<double, UseThisDevice<Kokkos::Cuda>::type> U(wptr, np,
-                                                                      m, m);
-      wptr += U.span();
-      wlen -= U.span();
-      TINES_CHECK_ERROR(wlen < 0, "Error: workspace is too small");
+        SolveEigenvaluesNonSymmetricProblem ::invoke(
+          member, _A, _er, _ei, _UL, _UR, _w, use_tpl_if_avail);
+      });
 
-      RightEigenvectorSchurDevice<Kokkos::Cuda>::invoke(exec_instance, A, b, U,
-                                                        w);
+    Kokkos::Profiling::popRegion();
+    return 0;
+  }
+  int SolveEigenvaluesNonSymmetricProblemDevice<Kokkos::Cuda>::invoke(
+    const Kokkos::Cuda &exec_instance,
+    const value_type_3d_view<double, UseThisDevice<Kokkos::Cuda>::type> &A,
+    const value_type_2d_view<double, UseThisDevice<Kokkos::Cuda>::type> &er,
+    const value_type_2d_view<double, UseThisDevice<Kokkos::Cuda>::type> &ei,
+    const value_type_2d_view<double, UseThisDevice<Kokkos::Cuda>::type> &w,
+    const bool use_tpl_if_avail) {
+    Kokkos::Profiling::pushRegion(
+      "Tines::SolveEigenvaluesNonSymmetricProbelmEigenvaluesOnlyCuda");
+    /// without schur vectors, the whole computation stays on device
+    using policy_type = Kokkos::TeamPolicy<Kokkos::Cuda>;
+    policy_type policy(exec_instance, A.extent(0), Kokkos::AUTO);
+    Kokkos::parallel_for(
+      "Tines::SolveEigenvaluesNonsymmetricProblemEigenvaluesOnlyCuda::"
+      "parallel_for",
+      policy, KOKKOS_LAMBDA(const typename policy_type::member_type &member) {
+        const int i = member.league_rank();
+        const auto _A = Kokkos::subview(A, i, Kokkos::ALL(), Kokkos::ALL());
+        const auto _er = Kokkos::subview(er, i, Kokkos::ALL());
+        const auto _ei = Kokkos::subview(ei, i, Kokkos::ALL());
+        const auto _w = Kokkos::subview(w, i, Kokkos::ALL());
+
+        SolveEigenvaluesNonSymmetricProblem ::invoke(member, _A, _er, _ei, _w,
+                                                     use_tpl_if_avail);
+      });
 
-      const double one(1), zero(0);
-      GemmDevice<Trans::NoTranspose, Trans::NoTranspose, Kokkos::Cuda>::invoke(
-        exec_instance, one, Z, U, zero, V);
-    }
-#endif
     Kokkos::Profiling::popRegion();
     return 0;
   }
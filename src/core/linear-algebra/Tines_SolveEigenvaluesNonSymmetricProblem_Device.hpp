@@ -36,6 +36,34 @@ namespace Tines {
                         "Error: the given execution space is not implemented");
       return -1;
     }
+
+    /// left and right eigenvectors
+    static int invoke(
+      const SpT &exec_instance,
+      const value_type_3d_view<double, typename UseThisDevice<SpT>::type> &A,
+      const value_type_2d_view<double, typename UseThisDevice<SpT>::type> &er,
+      const value_type_2d_view<double, typename UseThisDevice<SpT>::type> &ei,
+      const value_type_3d_view<double, typename UseThisDevice<SpT>::type> &UL,
+      const value_type_3d_view<double, typename UseThisDevice<SpT>::type> &UR,
+      const value_type_2d_view<double, typename UseThisDevice<SpT>::type> &W,
+      const bool use_tpl_if_avail = true) {
+      TINES_CHECK_ERROR(!ValidExecutionSpace<SpT>::value,
+                        "Error: the given execution space is not implemented");
+      return -1;
+    }
+
+    /// eigenvalues only
+    static int invoke(
+      const SpT &exec_instance,
+      const value_type_3d_view<double, typename UseThisDevice<SpT>::type> &A,
+      const value_type_2d_view<double, typename UseThisDevice<SpT>::type> &er,
+      const value_type_2d_view<double, typename UseThisDevice<SpT>::type> &ei,
+      const value_type_2d_view<double, typename UseThisDevice<SpT>::type> &W,
+      const bool use_tpl_if_avail = true) {
+      TINES_CHECK_ERROR(!ValidExecutionSpace<SpT>::value,
+                        "Error: the given execution space is not implemented");
+      return -1;
+    }
   };
 
 #if defined(KOKKOS_ENABLE_SERIAL)
@@ -53,6 +81,36 @@ namespace Tines {
       const value_type_2d_view<double,
                                typename UseThisDevice<Kokkos::Serial>::type> &W,
       const bool use_tpl_if_avail = true);
+
+    /// left and right eigenvectors
+    static int invoke(
+      const Kokkos::Serial &exec_instance,
+      const value_type_3d_view<double,
+                               typename UseThisDevice<Kokkos::Serial>::type> &A,
+      const value_type_2d_view<
+        double, typename UseThisDevice<Kokkos::Serial>::type> &er,
+      const value_type_2d_view<
+        double, typename UseThisDevice<Kokkos::Serial>::type> &ei,
+      const value_type_3d_view<double,
+                               typename UseThisDevice<Kokkos::Serial>::type> &UL,
+      const value_type_3d_view<double,
+                               typename UseThisDevice<Kokkos::Serial>::type> &UR,
+      const value_type_2d_view<double,
+                               typename UseThisDevice<Kokkos::Serial>::type> &W,
+      const bool use_tpl_if_avail = true);
+
+    /// eigenvalues only
+    static int invoke(
+      const Kokkos::Serial &exec_instance,
+      const value_type_3d_view<double,
+                               typename UseThisDevice<Kokkos::Serial>::type> &A,
+      const value_type_2d_view<
+        double, typename UseThisDevice<Kokkos::Serial>::type> &er,
+      const value_type_2d_view<
+        double, typename UseThisDevice<Kokkos::Serial>::type> &ei,
+      const value_type_2d_view<double,
+                               typename UseThisDevice<Kokkos::Serial>::type> &W,
+      const bool use_tpl_if_avail = true);
   };
 #endif
 #if defined(KOKKOS_ENABLE_OPENMP)
@@ -70,6 +128,36 @@ namespace Tines {
       const value_type_2d_view<double,
                                typename UseThisDevice<Kokkos::OpenMP>::type> &W,
       const bool use_tpl_if_avail = true);
+
+    /// left and right eigenvectors
+    static int invoke(
+      const Kokkos::OpenMP &exec_instance,
+      const value_type_3d_view<double,
+                               typename UseThisDevice<Kokkos::OpenMP>::type> &A,
+      const value_type_2d_view<
+        double, typename UseThisDevice<Kokkos::OpenMP>::type> &er,
+      const value_type_2d_view<
+        double, typename UseThisDevice<Kokkos::OpenMP>::type> &ei,
+      const value_type_3d_view<double,
+                               typename UseThisDevice<Kokkos::OpenMP>::type> &UL,
+      const value_type_3d_view<double,
+                               typename UseThisDevice<Kokkos::OpenMP>::type> &UR,
+      const value_type_2d_view<double,
+                               typename UseThisDevice<Kokkos::OpenMP>::type> &W,
+      const bool use_tpl_if_avail = true);
+
+    /// eigenvalues only
+    static int invoke(
+      const Kokkos::OpenMP &exec_instance,
+      const value_type_3d_view<double,
+                               typename UseThisDevice<Kokkos::OpenMP>::type> &A,
+      const value_type_2d_view<
+        double, typename UseThisDevice<Kokkos::OpenMP>::type> &er,
+      const value_type_2d_view<
+        double, typename UseThisDevice<Kokkos::OpenMP>::type> &ei,
+      const value_type_2d_view<double,
+                               typename UseThisDevice<Kokkos::OpenMP>::type> &W,
+      const bool use_tpl_if_avail = true);
   };
 #endif
 #if defined(KOKKOS_ENABLE_CUDA)
@@ -87,8 +175,267 @@ namespace Tines {
       const value_type_2d_view<double,
                                typename UseThisDevice<Kokkos::Cuda>::type> &W,
       const bool use_tpl_if_avail = true);
+
+    /// left and right eigenvectors
+    static int invoke(
+      const Kokkos::Cuda &exec_instance,
+      const value_type_3d_view<double,
+                               typename UseThisDevice<Kokkos::Cuda>::type> &A,
+      const value_type_2d_view<double,
+                               typename UseThisDevice<Kokkos::Cuda>::type> &er,
+      const value_type_2d_view<double,
+                               typename UseThisDevice<Kokkos::Cuda>::type> &ei,
+      const value_type_3d_view<double,
+                               typename UseThisDevice<Kokkos::Cuda>::type> &UL,
+      const value_type_3d_view<double,
+                               typename UseThisDevice<Kokkos::Cuda>::type> &UR,
+      const value_type_2d_view<double,
+                               typename UseThisDevice<Kokkos::Cuda>::type> &W,
+      const bool use_tpl_if_avail = true);
+
+    /// eigenvalues only
+    static int invoke(
+      const Kokkos::Cuda &exec_instance,
+      const value_type_3d_view<double,
+                               typename UseThisDevice<Kokkos::Cuda>::type> &A,
+      const value_type_2d_view<double,
+                               typename UseThisDevice<Kokkos::Cuda>::type> &er,
+      const value_type_2d_view<double,
+                               typename UseThisDevice<Kokkos::Cuda>::type> &ei,
+      const value_type_2d_view<double,
+                               typename UseThisDevice<Kokkos::Cuda>::type> &W,
+      const bool use_tpl_if_avail = true);
   };
 #endif
+
+  ///
+  /// Batched right eigenvectors computed by a sequence of batched kernels;
+  /// balancing A := D^{-1} P^T A P D, Hessenberg reduction A = Q H Q^H,
+  /// Schur decomposition H = Z T Z^H, eigenvectors of the Schur form
+  /// T = X S X^{-1} and the back transformation V = P D (Q Z) X followed by
+  /// the normalization of V as the team solver does. Each stage is launched
+  /// with its own team mapping and the data stays in the memory space of SpT.
+  /// With schur_on_host, the Schur decomposition is computed on host (LAPACK
+  /// when it is available) and H and Z make a round trip to the host memory.
+  /// W(np, wlen) is a contiguous workspace with wlen >= 2m^2 + 3m + 1 (see
+  /// workspace). The return value is the number of problems whose QR
+  /// iteration does not converge; their eigenvalues are not accurate.
+  ///
+  template <typename SpT>
+  struct SolveEigenvaluesNonSymmetricProblemStagedDevice {
+    using device_type = typename UseThisDevice<SpT>::type;
+    using real_type_2d_view_type = value_type_2d_view<double, device_type>;
+    using real_type_3d_view_type = value_type_3d_view<double, device_type>;
+    using int_type_2d_view_type = value_type_2d_view<int, device_type>;
+
+    static int workspace(const int m, int &wlen) {
+      wlen = 2 * m * m + 3 * m + 1;
+      return 0;
+    }
+
+    /// A := D^{-1} P^T A P D; ilohi(p,:) stores ilo and ihi of the problem p
+    static void balance(const SpT &exec_instance,
+                        const real_type_3d_view_type &A,
+                        const real_type_2d_view_type &scale,
+                        const int_type_2d_view_type &ilohi) {
+      using policy_type = Kokkos::TeamPolicy<SpT>;
+      policy_type policy(exec_instance, A.extent(0), Kokkos::AUTO);
+      Kokkos::parallel_for(
+        "Tines::SolveEigenvaluesNonSymmetricProblemStagedDevice::balance",
+        policy, KOKKOS_LAMBDA(const typename policy_type::member_type &member) {
+          const int p = member.league_rank();
+          const auto _A = Kokkos::subview(A, p, Kokkos::ALL(), Kokkos::ALL());
+          const auto _scale = Kokkos::subview(scale, p, Kokkos::ALL());
+          int ilo(0), ihi(0);
+          Balance::invoke(member, _A, _scale, ilo, ihi);
+          Kokkos::single(Kokkos::PerTeam(member), [&]() {
+            ilohi(p, 0) = ilo;
+            ilohi(p, 1) = ihi;
+          });
+        });
+    }
+
+    /// V := P D V and normalize the eigenvectors again
+    static void balanceBackTransform(const SpT &exec_instance,
+                                     const real_type_2d_view_type &scale,
+                                     const int_type_2d_view_type &ilohi,
+                                     const int_type_2d_view_type &b,
+                                     const real_type_3d_view_type &V,
+                                     const real_type_2d_view_type &w) {
+      using policy_type = Kokkos::TeamPolicy<SpT>;
+      policy_type policy(exec_instance, V.extent(0), Kokkos::AUTO);
+      Kokkos::parallel_for(
+        "Tines::SolveEigenvaluesNonSymmetricProblemStagedDevice::"
+        "balanceBackTransform",
+        policy, KOKKOS_LAMBDA(const typename policy_type::member_type &member) {
+          const int p = member.league_rank(), m = V.extent(1);
+          const int ilo = ilohi(p, 0), ihi = ilohi(p, 1);
+          if ((ihi - ilo + 1) < m || ilo < ihi) {
+            const auto _V =
+              Kokkos::subview(V, p, Kokkos::ALL(), Kokkos::ALL());
+            const auto _scale = Kokkos::subview(scale, p, Kokkos::ALL());
+            BalanceBackTransform::invoke(member, ilo, ihi, _scale, _V);
+            member.team_barrier();
+            SolveEigenvaluesNonSymmetricProblemInternal::normalize(
+              member, m, m, &b(p, 0), int(b.stride(1)), _V.data(),
+              int(_V.stride(0)), int(_V.stride(1)), &w(p, 0));
+          }
+        });
+    }
+
+    static int host_schur(const SpT &exec_instance,
+                          const real_type_3d_view_type &H,
+                          const real_type_3d_view_type &Z,
+                          const real_type_2d_view_type &er,
+                          const real_type_2d_view_type &ei,
+                          const int_type_2d_view_type &b) {
+      using host_exec_space = Kokkos::DefaultHostExecutionSpace;
+      const int np = H.extent(0);
+
+      /// mirror views are the same views when SpT is a host space
+      const auto H_host = Kokkos::create_mirror_view(Kokkos::HostSpace(), H);
+      const auto Z_host = Kokkos::create_mirror_view(Kokkos::HostSpace(), Z);
+      const auto er_host = Kokkos::create_mirror_view(Kokkos::HostSpace(), er);
+      const auto ei_host = Kokkos::create_mirror_view(Kokkos::HostSpace(), ei);
+      const auto b_host = Kokkos::create_mirror_view(Kokkos::HostSpace(), b);
+
+      Kokkos::deep_copy(exec_instance, H_host, H);
+      Kokkos::deep_copy(exec_instance, Z_host, Z);
+      exec_instance.fence();
+
+      int r_val(0);
+#if defined(TINES_ENABLE_TPL_LAPACKE_ON_HOST)
+      {
+        const int m = H.extent(1);
+        using policy_type = Kokkos::TeamPolicy<host_exec_space>;
+        using scratch_type = ScratchViewType<
+          value_type_1d_view<double, UseThisDevice<host_exec_space>::type>>;
+        const int level = 1,
+                  per_team_scratch = scratch_type::shmem_size(2 * m * m);
+
+        policy_type policy(np, 1);
+        policy.set_scratch_size(level, Kokkos::PerTeam(per_team_scratch));
+        Kokkos::parallel_reduce(
+          policy,
+          [=](const typename policy_type::member_type &member, int &update) {
+            const int p = member.league_rank();
+            scratch_type work(member.team_scratch(level), 2 * m * m);
+
+            double *__restrict__ _H = work.data();
+            double *__restrict__ _Z = work.data() + m * m;
+
+            /// change data column major
+            for (int i = 0; i < m; ++i)
+              for (int j = 0; j < m; ++j) {
+                _H[i + j * m] = H_host(p, i, j);
+                _Z[i + j * m] = Z_host(p, i, j);
+              }
+
+            const int info =
+              Schur_HostTPL(m, _H, 1, m, _Z, 1, m, &er_host(p, 0),
+                            &ei_host(p, 0), &b_host(p, 0), 1);
+            update += (info != 0);
+
+            for (int i = 0; i < m; ++i)
+              for (int j = 0; j < m; ++j) {
+                H_host(p, i, j) = _H[i + j * m];
+                Z_host(p, i, j) = _Z[i + j * m];
+              }
+          },
+          r_val);
+      }
+#else
+      {
+        using policy_type = Kokkos::RangePolicy<host_exec_space>;
+        const auto member = HostSerialTeamMember();
+        Kokkos::parallel_reduce(
+          policy_type(0, np),
+          [=](const int &p, int &update) {
+            const auto _H =
+              Kokkos::subview(H_host, p, Kokkos::ALL(), Kokkos::ALL());
+            const auto _Z =
+              Kokkos::subview(Z_host, p, Kokkos::ALL(), Kokkos::ALL());
+            const auto _er = Kokkos::subview(er_host, p, Kokkos::ALL());
+            const auto _ei = Kokkos::subview(ei_host, p, Kokkos::ALL());
+            const auto _b = Kokkos::subview(b_host, p, Kokkos::ALL());
+            update += (Schur::invoke(member, _H, _Z, _er, _ei, _b) != 0);
+          },
+          r_val);
+      }
+#endif
+      Kokkos::deep_copy(exec_instance, H, H_host);
+      Kokkos::deep_copy(exec_instance, Z, Z_host);
+      Kokkos::deep_copy(exec_instance, er, er_host);
+      Kokkos::deep_copy(exec_instance, ei, ei_host);
+      Kokkos::deep_copy(exec_instance, b, b_host);
+      return r_val;
+    }
+
+    static int invoke(const SpT &exec_instance,
+                      const real_type_3d_view_type &A,
+                      const real_type_2d_view_type &er,
+                      const real_type_2d_view_type &ei,
+                      const real_type_3d_view_type &V,
+                      const real_type_2d_view_type &W,
+                      const bool schur_on_host = false) {
+      const int np = A.extent(0), m = A.extent(1);
+      double *wptr = W.data();
+      int wlen = W.span();
+
+      real_type_3d_view_type Z(wptr, np, m, m);
+      wptr += Z.span();
+      wlen -= Z.span();
+
+      real_type_3d_view_type U(wptr, np, m, m);
+      wptr += U.span();
+      wlen -= U.span();
+
+      real_type_2d_view_type t(wptr, np, m);
+      wptr += t.span();
+      wlen -= t.span();
+
+      real_type_2d_view_type w(wptr, np, m);
+      wptr += w.span();
+      wlen -= w.span();
+
+      real_type_2d_view_type scale(wptr, np, m);
+      wptr += scale.span();
+      wlen -= scale.span();
+
+      /// two integers of ilo and ihi fit in a double per problem
+      int_type_2d_view_type ilohi((int *)wptr, np, 2);
+      wptr += np;
+      wlen -= np;
+      TINES_CHECK_ERROR(wlen < 0, "Error: workspace is too small");
+
+      /// t is not used after the Hessenberg reduction
+      int_type_2d_view_type b((int *)t.data(), np, m);
+
+      /// A := D^{-1} P^T A P D
+      balance(exec_instance, A, scale, ilohi);
+
+      /// A := H, Z := Q
+      HessenbergDevice<SpT>::invoke(exec_instance, A, Z, t, w);
+
+      /// A := T, Z := Q Z
+      const int r_val =
+        schur_on_host ? host_schur(exec_instance, A, Z, er, ei, b)
+                      : SchurDevice<SpT>::invoke(exec_instance, A, Z, er, ei, b);
+
+      /// V = (Q Z) X
+      RightEigenvectorSchurDevice<SpT>::invoke(exec_instance, A, b, U, w);
+
+      const double one(1), zero(0);
+      GemmDevice<Trans::NoTranspose, Trans::NoTranspose, SpT>::invoke(
+        exec_instance, one, Z, U, zero, V);
+
+      /// V := P D V
+      balanceBackTransform(exec_instance, scale, ilohi, b, V, w);
+
+      return r_val;
+    }
+  };
+
 } // namespace Tines
 
 #endif
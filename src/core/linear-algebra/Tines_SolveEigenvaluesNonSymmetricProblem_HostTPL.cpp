@@ -88,4 +88,25 @@ namespace Tines {
 #endif
   }
 
+  int SolveEigenvaluesNonSymmetricProblemWithoutEigenvectors_HostTPL(
+    const int m, double *A, const int as0, const int as1, double *er,
+    double *ei) {
+#if defined(TINES_ENABLE_TPL_LAPACKE_ON_HOST)
+    const int lapack_layouts[2] = {LAPACK_ROW_MAJOR, LAPACK_COL_MAJOR};
+    const auto layout = lapack_layouts[as0 == 1];
+
+    const int lda = (as0 == 1 ? as1 : as0);
+
+    const int r_val =
+      LAPACKE_dgeev(layout, 'N', 'N', m, (double *)A, lda, (double *)er,
+                    (double *)ei, (double *)nullptr, m, /// dummy
+                    (double *)nullptr, m);              /// dummy
+    return r_val;
+#else
+    TINES_CHECK_ERROR(true, "Error: LAPACKE is not enabled");
+
+    return -1;
+#endif
+  }
+
 } // namespace Tines
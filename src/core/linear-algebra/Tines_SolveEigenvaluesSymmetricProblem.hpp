@@ -0,0 +1,147 @@
+/*----------------------------------------------------------------------------------
+Tines - Time Integrator, Newton and Eigen Solver -  version 1.0
+Copyright (2021) NTESS
+https://github.com/sandialabs/Tines
+
+Copyright 2021 National Technology & Engineering Solutions of Sandia, LLC (NTESS). 
+Under the terms of Contract DE-NA0003525 with NTESS, the U.S. Government retains 
+certain rights in this software.
+
+This file is part of Tines. Tines is open-source software: you can redistribute it
+and/or modify it under the terms of BSD 2-Clause License
+(https://opensource.org/licenses/BSD-2-Clause). A copy of the license is also
+provided under the main directory
+Questions? Kyungjoo Kim <kyukim@sandia.gov>, or
+	   Oscar Diaz-Ibarra at <odiazib@sandia.gov>, or
+	   Cosmin Safta at <csafta@sandia.gov>, or
+	   Habib Najm at <hnnajm@sandia.gov>
+
+Sandia National Laboratories, New Mexico, USA
+----------------------------------------------------------------------------------*/
+#ifndef __TINES_SOLVE_EIGENVALUES_SYMMETRIC_PROBLEM_HPP__
+#define __TINES_SOLVE_EIGENVALUES_SYMMETRIC_PROBLEM_HPP__
+
+#include "Tines_Internal.hpp"
+#include "Tines_SolveEigenvaluesSymmetricProblem_Internal.hpp"
+
+namespace Tines {
+
+  int SolveEigenvaluesSymmetricProblem_HostTPL(const int m, double *A,
+                                               const int as0, const int as1,
+                                               double *e, double *V,
+                                               const int vs0, const int vs1);
+
+  int SolveEigenvaluesSymmetricProblemWithoutEigenvectors_HostTPL(
+    const int m, double *A, const int as0, const int as1, double *e);
+
+  ///
+  /// Eigen decomposition of a real symmetric matrix A = V diag(e) V^T; the
+  /// eigenvalues e are sorted in ascending order and V is orthonormal. Only
+  /// the lower triangular part of A is referenced and A is overwritten.
+  ///
+  struct SolveEigenvaluesSymmetricProblem {
+    template <typename AViewType>
+    KOKKOS_INLINE_FUNCTION static int workspace(const AViewType &A,
+                                                int &wlen) {
+      const int m = A.extent(0);
+      wlen = 3 * m;
+      return 0;
+    }
+
+    template <typename MemberType, typename AViewType, typename EViewType,
+              typename VViewType, typename WViewType>
+    KOKKOS_INLINE_FUNCTION static int
+    device_invoke(const MemberType &member, const AViewType &A,
+                  const EViewType &e, const VViewType &V, const WViewType &W) {
+      const int m = A.extent(0), as0 = A.stride(0), as1 = A.stride(1);
+      const int es = e.stride(0);
+      const int vs0 = V.stride(0), vs1 = V.stride(1);
+      const int wlen = W.extent(0);
+      const int r_val = SolveEigenvaluesSymmetricProblemInternal::invoke(
+        member, m, A.data(), as0, as1, e.data(), es, V.data(), vs0, vs1,
+        W.data(), wlen);
+      return r_val;
+    }
+
+    template <typename MemberType, typename AViewType, typename EViewType,
+              typename VViewType, typename WViewType>
+    KOKKOS_INLINE_FUNCTION static int
+    invoke(const MemberType &member, const AViewType &A, const EViewType &e,
+           const VViewType &V, const WViewType &W,
+           const bool use_tpl_if_avail = true) {
+      int r_val(0);
+      static_assert(AViewType::rank == 2, "A is not rank-2 view");
+      static_assert(EViewType::rank == 1, "e is not rank-1 view");
+      static_assert(VViewType::rank == 2, "V is not rank-2 view");
+      static_assert(WViewType::rank == 1, "W is not rank-1 view");
+
+#if defined(TINES_ENABLE_TPL_LAPACKE_ON_HOST) && !defined(__CUDA_ARCH__)
+      if ((std::is_same<Kokkos::Impl::ActiveExecutionMemorySpace,
+                        Kokkos::HostSpace>::value) &&
+          (A.stride(0) == 1 || A.stride(1) == 1) && (e.stride(0) == 1) &&
+          (V.stride(0) == 1 || V.stride(1) == 1) && use_tpl_if_avail) {
+        Kokkos::single(Kokkos::PerTeam(member), [&]() {
+          const int m = A.extent(0), as0 = A.stride(0), as1 = A.stride(1);
+          const int vs0 = V.stride(0), vs1 = V.stride(1);
+          r_val = SolveEigenvaluesSymmetricProblem_HostTPL(
+            m, A.data(), as0, as1, e.data(), V.data(), vs0, vs1);
+        });
+      } else {
+        r_val = device_invoke(member, A, e, V, W);
+      }
+#else
+      r_val = device_invoke(member, A, e, V, W);
+#endif
+      return r_val;
+    }
+
+    ///
+    /// Eigenvalues only; the workspace is the same as above.
+    ///
+    template <typename MemberType, typename AViewType, typename EViewType,
+              typename WViewType>
+    KOKKOS_INLINE_FUNCTION static int
+    device_invoke(const MemberType &member, const AViewType &A,
+                  const EViewType &e, const WViewType &W) {
+      const int m = A.extent(0), as0 = A.stride(0), as1 = A.stride(1);
+      const int es = e.stride(0);
+      const int wlen = W.extent(0);
+      const int r_val = SolveEigenvaluesSymmetricProblemInternal::invoke(
+        member, m, A.data(), as0, as1, e.data(), es, W.data(), wlen);
+      return r_val;
+    }
+
+    template <typename MemberType, typename AViewType, typename EViewType,
+              typename WViewType>
+    KOKKOS_INLINE_FUNCTION static int
+    invoke(const MemberType &member, const AViewType &A, const EViewType &e,
+           const WViewType &W, const bool use_tpl_if_avail = true) {
+      int r_val(0);
+      static_assert(AViewType::rank == 2, "A is not rank-2 view");
+      static_assert(EViewType::rank == 1, "e is not rank-1 view");
+      static_assert(WViewType::rank == 1, "W is not rank-1 view");
+
+#if defined(TINES_ENABLE_TPL_LAPACKE_ON_HOST) && !defined(__CUDA_ARCH__)
+      if ((std::is_same<Kokkos::Impl::ActiveExecutionMemorySpace,
+                        Kokkos::HostSpace>::value) &&
+          (A.stride(0) == 1 || A.stride(1) == 1) && (e.stride(0) == 1) &&
+          use_tpl_if_avail) {
+        Kokkos::single(Kokkos::PerTeam(member), [&]() {
+          const int m = A.extent(0), as0 = A.stride(0), as1 = A.stride(1);
+          r_val = SolveEigenvaluesSymmetricProblemWithoutEigenvectors_HostTPL(
+            m, A.data(), as0, as1, e.data());
+        });
+      } else {
+        r_val = device_invoke(member, A, e, W);
+      }
+#else
+      r_val = device_invoke(member, A, e, W);
+#endif
+      return r_val;
+    }
+  };
+
+} // namespace Tines
+
+#include "Tines_SolveEigenvaluesSymmetricProblem_Device.hpp"
+#endif
@@ -0,0 +1,218 @@
+/*----------------------------------------------------------------------------------
+Tines - Time Integrator, Newton and Eigen Solver -  version 1.0
+Copyright (2021) NTESS
+https://github.com/sandialabs/Tines
+
+Copyright 2021 National Technology & Engineering Solutions of Sandia, LLC (NTESS). 
+Under the terms of Contract DE-NA0003525 with NTESS, the U.S. Government retains 
+certain rights in this software.
+
+This file is part of Tines. Tines is open-source software: you can redistribute it
+and/or modify it under the terms of BSD 2-Clause License
+(https://opensource.org/licenses/BSD-2-Clause). A copy of the license is also
+provided under the main directory
+Questions? Kyungjoo Kim <kyukim@sandia.gov>, or
+	   Oscar Diaz-Ibarra at <odiazib@sandia.gov>, or
+	   Cosmin Safta at <csafta@sandia.gov>, or
+	   Habib Najm at <hnnajm@sandia.gov>
+
+Sandia National Laboratories, New Mexico, USA
+----------------------------------------------------------------------------------*/
+#include "Tines.hpp"
+
+namespace Tines {
+
+#if defined(KOKKOS_ENABLE_SERIAL)
+  int SolveEigenvaluesSymmetricProblemDevice<Kokkos::Serial>::invoke(
+    const Kokkos::Serial &,
+    const value_type_3d_view<double, UseThisDevice<Kokkos::Serial>::type> &A,
+    const value_type_2d_view<double, UseThisDevice<Kokkos::Serial>::type> &e,
+    const value_type_3d_view<double, UseThisDevice<Kokkos::Serial>::type> &V,
+    const value_type_2d_view<double, UseThisDevice<Kokkos::Serial>::type> &w,
+    const bool use_tpl_if_avail) {
+    Kokkos::Profiling::pushRegion(
+      "Tines::SolveEigenvaluesSymmetricProblemSerial");
+    const auto member = Tines::HostSerialTeamMember();
+    const int iend = A.extent(0);
+    int r_val(0);
+    for (int i = 0; i < iend; ++i) {
+      const auto _A = Kokkos::subview(A, i, Kokkos::ALL(), Kokkos::ALL());
+      const auto _e = Kokkos::subview(e, i, Kokkos::ALL());
+      const auto _V = Kokkos::subview(V, i, Kokkos::ALL(), Kokkos::ALL());
+      const auto _w = Kokkos::subview(w, i, Kokkos::ALL());
+
+      r_val += (SolveEigenvaluesSymmetricProblem ::invoke(
+                  member, _A, _e, _V, _w, use_tpl_if_avail) != 0);
+    }
+
+    Kokkos::Profiling::popRegion();
+    return r_val;
+  }
+  int SolveEigenvaluesSymmetricProblemDevice<Kokkos::Serial>::invoke(
+    const Kokkos::Serial &,
+    const value_type_3d_view<double, UseThisDevice<Kokkos::Serial>::type> &A,
+    const value_type_2d_view<double, UseThisDevice<Kokkos::Serial>::type> &e,
+    const value_type_2d_view<double, UseThisDevice<Kokkos::Serial>::type> &w,
+    const bool use_tpl_if_avail) {
+    Kokkos::Profiling::pushRegion(
+      "Tines::SolveEigenvaluesSymmetricProblemEigenvaluesOnlySerial");
+    const auto member = Tines::HostSerialTeamMember();
+    const int iend = A.extent(0);
+    int r_val(0);
+    for (int i = 0; i < iend; ++i) {
+      const auto _A = Kokkos::subview(A, i, Kokkos::ALL(), Kokkos::ALL());
+      const auto _e = Kokkos::subview(e, i, Kokkos::ALL());
+      const auto _w = Kokkos::subview(w, i, Kokkos::ALL());
+
+      r_val += (SolveEigenvaluesSymmetricProblem ::invoke(
+                  member, _A, _e, _w, use_tpl_if_avail) != 0);
+    }
+
+    Kokkos::Profiling::popRegion();
+    return r_val;
+  }
+#endif
+
+#if defined(KOKKOS_ENABLE_OPENMP)
+  int SolveEigenvaluesSymmetricProblemDevice<Kokkos::OpenMP>::invoke(
+    const Kokkos::OpenMP &exec_instance,
+    const value_type_3d_view<double, UseThisDevice<Kokkos::OpenMP>::type> &A,
+    const value_type_2d_view<double, UseThisDevice<Kokkos::OpenMP>::type> &e,
+    const value_type_3d_view<double, UseThisDevice<Kokkos::OpenMP>::type> &V,
+    const value_type_2d_view<double, UseThisDevice<Kokkos::OpenMP>::type> &w,
+    const bool use_tpl_if_avail) {
+    Kokkos::Profiling::pushRegion(
+      "Tines::SolveEigenvaluesSymmetricProblemOpenMP");
+    using policy_type = Kokkos::TeamPolicy<Kokkos::OpenMP>;
+    policy_type policy(exec_instance, A.extent(0), 1);
+    int r_val(0);
+    Kokkos::parallel_reduce(
+      "Tines::SolveEigenvaluesSymmetricProblemOpenMP::parallel_reduce", policy,
+      KOKKOS_LAMBDA(const typename policy_type::member_type &member,
+                    int &update) {
+        const int i = member.league_rank();
+        const auto _A = Kokkos::subview(A, i, Kokkos::ALL(), Kokkos::ALL());
+        const auto _e = Kokkos::subview(e, i, Kokkos::ALL());
+        const auto _V = Kokkos::subview(V, i, Kokkos::ALL(), Kokkos::ALL());
+        const auto _w = Kokkos::subview(w, i, Kokkos::ALL());
+
+        const int r = SolveEigenvaluesSymmetricProblem ::invoke(
+          member, _A, _e, _V, _w, use_tpl_if_avail);
+        Kokkos::single(Kokkos::PerTeam(member), [&]() { update += (r != 0); });
+      },
+      r_val);
+
+    Kokkos::Profiling::popRegion();
+    return r_val;
+  }
+  int SolveEigenvaluesSymmetricProblemDevice<Kokkos::OpenMP>::invoke(
+    const Kokkos::OpenMP &exec_instance,
+    const value_type_3d_view<double, UseThisDevice<Kokkos::OpenMP>::type> &A,
+    const value_type_2d_view<double, UseThisDevice<Kokkos::OpenMP>::type> &e,
+    const value_type_2d_view<double, UseThisDevice<Kokkos::OpenMP>::type> &w,
+    const bool use_tpl_if_avail) {
+    Kokkos::Profiling::pushRegion(
+      "Tines::SolveEigenvaluesSymmetricProblemEigenvaluesOnlyOpenMP");
+    using policy_type = Kokkos::TeamPolicy<Kokkos::OpenMP>;
+    policy_type policy(exec_instance, A.extent(0), 1);
+    int r_val(0);
+    Kokkos::parallel_reduce(
+      "Tines::SolveEigenvaluesSymmetricProblemEigenvaluesOnlyOpenMP::"
+      "parallel_reduce",
+      policy,
+      KOKKOS_LAMBDA(const typename policy_type::member_type &member,
+                    int &update) {
+        const int i = member.league_rank();
+        const auto _A = Kokkos::subview(A, i, Kokkos::ALL(), Kokkos::ALL());
+        const auto _e = Kokkos::subview(e, i, Kokkos::ALL());
+        const auto _w = Kokkos::subview(w, i, Kokkos::ALL());
+
+        const int r = SolveEigenvaluesSymmetricProblem ::invoke(
+          member, _A, _e, _w, use_tpl_if_avail);
+        Kokkos::single(Kokkos::PerTeam(member), [&]() { update += (r != 0); });
+      },
+      r_val);
+
+    Kokkos::Profiling::popRegion();
+    return r_val;
+  }
+#endif
+
+#if defined(KOKKOS_ENABLE_CUDA)
+  int SolveEigenvaluesSymmetricProblemDevice<Kokkos::Cuda>::invoke(
+    const Kokkos::Cuda &exec_instance,
+    const value_type_3d_view<double, UseThisDevice<Kokkos::Cuda>::type> &A,
+    const value_type_2d_view<double, UseThisDevice<Kokkos::Cuda>::type> &e,
+    const value_type_3d_view<double, UseThisDevice<Kokkos::Cuda>::type> &V,
+    const value_type_2d_view<double, UseThisDevice<Kokkos::Cuda>::type> &w,
+    const bool use_tpl_if_avail) {
+    Kokkos::Profiling::pushRegion(
+      "Tines::SolveEigenvaluesSymmetricProblemCuda");
+    const int league_size = A.extent(0);
+    using policy_type = Kokkos::TeamPolicy<Kokkos::Cuda>;
+    int team_size(0), vector_size(0);
+    getBatchedTeamSize(league_size, A.extent(1), team_size, vector_size);
+    const auto policy =
+      team_size > 0
+        ? policy_type(exec_instance, league_size, team_size, vector_size)
+        : policy_type(exec_instance, league_size, Kokkos::AUTO);
+    int r_val(0);
+    Kokkos::parallel_reduce(
+      "Tines::SolveEigenvaluesSymmetricProblemCuda::parallel_reduce", policy,
+      KOKKOS_LAMBDA(const typename policy_type::member_type &member,
+                    int &update) {
+        const int i = member.league_rank();
+        const auto _A = Kokkos::subview(A, i, Kokkos::ALL(), Kokkos::ALL());
+        const auto _e = Kokkos::subview(e, i, Kokkos::ALL());
+        const auto _V = Kokkos::subview(V, i, Kokkos::ALL(), Kokkos::ALL());
+        const auto _w = Kokkos::subview(w, i, Kokkos::ALL());
+
+        const int r = SolveEigenvaluesSymmetricProblem ::invoke(
+          member, _A, _e, _V, _w, use_tpl_if_avail);
+        Kokkos::single(Kokkos::PerTeam(member), [&]() { update += (r != 0); });
+      },
+      r_val);
+
+    Kokkos::Profiling::popRegion();
+    return r_val;
+  }
+  int SolveEigenvaluesSymmetricProblemDevice<Kokkos::Cuda>::invoke(
+    const Kokkos::Cuda &exec_instance,
+    const value_type_3d_view<double, UseThisDevice<Kokkos::Cuda>::type> &A,
+    const value_type_2d_view<double, UseThisDevice<Kokkos::Cuda>::type> &e,
+    const value_type_2d_view<double, UseThisDevice<Kokkos::Cuda>::type> &w,
+    const bool use_tpl_if_avail) {
+    Kokkos::Profiling::pushRegion(
+      "Tines::SolveEigenvaluesSymmetricProblemEigenvaluesOnlyCuda");
+    const int league_size = A.extent(0);
+    using policy_type = Kokkos::TeamPolicy<Kokkos::Cuda>;
+    int team_size(0), vector_size(0);
+    getBatchedTeamSize(league_size, A.extent(1), team_size, vector_size);
+    const auto policy =
+      team_size > 0
+        ? policy_type(exec_instance, league_size, team_size, vector_size)
+        : policy_type(exec_instance, league_size, Kokkos::AUTO);
+    int r_val(0);
+    Kokkos::parallel_reduce(
+      "Tines::SolveEigenvaluesSymmetricProblemEigenvaluesOnlyCuda::"
+      "parallel_reduce",
+      policy,
+      KOKKOS_LAMBDA(const typename policy_type::member_type &member,
+                    int &update) {
+        const int i = member.league_rank();
+        const auto _A = Kokkos::subview(A, i, Kokkos::ALL(), Kokkos::ALL());
+        const auto _e = Kokkos::subview(e, i, Kokkos::ALL());
+        const auto _w = Kokkos::subview(w, i, Kokkos::ALL());
+
+        const int r = SolveEigenvaluesSymmetricProblem ::invoke(
+          member, _A, _e, _w, use_tpl_if_avail);
+        Kokkos::single(Kokkos::PerTeam(member), [&]() { update += (r != 0); });
+      },
+      r_val);
+
+    Kokkos::Profiling::popRegion();
+    return r_val;
+  }
+#endif
+
+} // namespace Tines
@@ -0,0 +1,140 @@
+/*----------------------------------------------------------------------------------
+Tines - Time Integrator, Newton and Eigen Solver -  version 1.0
+Copyright (2021) NTESS
+https://github.com/sandialabs/Tines
+
+Copyright 2021 National Technology & Engineering Solutions of Sandia, LLC (NTESS). 
+Under the terms of Contract DE-NA0003525 with NTESS, the U.S. Government retains 
+certain rights in this software.
+
+This file is part of Tines. Tines is open-source software: you can redistribute it
+and/or modify it under the terms of BSD 2-Clause License
+(https://opensource.org/licenses/BSD-2-Clause). A copy of the license is also
+provided under the main directory
+Questions? Kyungjoo Kim <kyukim@sandia.gov>, or
+	   Oscar Diaz-Ibarra at <odiazib@sandia.gov>, or
+	   Cosmin Safta at <csafta@sandia.gov>, or
+	   Habib Najm at <hnnajm@sandia.gov>
+
+Sandia National Laboratories, New Mexico, USA
+----------------------------------------------------------------------------------*/
+#ifndef __TINES_SOLVE_EIGENVALUES_SYMMETRIC_PROBLEM_DEVICE_HPP__
+#define __TINES_SOLVE_EIGENVALUES_SYMMETRIC_PROBLEM_DEVICE_HPP__
+
+namespace Tines {
+
+  ///
+  /// Batched symmetric eigensolver; A(np,m,m), e(np,m), V(np,m,m) and
+  /// W(np,wlen). The number of problems whose QL iteration does not converge
+  /// is returned.
+  ///
+  template <typename SpT> struct SolveEigenvaluesSymmetricProblemDevice {
+    static int invoke(
+      const SpT &exec_instance,
+      const value_type_3d_view<double, typename UseThisDevice<SpT>::type> &A,
+      const value_type_2d_view<double, typename UseThisDevice<SpT>::type> &e,
+      const value_type_3d_view<double, typename UseThisDevice<SpT>::type> &V,
+      const value_type_2d_view<double, typename UseThisDevice<SpT>::type> &W,
+      const bool use_tpl_if_avail = true) {
+      TINES_CHECK_ERROR(!ValidExecutionSpace<SpT>::value,
+                        "Error: the given execution space is not implemented");
+      return -1;
+    }
+
+    /// eigenvalues only
+    static int invoke(
+      const SpT &exec_instance,
+      const value_type_3d_view<double, typename UseThisDevice<SpT>::type> &A,
+      const value_type_2d_view<double, typename UseThisDevice<SpT>::type> &e,
+      const value_type_2d_view<double, typename UseThisDevice<SpT>::type> &W,
+      const bool use_tpl_if_avail = true) {
+      TINES_CHECK_ERROR(!ValidExecutionSpace<SpT>::value,
+                        "Error: the given execution space is not implemented");
+      return -1;
+    }
+  };
+
+#if defined(KOKKOS_ENABLE_SERIAL)
+  template <> struct SolveEigenvaluesSymmetricProblemDevice<Kokkos::Serial> {
+    static int invoke(
+      const Kokkos::Serial &exec_instance,
+      const value_type_3d_view<double,
+                               typename UseThisDevice<Kokkos::Serial>::type> &A,
+      const value_type_2d_view<double,
+                               typename UseThisDevice<Kokkos::Serial>::type> &e,
+      const value_type_3d_view<double,
+                               typename UseThisDevice<Kokkos::Serial>::type> &V,
+      const value_type_2d_view<double,
+                               typename UseThisDevice<Kokkos::Serial>::type> &W,
+      const bool use_tpl_if_avail = true);
+
+    /// eigenvalues only
+    static int invoke(
+      const Kokkos::Serial &exec_instance,
+      const value_type_3d_view<double,
+                               typename UseThisDevice<Kokkos::Serial>::type> &A,
+      const value_type_2d_view<double,
+                               typename UseThisDevice<Kokkos::Serial>::type> &e,
+      const value_type_2d_view<double,
+                               typename UseThisDevice<Kokkos::Serial>::type> &W,
+      const bool use_tpl_if_avail = true);
+  };
+#endif
+
+#if defined(KOKKOS_ENABLE_OPENMP)
+  template <> struct SolveEigenvaluesSymmetricProblemDevice<Kokkos::OpenMP> {
+    static int invoke(
+      const Kokkos::OpenMP &exec_instance,
+      const value_type_3d_view<double,
+                               typename UseThisDevice<Kokkos::OpenMP>::type> &A,
+      const value_type_2d_view<double,
+                               typename UseThisDevice<Kokkos::OpenMP>::type> &e,
+      const value_type_3d_view<double,
+                               typename UseThisDevice<Kokkos::OpenMP>::type> &V,
+      const value_type_2d_view<double,
+                               typename UseThisDevice<Kokkos::OpenMP>::type> &W,
+      const bool use_tpl_if_avail = true);
+
+    /// eigenvalues only
+    static int invoke(
+      const Kokkos::OpenMP &exec_instance,
+      const value_type_3d_view<double,
+                               typename UseThisDevice<Kokkos::OpenMP>::type> &A,
+      const value_type_2d_view<double,
+                               typename UseThisDevice<Kokkos::OpenMP>::type> &e,
+      const value_type_2d_view<double,
+                               typename UseThisDevice<Kokkos::OpenMP>::type> &W,
+      const bool use_tpl_if_avail = true);
+  };
+#endif
+
+#if defined(KOKKOS_ENABLE_CUDA)
+  template <> struct SolveEigenvaluesSymmetricProblemDevice<Kokkos::Cuda> {
+    static int invoke(
+      const Kokkos::Cuda &exec_instance,
+      const value_type_3d_view<double,
+                               typename UseThisDevice<Kokkos::Cuda>::type> &A,
+      const value_type_2d_view<double,
+                               typename UseThisDevice<Kokkos::Cuda>::type> &e,
+      const value_type_3d_view<double,
+                               typename UseThisDevice<Kokkos::Cuda>::type> &V,
+      const value_type_2d_view<double,
+                               typename UseThisDevice<Kokkos::Cuda>::type> &W,
+      const bool use_tpl_if_avail = true);
+
+    /// eigenvalues only
+    static int invoke(
+      const Kokkos::Cuda &exec_instance,
+      const value_type_3d_view<double,
+                               typename UseThisDevice<Kokkos::Cuda>::type> &A,
+      const value_type_2d_view<double,
+                               typename UseThisDevice<Kokkos::Cuda>::type> &e,
+      const value_type_2d_view<double,
+                               typename UseThisDevice<Kokkos::Cuda>::type> &W,
+      const bool use_tpl_if_avail = true);
+  };
+#endif
+
+} // namespace Tines
+
+#endif
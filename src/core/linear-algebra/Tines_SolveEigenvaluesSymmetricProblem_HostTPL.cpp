@@ -0,0 +1,77 @@
+/*----------------------------------------------------------------------------------
+Tines - Time Integrator, Newton and Eigen Solver -  version 1.0
+Copyright (2021) NTESS
+https://github.com/sandialabs/Tines
+
+Copyright 2021 National Technology & Engineering Solutions of Sandia, LLC (NTESS). 
+Under the terms of Contract DE-NA0003525 with NTESS, the U.S. Government retains 
+certain rights in this software.
+
+This file is part of Tines. Tines is open-source software: you can redistribute it
+and/or modify it under the terms of BSD 2-Clause License
+(https://opensource.org/licenses/BSD-2-Clause). A copy of the license is also
+provided under the main directory
+Questions? Kyungjoo Kim <kyukim@sandia.gov>, or
+	   Oscar Diaz-Ibarra at <odiazib@sandia.gov>, or
+	   Cosmin Safta at <csafta@sandia.gov>, or
+	   Habib Najm at <hnnajm@sandia.gov>
+
+Sandia National Laboratories, New Mexico, USA
+----------------------------------------------------------------------------------*/
+#include "Tines_Interface.hpp"
+#include "Tines_Internal.hpp"
+
+namespace Tines {
+
+  ///
+  /// Eigen decomposition for symmetric matrices
+  /// A = V D V^T where V^T = V^{-1}
+  ///
+
+  int SolveEigenvaluesSymmetricProblem_HostTPL(const int m, double *A,
+                                               const int as0, const int as1,
+                                               double *e, double *V,
+                                               const int vs0, const int vs1) {
+#if defined(TINES_ENABLE_TPL_LAPACKE_ON_HOST)
+    const int lapack_layouts[2] = {LAPACK_ROW_MAJOR, LAPACK_COL_MAJOR};
+    const auto layout = lapack_layouts[as0 == 1];
+
+    const int lda = (as0 == 1 ? as1 : as0);
+
+    /// uplo is given for the column major; the row major lower triangular
+    /// part is the column major upper triangular part
+    const char uplo = (as0 == 1 ? 'L' : 'U');
+    const int r_val = LAPACKE_dsyev(layout, 'V', uplo, m, (double *)A, lda,
+                                    (double *)e);
+
+    /// eigenvectors are overwritten on A
+    for (int i = 0; i < m; ++i)
+      for (int j = 0; j < m; ++j)
+        V[i * vs0 + j * vs1] = A[i * as0 + j * as1];
+    return r_val;
+#else
+    TINES_CHECK_ERROR(true, "Error: LAPACKE is not enabled");
+
+    return -1;
+#endif
+  }
+
+  int SolveEigenvaluesSymmetricProblemWithoutEigenvectors_HostTPL(
+    const int m, double *A, const int as0, const int as1, double *e) {
+#if defined(TINES_ENABLE_TPL_LAPACKE_ON_HOST)
+    const int lapack_layouts[2] = {LAPACK_ROW_MAJOR, LAPACK_COL_MAJOR};
+    const auto layout = lapack_layouts[as0 == 1];
+
+    const int lda = (as0 == 1 ? as1 : as0);
+    const char uplo = (as0 == 1 ? 'L' : 'U');
+    const int r_val = LAPACKE_dsyev(layout, 'N', uplo, m, (double *)A, lda,
+                                    (double *)e);
+    return r_val;
+#else
+    TINES_CHECK_ERROR(true, "Error: LAPACKE is not enabled");
+
+    return -1;
+#endif
+  }
+
+} // namespace Tines
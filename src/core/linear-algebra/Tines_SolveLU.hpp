@@ -0,0 +1,101 @@
+/*----------------------------------------------------------------------------------
+Tines - Time Integrator, Newton and Eigen Solver -  version 1.0
+Copyright (2021) NTESS
+https://github.com/sandialabs/Tines
+
+Copyright 2021 National Technology & Engineering Solutions of Sandia, LLC (NTESS). 
+Under the terms of Contract DE-NA0003525 with NTESS, the U.S. Government retains 
+certain rights in this software.
+
+This file is part of Tines. Tines is open-source software: you can redistribute it
+and/or modify it under the terms of BSD 2-Clause License
+(https://opensource.org/licenses/BSD-2-Clause). A copy of the license is also
+provided under the main directory
+Questions? Kyungjoo Kim <kyukim@sandia.gov>, or
+	   Oscar Diaz-Ibarra at <odiazib@sandia.gov>, or
+	   Cosmin Safta at <csafta@sandia.gov>, or
+	   Habib Najm at <hnnajm@sandia.gov>
+
+Sandia National Laboratories, New Mexico, USA
+----------------------------------------------------------------------------------*/
+#ifndef __TINES_SOLVE_LU_HPP__
+#define __TINES_SOLVE_LU_HPP__
+
+#include "Tines_Internal.hpp"
+#include "Tines_SolveLU_Internal.hpp"
+
+namespace Tines {
+
+  int SolveLU_HostTPL(const int m, const double *A, const int as0,
+                      const int as1, const int *ipiv, double *x, const int xs0,
+                      double *b, const int bs0);
+
+  int SolveLU_HostTPL(const int m, const int nrhs, const double *A,
+                      const int as0, const int as1, const int *ipiv, double *x,
+                      const int xs0, const int xs1, double *b, const int bs0,
+                      const int bs1);
+
+  struct SolveLU {
+    template <typename MemberType, typename AViewType, typename pViewType,
+              typename XViewType, typename BViewType>
+    KOKKOS_INLINE_FUNCTION static int
+    device_invoke(const MemberType &member, const AViewType &A,
+                  const pViewType &p, const XViewType &X, const BViewType &B) {
+      using value_type_a = typename AViewType::non_const_value_type;
+      using value_type_x = typename XViewType::non_const_value_type;
+      using value_type_b = typename BViewType::non_const_value_type;
+      constexpr bool is_value_type_same =
+        (std::is_same<value_type_a, value_type_x>::value &&
+         std::is_same<value_type_a, value_type_b>::value);
+      static_assert(is_value_type_same,
+                    "value_type of A, x and b does not match");
+
+      int r_val(0);
+      if (BViewType::rank == 1) {
+        r_val = SolveLU_Internal::invoke(
+          member, A.extent(0), A.data(), A.stride(0), A.stride(1), p.data(),
+          p.stride(0), X.data(), X.stride(0), B.data(), B.stride(0));
+      } else if (BViewType::rank == 2) {
+        r_val = SolveLU_Internal::invoke(
+          member, A.extent(0), B.extent(1), A.data(), A.stride(0), A.stride(1),
+          p.data(), p.stride(0), X.data(), X.stride(0), X.stride(1), B.data(),
+          B.stride(0), B.stride(1));
+      }
+      return r_val;
+    }
+
+    template <typename MemberType, typename AViewType, typename pViewType,
+              typename XViewType, typename BViewType>
+    KOKKOS_INLINE_FUNCTION static int
+    invoke(const MemberType &member, const AViewType &A, const pViewType &p,
+           const XViewType &X, const BViewType &B) {
+      int r_val(0);
+#if defined(TINES_ENABLE_TPL_CBLAS_ON_HOST) && !defined(__CUDA_ARCH__)
+      if ((std::is_same<Kokkos::Impl::ActiveExecutionMemorySpace,
+                        Kokkos::HostSpace>::value) &&
+          (A.stride(0) == 1 || A.stride(1) == 1) && (p.stride(0) == 1)) {
+        Kokkos::single(Kokkos::PerTeam(member), [&]() {
+          if (BViewType::rank == 1) {
+            r_val = SolveLU_HostTPL(A.extent(0), A.data(), A.stride(0),
+                                    A.stride(1), p.data(), X.data(),
+                                    X.stride(0), B.data(), B.stride(0));
+          } else if (BViewType::rank == 2) {
+            r_val = SolveLU_HostTPL(A.extent(0), B.extent(1), A.data(),
+                                    A.stride(0), A.stride(1), p.data(),
+                                    X.data(), X.stride(0), X.stride(1),
+                                    B.data(), B.stride(0), B.stride(1));
+          }
+        });
+      } else {
+        r_val = device_invoke(member, A, p, X, B);
+      }
+#else
+      r_val = device_invoke(member, A, p, X, B);
+#endif
+      return r_val;
+    }
+  };
+
+} // namespace Tines
+
+#endif
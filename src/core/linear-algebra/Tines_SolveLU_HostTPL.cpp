@@ -0,0 +1,108 @@
+/*----------------------------------------------------------------------------------
+Tines - Time Integrator, Newton and Eigen Solver -  version 1.0
+Copyright (2021) NTESS
+https://github.com/sandialabs/Tines
+
+Copyright 2021 National Technology & Engineering Solutions of Sandia, LLC (NTESS). 
+Under the terms of Contract DE-NA0003525 with NTESS, the U.S. Government retains 
+certain rights in this software.
+
+This file is part of Tines. Tines is open-source software: you can redistribute it
+and/or modify it under the terms of BSD 2-Clause License
+(https://opensource.org/licenses/BSD-2-Clause). A copy of the license is also
+provided under the main directory
+Questions? Kyungjoo Kim <kyukim@sandia.gov>, or
+	   Oscar Diaz-Ibarra at <odiazib@sandia.gov>, or
+	   Cosmin Safta at <csafta@sandia.gov>, or
+	   Habib Najm at <hnnajm@sandia.gov>
+
+Sandia National Laboratories, New Mexico, USA
+----------------------------------------------------------------------------------*/
+#include "Tines_Interface.hpp"
+#include "Tines_Internal.hpp"
+
+namespace Tines {
+
+  ///
+  /// Solve LU
+  /// P A = L U
+  ///
+  /// Input:
+  ///  A[m,m]: L and U factors from LU_HostTPL
+  ///  ipiv[m]: row pivots (relative zero-base index)
+  ///  b[m]: right hand side
+  /// Output:
+  ///  x[m]: solution
+  ///
+  int SolveLU_HostTPL(const int m, const double *A, const int as0,
+                      const int as1, const int *ipiv, double *x, const int xs0,
+                      double *b, const int bs0) {
+#if defined(TINES_ENABLE_TPL_CBLAS_ON_HOST)
+    const auto layout_cblas = as0 == 1 ? CblasColMajor : CblasRowMajor;
+    const int lda = as0 == 1 ? as1 : as0;
+
+    /// x = P b
+    if (x != b)
+      for (int i = 0; i < m; ++i)
+        x[i * xs0] = b[i * bs0];
+    for (int i = 0; i < m; ++i) {
+      const int piv = ipiv[i];
+      if (piv != 0) {
+        const int idx_i = i * xs0, idx_p = (i + piv) * xs0;
+        const double tmp = x[idx_i];
+        x[idx_i] = x[idx_p];
+        x[idx_p] = tmp;
+      }
+    }
+
+    cblas_dtrsv(layout_cblas, CblasLower, CblasNoTrans, CblasUnit, m, A, lda, x,
+                xs0);
+    cblas_dtrsv(layout_cblas, CblasUpper, CblasNoTrans, CblasNonUnit, m, A, lda,
+                x, xs0);
+#else
+    printf("Error: CBLAS is not enabled; use MKL or OpenBLAS\n");
+#endif
+    return 0;
+  }
+
+  int SolveLU_HostTPL(const int m, const int nrhs, const double *A,
+                      const int as0, const int as1, const int *ipiv, double *x,
+                      const int xs0, const int xs1, double *b, const int bs0,
+                      const int bs1) {
+#if defined(TINES_ENABLE_TPL_CBLAS_ON_HOST)
+    const auto layout_cblas = as0 == 1 ? CblasColMajor : CblasRowMajor;
+    const int lda = as0 == 1 ? as1 : as0;
+
+    /// cblas requires the same layout for A and x
+    assert((as0 == 1 && xs0 == 1) || (as1 == 1 && xs1 == 1));
+    const int ldx = xs0 == 1 ? xs1 : xs0;
+
+    /// X = P B
+    if (x != b)
+      for (int i = 0; i < m; ++i)
+        for (int j = 0; j < nrhs; ++j)
+          x[i * xs0 + j * xs1] = b[i * bs0 + j * bs1];
+    for (int i = 0; i < m; ++i) {
+      const int piv = ipiv[i];
+      if (piv != 0) {
+        for (int j = 0; j < nrhs; ++j) {
+          const int idx_i = i * xs0 + j * xs1, idx_p = (i + piv) * xs0 + j * xs1;
+          const double tmp = x[idx_i];
+          x[idx_i] = x[idx_p];
+          x[idx_p] = tmp;
+        }
+      }
+    }
+
+    const double one(1);
+    cblas_dtrsm(layout_cblas, CblasLeft, CblasLower, CblasNoTrans, CblasUnit, m,
+                nrhs, one, A, lda, x, ldx);
+    cblas_dtrsm(layout_cblas, CblasLeft, CblasUpper, CblasNoTrans,
+                CblasNonUnit, m, nrhs, one, A, lda, x, ldx);
+#else
+    printf("Error: CBLAS is not enabled; use MKL or OpenBLAS\n");
+#endif
+    return 0;
+  }
+
+} // namespace Tines
@@ -25,6 +25,11 @@ Sandia National Laboratories, New Mexico, USA
 #include "Tines_SolveUTV_Internal.hpp"
 #include "Tines_UTV_Internal.hpp"
 
+#include "Tines_Copy_Internal.hpp"
+#include "Tines_LU_Internal.hpp"
+#include "Tines_LU_Static_Internal.hpp"
+#include "Tines_SolveLU_Internal.hpp"
+
 namespace Tines {
 
   //#define TINES_ENABLE_SOLVE_LINEAR_SYSTEM_SIMPLE
@@ -53,11 +58,35 @@ namespace Tines {
 #if !defined(__CUDA_ARCH__)
       SolveLinearSystem_WorkSpaceHostTPL(m, n, nrhs, wlen_tpl);
 #endif
-      const int wlen_internal = (wlen_utv + wlen_solve + wlen_misc);
+      /// lu keeps a header, pivots and a copy of A in front of the simple utv
+      /// workspace so that it can fall back to utv
+      int wlen_lu;
+      workspace_lu(m, n, nrhs, wlen_lu);
+
+      const int wlen_utv_total = (wlen_utv + wlen_solve + wlen_misc);
+      const int wlen_internal =
+        wlen_utv_total > wlen_lu ? wlen_utv_total : wlen_lu;
       wlen = wlen_internal > wlen_tpl ? wlen_internal : wlen_tpl;
       return 0;
     }
 
+    KOKKOS_INLINE_FUNCTION
+    static void workspace_simple(const int m, const int n, const int nrhs,
+                                 int &wlen) {
+      const int max_mn = (m > n ? m : n);
+      /// perm, q, U, s, utv, solve
+      wlen = n + m + m * m + n + 4 * max_mn + (m * nrhs + m);
+    }
+
+    KOKKOS_INLINE_FUNCTION
+    static void workspace_lu(const int m, const int n, const int nrhs,
+                             int &wlen) {
+      int wlen_simple;
+      workspace_simple(m, n, nrhs, wlen_simple);
+      /// header, perm, copy of A, fallback
+      wlen = 2 + n + m * n + wlen_simple;
+    }
+
     template <typename MemberType, typename AViewType, typename XViewType,
               typename BViewType, typename WViewType>
     KOKKOS_INLINE_FUNCTION static int
@@ -131,12 +160,59 @@ namespace Tines {
       return r_val;
     }
 
+    template <typename MemberType, typename AViewType, typename WViewType>
+    KOKKOS_INLINE_FUNCTION static int
+    device_factorize_simple(const MemberType &member, const AViewType &A,
+                            const WViewType &W, int &matrix_rank) {
+      using value_type_a = typename AViewType::non_const_value_type;
+      using value_type_w = typename WViewType::non_const_value_type;
+      constexpr bool is_value_type_same =
+        std::is_same<value_type_a, value_type_w>::value;
+      static_assert(is_value_type_same, "value_type of A and w does not match");
+      using value_type = value_type_a;
+
+      const bool is_w_unit_stride = (int(W.stride(0)) == int(1));
+      assert(is_w_unit_stride);
+
+      const int m = A.extent(0), n = A.extent(1), max_mn = (m > n ? m : n);
+      assert(m == n);
+
+      value_type *wptr = W.data();
+      int *perm = (int *)wptr;
+      wptr += n;
+      value_type *qptr = wptr;
+      wptr += m;
+      value_type *Uptr = wptr;
+      wptr += m * m;
+      value_type *sptr = wptr;
+      wptr += n;
+      value_type *work_utv = wptr;
+      wptr += 4 * max_mn;
+
+      assert(int(wptr - W.data()) <= int(W.extent(0)));
+
+      value_type *Aptr = A.data();
+      const int as0 = A.stride(0), as1 = A.stride(1);
+
+      const int ps0 = 1, qs0 = 1, ss0 = 1;
+      const int us0 = m, us1 = 1;
+
+      int r_val(0);
+      r_val = UTV_Internal ::invoke(member, m, n, Aptr, as0, as1, perm, ps0,
+                                    qptr, qs0, Uptr, us0, us1, sptr, ss0,
+                                    work_utv, matrix_rank);
+      member.team_barrier();
+
+      return r_val;
+    }
+
     template <typename MemberType, typename AViewType, typename XViewType,
               typename BViewType, typename WViewType>
     KOKKOS_INLINE_FUNCTION static int
-    device_invoke_simple(const MemberType &member, const AViewType &A,
-                         const XViewType &X, const BViewType &B,
-                         const WViewType &W, int &matrix_rank) {
+    device_solve_factorized_simple(const MemberType &member,
+                                   const int matrix_rank, const AViewType &A,
+                                   const XViewType &X, const BViewType &B,
+                                   const WViewType &W) {
       using value_type_a = typename AViewType::non_const_value_type;
       using value_type_x = typename XViewType::non_const_value_type;
       using value_type_b = typename BViewType::non_const_value_type;
@@ -164,12 +240,12 @@ namespace Tines {
       wptr += m * m;
       value_type *sptr = wptr;
       wptr += n;
-      value_type *work_utv = wptr;
+      /* value_type *work_utv = wptr; */
       wptr += 4 * max_mn;
       value_type *work_solve = wptr;
       wptr += (B.span() + m);
 
-      assert(int(wptr - W.data()) < int(W.extent(0)));
+      assert(int(wptr - W.data()) <= int(W.extent(0)));
 
       value_type *Aptr = A.data();
       const int as0 = A.stride(0), as1 = A.stride(1);
@@ -177,15 +253,10 @@ namespace Tines {
       const int ps0 = 1, qs0 = 1, ss0 = 1;
       const int us0 = m, us1 = 1;
 
-      int r_val(0);
-      r_val = UTV_Internal ::invoke(member, m, n, Aptr, as0, as1, perm, ps0,
-                                    qptr, qs0, Uptr, us0, us1, sptr, ss0,
-                                    work_utv, matrix_rank);
-      member.team_barrier();
-
       value_type *Xptr = X.data();
       value_type *Bptr = B.data();
 
+      int r_val(0);
       if (BViewType::rank == 1) {
         const int xs0 = X.stride(0);
         const int bs0 = B.stride(0);
@@ -206,6 +277,184 @@ namespace Tines {
       return r_val;
     }
 
+    template <typename MemberType, typename AViewType, typename XViewType,
+              typename BViewType, typename WViewType>
+    KOKKOS_INLINE_FUNCTION static int
+    device_invoke_simple(const MemberType &member, const AViewType &A,
+                         const XViewType &X, const BViewType &B,
+                         const WViewType &W, int &matrix_rank) {
+      int r_val(0);
+      r_val = device_factorize_simple(member, A, W, matrix_rank);
+      r_val = device_solve_factorized_simple(member, matrix_rank, A, X, B, W);
+      return r_val;
+    }
+
+    ///
+    /// Factorize A and keep the factors in A and W so that they can be
+    /// reused for multiple solves (e.g., modified Newton); W starts with a
+    /// small header recording which factorization is stored.
+    ///  - use_lu = true: LU with partial pivoting; when the LU factorization
+    ///    detects a (numerically) rank deficient matrix or a large pivot
+    ///    growth, A is restored and factorized with the simple UTV version
+    ///  - use_lu = false: the simple UTV version
+    ///
+    template <typename MemberType, typename AViewType, typename WViewType>
+    KOKKOS_INLINE_FUNCTION static int
+    device_factorize(const MemberType &member, const bool use_lu,
+                     const AViewType &A, const WViewType &W,
+                     int &matrix_rank) {
+      using value_type_a = typename AViewType::non_const_value_type;
+      using value_type_w = typename WViewType::non_const_value_type;
+      constexpr bool is_value_type_same =
+        std::is_same<value_type_a, value_type_w>::value;
+      static_assert(is_value_type_same, "value_type of A and w does not match");
+      using value_type = value_type_a;
+      using magnitude_type = typename ats<value_type>::magnitude_type;
+
+      const bool is_w_unit_stride = (int(W.stride(0)) == int(1));
+      assert(is_w_unit_stride);
+
+      const int m = A.extent(0), n = A.extent(1);
+      assert(m == n);
+
+      value_type *wptr = W.data();
+      int *header = (int *)wptr;
+      wptr += 2;
+      int *perm = (int *)wptr;
+      wptr += n;
+      value_type *Cptr = wptr;
+      wptr += m * n;
+
+      const int wlen_lu = wptr - W.data();
+      assert(wlen_lu <= int(W.extent(0)));
+
+      value_type *Aptr = A.data();
+      const int as0 = A.stride(0), as1 = A.stride(1);
+
+      const int ps0 = 1;
+      const int cs0 = n, cs1 = 1;
+
+      int r_val(0);
+      bool use_utv(true);
+      if (use_lu) {
+        /// keep A for fallback
+        CopyInternal::invoke(member, Trans::NoTranspose(), m, n, Aptr, as0,
+                             as1, Cptr, cs0, cs1);
+        member.team_barrier();
+
+        magnitude_type pivot_growth(0);
+        r_val = LU_Internal::invoke(member, m, n, Aptr, as0, as1, perm, ps0,
+                                    matrix_rank, pivot_growth);
+        member.team_barrier();
+
+        /// partial pivoting bounds |L| by one; growth of U beyond 1/sqrt(eps)
+        /// means that the backward error is no longer controlled
+        const magnitude_type pivot_growth_limit =
+          magnitude_type(1) /
+          ats<magnitude_type>::sqrt(ats<magnitude_type>::epsilon());
+        use_utv = (matrix_rank < m || !(pivot_growth < pivot_growth_limit));
+        if (use_utv) {
+          CopyInternal::invoke(member, Trans::NoTranspose(), m, n, Cptr, cs0,
+                               cs1, Aptr, as0, as1);
+          member.team_barrier();
+        }
+      }
+
+      if (use_utv) {
+        const auto W_utv = Kokkos::subview(
+          W, Kokkos::pair<int, int>(wlen_lu, int(W.extent(0))));
+        r_val = device_factorize_simple(member, A, W_utv, matrix_rank);
+      }
+
+      Kokkos::single(Kokkos::PerTeam(member), [&]() {
+        header[0] = matrix_rank;
+        header[1] = use_utv;
+      });
+      member.team_barrier();
+
+      return r_val;
+    }
+
+    template <typename MemberType, typename AViewType, typename XViewType,
+              typename BViewType, typename WViewType>
+    KOKKOS_INLINE_FUNCTION static int
+    device_solve_factorized(const MemberType &member, const AViewType &A,
+                            const XViewType &X, const BViewType &B,
+                            const WViewType &W) {
+      using value_type_a = typename AViewType::non_const_value_type;
+      using value_type_x = typename XViewType::non_const_value_type;
+      using value_type_b = typename BViewType::non_const_value_type;
+      using value_type_w = typename WViewType::non_const_value_type;
+      constexpr bool is_value_type_same =
+        (std::is_same<value_type_a, value_type_x>::value &&
+         std::is_same<value_type_a, value_type_b>::value &&
+         std::is_same<value_type_a, value_type_w>::value);
+      static_assert(is_value_type_same,
+                    "value_type of A, x, b and w does not match");
+      using value_type = value_type_a;
+
+      const int m = A.extent(0), n = A.extent(1);
+
+      value_type *wptr = W.data();
+      const int *header = (const int *)wptr;
+      wptr += 2;
+      const int *perm = (const int *)wptr;
+      wptr += n;
+      /* value_type *Cptr = wptr; */
+      wptr += m * n;
+
+      const int wlen_lu = wptr - W.data();
+      const int matrix_rank = header[0];
+      const bool use_utv = header[1];
+
+      int r_val(0);
+      if (use_utv) {
+        const auto W_utv = Kokkos::subview(
+          W, Kokkos::pair<int, int>(wlen_lu, int(W.extent(0))));
+        r_val =
+          device_solve_factorized_simple(member, matrix_rank, A, X, B, W_utv);
+      } else {
+        const value_type *Aptr = A.data();
+        const int as0 = A.stride(0), as1 = A.stride(1);
+        const int ps0 = 1;
+
+        value_type *Xptr = X.data();
+        value_type *Bptr = B.data();
+
+        if (BViewType::rank == 1) {
+          const int xs0 = X.stride(0);
+          const int bs0 = B.stride(0);
+          r_val = SolveLU_Internal::invoke(member, m, Aptr, as0, as1, perm, ps0,
+                                           Xptr, xs0, Bptr, bs0);
+        } else if (BViewType::rank == 2) {
+          const int nrhs = B.extent(1);
+          const int xs0 = X.stride(0), xs1 = X.stride(1);
+          const int bs0 = B.stride(0), bs1 = B.stride(1);
+          r_val = SolveLU_Internal::invoke(member, m, nrhs, Aptr, as0, as1,
+                                           perm, ps0, Xptr, xs0, xs1, Bptr, bs0,
+                                           bs1);
+        } else {
+          assert(false);
+        }
+      }
+      return r_val;
+    }
+
+    ///
+    /// LU with partial pivoting and UTV fallback
+    ///
+    template <typename MemberType, typename AViewType, typename XViewType,
+              typename BViewType, typename WViewType>
+    KOKKOS_INLINE_FUNCTION static int
+    device_invoke_lu(const MemberType &member, const AViewType &A,
+                     const XViewType &X, const BViewType &B,
+                     const WViewType &W, int &matrix_rank) {
+      int r_val(0);
+      r_val = device_factorize(member, true, A, W, matrix_rank);
+      r_val = device_solve_factorized(member, A, X, B, W);
+      return r_val;
+    }
+
     template <typename MemberType, typename AViewType, typename XViewType,
               typename BViewType, typename WViewType>
     KOKKOS_INLINE_FUNCTION static int
@@ -279,6 +528,154 @@ namespace Tines {
     }
   };
 
+  ///
+  /// LU with partial pivoting for a compile-time size M; the factorization
+  /// is done by a single thread on a stack array and it is stored in A and W
+  /// in the same format as SolveLinearSystem::device_factorize so that
+  /// the UTV fallback and the workspace requirement are unchanged
+  ///
+  template <int M> struct SolveLinearSystemStatic {
+    static_assert(M > 0 && M <= TINES_STATIC_SIZE_MAX,
+                  "M is out of range of the static size kernels");
+
+    template <typename MemberType, typename AViewType, typename WViewType>
+    KOKKOS_INLINE_FUNCTION static int
+    device_factorize(const MemberType &member, const AViewType &A,
+                     const WViewType &W, int &matrix_rank) {
+      using value_type_a = typename AViewType::non_const_value_type;
+      using value_type_w = typename WViewType::non_const_value_type;
+      constexpr bool is_value_type_same =
+        std::is_same<value_type_a, value_type_w>::value;
+      static_assert(is_value_type_same, "value_type of A and w does not match");
+      using value_type = value_type_a;
+      using magnitude_type = typename ats<value_type>::magnitude_type;
+
+      const bool is_w_unit_stride = (int(W.stride(0)) == int(1));
+      assert(is_w_unit_stride);
+      assert(int(A.extent(0)) == M && int(A.extent(1)) == M);
+
+      value_type *wptr = W.data();
+      int *header = (int *)wptr;
+      wptr += 2;
+      int *perm = (int *)wptr;
+
+      value_type *Aptr = A.data();
+      const int as0 = A.stride(0), as1 = A.stride(1);
+
+      Kokkos::single(Kokkos::PerTeam(member), [&]() {
+        value_type a[M][M];
+        int p[M];
+        for (int i = 0; i < M; ++i)
+          for (int j = 0; j < M; ++j)
+            a[i][j] = Aptr[i * as0 + j * as1];
+
+        int rank(0);
+        magnitude_type pivot_growth(0);
+        LU_StaticInternal<M>::invoke(a, p, rank, pivot_growth);
+
+        const magnitude_type pivot_growth_limit =
+          magnitude_type(1) /
+          ats<magnitude_type>::sqrt(ats<magnitude_type>::epsilon());
+        const bool use_utv = (rank < M || !(pivot_growth < pivot_growth_limit));
+
+        /// A is not touched when it falls back to utv
+        if (!use_utv) {
+          for (int i = 0; i < M; ++i) {
+            perm[i] = p[i];
+            for (int j = 0; j < M; ++j)
+              Aptr[i * as0 + j * as1] = a[i][j];
+          }
+        }
+        header[0] = rank;
+        header[1] = use_utv;
+      });
+      member.team_barrier();
+
+      int r_val(0);
+      matrix_rank = header[0];
+      if (header[1])
+        r_val = SolveLinearSystem::device_factorize(member, false, A, W,
+                                                    matrix_rank);
+      return r_val;
+    }
+
+    template <typename MemberType, typename AViewType, typename XViewType,
+              typename BViewType, typename WViewType>
+    KOKKOS_INLINE_FUNCTION static int
+    device_solve_factorized(const MemberType &member, const AViewType &A,
+                            const XViewType &X, const BViewType &B,
+                            const WViewType &W) {
+      using value_type_a = typename AViewType::non_const_value_type;
+      using value_type_x = typename XViewType::non_const_value_type;
+      using value_type_b = typename BViewType::non_const_value_type;
+      using value_type_w = typename WViewType::non_const_value_type;
+      constexpr bool is_value_type_same =
+        (std::is_same<value_type_a, value_type_x>::value &&
+         std::is_same<value_type_a, value_type_b>::value &&
+         std::is_same<value_type_a, value_type_w>::value);
+      static_assert(is_value_type_same,
+                    "value_type of A, x, b and w does not match");
+      using value_type = value_type_a;
+
+      const value_type *wptr = W.data();
+      const int *header = (const int *)wptr;
+      wptr += 2;
+      const int *perm = (const int *)wptr;
+
+      const bool use_utv = header[1];
+
+      int r_val(0);
+      if (use_utv) {
+        r_val = SolveLinearSystem::device_solve_factorized(member, A, X, B, W);
+      } else {
+        const value_type *Aptr = A.data();
+        const int as0 = A.stride(0), as1 = A.stride(1);
+
+        value_type *Xptr = X.data();
+        value_type *Bptr = B.data();
+
+        int nrhs(1), xs0(X.stride(0)), xs1(0), bs0(B.stride(0)), bs1(0);
+        if (BViewType::rank == 2) {
+          nrhs = B.extent(1);
+          xs1 = X.stride(1);
+          bs1 = B.stride(1);
+        }
+
+        Kokkos::single(Kokkos::PerTeam(member), [&]() {
+          value_type lu[M][M];
+          int p[M];
+          for (int i = 0; i < M; ++i) {
+            p[i] = perm[i];
+            for (int j = 0; j < M; ++j)
+              lu[i][j] = Aptr[i * as0 + j * as1];
+          }
+          for (int k = 0; k < nrhs; ++k) {
+            value_type x[M];
+            for (int i = 0; i < M; ++i)
+              x[i] = Bptr[i * bs0 + k * bs1];
+            SolveLU_StaticInternal<M>::invoke(lu, p, x);
+            for (int i = 0; i < M; ++i)
+              Xptr[i * xs0 + k * xs1] = x[i];
+          }
+        });
+        member.team_barrier();
+      }
+      return r_val;
+    }
+
+    template <typename MemberType, typename AViewType, typename XViewType,
+              typename BViewType, typename WViewType>
+    KOKKOS_INLINE_FUNCTION static int
+    device_invoke_lu(const MemberType &member, const AViewType &A,
+                     const XViewType &X, const BViewType &B,
+                     const WViewType &W, int &matrix_rank) {
+      int r_val(0);
+      r_val = device_factorize(member, A, W, matrix_rank);
+      r_val = device_solve_factorized(member, A, X, B, W);
+      return r_val;
+    }
+  };
+
 } // namespace Tines
 
 #endif
@@ -0,0 +1,298 @@
+/*----------------------------------------------------------------------------------
+Tines - Time Integrator, Newton and Eigen Solver -  version 1.0
+Copyright (2021) NTESS
+https://github.com/sandialabs/Tines
+
+Copyright 2021 National Technology & Engineering Solutions of Sandia, LLC (NTESS). 
+Under the terms of Contract DE-NA0003525 with NTESS, the U.S. Government retains 
+certain rights in this software.
+
+This file is part of Tines. Tines is open-source software: you can redistribute it
+and/or modify it under the terms of BSD 2-Clause License
+(https://opensource.org/licenses/BSD-2-Clause). A copy of the license is also
+provided under the main directory
+Questions? Kyungjoo Kim <kyukim@sandia.gov>, or
+	   Oscar Diaz-Ibarra at <odiazib@sandia.gov>, or
+	   Cosmin Safta at <csafta@sandia.gov>, or
+	   Habib Najm at <hnnajm@sandia.gov>
+
+Sandia National Laboratories, New Mexico, USA
+----------------------------------------------------------------------------------*/
+#ifndef __TINES_BALANCE_INTERNAL_HPP__
+#define __TINES_BALANCE_INTERNAL_HPP__
+
+#include "Tines_Internal.hpp"
+
+namespace Tines {
+
+  ///
+  /// Balance a general matrix (LAPACK dgebal with job = 'B')
+  ///   A := D^{-1} P^T A P D
+  /// The permutation P isolates eigenvalues into the leading (0:ilo-1) and
+  /// trailing (ihi+1:m-1) upper triangular parts; the diagonal scaling D of
+  /// powers of two equilibrates row and column norms of A(ilo:ihi,ilo:ihi).
+  /// Parameters:
+  ///   [in]m
+  ///     A dimension of the square matrix A.
+  ///   [in/out]A, [in]as0, [in]as1
+  ///     Real matrix A(m x m) with strides as0 and as1; on exit, A is
+  ///     overwritten by the balanced matrix.
+  ///   [out]scale, [in]ss
+  ///     For j < ilo or j > ihi, scale(j) is the index of the row and column
+  ///     interchanged with j; for ilo <= j <= ihi, scale(j) is the scaling
+  ///     factor applied to the row and column j.
+  ///   [out]ilo, [out]ihi
+  ///     A(i,j) = 0 if i > j and j = 0:ilo-1 or i = ihi+1:m-1.
+  ///
+  struct BalanceInternal {
+    template <typename MemberType, typename RealType>
+    KOKKOS_INLINE_FUNCTION static int
+    invoke(const MemberType &member, const int m,
+           /* */ RealType *__restrict__ A, const int as0, const int as1,
+           /* */ RealType *__restrict__ scale, const int ss,
+           /* */ int &ilo, int &ihi) {
+      using real_type = RealType;
+      using ats = ArithTraits<real_type>;
+
+      const real_type zero(0), one(1), sclfac(2), factor(0.95);
+
+      /// step 1: permutation to isolate eigenvalues
+      Kokkos::pair<int, int> lohi(0, m - 1);
+      Kokkos::single(
+        Kokkos::PerTeam(member),
+        [=](Kokkos::pair<int, int> &val) {
+          auto a = [A, as0, as1](const int i, const int j) -> real_type & {
+            return A[i * as0 + j * as1];
+          };
+          auto swap = [&a, m](const int i, const int j, const int k,
+                              const int l) {
+            /// swap columns i and j in rows 0:l and rows i and j in
+            /// columns k:m-1
+            for (int r = 0; r <= l; ++r) {
+              const real_type tmp = a(r, i);
+              a(r, i) = a(r, j);
+              a(r, j) = tmp;
+            }
+            for (int c = k; c < m; ++c) {
+              const real_type tmp = a(i, c);
+              a(i, c) = a(j, c);
+              a(j, c) = tmp;
+            }
+          };
+
+          int k = 0, l = m - 1;
+
+          /// rows isolating an eigenvalue are moved to the bottom
+          for (bool found = true; found && l > 0;) {
+            found = false;
+            for (int i = l; i >= 0; --i) {
+              bool can_swap = true;
+              for (int j = 0; j <= l && can_swap; ++j)
+                can_swap = (i == j || a(i, j) == zero);
+              if (can_swap) {
+                scale[l * ss] = real_type(i);
+                if (i != l)
+                  swap(i, l, k, l);
+                --l;
+                found = true;
+                break;
+              }
+            }
+          }
+
+          /// columns isolating an eigenvalue are moved to the left
+          for (bool found = l > 0; found;) {
+            found = false;
+            for (int j = k; j <= l; ++j) {
+              bool can_swap = true;
+              for (int i = k; i <= l && can_swap; ++i)
+                can_swap = (i == j || a(i, j) == zero);
+              if (can_swap) {
+                scale[k * ss] = real_type(j);
+                if (j != k)
+                  swap(j, k, k, l);
+                ++k;
+                found = true;
+                break;
+              }
+            }
+          }
+
+          for (int i = k; i <= l; ++i)
+            scale[i * ss] = one;
+
+          val.first = k;
+          val.second = l;
+        },
+        lohi);
+      member.team_barrier();
+
+      ilo = lohi.first;
+      ihi = lohi.second;
+      if (ilo == ihi)
+        return 0;
+
+      /// step 2: scaling of A(ilo:ihi,ilo:ihi) with powers of two
+      const real_type sfmin1 = ats::sfmin() / ats::prec(),
+                      sfmax1 = one / sfmin1, sfmin2 = sfmin1 * sclfac,
+                      sfmax2 = one / sfmin2;
+      const int n = ihi - ilo + 1;
+      auto max = [](const real_type a, const real_type b) {
+        return a > b ? a : b;
+      };
+      auto min = [](const real_type a, const real_type b) {
+        return a < b ? a : b;
+      };
+      for (bool noconv = true; noconv;) {
+        noconv = false;
+        for (int i = ilo; i <= ihi; ++i) {
+          real_type *a_col = A + i * as1, *a_row = A + i * as0;
+          real_type c(0), r(0), ca(0), ra(0);
+          Kokkos::parallel_reduce(
+            Kokkos::TeamVectorRange(member, n),
+            [&](const int &k, real_type &update) {
+              const real_type val = a_col[(ilo + k) * as0];
+              update += val * val;
+            },
+            c);
+          Kokkos::parallel_reduce(
+            Kokkos::TeamVectorRange(member, n),
+            [&](const int &k, real_type &update) {
+              const real_type val = a_row[(ilo + k) * as1];
+              update += val * val;
+            },
+            r);
+          Kokkos::parallel_reduce(
+            Kokkos::TeamVectorRange(member, ihi + 1),
+            [&](const int &k, real_type &update) {
+              const real_type val = ats::abs(a_col[k * as0]);
+              update = update > val ? update : val;
+            },
+            Kokkos::Max<real_type>(ca));
+          Kokkos::parallel_reduce(
+            Kokkos::TeamVectorRange(member, m - ilo),
+            [&](const int &k, real_type &update) {
+              const real_type val = ats::abs(a_row[(ilo + k) * as1]);
+              update = update > val ? update : val;
+            },
+            Kokkos::Max<real_type>(ra));
+          c = ats::sqrt(c);
+          r = ats::sqrt(r);
+
+          /// guard against zero c or r due to underflow
+          if (c == zero || r == zero)
+            continue;
+
+          real_type g = r / sclfac, f = one;
+          const real_type s = c + r;
+          while (c < g && max(f, max(c, ca)) < sfmax2 &&
+                 min(r, min(g, ra)) > sfmin2) {
+            f *= sclfac;
+            c *= sclfac;
+            ca *= sclfac;
+            r /= sclfac;
+            g /= sclfac;
+            ra /= sclfac;
+          }
+          g = c / sclfac;
+          while (g >= r && max(r, ra) < sfmax2 &&
+                 min(min(f, c), min(g, ca)) > sfmin2) {
+            f /= sclfac;
+            c /= sclfac;
+            g /= sclfac;
+            ca /= sclfac;
+            r *= sclfac;
+            ra *= sclfac;
+          }
+
+          /// now balance
+          const real_type scale_i = scale[i * ss];
+          if ((c + r) >= factor * s)
+            continue;
+          if (f < one && scale_i < one && f * scale_i <= sfmin1)
+            continue;
+          if (f > one && scale_i > one && scale_i >= sfmax1 / f)
+            continue;
+
+          g = one / f;
+          noconv = true;
+          Kokkos::parallel_for(Kokkos::TeamVectorRange(member, m - ilo),
+                               [&](const int &k) {
+                                 a_row[(ilo + k) * as1] *= g;
+                               });
+          member.team_barrier();
+          Kokkos::parallel_for(Kokkos::TeamVectorRange(member, ihi + 1),
+                               [&](const int &k) { a_col[k * as0] *= f; });
+          Kokkos::single(Kokkos::PerTeam(member),
+                         [&]() { scale[i * ss] = scale_i * f; });
+          member.team_barrier();
+        }
+      }
+      return 0;
+    }
+  };
+
+  ///
+  /// Back transformation of eigenvectors of a balanced matrix (LAPACK dgebak
+  /// with job = 'B'); right eigenvectors V := P D V and left eigenvectors
+  /// V := P D^{-1} V.
+  ///
+  struct BalanceBackTransformInternal {
+    template <typename MemberType, typename RealType>
+    KOKKOS_INLINE_FUNCTION static int
+    invoke(const MemberType &member, const int m, const int ilo, const int ihi,
+           const RealType *__restrict__ scale, const int ss, const int n,
+           /* */ RealType *__restrict__ V, const int vs0, const int vs1) {
+      return invoke(member, Side::Right(), m, ilo, ihi, scale, ss, n, V, vs0,
+                    vs1);
+    }
+
+    template <typename MemberType, typename SideType, typename RealType>
+    KOKKOS_INLINE_FUNCTION static int
+    invoke(const MemberType &member, const SideType &side, const int m,
+           const int ilo, const int ihi, const RealType *__restrict__ scale,
+           const int ss, const int n,
+           /* */ RealType *__restrict__ V, const int vs0, const int vs1) {
+      using real_type = RealType;
+      const bool is_left = SideType::tag == Side::Left::tag;
+
+      /// scaling
+      if (ilo != ihi) {
+        Kokkos::parallel_for(
+          Kokkos::TeamThreadRange(member, ihi - ilo + 1), [&](const int &ii) {
+            const int i = ilo + ii;
+            const real_type s =
+              is_left ? real_type(1) / scale[i * ss] : scale[i * ss];
+            Kokkos::parallel_for(
+              Kokkos::ThreadVectorRange(member, n),
+              [&](const int &j) { V[i * vs0 + j * vs1] *= s; });
+          });
+        member.team_barrier();
+      }
+
+      /// permutation in the reverse order of interchanges
+      auto swap_rows = [&](const int i) {
+        const int k = int(scale[i * ss]);
+        if (k != i) {
+          Kokkos::parallel_for(Kokkos::TeamVectorRange(member, n),
+                               [&](const int &j) {
+                                 real_type *vi = V + i * vs0 + j * vs1,
+                                           *vk = V + k * vs0 + j * vs1;
+                                 const real_type tmp = *vi;
+                                 *vi = *vk;
+                                 *vk = tmp;
+                               });
+          member.team_barrier();
+        }
+      };
+      for (int i = ilo - 1; i >= 0; --i)
+        swap_rows(i);
+      for (int i = ihi + 1; i < m; ++i)
+        swap_rows(i);
+      return 0;
+    }
+  };
+
+} // namespace Tines
+
+#endif
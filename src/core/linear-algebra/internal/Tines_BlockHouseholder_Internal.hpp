@@ -0,0 +1,155 @@
+/*----------------------------------------------------------------------------------
+Tines - Time Integrator, Newton and Eigen Solver -  version 1.0
+Copyright (2021) NTESS
+https://github.com/sandialabs/Tines
+
+Copyright 2021 National Technology & Engineering Solutions of Sandia, LLC (NTESS). 
+Under the terms of Contract DE-NA0003525 with NTESS, the U.S. Government retains 
+certain rights in this software.
+
+This file is part of Tines. Tines is open-source software: you can redistribute it
+and/or modify it under the terms of BSD 2-Clause License
+(https://opensource.org/licenses/BSD-2-Clause). A copy of the license is also
+provided under the main directory
+Questions? Kyungjoo Kim <kyukim@sandia.gov>, or
+	   Oscar Diaz-Ibarra at <odiazib@sandia.gov>, or
+	   Cosmin Safta at <csafta@sandia.gov>, or
+	   Habib Najm at <hnnajm@sandia.gov>
+
+Sandia National Laboratories, New Mexico, USA
+----------------------------------------------------------------------------------*/
+#ifndef __TINES_BLOCK_HOUSEHOLDER_INTERNAL_HPP__
+#define __TINES_BLOCK_HOUSEHOLDER_INTERNAL_HPP__
+
+#include "Tines_Gemm_Internal.hpp"
+#include "Tines_Internal.hpp"
+
+/// matrices larger than this use the blocked (compact WY) householder
+/// factorizations; smaller ones stay on the level-2 path
+#if !defined(TINES_BLOCKED_HOUSEHOLDER_MIN_SIZE)
+#define TINES_BLOCKED_HOUSEHOLDER_MIN_SIZE 64
+#endif
+
+/// number of householder vectors accumulated in a panel
+#if !defined(TINES_BLOCKED_HOUSEHOLDER_BLOCK_SIZE)
+#define TINES_BLOCKED_HOUSEHOLDER_BLOCK_SIZE 16
+#endif
+
+namespace Tines {
+
+  struct FormBlockHouseholderInternal {
+    template <typename MemberType, typename ValueType>
+    KOKKOS_INLINE_FUNCTION static int
+    invoke(const MemberType &member, const int m, const int j,
+           const ValueType *__restrict__ V, const int vs0, const int vs1,
+           const ValueType *__restrict__ tau,
+           /* */ ValueType *__restrict__ T, const int ts0, const int ts1,
+           /* */ ValueType *__restrict__ w) {
+      using value_type = ValueType;
+
+      /// Given householder vectors V = [V0 v] (m x (j+1)) and the upper
+      /// triangular T0 (j x j) of the block reflector H0 = I - V0 T0 V0^H,
+      /// it appends the j-th column to T such that
+      ///   H0 (I - v v^H / tau) = I - V T V^H
+      /// where
+      ///   T(0:j,j) = -T0 V0^H v / tau
+      ///   T(j,j)   = 1/tau
+      /// the strictly lower part of T is assumed to be zero
+      ///  - w (j x 1) is workspace
+      const value_type one(1), zero(0), inv_tau = one / (*tau);
+
+      /// w = V0^H v
+      const value_type *__restrict__ v = V + j * vs1;
+      GemmInternal::invoke(member, j, 1, m, one, V, vs1, vs0, v, vs0, vs0,
+                           zero, w, 1, 1);
+      member.team_barrier();
+
+      /// T(0:j,j) = -T0 w / tau
+      GemmInternal::invoke(member, j, 1, j, -inv_tau, T, ts0, ts1, w, 1, 1,
+                           zero, T + j * ts1, ts0, ts1);
+      Kokkos::single(Kokkos::PerTeam(member),
+                     [&]() { T[j * ts0 + j * ts1] = inv_tau; });
+      member.team_barrier();
+
+      return 0;
+    }
+  };
+
+  struct ApplyLeftBlockHouseholderInternal {
+    template <typename MemberType, typename ValueType>
+    KOKKOS_INLINE_FUNCTION static int
+    invoke(const MemberType &member, const int m, const int n, const int k,
+           const ValueType *__restrict__ V, const int vs0, const int vs1,
+           const ValueType *__restrict__ T, const int ts0, const int ts1,
+           /* */ ValueType *__restrict__ A, const int as0, const int as1,
+           /* */ ValueType *__restrict__ W) {
+      using value_type = ValueType;
+
+      /// Given a block reflector H = I - V T V^H, it applies H^H to A from
+      /// left with level 3 operations
+      ///   A = (I - V T^H V^H) A
+      /// where
+      ///   V is m x k (explicit unit lower trapezoidal)
+      ///   T is k x k upper triangular
+      ///   A is m x n
+      ///  - W (k x n) is workspace
+      const value_type one(1), minus_one(-1), zero(0);
+
+      if (m <= 0 || n <= 0 || k <= 0)
+        return 0;
+
+      /// W = V^H A
+      GemmInternal::invoke(member, k, n, m, one, V, vs1, vs0, A, as0, as1,
+                           zero, W, n, 1);
+      member.team_barrier();
+
+      /// W = T^H W; in-place triangular multiplication column by column
+      Kokkos::parallel_for(Kokkos::TeamVectorRange(member, n),
+                           [&](const int &j) {
+                             for (int p = (k - 1); p >= 0; --p) {
+                               value_type tmp(0);
+                               for (int q = 0; q <= p; ++q)
+                                 tmp += ats<value_type>::conj(
+                                          T[q * ts0 + p * ts1]) *
+                                        W[q * n + j];
+                               W[p * n + j] = tmp;
+                             }
+                           });
+      member.team_barrier();
+
+      /// A = A - V W
+      GemmInternal::invoke(member, m, n, k, minus_one, V, vs0, vs1, W, n, 1,
+                           one, A, as0, as1);
+      member.team_barrier();
+
+      return 0;
+    }
+  };
+
+  struct SetBlockHouseholderVectorInternal {
+    template <typename MemberType, typename ValueType>
+    KOKKOS_INLINE_FUNCTION static int
+    invoke(const MemberType &member, const int m, const int j,
+           const ValueType *__restrict__ u2, const int u2s,
+           /* */ ValueType *__restrict__ v, const int vs) {
+      using value_type = ValueType;
+
+      /// Given a householder vector [1; u2] stored in a factored matrix,
+      /// it forms the explicit j-th column of V (m x 1)
+      ///   v = [0 (j x 1); 1; u2 ((m-j-1) x 1)]
+      const value_type one(1), zero(0);
+      Kokkos::parallel_for(Kokkos::TeamVectorRange(member, m),
+                           [&](const int &i) {
+                             v[i * vs] = (i < j ? zero
+                                                : i == j ? one
+                                                         : u2[(i - j - 1) * u2s]);
+                           });
+      member.team_barrier();
+
+      return 0;
+    }
+  };
+
+} // namespace Tines
+
+#endif
@@ -28,6 +28,71 @@ Sandia National Laboratories, New Mexico, USA
 
 namespace Tines {
 
+  template <int MB, int NB> struct GemmMicroKernelInternal {
+    template <typename ScalarType, typename ValueType>
+    KOKKOS_FORCEINLINE_FUNCTION static int
+    invoke(const int mb, const int nb, const int k, const ScalarType alpha,
+           const ValueType *__restrict__ A, const int as0, const int as1,
+           const ValueType *__restrict__ B, const int bs0, const int bs1,
+           /**/ ValueType *__restrict__ C, const int cs0, const int cs1) {
+
+      // C += alpha A B
+      // C (mb x nb), A(mb x k), B(k x nb) where mb <= MB and nb <= NB
+      //  - the MB x NB tile of C is accumulated in registers and a column of
+      //    A and a row of B are loaded once for each p
+
+      ValueType c[MB][NB];
+      for (int i = 0; i < MB; ++i)
+        for (int j = 0; j < NB; ++j)
+          c[i][j] = ValueType(0);
+
+      if (mb == MB && nb == NB) {
+        if (bs1 == 1) {
+          /// contiguous rows of B are vectorized
+          for (int p = 0; p < k; ++p) {
+            const ValueType *__restrict__ pA = A + p * as1;
+            const ValueType *__restrict__ pB = B + p * bs0;
+            for (int i = 0; i < MB; ++i) {
+              const ValueType a = pA[i * as0];
+              for (int j = 0; j < NB; ++j)
+                c[i][j] += a * pB[j];
+            }
+          }
+        } else {
+          ValueType b[NB];
+          for (int p = 0; p < k; ++p) {
+            const ValueType *__restrict__ pA = A + p * as1;
+            const ValueType *__restrict__ pB = B + p * bs0;
+            for (int j = 0; j < NB; ++j)
+              b[j] = pB[j * bs1];
+            for (int i = 0; i < MB; ++i) {
+              const ValueType a = pA[i * as0];
+              for (int j = 0; j < NB; ++j)
+                c[i][j] += a * b[j];
+            }
+          }
+        }
+      } else {
+        /// remainder tile
+        for (int p = 0; p < k; ++p) {
+          const ValueType *__restrict__ pA = A + p * as1;
+          const ValueType *__restrict__ pB = B + p * bs0;
+          for (int i = 0; i < mb; ++i) {
+            const ValueType a = pA[i * as0];
+            for (int j = 0; j < nb; ++j)
+              c[i][j] += a * pB[j * bs1];
+          }
+        }
+      }
+
+      for (int i = 0; i < mb; ++i)
+        for (int j = 0; j < nb; ++j)
+          C[i * cs0 + j * cs1] += alpha * c[i][j];
+
+      return 0;
+    }
+  };
+
   struct GemmInternal {
     template <typename MemberType, typename ScalarType, typename ValueType>
     KOKKOS_INLINE_FUNCTION static int
@@ -54,6 +119,23 @@ namespace Tines {
         if (beta != one)
           member.team_barrier();
 
+#if defined(KOKKOS_ACTIVE_EXECUTION_MEMORY_SPACE_HOST)
+        if (std::is_floating_point<ValueType>::value) {
+          /// register blocked tiles on host; a team thread computes a tile
+          constexpr int mb = 4, nb = 8;
+          const int mt = (m + mb - 1) / mb, nt = (n + nb - 1) / nb;
+          Kokkos::parallel_for(
+            Kokkos::TeamThreadRange(member, mt * nt), [&](const int &ij) {
+              const int i = (ij / nt) * mb, j = (ij % nt) * nb;
+              const int mi = (m - i) < mb ? (m - i) : mb;
+              const int nj = (n - j) < nb ? (n - j) : nb;
+              GemmMicroKernelInternal<mb, nb>::invoke(
+                mi, nj, k, alpha, A + i * as0, as0, as1, B + j * bs1, bs0, bs1,
+                C + i * cs0 + j * cs1, cs0, cs1);
+            });
+          return 0;
+        }
+#endif
         Kokkos::parallel_for(
           Kokkos::TeamThreadRange(member, m), [&](const int &i) {
             const ValueType *__restrict__ pA = A + i * as0;
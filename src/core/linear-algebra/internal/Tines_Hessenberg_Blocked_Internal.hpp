@@ -0,0 +1,156 @@
+/*----------------------------------------------------------------------------------
+Tines - Time Integrator, Newton and Eigen Solver -  version 1.0
+Copyright (2021) NTESS
+https://github.com/sandialabs/Tines
+
+Copyright 2021 National Technology & Engineering Solutions of Sandia, LLC (NTESS). 
+Under the terms of Contract DE-NA0003525 with NTESS, the U.S. Government retains 
+certain rights in this software.
+
+This file is part of Tines. Tines is open-source software: you can redistribute it
+and/or modify it under the terms of BSD 2-Clause License
+(https://opensource.org/licenses/BSD-2-Clause). A copy of the license is also
+provided under the main directory
+Questions? Kyungjoo Kim <kyukim@sandia.gov>, or
+	   Oscar Diaz-Ibarra at <odiazib@sandia.gov>, or
+	   Cosmin Safta at <csafta@sandia.gov>, or
+	   Habib Najm at <hnnajm@sandia.gov>
+
+Sandia National Laboratories, New Mexico, USA
+----------------------------------------------------------------------------------*/
+#ifndef __TINES_HESSENBERG_BLOCKED_INTERNAL_HPP__
+#define __TINES_HESSENBERG_BLOCKED_INTERNAL_HPP__
+
+#include "Tines_BlockHouseholder_Internal.hpp"
+#include "Tines_Gemm_Internal.hpp"
+#include "Tines_Householder_Internal.hpp"
+#include "Tines_Internal.hpp"
+#include "Tines_Set_Internal.hpp"
+
+namespace Tines {
+
+  struct HessenbergBlockedInternal {
+    KOKKOS_INLINE_FUNCTION
+    static int workspace(const int m, int &wlen) {
+      const int nb = TINES_BLOCKED_HOUSEHOLDER_BLOCK_SIZE;
+      /// V (m x nb), Y (m x nb), W (nb x m), T (nb x nb) and two vectors (nb)
+      wlen = nb * (3 * m + nb + 2);
+      return 0;
+    }
+
+    template <typename MemberType, typename ValueType>
+    KOKKOS_INLINE_FUNCTION static int
+    invoke(const MemberType &member,
+           const int m, // m = NumRows(A)
+           ValueType *__restrict__ A, const int as0, const int as1,
+           ValueType *__restrict__ t, const int ts, ValueType *__restrict__ w) {
+      using value_type = ValueType;
+
+      /// Given a matrix A, it computes HESSENBERG decomposition of the matrix
+      /// in panels of nb columns (LAPACK dlahr2 approach). Within a panel,
+      /// a column is updated with the previous reflectors just before its
+      /// householder vector is computed; the panel reflectors are
+      /// accumulated as Q = I - V T V^H together with Y = A V T so that the
+      /// trailing matrix is updated with gemm only
+      ///   A = (I - V T^H V^H) (A - Y V^H)
+      ///  - the output is identical to HessenbergInternal
+      ///  - t is to store tau and w is for workspace
+      const value_type one(1), minus_one(-1), zero(0);
+      const int nb = TINES_BLOCKED_HOUSEHOLDER_BLOCK_SIZE;
+
+      /// the last reflector (column m-2) only flips the sign of A(m-1,m-2)
+      const int nh = m - 1;
+
+      value_type *V = w;
+      value_type *Y = V + m * nb;
+      value_type *W = Y + m * nb;
+      value_type *T = W + nb * m;
+      value_type *tw0 = T + nb * nb;
+      value_type *tw1 = tw0 + nb;
+
+      const int vs0 = 1, vs1 = m, ys0 = 1, ys1 = m, ts0 = 1, ts1 = nb;
+      for (int k = 0; k < nh; k += nb) {
+        const int b = (nh - k) < nb ? (nh - k) : nb;
+
+        /// V holds rows k+1:m of the householder vectors
+        const int m_V = m - k - 1;
+
+        SetInternal::invoke(member, b, b, zero, T, ts0, ts1);
+        member.team_barrier();
+
+        /// -----------------------------------------------------
+        /// panel factorization
+        for (int j = 0; j < b; ++j) {
+          const int c = k + j;
+          value_type *a = A + c * as1;
+          value_type *a_V = a + (k + 1) * as0;
+          if (j > 0) {
+            /// a = a - Y V(c,:)^H; right reflectors of the panel
+            GemmInternal::invoke(member, m, 1, j, minus_one, Y, ys0, ys1,
+                                 V + (j - 1) * vs0, vs1, vs1, one, a, as0,
+                                 as1);
+            member.team_barrier();
+
+            /// a = (I - V T^H V^H) a; left reflectors of the panel
+            GemmInternal::invoke(member, j, 1, m_V, one, V, vs1, vs0, a_V,
+                                 as0, as0, zero, tw0, 1, 1);
+            member.team_barrier();
+            GemmInternal::invoke(member, j, 1, j, one, T, ts1, ts0, tw0, 1, 1,
+                                 zero, tw1, 1, 1);
+            member.team_barrier();
+            GemmInternal::invoke(member, m_V, 1, j, minus_one, V, vs0, vs1,
+                                 tw1, 1, 1, one, a_V, as0, as0);
+            member.team_barrier();
+          }
+
+          /// householder vector annihilating a(c+2:m)
+          value_type *chi1 = a + (c + 1) * as0;
+          value_type *tau = t + c * ts;
+          LeftHouseholderInternal::invoke(member, m - c - 2, chi1, chi1 + as0,
+                                          as0, tau);
+          member.team_barrier();
+
+          SetBlockHouseholderVectorInternal::invoke(member, m_V, j, chi1 + as0,
+                                                    as0, V + j * vs1, vs0);
+
+          /// T(:,j)
+          FormBlockHouseholderInternal::invoke(member, m_V, j, V, vs0, vs1,
+                                               tau, T, ts0, ts1, tw0);
+
+          /// Y(:,j) = (A(:,k+1:m) V(:,j) - Y(:,0:j) w) / tau
+          /// where w = V(:,0:j)^H V(:,j) is left in tw0 by the T update
+          const value_type inv_tau = one / (*tau);
+          value_type *y = Y + j * ys1;
+          GemmInternal::invoke(member, m, 1, m_V - j, inv_tau,
+                               A + (c + 1) * as1, as0, as1, V + j * vs1 + j,
+                               vs0, vs0, zero, y, ys0, ys0);
+          member.team_barrier();
+          GemmInternal::invoke(member, m, 1, j, -inv_tau, Y, ys0, ys1, tw0, 1,
+                               1, one, y, ys0, ys0);
+          member.team_barrier();
+        }
+
+        /// -----------------------------------------------------
+        /// trailing matrix update
+        const int n_trail = m - k - b;
+        if (n_trail > 0) {
+          value_type *A2 = A + (k + b) * as1;
+
+          /// A2 = A2 - Y V(k+b:m,:)^H; rows of V start at k+1
+          GemmInternal::invoke(member, m, n_trail, b, minus_one, Y, ys0, ys1,
+                               V + (b - 1) * vs0, vs1, vs0, one, A2, as0, as1);
+          member.team_barrier();
+
+          /// A2(k+1:m,:) = (I - V T^H V^H) A2(k+1:m,:)
+          ApplyLeftBlockHouseholderInternal::invoke(
+            member, m_V, n_trail, b, V, vs0, vs1, T, ts0, ts1,
+            A2 + (k + 1) * as0, as0, as1, W);
+        }
+      }
+      return 0;
+    }
+  };
+
+} // namespace Tines
+
+#endif
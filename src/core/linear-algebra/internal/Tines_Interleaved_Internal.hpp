@@ -0,0 +1,323 @@
+/*----------------------------------------------------------------------------------
+Tines - Time Integrator, Newton and Eigen Solver -  version 1.0
+Copyright (2021) NTESS
+https://github.com/sandialabs/Tines
+
+Copyright 2021 National Technology & Engineering Solutions of Sandia, LLC (NTESS). 
+Under the terms of Contract DE-NA0003525 with NTESS, the U.S. Government retains 
+certain rights in this software.
+
+This file is part of Tines. Tines is open-source software: you can redistribute it
+and/or modify it under the terms of BSD 2-Clause License
+(https://opensource.org/licenses/BSD-2-Clause). A copy of the license is also
+provided under the main directory
+Questions? Kyungjoo Kim <kyukim@sandia.gov>, or
+	   Oscar Diaz-Ibarra at <odiazib@sandia.gov>, or
+	   Cosmin Safta at <csafta@sandia.gov>, or
+	   Habib Najm at <hnnajm@sandia.gov>
+
+Sandia National Laboratories, New Mexico, USA
+----------------------------------------------------------------------------------*/
+#ifndef __TINES_INTERLEAVED_INTERNAL_HPP__
+#define __TINES_INTERLEAVED_INTERNAL_HPP__
+
+#include "Tines_Internal.hpp"
+
+/// number of samples interleaved in a pack; 8 doubles fill an AVX-512
+/// register (use 4 for AVX2)
+#if !defined(TINES_INTERLEAVED_VECTOR_LENGTH)
+#define TINES_INTERLEAVED_VECTOR_LENGTH 8
+#endif
+
+namespace Tines {
+
+  ///
+  /// Lane-wise kernels for the interleaved batch layout; a pack of N samples
+  /// is stored such that the entry (i,j) of the sample l is
+  ///   A[i*as0 + j*as1 + l]
+  /// i.e., the sample index is innermost and contiguous. A single thread
+  /// works on a pack and the innermost loop over the lanes is vectorized.
+  ///
+
+  template <int N> struct GemvInterleavedInternal {
+    template <typename ScalarType, typename ValueType>
+    KOKKOS_INLINE_FUNCTION static int
+    invoke(const int m, const int n, const ScalarType alpha,
+           const ValueType *__restrict__ A, const int as0, const int as1,
+           const ValueType *__restrict__ x, const int xs0,
+           const ScalarType beta,
+           /* */ ValueType *__restrict__ y, const int ys0) {
+      /// y = beta y + alpha A x
+      for (int i = 0; i < m; ++i) {
+        ValueType acc[N];
+        for (int l = 0; l < N; ++l)
+          acc[l] = ValueType(0);
+        for (int j = 0; j < n; ++j) {
+          const ValueType *__restrict__ a = A + i * as0 + j * as1;
+          const ValueType *__restrict__ xj = x + j * xs0;
+          for (int l = 0; l < N; ++l)
+            acc[l] += a[l] * xj[l];
+        }
+        ValueType *__restrict__ yi = y + i * ys0;
+        if (beta == ScalarType(0))
+          for (int l = 0; l < N; ++l)
+            yi[l] = alpha * acc[l];
+        else
+          for (int l = 0; l < N; ++l)
+            yi[l] = beta * yi[l] + alpha * acc[l];
+      }
+      return 0;
+    }
+  };
+
+  template <int N> struct LU_InterleavedInternal {
+    template <typename ValueType>
+    KOKKOS_INLINE_FUNCTION static int
+    invoke(const int m, /* */ ValueType *__restrict__ A, const int as0,
+           const int as1,
+           /* */ int *__restrict__ p, const int ps0) {
+      using value_type = ValueType;
+      using magnitude_type = typename ats<value_type>::magnitude_type;
+      const value_type zero(0), one(1);
+
+      /// P A = L U with partial pivoting for each lane; pivots are relative
+      /// to the current row as in LU_Internal
+      for (int k = 0; k < m; ++k) {
+        value_type *__restrict__ a11 = A + k * as0 + k * as1;
+        int *__restrict__ pk = p + k * ps0;
+
+        /// find pivots
+        for (int l = 0; l < N; ++l) {
+          magnitude_type max_val(-1);
+          int piv(0);
+          for (int i = 0; i < (m - k); ++i) {
+            const magnitude_type val = ats<value_type>::abs(a11[i * as0 + l]);
+            if (val > max_val) {
+              max_val = val;
+              piv = i;
+            }
+          }
+          pk[l] = piv;
+        }
+
+        /// swap rows lane by lane
+        for (int j = 0; j < m; ++j) {
+          value_type *__restrict__ a = A + k * as0 + j * as1;
+          for (int l = 0; l < N; ++l) {
+            const int piv = pk[l];
+            const value_type tmp = a[l];
+            a[l] = a[piv * as0 + l];
+            a[piv * as0 + l] = tmp;
+          }
+        }
+
+        /// an exact zero pivot leaves the column as it is
+        value_type inv_alpha11[N];
+        for (int l = 0; l < N; ++l)
+          inv_alpha11[l] = a11[l] == zero ? zero : one / a11[l];
+
+        for (int i = k + 1; i < m; ++i) {
+          value_type *__restrict__ ai = A + i * as0;
+          value_type *__restrict__ aik = ai + k * as1;
+          for (int l = 0; l < N; ++l)
+            aik[l] *= inv_alpha11[l];
+          for (int j = k + 1; j < m; ++j) {
+            const value_type *__restrict__ akj = A + k * as0 + j * as1;
+            value_type *__restrict__ aij = ai + j * as1;
+            for (int l = 0; l < N; ++l)
+              aij[l] -= aik[l] * akj[l];
+          }
+        }
+      }
+      return 0;
+    }
+  };
+
+  template <int N> struct SolveLU_InterleavedInternal {
+    template <typename ValueType>
+    KOKKOS_INLINE_FUNCTION static int
+    invoke(const int m, const ValueType *__restrict__ LU, const int as0,
+           const int as1, const int *__restrict__ p, const int ps0,
+           /* */ ValueType *__restrict__ x, const int xs0) {
+      using value_type = ValueType;
+
+      /// x = U^{-1} L^{-1} P x for each lane
+
+      /// x = P x
+      for (int k = 0; k < m; ++k) {
+        const int *__restrict__ pk = p + k * ps0;
+        value_type *__restrict__ xk = x + k * xs0;
+        for (int l = 0; l < N; ++l) {
+          const int piv = pk[l];
+          const value_type tmp = xk[l];
+          xk[l] = xk[piv * xs0 + l];
+          xk[piv * xs0 + l] = tmp;
+        }
+      }
+
+      /// x = L^{-1} x
+      for (int i = 1; i < m; ++i) {
+        value_type *__restrict__ xi = x + i * xs0;
+        for (int j = 0; j < i; ++j) {
+          const value_type *__restrict__ a = LU + i * as0 + j * as1;
+          const value_type *__restrict__ xj = x + j * xs0;
+          for (int l = 0; l < N; ++l)
+            xi[l] -= a[l] * xj[l];
+        }
+      }
+
+      /// x = U^{-1} x
+      for (int i = (m - 1); i >= 0; --i) {
+        value_type *__restrict__ xi = x + i * xs0;
+        for (int j = i + 1; j < m; ++j) {
+          const value_type *__restrict__ a = LU + i * as0 + j * as1;
+          const value_type *__restrict__ xj = x + j * xs0;
+          for (int l = 0; l < N; ++l)
+            xi[l] -= a[l] * xj[l];
+        }
+        const value_type *__restrict__ a = LU + i * as0 + i * as1;
+        for (int l = 0; l < N; ++l)
+          xi[l] /= a[l];
+      }
+      return 0;
+    }
+  };
+
+  template <int N> struct QR_InterleavedInternal {
+    template <typename ValueType>
+    KOKKOS_INLINE_FUNCTION static int
+    invoke(const int m, const int n, /* */ ValueType *__restrict__ A,
+           const int as0, const int as1,
+           /* */ ValueType *__restrict__ t, const int ts0) {
+      using value_type = ValueType;
+      const value_type zero(0), half(0.5), one(1);
+
+      /// A = Q R for each lane with householder vectors stored as in
+      /// QR_Internal i.e., H = I - u u^H / tau with u = [1 u2]
+      const int min_mn = m < n ? m : n;
+      for (int k = 0; k < min_mn; ++k) {
+        value_type *__restrict__ chi1 = A + k * as0 + k * as1;
+        value_type *__restrict__ x2 = chi1 + as0;
+        value_type *__restrict__ tau = t + k * ts0;
+        const int m_x2 = m - k - 1;
+
+        /// householder vectors
+        value_type norm_x2_square[N], inv_chi1_minus_alpha[N];
+        for (int l = 0; l < N; ++l)
+          norm_x2_square[l] = zero;
+        for (int i = 0; i < m_x2; ++i) {
+          const value_type *__restrict__ x = x2 + i * as0;
+          for (int l = 0; l < N; ++l)
+            norm_x2_square[l] += x[l] * x[l];
+        }
+        for (int l = 0; l < N; ++l) {
+          if (norm_x2_square[l] == zero) {
+            chi1[l] = -chi1[l];
+            tau[l] = half;
+            inv_chi1_minus_alpha[l] = zero;
+          } else {
+            const value_type norm_x = ats<value_type>::sqrt(
+              norm_x2_square[l] + chi1[l] * chi1[l]);
+            const value_type alpha = (chi1[l] < zero ? one : -one) * norm_x;
+            const value_type chi1_minus_alpha = chi1[l] - alpha;
+            inv_chi1_minus_alpha[l] = one / chi1_minus_alpha;
+            tau[l] = half + half * (norm_x2_square[l] /
+                                    (chi1_minus_alpha * chi1_minus_alpha));
+            chi1[l] = alpha;
+          }
+        }
+        for (int i = 0; i < m_x2; ++i) {
+          value_type *__restrict__ x = x2 + i * as0;
+          for (int l = 0; l < N; ++l)
+            x[l] *= inv_chi1_minus_alpha[l];
+        }
+
+        /// apply to the trailing columns
+        for (int j = k + 1; j < n; ++j) {
+          value_type *__restrict__ a1 = A + k * as0 + j * as1;
+          value_type *__restrict__ a2 = a1 + as0;
+          value_type w[N];
+          for (int l = 0; l < N; ++l)
+            w[l] = a1[l];
+          for (int i = 0; i < m_x2; ++i) {
+            const value_type *__restrict__ u = x2 + i * as0;
+            const value_type *__restrict__ a = a2 + i * as0;
+            for (int l = 0; l < N; ++l)
+              w[l] += u[l] * a[l];
+          }
+          for (int l = 0; l < N; ++l) {
+            w[l] /= tau[l];
+            a1[l] -= w[l];
+          }
+          for (int i = 0; i < m_x2; ++i) {
+            const value_type *__restrict__ u = x2 + i * as0;
+            value_type *__restrict__ a = a2 + i * as0;
+            for (int l = 0; l < N; ++l)
+              a[l] -= u[l] * w[l];
+          }
+        }
+      }
+      return 0;
+    }
+  };
+
+  template <int N> struct SolveQR_InterleavedInternal {
+    template <typename ValueType>
+    KOKKOS_INLINE_FUNCTION static int
+    invoke(const int m, const ValueType *__restrict__ QR, const int as0,
+           const int as1, const ValueType *__restrict__ t, const int ts0,
+           /* */ ValueType *__restrict__ x, const int xs0) {
+      using value_type = ValueType;
+
+      /// x = R^{-1} Q^H x for each lane where QR is given by
+      /// QR_InterleavedInternal for a square matrix
+
+      /// x = Q^H x
+      for (int k = 0; k < m; ++k) {
+        const value_type *__restrict__ u2 = QR + (k + 1) * as0 + k * as1;
+        const value_type *__restrict__ tau = t + k * ts0;
+        value_type *__restrict__ x1 = x + k * xs0;
+        value_type *__restrict__ x2 = x1 + xs0;
+        const int m_x2 = m - k - 1;
+
+        value_type w[N];
+        for (int l = 0; l < N; ++l)
+          w[l] = x1[l];
+        for (int i = 0; i < m_x2; ++i) {
+          const value_type *__restrict__ u = u2 + i * as0;
+          const value_type *__restrict__ xi = x2 + i * xs0;
+          for (int l = 0; l < N; ++l)
+            w[l] += u[l] * xi[l];
+        }
+        for (int l = 0; l < N; ++l) {
+          w[l] /= tau[l];
+          x1[l] -= w[l];
+        }
+        for (int i = 0; i < m_x2; ++i) {
+          const value_type *__restrict__ u = u2 + i * as0;
+          value_type *__restrict__ xi = x2 + i * xs0;
+          for (int l = 0; l < N; ++l)
+            xi[l] -= u[l] * w[l];
+        }
+      }
+
+      /// x = R^{-1} x
+      for (int i = (m - 1); i >= 0; --i) {
+        value_type *__restrict__ xi = x + i * xs0;
+        for (int j = i + 1; j < m; ++j) {
+          const value_type *__restrict__ a = QR + i * as0 + j * as1;
+          const value_type *__restrict__ xj = x + j * xs0;
+          for (int l = 0; l < N; ++l)
+            xi[l] -= a[l] * xj[l];
+        }
+        const value_type *__restrict__ a = QR + i * as0 + i * as1;
+        for (int l = 0; l < N; ++l)
+          xi[l] /= a[l];
+      }
+      return 0;
+    }
+  };
+
+} // namespace Tines
+
+#endif
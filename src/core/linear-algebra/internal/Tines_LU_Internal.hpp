@@ -0,0 +1,165 @@
+/*----------------------------------------------------------------------------------
+Tines - Time Integrator, Newton and Eigen Solver -  version 1.0
+Copyright (2021) NTESS
+https://github.com/sandialabs/Tines
+
+Copyright 2021 National Technology & Engineering Solutions of Sandia, LLC (NTESS). 
+Under the terms of Contract DE-NA0003525 with NTESS, the U.S. Government retains 
+certain rights in this software.
+
+This file is part of Tines. Tines is open-source software: you can redistribute it
+and/or modify it under the terms of BSD 2-Clause License
+(https://opensource.org/licenses/BSD-2-Clause). A copy of the license is also
+provided under the main directory
+Questions? Kyungjoo Kim <kyukim@sandia.gov>, or
+	   Oscar Diaz-Ibarra at <odiazib@sandia.gov>, or
+	   Cosmin Safta at <csafta@sandia.gov>, or
+	   Habib Najm at <hnnajm@sandia.gov>
+
+Sandia National Laboratories, New Mexico, USA
+----------------------------------------------------------------------------------*/
+#ifndef __TINES_LU_INTERNAL_HPP__
+#define __TINES_LU_INTERNAL_HPP__
+
+#include "Tines_Internal.hpp"
+
+#include "Tines_ApplyPivot_Internal.hpp"
+
+namespace Tines {
+
+  struct LU_Internal {
+    template <typename MemberType, typename ValueType, typename IntType>
+    KOKKOS_INLINE_FUNCTION static int
+    invoke(const MemberType &member, const int m, // m = NumRows(A)
+           const int n,                           // n = NumCols(A)
+           /* */ ValueType *__restrict__ A, const int as0, const int as1,
+           /* */ IntType *__restrict__ p, const int ps0,
+           /* */ int &matrix_rank,
+           /* */ typename ats<ValueType>::magnitude_type &pivot_growth) {
+      using value_type = ValueType;
+      using magnitude_type = typename ats<value_type>::magnitude_type;
+
+      /// Given a matrix A, it computes P A = L U with partial (row) pivoting
+      ///  - L is unit lower triangular and U is upper triangular; both are
+      ///    overwritten on A
+      ///  - p stores pivots relative to the current row (LAPACK style but
+      ///    zero-based and relative i.e., row i is swapped with row i+p[i])
+      ///  - matrix_rank is the index of the first pivot that is negligible
+      ///    compared to max |A|
+      ///  - pivot_growth is max |U| / max |A|; a large value indicates that
+      ///    the factorization is not backward stable
+
+      const int min_mn = m < n ? m : n;
+      const value_type zero(0), one(1);
+
+      /// max |A| for the rank check and pivot growth
+      magnitude_type max_abs_a(0);
+      {
+        using reducer_value_type =
+          typename Kokkos::Max<magnitude_type>::value_type;
+        reducer_value_type value;
+        Kokkos::Max<magnitude_type> reducer_value(value);
+        Kokkos::parallel_reduce(
+          Kokkos::TeamVectorRange(member, m * n),
+          [&](const int &ij, reducer_value_type &update) {
+            const int i = ij / n, j = ij % n;
+            const magnitude_type val = ats<value_type>::abs(A[i * as0 + j * as1]);
+            update = val > update ? val : update;
+          },
+          reducer_value);
+        max_abs_a = value;
+      }
+      const magnitude_type threshold(max_abs_a * ats<value_type>::epsilon());
+
+      matrix_rank = min_mn;
+      for (int k = 0; k < min_mn; ++k) {
+        const int m_A22 = m - k - 1, n_A22 = n - k - 1;
+
+        value_type *__restrict__ a11 = A + k * as0 + k * as1;
+        value_type *__restrict__ a21 = a11 + as0;
+        value_type *__restrict__ a12 = a11 + as1;
+        value_type *__restrict__ A22 = a11 + as0 + as1;
+
+        /// find max location of |a11; a21|
+        int piv(0);
+        {
+          using reducer_value_type =
+            typename Kokkos::MaxLoc<magnitude_type, int>::value_type;
+          reducer_value_type value;
+          Kokkos::MaxLoc<magnitude_type, int> reducer_value(value);
+          Kokkos::parallel_reduce(
+            Kokkos::TeamVectorRange(member, m - k),
+            [&](const int &i, reducer_value_type &update) {
+              const magnitude_type val = ats<value_type>::abs(a11[i * as0]);
+              if (val > update.val) {
+                update.val = val;
+                update.loc = i;
+              }
+            },
+            reducer_value);
+          piv = value.loc;
+        }
+        Kokkos::single(Kokkos::PerTeam(member), [&]() { p[k * ps0] = piv; });
+
+        /// apply pivot to the entire row
+        ApplyPivotMatrixForwardInternal::invoke(member, piv, n, A + k * as0,
+                                                as0, as1);
+        member.team_barrier();
+
+        const value_type alpha11 = *a11;
+        if (matrix_rank == min_mn) {
+          const magnitude_type val_diag = ats<value_type>::abs(alpha11);
+          if (val_diag <= threshold)
+            matrix_rank = k;
+        }
+
+        /// exact zero pivot; the column is already eliminated
+        if (alpha11 != zero) {
+          /// a21 = a21 / alpha11
+          const value_type inv_alpha11 = one / alpha11;
+          Kokkos::parallel_for(
+            Kokkos::TeamVectorRange(member, m_A22),
+            [&](const int &i) { a21[i * as0] *= inv_alpha11; });
+          member.team_barrier();
+
+          /// A22 = A22 - a21 a12
+          Kokkos::parallel_for(
+            Kokkos::TeamThreadRange(member, m_A22), [&](const int &i) {
+              const value_type a21_at_i = a21[i * as0];
+              value_type *__restrict__ A22_at_i = A22 + i * as0;
+              Kokkos::parallel_for(
+                Kokkos::ThreadVectorRange(member, n_A22), [&](const int &j) {
+                  A22_at_i[j * as1] -= a21_at_i * a12[j * as1];
+                });
+            });
+          member.team_barrier();
+        }
+      }
+
+      /// max |U| / max |A|
+      {
+        using reducer_value_type =
+          typename Kokkos::Max<magnitude_type>::value_type;
+        reducer_value_type value;
+        Kokkos::Max<magnitude_type> reducer_value(value);
+        Kokkos::parallel_reduce(
+          Kokkos::TeamVectorRange(member, min_mn * n),
+          [&](const int &ij, reducer_value_type &update) {
+            const int i = ij / n, j = ij % n;
+            const magnitude_type val =
+              j < i ? magnitude_type(0)
+                    : ats<value_type>::abs(A[i * as0 + j * as1]);
+            update = val > update ? val : update;
+          },
+          reducer_value);
+        pivot_growth = max_abs_a > magnitude_type(0) ? value / max_abs_a
+                                                      : magnitude_type(0);
+      }
+
+      return 0;
+    }
+  };
+
+} // namespace Tines
+
+#endif
@@ -0,0 +1,147 @@
+/*----------------------------------------------------------------------------------
+Tines - Time Integrator, Newton and Eigen Solver -  version 1.0
+Copyright (2021) NTESS
+https://github.com/sandialabs/Tines
+
+Copyright 2021 National Technology & Engineering Solutions of Sandia, LLC (NTESS). 
+Under the terms of Contract DE-NA0003525 with NTESS, the U.S. Government retains 
+certain rights in this software.
+
+This file is part of Tines. Tines is open-source software: you can redistribute it
+and/or modify it under the terms of BSD 2-Clause License
+(https://opensource.org/licenses/BSD-2-Clause). A copy of the license is also
+provided under the main directory
+Questions? Kyungjoo Kim <kyukim@sandia.gov>, or
+	   Oscar Diaz-Ibarra at <odiazib@sandia.gov>, or
+	   Cosmin Safta at <csafta@sandia.gov>, or
+	   Habib Najm at <hnnajm@sandia.gov>
+
+Sandia National Laboratories, New Mexico, USA
+----------------------------------------------------------------------------------*/
+#ifndef __TINES_LU_STATIC_INTERNAL_HPP__
+#define __TINES_LU_STATIC_INTERNAL_HPP__
+
+#include "Tines_Internal.hpp"
+
+/// largest compile-time size dispatched to the fixed size kernels; larger
+/// systems use the team parallel kernels
+#if !defined(TINES_STATIC_SIZE_MAX)
+#define TINES_STATIC_SIZE_MAX 16
+#endif
+
+namespace Tines {
+
+  ///
+  /// Fixed size kernels; a single thread works on a matrix kept in a stack
+  /// array so that loops with the compile-time bound M are fully unrolled
+  ///
+  template <int M> struct LU_StaticInternal {
+    template <typename ValueType>
+    KOKKOS_FORCEINLINE_FUNCTION static int
+    invoke(/* */ ValueType (&A)[M][M], int (&p)[M],
+           /* */ int &matrix_rank,
+           /* */ typename ats<ValueType>::magnitude_type &pivot_growth) {
+      using value_type = ValueType;
+      using magnitude_type = typename ats<value_type>::magnitude_type;
+
+      /// Given a matrix A, it computes P A = L U with partial (row) pivoting
+      /// where the pivots, the rank and the pivot growth follow LU_Internal
+
+      const value_type zero(0), one(1);
+
+      magnitude_type max_abs_a(0);
+      for (int i = 0; i < M; ++i)
+        for (int j = 0; j < M; ++j) {
+          const magnitude_type val = ats<value_type>::abs(A[i][j]);
+          max_abs_a = val > max_abs_a ? val : max_abs_a;
+        }
+      const magnitude_type threshold(max_abs_a * ats<value_type>::epsilon());
+
+      matrix_rank = M;
+      for (int k = 0; k < M; ++k) {
+        /// find max location of |A(k:M,k)|
+        int piv(0);
+        magnitude_type max_val(-1);
+        for (int i = k; i < M; ++i) {
+          const magnitude_type val = ats<value_type>::abs(A[i][k]);
+          if (val > max_val) {
+            max_val = val;
+            piv = i - k;
+          }
+        }
+        p[k] = piv;
+
+        /// apply pivot to the entire row
+        if (piv) {
+          for (int j = 0; j < M; ++j) {
+            const value_type tmp = A[k][j];
+            A[k][j] = A[k + piv][j];
+            A[k + piv][j] = tmp;
+          }
+        }
+
+        const value_type alpha11 = A[k][k];
+        if (matrix_rank == M && ats<value_type>::abs(alpha11) <= threshold)
+          matrix_rank = k;
+
+        /// exact zero pivot; the column is already eliminated
+        if (alpha11 != zero) {
+          const value_type inv_alpha11 = one / alpha11;
+          for (int i = k + 1; i < M; ++i) {
+            const value_type a21 = (A[i][k] *= inv_alpha11);
+            for (int j = k + 1; j < M; ++j)
+              A[i][j] -= a21 * A[k][j];
+          }
+        }
+      }
+
+      /// max |U| / max |A|
+      magnitude_type max_abs_u(0);
+      for (int i = 0; i < M; ++i)
+        for (int j = i; j < M; ++j) {
+          const magnitude_type val = ats<value_type>::abs(A[i][j]);
+          max_abs_u = val > max_abs_u ? val : max_abs_u;
+        }
+      pivot_growth = max_abs_a > magnitude_type(0) ? max_abs_u / max_abs_a
+                                                    : magnitude_type(0);
+      return 0;
+    }
+  };
+
+  template <int M> struct SolveLU_StaticInternal {
+    template <typename ValueType>
+    KOKKOS_FORCEINLINE_FUNCTION static int
+    invoke(const ValueType (&LU)[M][M], const int (&p)[M],
+           /* */ ValueType (&x)[M]) {
+      using value_type = ValueType;
+
+      /// x = U^{-1} L^{-1} P x where LU factors are given by LU_StaticInternal
+
+      /// x = P x
+      for (int k = 0; k < M; ++k) {
+        const int piv = p[k];
+        if (piv) {
+          const value_type tmp = x[k];
+          x[k] = x[k + piv];
+          x[k + piv] = tmp;
+        }
+      }
+
+      /// x = L^{-1} x
+      for (int i = 1; i < M; ++i)
+        for (int j = 0; j < i; ++j)
+          x[i] -= LU[i][j] * x[j];
+
+      /// x = U^{-1} x
+      for (int i = (M - 1); i >= 0; --i) {
+        for (int j = i + 1; j < M; ++j)
+          x[i] -= LU[i][j] * x[j];
+        x[i] /= LU[i][i];
+      }
+      return 0;
+    }
+  };
+
+} // namespace Tines
+
+#endif
@@ -0,0 +1,124 @@
+/*----------------------------------------------------------------------------------
+Tines - Time Integrator, Newton and Eigen Solver -  version 1.0
+Copyright (2021) NTESS
+https://github.com/sandialabs/Tines
+
+Copyright 2021 National Technology & Engineering Solutions of Sandia, LLC (NTESS). 
+Under the terms of Contract DE-NA0003525 with NTESS, the U.S. Government retains 
+certain rights in this software.
+
+This file is part of Tines. Tines is open-source software: you can redistribute it
+and/or modify it under the terms of BSD 2-Clause License
+(https://opensource.org/licenses/BSD-2-Clause). A copy of the license is also
+provided under the main directory
+Questions? Kyungjoo Kim <kyukim@sandia.gov>, or
+	   Oscar Diaz-Ibarra at <odiazib@sandia.gov>, or
+	   Cosmin Safta at <csafta@sandia.gov>, or
+	   Habib Najm at <hnnajm@sandia.gov>
+
+Sandia National Laboratories, New Mexico, USA
+----------------------------------------------------------------------------------*/
+#ifndef __TINES_LEFT_EIGENVECTOR_SCHUR_INTERNAL_HPP__
+#define __TINES_LEFT_EIGENVECTOR_SCHUR_INTERNAL_HPP__
+
+#include "Tines_RightEigenvectorSchur_Internal.hpp"
+#include "Tines_ShiftedQuasiTrsvInternal.hpp"
+
+namespace Tines {
+
+  ///
+  /// Left eigenvectors of a quasi upper triangular Schur form T,
+  ///   u^H T = lambda u^H
+  /// The conjugate of u solves the lower quasi triangular system
+  /// (T^T - lambda I) x = 0 where x is zero above the diagonal block of
+  /// lambda. A complex pair (j, j+1) stores the real and imaginary parts of
+  /// u for the eigenvalue with the positive imaginary part in V(:,j) and
+  /// V(:,j+1) (the same convention as LAPACK dgeev). Eigenvectors are not
+  /// normalized.
+  ///
+  struct LeftEigenvectorSchurInternal {
+    template <typename MemberType, typename RealType>
+    KOKKOS_INLINE_FUNCTION static int
+    invoke(const MemberType &member, const int m, const int *blks, const int bs,
+           /* */ RealType *T, const int ts0, const int ts1,
+           /* */ RealType *V, const int vs0, const int vs1) {
+      using real_type = RealType;
+      using complex_type = Kokkos::complex<real_type>;
+
+      const int ts = ts0 + ts1, vs = vs0 + vs1;
+      const real_type one(1), zero(0);
+      int r_val = 0;
+
+      for (int k = 0; k < m; ++k) {
+        const int tmp_blk = blks[k * bs];
+        const int blk = tmp_blk < 0 ? -tmp_blk : tmp_blk;
+
+        /// T12 is the row block right to the diagonal block and T22^T is
+        /// the trailing lower quasi triangular matrix
+        const real_type *T11 = T + k * ts;
+        const real_type *T12 = T11 + blk * ts1;
+        const real_type *T22 = T11 + blk * ts;
+
+        real_type *V0 = V + k * vs1;
+        real_type *V1 = V + k * vs;
+        real_type *V2 = V1 + blk * vs0;
+
+        const int m_A00 = k;
+        const int m_A22 = m - blk - k;
+
+        if (blk == 1) {
+          /// a real distint eigen value
+          Kokkos::parallel_for(Kokkos::TeamVectorRange(member, m_A00),
+                               [&](const int &i) { V0[i * vs0] = zero; });
+          Kokkos::single(Kokkos::PerTeam(member), [&]() { V1[0] = one; });
+          Kokkos::parallel_for(
+            Kokkos::TeamVectorRange(member, m_A22),
+            [&](const int &i) { V2[i * vs0] = -T12[i * ts1]; });
+          member.team_barrier();
+          const real_type lambda = *T11;
+          ShiftedQuasiTrsvInternalLower::invoke(member, m_A22,
+                                                blks + (k + 1) * bs, bs, lambda,
+                                                T22, ts1, ts0, V2, vs0);
+        } else if (blk == 2) {
+          /// left eigenvector of the 2x2 block is the right eigenvector of
+          /// its transpose
+          complex_type lambda, Q00, Q10;
+          RightEigenvectorSchurInternal::eigenvector2x2(T11, ts1, ts0, lambda,
+                                                        Q00, Q10);
+          Kokkos::parallel_for(Kokkos::TeamVectorRange(member, m_A00),
+                               [&](const int &i) {
+                                 V0[i * vs0] = zero;
+                                 V0[i * vs0 + vs1] = zero;
+                               });
+          Kokkos::single(Kokkos::PerTeam(member), [&]() {
+            V1[0] = Q00.real();
+            V1[vs1] = Q00.imag();
+            V1[vs0] = Q10.real();
+            V1[vs] = Q10.imag();
+          });
+          Kokkos::parallel_for(
+            Kokkos::TeamVectorRange(member, m_A22), [&](const int &i) {
+              const complex_type val =
+                -(T12[i * ts1] * Q00 + T12[i * ts1 + ts0] * Q10);
+              V2[i * vs0] = val.real();
+              V2[i * vs0 + vs1] = val.imag();
+            });
+          member.team_barrier();
+          ShiftedQuasiTrsvInternalLower::invoke(member, m_A22,
+                                                blks + (k + 2) * bs, bs, lambda,
+                                                T22, ts1, ts0, V2, vs0, vs1);
+          member.team_barrier();
+
+          /// u = conj(x)
+          Kokkos::parallel_for(Kokkos::TeamVectorRange(member, m - k),
+                               [&](const int &i) { V1[i * vs0 + vs1] *= -one; });
+        }
+        member.team_barrier();
+      }
+      return r_val;
+    }
+  };
+
+} // namespace Tines
+
+#endif
@@ -0,0 +1,113 @@
+/*----------------------------------------------------------------------------------
+Tines - Time Integrator, Newton and Eigen Solver -  version 1.0
+Copyright (2021) NTESS
+https://github.com/sandialabs/Tines
+
+Copyright 2021 National Technology & Engineering Solutions of Sandia, LLC (NTESS). 
+Under the terms of Contract DE-NA0003525 with NTESS, the U.S. Government retains 
+certain rights in this software.
+
+This file is part of Tines. Tines is open-source software: you can redistribute it
+and/or modify it under the terms of BSD 2-Clause License
+(https://opensource.org/licenses/BSD-2-Clause). A copy of the license is also
+provided under the main directory
+Questions? Kyungjoo Kim <kyukim@sandia.gov>, or
+	   Oscar Diaz-Ibarra at <odiazib@sandia.gov>, or
+	   Cosmin Safta at <csafta@sandia.gov>, or
+	   Habib Najm at <hnnajm@sandia.gov>
+
+Sandia National Laboratories, New Mexico, USA
+----------------------------------------------------------------------------------*/
+#ifndef __TINES_QR_BLOCKED_INTERNAL_HPP__
+#define __TINES_QR_BLOCKED_INTERNAL_HPP__
+
+#include "Tines_ApplyHouseholder_Internal.hpp"
+#include "Tines_BlockHouseholder_Internal.hpp"
+#include "Tines_Householder_Internal.hpp"
+#include "Tines_Internal.hpp"
+#include "Tines_Set_Internal.hpp"
+
+namespace Tines {
+
+  struct QR_BlockedInternal {
+    KOKKOS_INLINE_FUNCTION
+    static int workspace(const int m, const int n, int &wlen) {
+      const int nb = TINES_BLOCKED_HOUSEHOLDER_BLOCK_SIZE;
+      /// V (m x nb), T (nb x nb), W (nb x n) and a vector (nb)
+      wlen = nb * (m + nb + n + 1);
+      return 0;
+    }
+
+    template <typename MemberType, typename ValueType>
+    KOKKOS_INLINE_FUNCTION static int
+    invoke(const MemberType &member,
+           const int m, // m = NumRows(A)
+           const int n, // n = NumCols(A)
+           ValueType *__restrict__ A, const int as0, const int as1,
+           ValueType *__restrict__ t, const int ts, ValueType *__restrict__ w) {
+      using value_type = ValueType;
+
+      /// Given a matrix A, it computes QR decomposition of the matrix
+      /// in panels of nb columns; householder vectors of a panel are
+      /// accumulated in the compact WY form H = I - V T V^H and applied to
+      /// the trailing matrix with gemm
+      ///  - the output is identical to QR_Internal
+      ///  - t is to store tau and w is for workspace
+      const int nb = TINES_BLOCKED_HOUSEHOLDER_BLOCK_SIZE;
+      const int min_mn = m < n ? m : n;
+
+      value_type *V = w;
+      value_type *T = V + m * nb;
+      value_type *W = T + nb * nb;
+      value_type *tw = W + nb * n;
+
+      const int vs0 = 1, vs1 = m, ts0 = 1, ts1 = nb;
+      for (int k = 0; k < min_mn; k += nb) {
+        const int b = (min_mn - k) < nb ? (min_mn - k) : nb;
+        const int m_panel = m - k;
+        const int n_trail = n - k - b;
+
+        /// -----------------------------------------------------
+        /// unblocked factorization of the panel
+        for (int j = 0; j < b; ++j) {
+          const int c = k + j, m_A22 = m - c - 1, n_A12 = b - j - 1;
+          value_type *A11 = A + c * as0 + c * as1;
+          value_type *tau = t + c * ts;
+
+          LeftHouseholderInternal::invoke(member, m_A22, A11, A11 + as0, as0,
+                                          tau);
+          member.team_barrier();
+
+          ApplyLeftHouseholderInternal::invoke(member, m_A22, n_A12, tau,
+                                               A11 + as0, as0, A11 + as1, as1,
+                                               A11 + as0 + as1, as0, as1, W);
+          member.team_barrier();
+        }
+
+        /// -----------------------------------------------------
+        /// block reflector update of the trailing matrix
+        if (n_trail > 0) {
+          SetInternal::invoke(member, b, b, value_type(0), T, ts0, ts1);
+          for (int j = 0; j < b; ++j) {
+            const int c = k + j;
+            SetBlockHouseholderVectorInternal::invoke(
+              member, m_panel, j, A + (c + 1) * as0 + c * as1, as0,
+              V + j * vs1, vs0);
+          }
+          for (int j = 0; j < b; ++j)
+            FormBlockHouseholderInternal::invoke(member, m_panel, j, V, vs0,
+                                                 vs1, t + (k + j) * ts, T, ts0,
+                                                 ts1, tw);
+
+          ApplyLeftBlockHouseholderInternal::invoke(
+            member, m_panel, n_trail, b, V, vs0, vs1, T, ts0, ts1,
+            A + k * as0 + (k + b) * as1, as0, as1, W);
+        }
+      }
+      return 0;
+    }
+  };
+
+} // namespace Tines
+
+#endif
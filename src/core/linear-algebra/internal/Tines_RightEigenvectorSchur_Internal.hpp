@@ -22,11 +22,49 @@ Sandia National Laboratories, New Mexico, USA
 #define __TINES_RIGHT_EIGENVECTOR_SCHUR_INTERNAL_HPP__
 
 /// \author Kyungjoo Kim (kyukim@sandia.gov)
+#include "Tines_Gemv_Internal.hpp"
 #include "Tines_ShiftedQuasiTrsvInternal.hpp"
 
 namespace Tines {
 
   struct RightEigenvectorSchurInternal {
+    ///
+    /// Eigenvalue lambda (positive imaginary part) and the normalized
+    /// eigenvector (Q00, Q10) of a standardized 2x2 diagonal block T11
+    ///
+    template <typename RealType>
+    KOKKOS_INLINE_FUNCTION static void
+    eigenvector2x2(const RealType *T11, const int ts0, const int ts1,
+                   Kokkos::complex<RealType> &lambda,
+                   Kokkos::complex<RealType> &Q00,
+                   Kokkos::complex<RealType> &Q10) {
+      using real_type = RealType;
+      using complex_type = Kokkos::complex<real_type>;
+      using rats = ArithTraits<real_type>;
+
+      const real_type one(1), half(0.5), zero(0);
+      const real_type a = T11[0], b = T11[ts1];
+      const real_type c = T11[ts0], d = T11[ts0 + ts1];
+      const real_type r = (a + d) * half;
+      const real_type u = (b * c - a * d);
+      const real_type v = r * r + u;
+      const real_type sqrt_v = rats::sqrt(rats::abs(v));
+
+      lambda = complex_type(r, sqrt_v);
+      if (b == zero) {
+        Q00 = b / (lambda - a);
+        Q10 = one;
+      } else {
+        Q00 = one;
+        Q10 = (lambda - a) / b;
+      }
+      const real_type norm =
+        (rats::sqrt(Q00.real() * Q00.real() + Q00.imag() * Q00.imag() +
+                    Q10.real() * Q10.real() + Q10.imag() * Q10.imag()));
+      Q00 /= norm;
+      Q10 /= norm;
+    }
+
     template <typename MemberType, typename RealType>
     KOKKOS_INLINE_FUNCTION static int
     invoke(const MemberType &member, const int m, const int *blks, const int bs,
@@ -36,10 +74,9 @@ namespace Tines {
       using real_type = RealType;
       using complex_type = Kokkos::complex<real_type>;
       using rats = ArithTraits<real_type>;
-      using cats = ArithTraits<complex_type>;
 
-      const int ts = ts0 + ts1, vs = vs0 + vs1;
-      const real_type one(1), half(0.5), zero(0);
+      const int vs = vs0 + vs1;
+      const real_type one(1), zero(0);
       int r_val = 0;
 
       Partition2x2<real_type> T_part2x2(ts0, ts1);
@@ -84,39 +121,8 @@ namespace Tines {
                                                 T00, ts0, ts1, V0, vs0);
         } else if (blk == 2) {
           /// transform 2x2 block to complex schur form
-          const real_type a = T11[0], b = T11[ts1];
-          const real_type c = T11[ts0], d = T11[ts];
-          const real_type r = (a + d) * half;
-          const real_type u = (b * c - a * d);
-          const real_type v = r * r + u;
-          const real_type sqrt_v = rats::sqrt(rats::abs(v));
-
-          const complex_type lambda(r, sqrt_v);
-          complex_type Q00, Q01, Q10, Q11;
-          if (b == zero) {
-            Q00 = b / (lambda - a);
-            Q10 = one;
-          } else {
-            Q00 = one;
-            Q10 = (lambda - a) / b;
-          }
-          {
-            const real_type norm =
-              (rats::sqrt(Q00.real() * Q00.real() + Q00.imag() * Q00.imag() +
-                          Q10.real() * Q10.real() + Q10.imag() * Q10.imag()));
-            Q00 /= norm;
-            Q10 /= norm;
-          }
-
-          Q01 = one;
-          Q11 = cats::conj(-Q00 / Q10);
-          {
-            const real_type norm =
-              (rats::sqrt(Q01.real() * Q01.real() + Q01.imag() * Q01.imag() +
-                          Q11.real() * Q10.real() + Q11.imag() * Q10.imag()));
-            Q01 /= norm;
-            Q11 /= norm;
-          }
+          complex_type lambda, Q00, Q10;
+          eigenvector2x2(T11, ts0, ts1, lambda, Q00, Q10);
 
           /// set a reduced problem
           Kokkos::parallel_for(Kokkos::TeamVectorRange(member, m_A22),
@@ -194,6 +200,89 @@ namespace Tines {
     }
   };
 
+  ///
+  /// Right eigenvectors for selected eigenvalues only; A = Z T Z^H
+  ///   [in]sel, [in]ss
+  ///     n column indices of T in the Schur form; a complex pair appears as
+  ///     two consecutive entries (j, j+1) where j is the first column of the
+  ///     2x2 block.
+  ///   [out]V, [in]vs0, [in]vs1
+  ///     V(:,i) = Z x where x solves (T - lambda I) x = 0 for the eigenvalue
+  ///     sel(i); a complex pair stores the real and imaginary parts in
+  ///     V(:,i) and V(:,i+1). Eigenvectors are not normalized.
+  ///   [in]w
+  ///     Workspace of 2m.
+  /// Only the leading k x k part of T is solved for the k-th eigenvalue and
+  /// the back transformation is a matrix vector product; the cost is
+  /// O(n m^2) instead of O(m^3).
+  ///
+  struct RightEigenvectorSchurSelectiveInternal {
+    template <typename MemberType, typename RealType>
+    KOKKOS_INLINE_FUNCTION static int
+    invoke(const MemberType &member, const int m, const int *blks, const int bs,
+           /* */ RealType *T, const int ts0, const int ts1,
+           /* */ RealType *Z, const int zs0, const int zs1, const int n,
+           const int *sel, const int ss,
+           /* */ RealType *V, const int vs0, const int vs1,
+           /* */ RealType *w) {
+      using real_type = RealType;
+      using complex_type = Kokkos::complex<real_type>;
+
+      const real_type one(1), zero(0);
+      for (int i = 0; i < n;) {
+        const int k = sel[i * ss];
+        const int tmp_blk = blks[k * bs];
+        const int blk = tmp_blk < 0 ? -tmp_blk : tmp_blk;
+
+        const real_type *T01 = T + k * ts1, *T11 = T + k * (ts0 + ts1);
+        real_type *v = V + i * vs1;
+        if (blk == 1) {
+          /// a real eigen value; x = [x0; 1]
+          Kokkos::parallel_for(Kokkos::TeamVectorRange(member, k),
+                               [&](const int &ii) { w[ii] = -T01[ii * ts0]; });
+          Kokkos::single(Kokkos::PerTeam(member), [&]() { w[k] = one; });
+          member.team_barrier();
+          const real_type lambda = *T11;
+          ShiftedQuasiTrsvInternalUpper::invoke(member, k, blks, bs, lambda, T,
+                                                ts0, ts1, w, 1);
+          member.team_barrier();
+          GemvInternal::invoke(member, m, k + 1, one, Z, zs0, zs1, w, 1, zero,
+                               v, vs0);
+        } else if (blk == 2) {
+          /// a complex pair; x = [x0; q] is stored with interleaved real and
+          /// imaginary parts
+          complex_type lambda, Q00, Q10;
+          RightEigenvectorSchurInternal::eigenvector2x2(T11, ts0, ts1, lambda,
+                                                        Q00, Q10);
+          Kokkos::parallel_for(
+            Kokkos::TeamVectorRange(member, k), [&](const int &ii) {
+              const complex_type val =
+                -(T01[ii * ts0] * Q00 + T01[ii * ts0 + ts1] * Q10);
+              w[2 * ii] = val.real();
+              w[2 * ii + 1] = val.imag();
+            });
+          Kokkos::single(Kokkos::PerTeam(member), [&]() {
+            w[2 * k] = Q00.real();
+            w[2 * k + 1] = Q00.imag();
+            w[2 * k + 2] = Q10.real();
+            w[2 * k + 3] = Q10.imag();
+          });
+          member.team_barrier();
+          ShiftedQuasiTrsvInternalUpper::invoke(member, k, blks, bs, lambda, T,
+                                                ts0, ts1, w, 2, 1);
+          member.team_barrier();
+          GemvInternal::invoke(member, m, k + 2, one, Z, zs0, zs1, w, 2, zero,
+                               v, vs0);
+          GemvInternal::invoke(member, m, k + 2, one, Z, zs0, zs1, w + 1, 2,
+                               zero, v + vs1, vs0);
+        }
+        member.team_barrier();
+        i += (blk == 2 ? 2 : 1);
+      }
+      return 0;
+    }
+  };
+
 } // namespace Tines
 
 #endif
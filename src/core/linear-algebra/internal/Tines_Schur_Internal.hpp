@@ -45,12 +45,16 @@ namespace Tines {
     ///   [in/out]Z, [in]zs0, [in]zs1
     ///     Unitary matrix resulting from Schur decomposition. With a restarting
     ///     option, the matrix may contain previous partial computation results.
+    ///     When Z is a null pointer, only eigenvalues are computed; Schur
+    ///     vectors are not accumulated and the part of H above and right of
+    ///     the active block is not updated i.e., H does not hold T on exit.
     ///   [in]user_max_iteration(30)
     ///     Unlike LAPACK which uses various methods for different types of
     ///     matrices, this routine uses the Francis method only. A user can set
     ///     the maximum number of iterations. When it reaches the maximum
     ///     iteration counts without converging all eigenvalues, the routine
-    ///     returns -1.
+    ///     returns -p where p is the size of the unconverged leading block;
+    ///     the diagonal of the block is stored in er and blks is set to 1.
     template <typename MemberType, typename RealType>
     KOKKOS_INLINE_FUNCTION static int
     invoke(const MemberType &member, const int m,
@@ -68,6 +72,7 @@ namespace Tines {
       const int max_iteration =
         user_max_iteration < 0 ? 40 : user_max_iteration;
       const int hs = hs0 + hs1; /// diagonal stride
+      const bool wantz = Z != nullptr;
 
       auto set_single_eigenvalue = [H, hs0, hs1, hs, er, ers, ei, eis, blks, bs,
                                     zero](const int pidx) {
@@ -262,14 +267,14 @@ namespace Tines {
                         rr = (k4 < p ? k4 : p);
               const int rlidx = rl - 1; /*, rridx = rr-1;*/
               {
-                const int mm = rr, nn = m - rl + 1;
+                const int mm = rr, nn = (wantz ? m : p) - rl + 1;
                 real_type *hl = &H[k * hs0 + rlidx * hs1];
                 real_type *hr = &H[k * hs1];
                 ApplyLeftRightHouseholderReflectorInternal::invoke(
                   member, 3, reflector, mm, nn, hl, hr, hs0, hs1);
                 member.team_barrier();
               }
-              {
+              if (wantz) {
                 const int mm = m;
                 real_type *zr = &Z[k * zs1];
                 ApplyRightHouseholderReflectorInternal::invoke(
@@ -293,14 +298,14 @@ namespace Tines {
               FormHouseholderReflectorInternal::invoke(y, tau, reflector);
 
               {
-                const int mm = p, nn = m - p + 3;
+                const int mm = p, nn = (wantz ? m : p) - p + 3;
                 ApplyLeftRightHouseholderReflectorInternal::invoke(
                   member, 2, reflector, mm, nn,
                   H + qidx * hs0 + (pidx - 2) * hs1, H + (pidx - 1) * hs1, hs0,
                   hs1);
                 member.team_barrier();
               }
-              {
+              if (wantz) {
                 const int mm = m;
                 ApplyRightHouseholderReflectorInternal::invoke(
                   member, 2, reflector, mm, Z + (pidx - 1) * zs1, zs0, zs1);
@@ -331,6 +336,16 @@ namespace Tines {
             }
           });
         } else {
+          /// the leading block 0:p-1 does not converge; its diagonal is
+          /// reported as real eigenvalues so that the block structure is
+          /// still valid for the following eigenvector computation
+          Kokkos::parallel_for(Kokkos::TeamVectorRange(member, p),
+                               [=](const int &i) {
+                                 er[i * ers] = H[i * hs];
+                                 ei[i * eis] = zero;
+                                 blks[i * bs] = 1;
+                               });
+          member.team_barrier();
           r_val = -p;
         }
 
@@ -391,7 +406,7 @@ namespace Tines {
                   member.team_barrier();
                 }
                 /// Z = Z Q
-                {
+                if (wantz) {
                   const int mm = m;
                   Kokkos::parallel_for(
                     Kokkos::ThreadVectorRange(member, mm), [=](const int &i) {
@@ -0,0 +1,1374 @@
+/*----------------------------------------------------------------------------------
+Tines - Time Integrator, Newton and Eigen Solver -  version 1.0
+Copyright (2021) NTESS
+https://github.com/sandialabs/Tines
+
+Copyright 2021 National Technology & Engineering Solutions of Sandia, LLC (NTESS). 
+Under the terms of Contract DE-NA0003525 with NTESS, the U.S. Government retains 
+certain rights in this software.
+
+This file is part of Tines. Tines is open-source software: you can redistribute it
+and/or modify it under the terms of BSD 2-Clause License
+(https://opensource.org/licenses/BSD-2-Clause). A copy of the license is also
+provided under the main directory
+Questions? Kyungjoo Kim <kyukim@sandia.gov>, or
+	   Oscar Diaz-Ibarra at <odiazib@sandia.gov>, or
+	   Cosmin Safta at <csafta@sandia.gov>, or
+	   Habib Najm at <hnnajm@sandia.gov>
+
+Sandia National Laboratories, New Mexico, USA
+----------------------------------------------------------------------------------*/
+#ifndef __TINES_SCHUR_MULTISHIFT_INTERNAL_HPP__
+#define __TINES_SCHUR_MULTISHIFT_INTERNAL_HPP__
+
+#include "Tines_Copy_Internal.hpp"
+#include "Tines_Gemm_Internal.hpp"
+#include "Tines_Householder_Internal.hpp"
+#include "Tines_Schur_Internal.hpp"
+
+/// matrices larger than this use the multishift QR with aggressive early
+/// deflation; active blocks smaller than this are finished by the double
+/// shift QR on the window
+#if !defined(TINES_SCHUR_MULTISHIFT_MIN_SIZE)
+#define TINES_SCHUR_MULTISHIFT_MIN_SIZE 60
+#endif
+
+namespace Tines {
+
+  ///
+  /// Schur factorization of a real 2x2 nonsymmetric matrix in the standard
+  /// form (LAPACK dlanv2)
+  ///   [a b; c d] = [cs -sn; sn cs] [aa bb; cc dd] [cs sn; -sn cs]
+  /// where either cc = 0 (real eigenvalues) or aa = dd and bb cc < 0
+  /// (complex conjugate eigenvalues). The matrix is overwritten by the
+  /// standardized block.
+  ///
+  struct StandardizeSchur2x2Internal {
+    template <typename RealType>
+    KOKKOS_INLINE_FUNCTION static int
+    invoke(RealType &a, RealType &b, RealType &c, RealType &d, RealType &rt1r,
+           RealType &rt1i, RealType &rt2r, RealType &rt2i, RealType &cs,
+           RealType &sn) {
+      using real_type = RealType;
+      using ats = ArithTraits<real_type>;
+
+      const real_type zero(0), half(0.5), one(1), multpl(4);
+      const real_type eps = ats::epsilon();
+
+      auto sign = [](const real_type x) {
+        return x >= real_type(0) ? real_type(1) : real_type(-1);
+      };
+      auto pythag = [](const real_type x, const real_type y) {
+        const real_type xa = ats::abs(x), ya = ats::abs(y);
+        const real_type w = xa > ya ? xa : ya, z = xa > ya ? ya : xa;
+        return z == real_type(0) ? w
+                                 : w * ats::sqrt(real_type(1) + (z / w) * (z / w));
+      };
+
+      if (c == zero) {
+        cs = one;
+        sn = zero;
+      } else if (b == zero) {
+        /// swap rows and columns
+        cs = zero;
+        sn = one;
+        const real_type tmp = d;
+        d = a;
+        a = tmp;
+        b = -c;
+        c = zero;
+      } else if ((a - d) == zero && sign(b) != sign(c)) {
+        /// already standardized
+        cs = one;
+        sn = zero;
+      } else {
+        const real_type temp = a - d;
+        real_type p = half * temp;
+        const real_type abs_b = ats::abs(b), abs_c = ats::abs(c);
+        const real_type bcmax = abs_b > abs_c ? abs_b : abs_c;
+        const real_type bcmis =
+          (abs_b > abs_c ? abs_c : abs_b) * sign(b) * sign(c);
+        const real_type abs_p = ats::abs(p);
+        const real_type scale = abs_p > bcmax ? abs_p : bcmax;
+        real_type z = (p / scale) * p + (bcmax / scale) * bcmis;
+        if (z >= multpl * eps) {
+          /// real eigenvalues; compute a and d
+          z = p + sign(p) * ats::sqrt(scale) * ats::sqrt(z);
+          a = d + z;
+          d = d - (bcmax / z) * bcmis;
+          const real_type tau = pythag(c, z);
+          cs = z / tau;
+          sn = c / tau;
+          b = b - c;
+          c = zero;
+        } else {
+          /// complex eigenvalues or real (almost) equal eigenvalues; make
+          /// diagonal elements equal
+          const real_type sigma = b + c;
+          const real_type tau = pythag(sigma, temp);
+          cs = ats::sqrt(half * (one + ats::abs(sigma) / tau));
+          sn = -(p / (tau * cs)) * sign(sigma);
+
+          const real_type aa = a * cs + b * sn, bb = -a * sn + b * cs,
+                          cc = c * cs + d * sn, dd = -c * sn + d * cs;
+          a = aa * cs + cc * sn;
+          b = bb * cs + dd * sn;
+          c = -aa * sn + cc * cs;
+          d = -bb * sn + dd * cs;
+
+          const real_type tmp = half * (a + d);
+          a = tmp;
+          d = tmp;
+          if (c != zero) {
+            if (b != zero) {
+              if (sign(b) == sign(c)) {
+                /// real eigenvalues; reduce to upper triangular
+                const real_type sab = ats::sqrt(ats::abs(b)),
+                                sac = ats::sqrt(ats::abs(c));
+                p = sign(c) * sab * sac;
+                const real_type tau1 = one / ats::sqrt(ats::abs(b + c));
+                a = tmp + p;
+                d = tmp - p;
+                b = b - c;
+                c = zero;
+                const real_type cs1 = sab * tau1, sn1 = sac * tau1;
+                const real_type cs_new = cs * cs1 - sn * sn1;
+                sn = cs * sn1 + sn * cs1;
+                cs = cs_new;
+              }
+            } else {
+              b = -c;
+              c = zero;
+              const real_type cs_new = -sn;
+              sn = cs;
+              cs = cs_new;
+            }
+          }
+        }
+      }
+
+      rt1r = a;
+      rt2r = d;
+      if (c == zero) {
+        rt1i = zero;
+        rt2i = zero;
+      } else {
+        rt1i = ats::sqrt(ats::abs(b)) * ats::sqrt(ats::abs(c));
+        rt2i = -rt1i;
+      }
+      return 0;
+    }
+  };
+
+  ///
+  /// Serial building blocks used in the deflation window
+  ///
+  struct SchurSerialHelperInternal {
+    /// [x y] = [x y] [cs -sn; sn cs] i.e., x = cs x + sn y, y = cs y - sn x
+    template <typename RealType>
+    KOKKOS_INLINE_FUNCTION static void
+    rotate(const int n, RealType *x, const int xs, RealType *y, const int ys,
+           const RealType cs, const RealType sn) {
+      for (int i = 0; i < n; ++i) {
+        const RealType tx = x[i * xs], ty = y[i * ys];
+        x[i * xs] = cs * tx + sn * ty;
+        y[i * ys] = cs * ty - sn * tx;
+      }
+    }
+
+    /// A = (I - u u^H/tau) A, u = [1; u2], A is (m x n)
+    template <typename RealType>
+    KOKKOS_INLINE_FUNCTION static void
+    applyLeft(const int m, const RealType *u2, const int us, const RealType tau,
+              const int n, RealType *A, const int as0, const int as1) {
+      const RealType inv_tau = RealType(1) / tau;
+      for (int j = 0; j < n; ++j) {
+        RealType *a = A + j * as1;
+        RealType s = a[0];
+        for (int i = 1; i < m; ++i)
+          s += u2[(i - 1) * us] * a[i * as0];
+        s *= inv_tau;
+        a[0] -= s;
+        for (int i = 1; i < m; ++i)
+          a[i * as0] -= u2[(i - 1) * us] * s;
+      }
+    }
+
+    /// A = A (I - u u^H/tau), u = [1; u2], A is (m x n)
+    template <typename RealType>
+    KOKKOS_INLINE_FUNCTION static void
+    applyRight(const int m, const int n, const RealType *u2, const int us,
+               const RealType tau, RealType *A, const int as0,
+               const int as1) {
+      const RealType inv_tau = RealType(1) / tau;
+      for (int i = 0; i < m; ++i) {
+        RealType *a = A + i * as0;
+        RealType s = a[0];
+        for (int j = 1; j < n; ++j)
+          s += a[j * as1] * u2[(j - 1) * us];
+        s *= inv_tau;
+        a[0] -= s;
+        for (int j = 1; j < n; ++j)
+          a[j * as1] -= s * u2[(j - 1) * us];
+      }
+    }
+
+    /// standardize the 2x2 diagonal block at k of the n x n quasi triangular
+    /// matrix T and accumulate the rotation into the columns of V (nv rows)
+    template <typename RealType>
+    KOKKOS_INLINE_FUNCTION static void
+    standardize(const int n, const int k, RealType *T, const int ts0,
+                const int ts1, RealType *V, const int vs0, const int vs1,
+                const int nv, RealType &rt1r, RealType &rt1i, RealType &rt2r,
+                RealType &rt2i) {
+      RealType cs, sn;
+      RealType *t = T + k * (ts0 + ts1);
+      StandardizeSchur2x2Internal::invoke(t[0], t[ts1], t[ts0], t[ts0 + ts1],
+                                          rt1r, rt1i, rt2r, rt2i, cs, sn);
+      if (k + 2 < n)
+        rotate(n - k - 2, t + 2 * ts1, ts1, t + ts0 + 2 * ts1, ts1, cs, sn);
+      rotate(k, T + k * ts1, ts0, T + (k + 1) * ts1, ts0, cs, sn);
+      rotate(nv, V + k * vs1, vs0, V + (k + 1) * vs1, vs0, cs, sn);
+    }
+  };
+
+  ///
+  /// Double shift QR on the active window [ilo, ihi] of an n x n Hessenberg
+  /// matrix H (LAPACK dlahqr with wantt and wantz). Transformations are
+  /// applied to the full rows and columns of H and accumulated into the
+  /// columns of Z (nz rows). Diagonal 2x2 blocks are standardized on exit so
+  /// that complex conjugate pairs are the only remaining 2x2 blocks.
+  /// This is a serial routine and returns i+1 when the i-th eigenvalue does
+  /// not converge.
+  ///
+  struct SchurWindowInternal {
+    template <typename RealType>
+    KOKKOS_INLINE_FUNCTION static int
+    invoke(const int n, const int ilo, const int ihi,
+           /* */ RealType *H, const int hs0, const int hs1,
+           /* */ RealType *Z, const int zs0, const int zs1, const int nz,
+           /* */ RealType *wr, const int wrs,
+           /* */ RealType *wi, const int wis) {
+      using real_type = RealType;
+      using ats = ArithTraits<real_type>;
+
+      const real_type zero(0), one(1), half(0.5);
+      const real_type dat1(0.75), dat2(-0.4375);
+      const int kexsh = 10;
+
+      if (ilo > ihi)
+        return 0;
+
+      auto h = [H, hs0, hs1](const int i, const int j) -> real_type & {
+        return H[i * hs0 + j * hs1];
+      };
+      auto max = [](const real_type a, const real_type b) {
+        return a > b ? a : b;
+      };
+      auto min = [](const real_type a, const real_type b) {
+        return a > b ? b : a;
+      };
+
+      if (ilo == ihi) {
+        wr[ilo * wrs] = h(ilo, ilo);
+        wi[ilo * wis] = zero;
+        return 0;
+      }
+
+      /// clear out the trash
+      for (int j = ilo; j < ihi - 2; ++j) {
+        h(j + 2, j) = zero;
+        h(j + 3, j) = zero;
+      }
+      if (ilo <= ihi - 2)
+        h(ihi, ihi - 2) = zero;
+
+      const int nh = ihi - ilo + 1;
+      const real_type safmin = ats::sfmin(), ulp = ats::epsilon();
+      const real_type smlnum = safmin * (real_type(nh) / ulp);
+
+      /// full Schur form is computed
+      const int i1 = 0, i2 = n - 1;
+      const int itmax = 30 * (nh > 10 ? nh : 10);
+
+      int kdefl(0);
+      for (int i = ihi; i >= ilo;) {
+        int l = ilo;
+        bool converged = false;
+        for (int its = 0; its <= itmax; ++its) {
+          /// look for a single small subdiagonal element
+          int k = i;
+          for (; k > l; --k) {
+            const real_type hkk1 = ats::abs(h(k, k - 1));
+            if (hkk1 <= smlnum)
+              break;
+            real_type tst = ats::abs(h(k - 1, k - 1)) + ats::abs(h(k, k));
+            if (tst == zero) {
+              if (k - 2 >= ilo)
+                tst += ats::abs(h(k - 1, k - 2));
+              if (k + 1 <= ihi)
+                tst += ats::abs(h(k + 1, k));
+            }
+            /// conservative small subdiagonal deflation criterion
+            /// (Ahues & Tisseur)
+            if (hkk1 <= ulp * tst) {
+              const real_type hk1k = ats::abs(h(k - 1, k));
+              const real_type ab = max(hkk1, hk1k), ba = min(hkk1, hk1k);
+              const real_type hkk = ats::abs(h(k, k)),
+                              hdiff = ats::abs(h(k - 1, k - 1) - h(k, k));
+              const real_type aa = max(hkk, hdiff), bb = min(hkk, hdiff);
+              const real_type s = aa + ab;
+              if (ba * (ab / s) <= max(smlnum, ulp * (bb * (aa / s))))
+                break;
+            }
+          }
+          l = k;
+          if (l > ilo)
+            h(l, l - 1) = zero;
+
+          /// a single eigenvalue or a 2x2 block has split off
+          if (l >= i - 1) {
+            converged = true;
+            break;
+          }
+          ++kdefl;
+
+          /// shifts
+          real_type h11, h12, h21, h22;
+          if (kdefl % (2 * kexsh) == 0) {
+            /// exceptional shift
+            const real_type s =
+              ats::abs(h(i, i - 1)) + ats::abs(h(i - 1, i - 2));
+            h11 = dat1 * s + h(i, i);
+            h12 = dat2 * s;
+            h21 = s;
+            h22 = h11;
+          } else if (kdefl % kexsh == 0) {
+            /// exceptional shift
+            const real_type s =
+              ats::abs(h(l + 1, l)) + ats::abs(h(l + 2, l + 1));
+            h11 = dat1 * s + h(l, l);
+            h12 = dat2 * s;
+            h21 = s;
+            h22 = h11;
+          } else {
+            /// Wilkinson's double shift
+            h11 = h(i - 1, i - 1);
+            h21 = h(i, i - 1);
+            h12 = h(i - 1, i);
+            h22 = h(i, i);
+          }
+          real_type rt1r(0), rt1i(0), rt2r(0), rt2i(0);
+          {
+            const real_type s = ats::abs(h11) + ats::abs(h12) +
+                                ats::abs(h21) + ats::abs(h22);
+            if (s != zero) {
+              h11 /= s;
+              h21 /= s;
+              h12 /= s;
+              h22 /= s;
+              const real_type tr = (h11 + h22) * half;
+              const real_type det =
+                (h11 - tr) * (h22 - tr) - h12 * h21;
+              const real_type rtdisc = ats::sqrt(ats::abs(det));
+              if (det >= zero) {
+                /// complex conjugate shifts
+                rt1r = tr * s;
+                rt2r = rt1r;
+                rt1i = rtdisc * s;
+                rt2i = -rt1i;
+              } else {
+                /// real shifts; use only the one closer to h22
+                rt1r = tr + rtdisc;
+                rt2r = tr - rtdisc;
+                if (ats::abs(rt1r - h22) <= ats::abs(rt2r - h22)) {
+                  rt1r *= s;
+                  rt2r = rt1r;
+                } else {
+                  rt2r *= s;
+                  rt1r = rt2r;
+                }
+                rt1i = zero;
+                rt2i = zero;
+              }
+            }
+          }
+
+          /// look for two consecutive small subdiagonal elements
+          real_type v[3] = {};
+          int mm = i - 2;
+          for (; mm >= l; --mm) {
+            real_type h21s = h(mm + 1, mm);
+            real_type s =
+              ats::abs(h(mm, mm) - rt2r) + ats::abs(rt2i) + ats::abs(h21s);
+            h21s = h(mm + 1, mm) / s;
+            v[0] = h21s * h(mm, mm + 1) +
+                   (h(mm, mm) - rt1r) * ((h(mm, mm) - rt2r) / s) -
+                   rt1i * (rt2i / s);
+            v[1] = h21s * (h(mm, mm) + h(mm + 1, mm + 1) - rt1r - rt2r);
+            v[2] = h21s * h(mm + 2, mm + 1);
+            s = ats::abs(v[0]) + ats::abs(v[1]) + ats::abs(v[2]);
+            v[0] /= s;
+            v[1] /= s;
+            v[2] /= s;
+            if (mm == l)
+              break;
+            const real_type h00 =
+              ats::abs(h(mm, mm - 1)) * (ats::abs(v[1]) + ats::abs(v[2]));
+            const real_type h01 =
+              ulp * ats::abs(v[0]) *
+              (ats::abs(h(mm - 1, mm - 1)) + ats::abs(h(mm, mm)) +
+               ats::abs(h(mm + 1, mm + 1)));
+            if (h00 <= h01)
+              break;
+          }
+
+          /// double shift QR sweep
+          for (int k = mm; k < i; ++k) {
+            const int nr = (i - k + 1) < 3 ? (i - k + 1) : 3;
+            if (k > mm) {
+              v[0] = h(k, k - 1);
+              v[1] = h(k + 1, k - 1);
+              if (nr == 3)
+                v[2] = h(k + 2, k - 1);
+            }
+            real_type tau;
+            if (nr == 3)
+              LeftHouseholderInternal::invoke(&v[0], &v[1], &v[2], &tau);
+            else
+              LeftHouseholderInternal::invoke(&v[0], &v[1], &tau);
+            const real_type t1 = one / tau;
+            if (k > mm) {
+              h(k, k - 1) = v[0];
+              h(k + 1, k - 1) = zero;
+              if (k < i - 1)
+                h(k + 2, k - 1) = zero;
+            } else if (mm > l) {
+              h(k, k - 1) *= (one - t1);
+            }
+            const real_type v2 = v[1], t2 = t1 * v2;
+            if (nr == 3) {
+              const real_type v3 = v[2], t3 = t1 * v3;
+              for (int j = k; j <= i2; ++j) {
+                const real_type sum =
+                  h(k, j) + v2 * h(k + 1, j) + v3 * h(k + 2, j);
+                h(k, j) -= sum * t1;
+                h(k + 1, j) -= sum * t2;
+                h(k + 2, j) -= sum * t3;
+              }
+              const int jend = (k + 3) < i ? (k + 3) : i;
+              for (int j = i1; j <= jend; ++j) {
+                const real_type sum =
+                  h(j, k) + v2 * h(j, k + 1) + v3 * h(j, k + 2);
+                h(j, k) -= sum * t1;
+                h(j, k + 1) -= sum * t2;
+                h(j, k + 2) -= sum * t3;
+              }
+              for (int j = 0; j < nz; ++j) {
+                real_type *z = Z + j * zs0 + k * zs1;
+                const real_type sum = z[0] + v2 * z[zs1] + v3 * z[2 * zs1];
+                z[0] -= sum * t1;
+                z[zs1] -= sum * t2;
+                z[2 * zs1] -= sum * t3;
+              }
+            } else {
+              for (int j = k; j <= i2; ++j) {
+                const real_type sum = h(k, j) + v2 * h(k + 1, j);
+                h(k, j) -= sum * t1;
+                h(k + 1, j) -= sum * t2;
+              }
+              for (int j = i1; j <= i; ++j) {
+                const real_type sum = h(j, k) + v2 * h(j, k + 1);
+                h(j, k) -= sum * t1;
+                h(j, k + 1) -= sum * t2;
+              }
+              for (int j = 0; j < nz; ++j) {
+                real_type *z = Z + j * zs0 + k * zs1;
+                const real_type sum = z[0] + v2 * z[zs1];
+                z[0] -= sum * t1;
+                z[zs1] -= sum * t2;
+              }
+            }
+          }
+        }
+
+        if (!converged)
+          return i + 1;
+
+        if (l == i) {
+          /// a single eigenvalue has converged
+          wr[i * wrs] = h(i, i);
+          wi[i * wis] = zero;
+        } else {
+          /// a pair of eigenvalues has converged; standardize the block
+          SchurSerialHelperInternal::standardize(
+            n, i - 1, H, hs0, hs1, Z, zs0, zs1, nz, wr[(i - 1) * wrs],
+            wi[(i - 1) * wis], wr[i * wrs], wi[i * wis]);
+        }
+        kdefl = 0;
+        i = l - 1;
+      }
+      return 0;
+    }
+  };
+
+  ///
+  /// Swap adjacent diagonal blocks T11 (n1 x n1) and T22 (n2 x n2) at j1 of
+  /// an n x n matrix in the standardized Schur form (LAPACK dlaexc). The
+  /// swap is computed from the invariant subspace [-X; I] where X solves
+  /// T11 X - X T22 = T12; its orthogonal basis brings T22 to the top. The
+  /// swap is rejected (return 1) when it would perturb T by more than a few
+  /// ulps; otherwise T and the columns of V (nv rows) are updated.
+  ///
+  struct SchurSwapInternal {
+    template <typename RealType>
+    KOKKOS_INLINE_FUNCTION static int
+    invoke(const int n, const int j1, const int n1, const int n2,
+           /* */ RealType *T, const int ts0, const int ts1,
+           /* */ RealType *V, const int vs0, const int vs1, const int nv) {
+      using real_type = RealType;
+      using ats = ArithTraits<real_type>;
+
+      const real_type zero(0), one(1);
+      const real_type eps = ats::epsilon(), smlnum = ats::sfmin() / eps;
+      const int nd = n1 + n2;
+
+      auto t = [T, ts0, ts1](const int i, const int j) -> real_type & {
+        return T[i * ts0 + j * ts1];
+      };
+
+      /// local copy of the diagonal block to test the swap
+      real_type D[4][4], dnorm(0);
+      for (int i = 0; i < nd; ++i)
+        for (int j = 0; j < nd; ++j) {
+          D[i][j] = t(j1 + i, j1 + j);
+          const real_type val = ats::abs(D[i][j]);
+          dnorm = dnorm > val ? dnorm : val;
+        }
+      const real_type thres =
+        (10 * eps * dnorm) > smlnum ? (10 * eps * dnorm) : smlnum;
+
+      /// solve the sylvester equation T11 X - X T22 = T12 with complete
+      /// pivoting; x(i,j) is stored at i + j*n1
+      real_type X[4];
+      {
+        const int nk = n1 * n2;
+        real_type K[4][4], rhs[4];
+        int jpiv[4];
+        real_type kmax(0);
+        for (int r = 0; r < nk; ++r) {
+          for (int c = 0; c < nk; ++c)
+            K[r][c] = zero;
+          jpiv[r] = r;
+        }
+        for (int j = 0; j < n2; ++j)
+          for (int i = 0; i < n1; ++i) {
+            const int r = i + j * n1;
+            for (int k = 0; k < n1; ++k)
+              K[r][k + j * n1] += D[i][k];
+            for (int l = 0; l < n2; ++l)
+              K[r][i + l * n1] -= D[n1 + l][n1 + j];
+            rhs[r] = D[i][n1 + j];
+          }
+        for (int r = 0; r < nk; ++r)
+          for (int c = 0; c < nk; ++c) {
+            const real_type val = ats::abs(K[r][c]);
+            kmax = kmax > val ? kmax : val;
+          }
+        const real_type smin =
+          (eps * kmax) > smlnum ? (eps * kmax) : smlnum;
+
+        for (int p = 0; p < nk; ++p) {
+          /// complete pivoting
+          int ip(p), jp(p);
+          real_type amax(-1);
+          for (int r = p; r < nk; ++r)
+            for (int c = p; c < nk; ++c) {
+              const real_type val = ats::abs(K[r][c]);
+              if (val > amax) {
+                amax = val;
+                ip = r;
+                jp = c;
+              }
+            }
+          if (ip != p) {
+            for (int c = 0; c < nk; ++c) {
+              const real_type tmp = K[p][c];
+              K[p][c] = K[ip][c];
+              K[ip][c] = tmp;
+            }
+            const real_type tmp = rhs[p];
+            rhs[p] = rhs[ip];
+            rhs[ip] = tmp;
+          }
+          if (jp != p) {
+            for (int r = 0; r < nk; ++r) {
+              const real_type tmp = K[r][p];
+              K[r][p] = K[r][jp];
+              K[r][jp] = tmp;
+            }
+            const int itmp = jpiv[p];
+            jpiv[p] = jpiv[jp];
+            jpiv[jp] = itmp;
+          }
+          /// perturb a tiny pivot as dlasy2 does
+          if (ats::abs(K[p][p]) < smin)
+            K[p][p] = smin;
+          for (int r = p + 1; r < nk; ++r) {
+            const real_type f = K[r][p] / K[p][p];
+            for (int c = p + 1; c < nk; ++c)
+              K[r][c] -= f * K[p][c];
+            rhs[r] -= f * rhs[p];
+          }
+        }
+        real_type y[4];
+        for (int p = nk - 1; p >= 0; --p) {
+          real_type val = rhs[p];
+          for (int c = p + 1; c < nk; ++c)
+            val -= K[p][c] * y[c];
+          y[p] = val / K[p][p];
+        }
+        for (int p = 0; p < nk; ++p)
+          X[jpiv[p]] = y[p];
+      }
+
+      /// householder QR of M = [-X; I] (nd x n2); u of the c-th reflector
+      /// is stored as [1; U[c][0:nd-c-1]]
+      real_type M[4][2], U[2][3], tau[2];
+      for (int j = 0; j < n2; ++j) {
+        for (int i = 0; i < n1; ++i)
+          M[i][j] = -X[i + j * n1];
+        for (int l = 0; l < n2; ++l)
+          M[n1 + l][j] = (l == j ? one : zero);
+      }
+      for (int c = 0; c < n2; ++c) {
+        const int len = nd - c;
+        real_type chi1 = M[c][c], x2[3];
+        for (int i = 1; i < len; ++i)
+          x2[i - 1] = M[c + i][c];
+        LeftHouseholderInternal::invoke(len - 1, &chi1, x2, 1, &tau[c]);
+        for (int i = 1; i < len; ++i)
+          U[c][i - 1] = x2[i - 1];
+        if (c + 1 < n2) {
+          /// apply to the remaining column
+          real_type s = M[c][c + 1];
+          for (int i = 1; i < len; ++i)
+            s += U[c][i - 1] * M[c + i][c + 1];
+          s /= tau[c];
+          M[c][c + 1] -= s;
+          for (int i = 1; i < len; ++i)
+            M[c + i][c + 1] -= U[c][i - 1] * s;
+        }
+      }
+
+      /// test the swap on the local copy
+      for (int c = 0; c < n2; ++c) {
+        const int len = nd - c;
+        SchurSerialHelperInternal::applyLeft(len, U[c], 1, tau[c], nd, &D[c][0],
+                                             4, 1);
+        SchurSerialHelperInternal::applyRight(nd, len, U[c], 1, tau[c],
+                                              &D[0][c], 4, 1);
+      }
+      for (int i = n2; i < nd; ++i)
+        for (int j = 0; j < n2; ++j)
+          if (ats::abs(D[i][j]) > thres)
+            return 1;
+
+      /// accept the swap
+      for (int c = 0; c < n2; ++c) {
+        const int len = nd - c, jc = j1 + c;
+        SchurSerialHelperInternal::applyLeft(len, U[c], 1, tau[c], n - j1,
+                                             &t(jc, j1), ts0, ts1);
+        SchurSerialHelperInternal::applyRight(j1 + nd, len, U[c], 1, tau[c],
+                                              &t(0, jc), ts0, ts1);
+        SchurSerialHelperInternal::applyRight(nv, len, U[c], 1, tau[c],
+                                              V + jc * vs1, vs0, vs1);
+      }
+      for (int i = n2; i < nd; ++i)
+        for (int j = 0; j < n2; ++j)
+          t(j1 + i, j1 + j) = zero;
+
+      /// standardize the swapped blocks
+      real_type rt1r, rt1i, rt2r, rt2i;
+      if (n2 == 2)
+        SchurSerialHelperInternal::standardize(n, j1, T, ts0, ts1, V, vs0, vs1,
+                                               nv, rt1r, rt1i, rt2r, rt2i);
+      if (n1 == 2)
+        SchurSerialHelperInternal::standardize(n, j1 + n2, T, ts0, ts1, V, vs0,
+                                               vs1, nv, rt1r, rt1i, rt2r, rt2i);
+      return 0;
+    }
+  };
+
+  ///
+  /// Multishift QR with aggressive early deflation (Braman, Byers and
+  /// Mathias; LAPACK dlaqr0, dlaqr3 and dlaqr5). Each iteration
+  ///   1) looks for a deflation in the trailing nw x nw window of the active
+  ///      block; the window is reduced to the Schur form and its eigenvalues
+  ///      are deflated when the spike from the subdiagonal is negligible. The
+  ///      window transformation is applied to the rest of H and Z with Gemm.
+  ///   2) uses the undeflatable eigenvalues of the window as shifts and
+  ///      chases a chain of tightly packed 3x3 bulges through the active
+  ///      block. All bulges in the chain advance one column per step and a
+  ///      step costs three team barriers regardless of the number of shifts.
+  /// Active blocks smaller than TINES_SCHUR_MULTISHIFT_MIN_SIZE are finished
+  /// by the double shift QR on the window. The interface and the output
+  /// follow SchurInternal except that the workspace is required; a null Z
+  /// skips the accumulation of Schur vectors.
+  ///
+  struct SchurMultiShiftInternal {
+    /// number of shifts and the deflation window size (LAPACK iparmq)
+    KOKKOS_INLINE_FUNCTION static void getParameters(const int nh, int &ns,
+                                                     int &nw) {
+      if (nh < 30) {
+        ns = 2;
+      } else if (nh < 60) {
+        ns = 4;
+      } else if (nh < 150) {
+        ns = 10;
+      } else if (nh < 590) {
+        /// nh / nint(log2(nh))
+        int lg(0);
+        for (int v = nh; v > 1; v >>= 1)
+          ++lg;
+        if (nh * nh >= 2 * (1 << (2 * lg)))
+          ++lg;
+        ns = nh / lg;
+        ns = ns < 10 ? 10 : ns;
+      } else if (nh < 3000) {
+        ns = 64;
+      } else if (nh < 6000) {
+        ns = 128;
+      } else {
+        ns = 256;
+      }
+      ns -= ns % 2;
+      ns = ns < 2 ? 2 : ns;
+      nw = nh <= 500 ? ns : (3 * ns) / 2;
+    }
+
+    KOKKOS_INLINE_FUNCTION static int workspace(const int m, int &wlen) {
+      int ns, nw;
+      getParameters(m, ns, nw);
+      /// T, V, window eigenvalues, shifts, bulge reflectors, gemm buffer and
+      /// a few integers stored in real slots
+      wlen = 2 * nw * nw + 2 * nw + 2 * ns + 4 * (ns / 2) + m * nw + 4;
+      return 0;
+    }
+
+    ///
+    /// Aggressive early deflation on the trailing window of [ktop, kbot].
+    /// On exit, iw[0] is the number of undeflated eigenvalues of the window
+    /// (shifts in sr, si), iw[1] is the number of deflated eigenvalues.
+    ///
+    template <typename MemberType, typename RealType>
+    KOKKOS_INLINE_FUNCTION static int
+    aggressiveEarlyDeflation(const MemberType &member, const int m,
+                             const int ktop, const int kbot, const int nw,
+                             /* */ RealType *H, const int hs0, const int hs1,
+                             /* */ RealType *Z, const int zs0, const int zs1,
+                             /* */ RealType *T, RealType *V, RealType *sr,
+                             RealType *si, RealType *work, int *iw) {
+      using real_type = RealType;
+      using ats = ArithTraits<real_type>;
+
+      const real_type zero(0), one(1);
+      const int jw = (nw < (kbot - ktop + 1)) ? nw : (kbot - ktop + 1);
+      const int kwtop = kbot - jw + 1;
+      const int ts0 = jw, ts1 = 1, vs0 = jw, vs1 = 1;
+
+      Kokkos::single(Kokkos::PerTeam(member), [=]() {
+        const real_type ulp = ats::epsilon(),
+                        smlnum = ats::sfmin() * (real_type(m) / ulp);
+        auto h = [H, hs0, hs1](const int i, const int j) -> real_type & {
+          return H[i * hs0 + j * hs1];
+        };
+        auto t = [T, ts0, ts1](const int i, const int j) -> real_type & {
+          return T[i * ts0 + j * ts1];
+        };
+        auto max = [](const real_type a, const real_type b) {
+          return a > b ? a : b;
+        };
+
+        real_type s = kwtop == ktop ? zero : h(kwtop, kwtop - 1);
+
+        if (jw == 1) {
+          /// 1x1 deflation window
+          sr[0] = h(kwtop, kwtop);
+          si[0] = zero;
+          iw[0] = 1;
+          iw[1] = 0;
+          iw[2] = 0;
+          if (ats::abs(s) <= max(smlnum, ulp * ats::abs(h(kwtop, kwtop)))) {
+            iw[0] = 0;
+            iw[1] = 1;
+            if (kwtop > ktop)
+              h(kwtop, kwtop - 1) = zero;
+          }
+          return;
+        }
+
+        /// T = H(window), V = I
+        for (int i = 0; i < jw; ++i)
+          for (int j = 0; j < jw; ++j) {
+            t(i, j) = (i <= j + 1) ? h(kwtop + i, kwtop + j) : zero;
+            V[i * vs0 + j * vs1] = (i == j) ? one : zero;
+          }
+
+        /// schur form of the window
+        const int info = SchurWindowInternal::invoke(
+          jw, 0, jw - 1, T, ts0, ts1, V, vs0, vs1, jw, sr, 1, si, 1);
+        if (info) {
+          /// the window does not converge; no deflation and the diagonal of
+          /// H is a poor but valid set of shifts
+          for (int i = 0; i < jw; ++i) {
+            sr[i] = h(kwtop + i, kwtop + i);
+            si[i] = zero;
+          }
+          iw[0] = jw;
+          iw[1] = 0;
+          iw[2] = 0;
+          return;
+        }
+
+        /// deflation detection; undeflatable blocks are moved to the top
+        int ns = jw, ilst = 0;
+        while (ilst < ns) {
+          const bool is_2x2 = ns >= 2 && (ns - 2) >= ilst &&
+                              t(ns - 1, ns - 2) != zero;
+          const int nb = is_2x2 ? 2 : 1, ifst = ns - nb;
+          real_type foo, spike;
+          if (is_2x2) {
+            foo = ats::abs(t(ns - 1, ns - 1)) +
+                  ats::sqrt(ats::abs(t(ns - 1, ns - 2))) *
+                    ats::sqrt(ats::abs(t(ns - 2, ns - 1)));
+            spike = max(ats::abs(s * V[ns - 1]), ats::abs(s * V[ns - 2]));
+          } else {
+            foo = ats::abs(t(ns - 1, ns - 1));
+            spike = ats::abs(s * V[ns - 1]);
+          }
+          if (foo == zero)
+            foo = ats::abs(s);
+          if (spike <= max(smlnum, ulp * foo)) {
+            /// deflatable
+            ns -= nb;
+          } else {
+            /// undeflatable; move the block up to ilst
+            int here = ifst, nbf = nb;
+            bool moved = true;
+            while (here > ilst) {
+              const int nbnext =
+                (here - 2 >= ilst && t(here - 1, here - 2) != zero) ? 2 : 1;
+              if (SchurSwapInternal::invoke(jw, here - nbnext, nbnext, nbf, T,
+                                            ts0, ts1, V, vs0, vs1, jw)) {
+                moved = false;
+                break;
+              }
+              here -= nbnext;
+              /// a 2x2 block may split into two 1x1 blocks by the swap
+              nbf = (here + 1 < jw && t(here + 1, here) != zero) ? 2 : 1;
+            }
+            if (!moved)
+              /// ill conditioned reordering; the rest is undeflatable
+              break;
+            ilst += (ilst + 1 < jw && t(ilst + 1, ilst) != zero) ? 2 : 1;
+          }
+        }
+        if (ns == 0)
+          s = zero;
+
+        /// eigenvalues of the undeflated part are used as shifts
+        for (int i = 0; i < ns;) {
+          if (i + 1 < ns && t(i + 1, i) != zero) {
+            real_type a = t(i, i), b = t(i, i + 1), c = t(i + 1, i),
+                      d = t(i + 1, i + 1), cs, sn;
+            StandardizeSchur2x2Internal::invoke(a, b, c, d, sr[i], si[i],
+                                                sr[i + 1], si[i + 1], cs, sn);
+            i += 2;
+          } else {
+            sr[i] = t(i, i);
+            si[i] = zero;
+            i += 1;
+          }
+        }
+
+        const int nd = jw - ns;
+        iw[0] = ns;
+        iw[1] = nd;
+        iw[2] = 0;
+        if (nd == 0 && s != zero)
+          /// nothing is deflated; leave H untouched
+          return;
+
+        /// reflect the spike back into a multiple of e1 and restore the
+        /// hessenberg form of the undeflated part
+        if (ns > 1 && s != zero) {
+          real_type *spike = work;
+          for (int i = 0; i < ns; ++i)
+            spike[i] = s * V[i * vs1];
+          real_type beta = spike[0], tau;
+          LeftHouseholderInternal::invoke(ns - 1, &beta, spike + 1, 1, &tau);
+          SchurSerialHelperInternal::applyLeft(ns, spike + 1, 1, tau, jw, T,
+                                               ts0, ts1);
+          SchurSerialHelperInternal::applyRight(ns, ns, spike + 1, 1, tau, T,
+                                                ts0, ts1);
+          SchurSerialHelperInternal::applyRight(jw, ns, spike + 1, 1, tau, V,
+                                                vs0, vs1);
+          s = beta;
+
+          for (int j = 0; j < ns - 2; ++j) {
+            const int len = ns - j - 1;
+            real_type *u2 = &t(j + 2, j);
+            LeftHouseholderInternal::invoke(len - 1, &t(j + 1, j), u2, ts0,
+                                            &tau);
+            SchurSerialHelperInternal::applyLeft(len, u2, ts0, tau, jw - j - 1,
+                                                 &t(j + 1, j + 1), ts0, ts1);
+            SchurSerialHelperInternal::applyRight(ns, len, u2, ts0, tau,
+                                                  &t(0, j + 1), ts0, ts1);
+            SchurSerialHelperInternal::applyRight(jw, len, u2, ts0, tau,
+                                                  V + (j + 1) * vs1, vs0, vs1);
+            for (int i = 0; i < len - 1; ++i)
+              u2[i * ts0] = zero;
+          }
+        }
+
+        /// copy back the window and the spike
+        if (kwtop > ktop) {
+          h(kwtop, kwtop - 1) = ns > 0 ? (ns > 1 ? s : s * V[0]) : zero;
+          for (int i = 1; i < jw; ++i)
+            h(kwtop + i, kwtop - 1) = zero;
+        }
+        for (int i = 0; i < jw; ++i)
+          for (int j = 0; j < jw; ++j)
+            h(kwtop + i, kwtop + j) = t(i, j);
+        iw[2] = 1;
+      });
+      member.team_barrier();
+
+      const bool update = iw[2];
+      if (update) {
+        /// apply the window transformation to the off diagonal blocks of H
+        /// and to Z; the full schur form is computed
+        if (kwtop > 0) {
+          GemmInternal::invoke(member, kwtop, jw, jw, one, H + kwtop * hs1, hs0,
+                               hs1, V, vs0, vs1, zero, work, jw, 1);
+          member.team_barrier();
+          CopyInternal::invoke(member, Trans::NoTranspose(), kwtop, jw, work,
+                               jw, 1, H + kwtop * hs1, hs0, hs1);
+          member.team_barrier();
+        }
+        if (kbot + 1 < m) {
+          const int nn = m - kbot - 1;
+          real_type *Hr = H + kwtop * hs0 + (kbot + 1) * hs1;
+          GemmInternal::invoke(member, jw, nn, jw, one, V, vs1, vs0, Hr, hs0,
+                               hs1, zero, work, nn, 1);
+          member.team_barrier();
+          CopyInternal::invoke(member, Trans::NoTranspose(), jw, nn, work, nn,
+                               1, Hr, hs0, hs1);
+          member.team_barrier();
+        }
+        if (Z != nullptr) {
+          GemmInternal::invoke(member, m, jw, jw, one, Z + kwtop * zs1, zs0,
+                               zs1, V, vs0, vs1, zero, work, jw, 1);
+          member.team_barrier();
+          CopyInternal::invoke(member, Trans::NoTranspose(), m, jw, work, jw, 1,
+                               Z + kwtop * zs1, zs0, zs1);
+          member.team_barrier();
+        }
+      }
+      return 0;
+    }
+
+    ///
+    /// Chase a chain of ns/2 bulges through the active block [ktop, kbot].
+    /// Bulges are three columns apart; bulge b sits at column
+    /// k = ktop - 1 + step - 3b and its reflector acts on rows k+1:k+3.
+    /// Reflectors of a step are computed from the matrix before the step so
+    /// their applications commute and are done in parallel.
+    ///
+    template <typename MemberType, typename RealType>
+    KOKKOS_INLINE_FUNCTION static int
+    sweep(const MemberType &member, const int m, const int ktop,
+          const int kbot, const int nshift, const RealType *sr,
+          const RealType *si,
+          /* */ RealType *H, const int hs0, const int hs1,
+          /* */ RealType *Z, const int zs0, const int zs1,
+          /* */ RealType *bq, int *bk) {
+      using real_type = RealType;
+      const real_type zero(0), one(1);
+      const int nbmps = nshift / 2, nz = Z != nullptr ? m : 0;
+      const int nstep = (kbot - ktop) + 3 * (nbmps - 1);
+      for (int step = 0; step < nstep; ++step) {
+        int bmax = step / 3;
+        bmax = bmax < (nbmps - 1) ? bmax : (nbmps - 1);
+        int bmin = step - (kbot - ktop - 1);
+        bmin = bmin <= 0 ? 0 : (bmin + 2) / 3;
+        const int nbact = bmax - bmin + 1;
+        if (nbact <= 0)
+          continue;
+
+        /// compute reflectors
+        Kokkos::single(Kokkos::PerTeam(member), [=]() {
+          auto h = [H, hs0, hs1](const int i, const int j) -> real_type & {
+            return H[i * hs0 + j * hs1];
+          };
+          for (int b = bmin; b <= bmax; ++b) {
+            const int k = ktop - 1 + step - 3 * b;
+            const int nr = (kbot - k) < 3 ? (kbot - k) : 3;
+            real_type v0, v1, v2(0), tau;
+            if (k == ktop - 1) {
+              /// introduce a new bulge; first column of (H-s1)(H-s2)
+              const real_type sr1 = sr[2 * b], si1 = si[2 * b],
+                              sr2 = sr[2 * b + 1], si2 = si[2 * b + 1];
+              const real_type h00 = h(ktop, ktop), h10 = h(ktop + 1, ktop),
+                              h01 = h(ktop, ktop + 1),
+                              h11 = h(ktop + 1, ktop + 1),
+                              h21 = h(ktop + 2, ktop + 1);
+              const real_type s = ArithTraits<real_type>::abs(h00 - sr2) +
+                                  ArithTraits<real_type>::abs(si2) +
+                                  ArithTraits<real_type>::abs(h10);
+              if (s == zero) {
+                v0 = zero;
+                v1 = zero;
+                v2 = zero;
+              } else {
+                const real_type h10s = h10 / s;
+                v0 = (h00 - sr1) * ((h00 - sr2) / s) - si1 * (si2 / s) +
+                     h01 * h10s;
+                v1 = h10s * (h00 + h11 - sr1 - sr2);
+                v2 = h10s * h21;
+              }
+            } else {
+              v0 = h(k + 1, k);
+              v1 = h(k + 2, k);
+              if (nr == 3)
+                v2 = h(k + 3, k);
+            }
+            if (nr == 3)
+              LeftHouseholderInternal::invoke(&v0, &v1, &v2, &tau);
+            else
+              LeftHouseholderInternal::invoke(&v0, &v1, &tau);
+            if (k >= ktop) {
+              h(k + 1, k) = v0;
+              h(k + 2, k) = zero;
+              if (nr == 3)
+                h(k + 3, k) = zero;
+            }
+            bq[3 * b] = v1;
+            bq[3 * b + 1] = nr == 3 ? v2 : zero;
+            bq[3 * b + 2] = one / tau;
+            bk[b] = nr;
+          }
+        });
+        member.team_barrier();
+
+        /// apply reflectors from the left; rows of the bulges are disjoint
+        Kokkos::parallel_for(
+          Kokkos::TeamThreadRange(member, nbact), [&](const int &ib) {
+            const int b = bmin + ib, k = ktop - 1 + step - 3 * b, nr = bk[b];
+            const real_type u1 = bq[3 * b], u2 = bq[3 * b + 1],
+                            t1 = bq[3 * b + 2];
+            const int j0 = k + 1;
+            Kokkos::parallel_for(
+              Kokkos::ThreadVectorRange(member, m - j0), [&](const int &jj) {
+                real_type *hh = H + (k + 1) * hs0 + (j0 + jj) * hs1;
+                if (nr == 3) {
+                  const real_type s =
+                    (hh[0] + u1 * hh[hs0] + u2 * hh[2 * hs0]) * t1;
+                  hh[0] -= s;
+                  hh[hs0] -= s * u1;
+                  hh[2 * hs0] -= s * u2;
+                } else {
+                  const real_type s = (hh[0] + u1 * hh[hs0]) * t1;
+                  hh[0] -= s;
+                  hh[hs0] -= s * u1;
+                }
+              });
+          });
+        member.team_barrier();
+
+        /// apply reflectors from the right to H and Z; columns are disjoint
+        Kokkos::parallel_for(
+          Kokkos::TeamThreadRange(member, nbact), [&](const int &ib) {
+            const int b = bmin + ib, k = ktop - 1 + step - 3 * b, nr = bk[b];
+            const real_type u1 = bq[3 * b], u2 = bq[3 * b + 1],
+                            t1 = bq[3 * b + 2];
+            const int ih = ((k + nr + 1) < kbot ? (k + nr + 1) : kbot) + 1;
+            Kokkos::parallel_for(
+              Kokkos::ThreadVectorRange(member, ih + nz), [&](const int &ii) {
+                real_type *x;
+                int xs;
+                if (ii < ih) {
+                  x = H + ii * hs0 + (k + 1) * hs1;
+                  xs = hs1;
+                } else {
+                  x = Z + (ii - ih) * zs0 + (k + 1) * zs1;
+                  xs = zs1;
+                }
+                if (nr == 3) {
+                  const real_type s = (x[0] + u1 * x[xs] + u2 * x[2 * xs]) * t1;
+                  x[0] -= s;
+                  x[xs] -= s * u1;
+                  x[2 * xs] -= s * u2;
+                } else {
+                  const real_type s = (x[0] + u1 * x[xs]) * t1;
+                  x[0] -= s;
+                  x[xs] -= s * u1;
+                }
+              });
+          });
+        member.team_barrier();
+      }
+      return 0;
+    }
+
+    template <typename MemberType, typename RealType>
+    KOKKOS_INLINE_FUNCTION static int
+    invoke(const MemberType &member, const int m,
+           /* */ RealType *H, const int hs0, const int hs1,
+           /* */ RealType *Z, const int zs0, const int zs1,
+           /* */ RealType *er, const int ers,
+           /* */ RealType *ei, const int eis,
+           /* */ int *blks, const int bs,
+           /* */ RealType *W, const int wlen,
+           const int user_max_iteration = -1) {
+      using real_type = RealType;
+      using ats = ArithTraits<real_type>;
+
+      const real_type zero(0);
+      const real_type wilk1(0.75), wilk2(-0.4375);
+      const int kexsh = 6, nibble = 14;
+
+      /// small matrices use the double shift QR
+      int wlen_ms(0);
+      workspace(m, wlen_ms);
+      if (m <= TINES_SCHUR_MULTISHIFT_MIN_SIZE || wlen < wlen_ms)
+        return SchurInternal::invoke(member, m, H, hs0, hs1, Z, zs0, zs1, er,
+                                     ers, ei, eis, blks, bs,
+                                     user_max_iteration);
+
+      int ns_max, nw_max;
+      getParameters(m, ns_max, nw_max);
+
+      real_type *w_now = W;
+      auto take = [&w_now](const int span) {
+        real_type *r = w_now;
+        w_now += span;
+        return r;
+      };
+      real_type *T = take(nw_max * nw_max), *V = take(nw_max * nw_max);
+      real_type *wsr = take(nw_max), *wsi = take(nw_max);
+      real_type *sr = take(ns_max), *si = take(ns_max);
+      real_type *bq = take(3 * (ns_max / 2));
+      int *bk = (int *)take(ns_max / 2);
+      real_type *work = take(m * nw_max);
+      int *iw = (int *)take(4);
+
+      const int nmin = TINES_SCHUR_MULTISHIFT_MIN_SIZE;
+      const int nz = Z != nullptr ? m : 0;
+      const int itmax = user_max_iteration < 0
+                          ? 30 * (m > 10 ? m : 10)
+                          : user_max_iteration * m;
+
+      int r_val(0), kbot = m - 1, its(0), ndfl(1);
+      while (kbot >= 0) {
+        /// locate the active block and apply the conservative small
+        /// subdiagonal deflation test
+        Kokkos::single(Kokkos::PerTeam(member), [=]() {
+          const real_type ulp = ats::epsilon(),
+                          smlnum = ats::sfmin() * (real_type(m) / ulp);
+          auto h = [H, hs0, hs1](const int i, const int j) -> real_type & {
+            return H[i * hs0 + j * hs1];
+          };
+          int k = kbot;
+          for (; k > 0; --k) {
+            const real_type hkk1 = ats::abs(h(k, k - 1));
+            if (hkk1 == zero)
+              break;
+            const real_type tst = ats::abs(h(k - 1, k - 1)) + ats::abs(h(k, k));
+            if (hkk1 <= smlnum || hkk1 <= ulp * tst) {
+              const real_type hk1k = ats::abs(h(k - 1, k));
+              const real_type ab = hkk1 > hk1k ? hkk1 : hk1k,
+                              ba = hkk1 > hk1k ? hk1k : hkk1;
+              const real_type hkk = ats::abs(h(k, k)),
+                              hdiff = ats::abs(h(k - 1, k - 1) - h(k, k));
+              const real_type aa = hkk > hdiff ? hkk : hdiff,
+                              bb = hkk > hdiff ? hdiff : hkk;
+              const real_type s = aa + ab, rhs = ulp * (bb * (aa / s));
+              if (hkk1 <= smlnum || ba * (ab / s) <= (smlnum > rhs ? smlnum : rhs)) {
+                h(k, k - 1) = zero;
+                break;
+              }
+            }
+          }
+          iw[0] = k;
+        });
+        member.team_barrier();
+        const int ktop = iw[0], nh = kbot - ktop + 1;
+        member.team_barrier();
+
+        if (nh < nmin) {
+          /// finish the small active block
+          Kokkos::single(Kokkos::PerTeam(member), [=]() {
+            iw[1] = SchurWindowInternal::invoke(m, ktop, kbot, H, hs0, hs1, Z,
+                                                zs0, zs1, nz, er, ers, ei, eis);
+          });
+          member.team_barrier();
+          const int info = iw[1];
+          member.team_barrier();
+          if (info) {
+            r_val = -info;
+            break;
+          }
+          kbot = ktop - 1;
+          continue;
+        }
+
+        if (its >= itmax) {
+          r_val = -(kbot + 1);
+          break;
+        }
+        ++its;
+
+        /// aggressive early deflation
+        int ns_iter, nw_iter;
+        getParameters(nh, ns_iter, nw_iter);
+        ns_iter = ns_iter < ns_max ? ns_iter : ns_max;
+        nw_iter = nw_iter < nw_max ? nw_iter : nw_max;
+
+        aggressiveEarlyDeflation(member, m, ktop, kbot, nw_iter, H, hs0, hs1, Z,
+                                 zs0, zs1, T, V, wsr, wsi, work, iw);
+        const int ns_avail = iw[0], nd = iw[1];
+        member.team_barrier();
+
+        kbot -= nd;
+        ndfl = nd > 0 ? 1 : ndfl + 1;
+
+        /// skip the sweep when aed deflates enough
+        const int nh_now = kbot - ktop + 1;
+        const int nw_min = nmin < nw_iter ? nmin : nw_iter;
+        const bool do_sweep =
+          (nd == 0) || (100 * nd <= nw_iter * nibble && nh_now > nw_min);
+        if (!do_sweep || nh_now < 3)
+          continue;
+
+        /// select shifts
+        Kokkos::single(Kokkos::PerTeam(member), [=]() {
+          auto h = [H, hs0, hs1](const int i, const int j) -> real_type & {
+            return H[i * hs0 + j * hs1];
+          };
+          int ns_use = ns_iter < (nh_now - 1) ? ns_iter : (nh_now - 1);
+          ns_use -= ns_use % 2;
+          ns_use = ns_use < 2 ? 2 : ns_use;
+
+          int nshift(0);
+          if (ndfl % kexsh == 0) {
+            /// exceptional shifts
+            for (int i = kbot; i >= ktop + 2 && nshift < ns_use; i -= 2) {
+              const real_type ss =
+                ats::abs(h(i, i - 1)) + ats::abs(h(i - 1, i - 2));
+              real_type aa = wilk1 * ss + h(i, i), bb = ss, cc = wilk2 * ss,
+                        dd = aa, cs, sn;
+              StandardizeSchur2x2Internal::invoke(aa, bb, cc, dd, sr[nshift],
+                                                  si[nshift], sr[nshift + 1],
+                                                  si[nshift + 1], cs, sn);
+              nshift += 2;
+            }
+          } else {
+            /// undeflatable eigenvalues of the window from the bottom;
+            /// complex pairs are kept together and real shifts are paired
+            int nreal(0);
+            real_type rbuf(0);
+            for (int i = ns_avail - 1; i >= 0 && nshift < ns_use;) {
+              if (wsi[i] != zero && i > 0) {
+                sr[nshift] = wsr[i - 1];
+                si[nshift] = wsi[i - 1];
+                sr[nshift + 1] = wsr[i];
+                si[nshift + 1] = wsi[i];
+                nshift += 2;
+                i -= 2;
+              } else if (wsi[i] != zero) {
+                i -= 1;
+              } else {
+                if (nreal) {
+                  sr[nshift] = rbuf;
+                  si[nshift] = zero;
+                  sr[nshift + 1] = wsr[i];
+                  si[nshift + 1] = zero;
+                  nshift += 2;
+                  nreal = 0;
+                } else {
+                  rbuf = wsr[i];
+                  nreal = 1;
+                }
+                i -= 1;
+              }
+            }
+          }
+          if (nshift < 2) {
+            /// eigenvalues of the trailing 2x2 block
+            real_type aa = h(kbot - 1, kbot - 1), bb = h(kbot - 1, kbot),
+                      cc = h(kbot, kbot - 1), dd = h(kbot, kbot), cs, sn;
+            StandardizeSchur2x2Internal::invoke(aa, bb, cc, dd, sr[0], si[0],
+                                                sr[1], si[1], cs, sn);
+            nshift = 2;
+          }
+          if (nshift == 2 && si[0] == zero) {
+            /// two real shifts; use the one closer to h(kbot,kbot) twice
+            const real_type hkk = h(kbot, kbot);
+            const real_type sel =
+              ats::abs(sr[0] - hkk) <= ats::abs(sr[1] - hkk) ? sr[0] : sr[1];
+            sr[0] = sel;
+            sr[1] = sel;
+          }
+          iw[3] = nshift;
+        });
+        member.team_barrier();
+        const int nshift = iw[3];
+        member.team_barrier();
+
+        sweep(member, m, ktop, kbot, nshift, sr, si, H, hs0, hs1, Z, zs0, zs1,
+              bq, bk);
+      }
+
+      /// standardize the remaining 2x2 blocks and extract eigenvalues
+      if (r_val == 0) {
+        Kokkos::single(Kokkos::PerTeam(member), [=]() {
+          auto h = [H, hs0, hs1](const int i, const int j) -> real_type & {
+            return H[i * hs0 + j * hs1];
+          };
+          for (int k = 0; k < m;) {
+            if (k + 1 < m && h(k + 1, k) != zero) {
+              real_type rt1r, rt1i, rt2r, rt2i;
+              SchurSerialHelperInternal::standardize(m, k, H, hs0, hs1, Z, zs0,
+                                                     zs1, nz, rt1r, rt1i, rt2r,
+                                                     rt2i);
+              er[k * ers] = rt1r;
+              ei[k * eis] = rt1i;
+              er[(k + 1) * ers] = rt2r;
+              ei[(k + 1) * eis] = rt2i;
+              if (rt1i != zero) {
+                blks[k * bs] = -2;
+                blks[(k + 1) * bs] = 0;
+              } else {
+                blks[k * bs] = 1;
+                blks[(k + 1) * bs] = 1;
+              }
+              k += 2;
+            } else {
+              er[k * ers] = h(k, k);
+              ei[k * eis] = zero;
+              blks[k * bs] = 1;
+              k += 1;
+            }
+          }
+        });
+        member.team_barrier();
+      }
+      return r_val;
+    }
+  };
+
+} // namespace Tines
+
+#endif
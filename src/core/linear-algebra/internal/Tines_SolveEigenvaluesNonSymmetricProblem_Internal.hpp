@@ -22,17 +22,132 @@ Sandia National Laboratories, New Mexico, USA
 #define __TINES_SOLVE_EIGENVALUES_NONSYMMETRIC_PROBLEM_INTERNAL_HPP__
 
 #include "Tines_ApplyQ_Internal.hpp"
+#include "Tines_Balance_Internal.hpp"
+#include "Tines_Copy_Internal.hpp"
+#include "Tines_Gemm_Internal.hpp"
 #include "Tines_HessenbergFormQ_Internal.hpp"
+#include "Tines_Hessenberg_Blocked_Internal.hpp"
 #include "Tines_Hessenberg_Internal.hpp"
 #include "Tines_Internal.hpp"
+#include "Tines_LeftEigenvectorSchur_Internal.hpp"
 #include "Tines_RightEigenvectorSchur_Internal.hpp"
 #include "Tines_Schur_Internal.hpp"
+#include "Tines_Schur_MultiShift_Internal.hpp"
 #include "Tines_Set_Internal.hpp"
 
 namespace Tines {
 
   struct SolveEigenvaluesNonSymmetricProblemInternal {
 
+    ///
+    /// Balancing, Hessenberg reduction and Schur decomposition of A. On exit,
+    /// A is the quasi upper triangular Schur form T of the balanced matrix
+    /// and D^{-1} P^T A P D = Z T Z^H. U is a scratch space of length ulen
+    /// (2m at least and max(ilo, m-ihi-1)(ihi-ilo+1) when the off diagonal
+    /// blocks are present); the blocked Hessenberg reduction and the
+    /// multishift QR use it when it is large enough.
+    ///
+    template <typename MemberType, typename RealType>
+    KOKKOS_INLINE_FUNCTION static int
+    schur(const MemberType &member, const int m, RealType *__restrict__ A,
+          const int as0, const int as1, RealType *__restrict__ er,
+          const int ers, RealType *__restrict__ ei, const int eis,
+          RealType *__restrict__ Z, const int zs0, const int zs1,
+          int *__restrict__ blks, const int bs, RealType *__restrict__ scale,
+          RealType *__restrict__ U, const int ulen, int &ilo, int &ihi) {
+      using real_type = RealType;
+      const real_type one(1), zero(0);
+
+      /// step 1: balancing A := D^{-1} P^T A P D
+      BalanceInternal::invoke(member, m, A, as0, as1, scale, 1, ilo, ihi);
+      member.team_barrier();
+
+      const int n = ihi - ilo + 1;
+      real_type *A22 = A + ilo * (as0 + as1), *Z22 = Z + ilo * (zs0 + zs1);
+
+      /// step 2: Hessenberg reduction A22 = Q H Q^H
+      {
+        real_type *t = U, *work = U + m;
+
+        /// the blocked reduction needs more than work; it takes the rest of
+        /// the workspace when it is available
+        int wlen_blocked(0);
+        HessenbergBlockedInternal::workspace(n, wlen_blocked);
+        if (n > TINES_BLOCKED_HOUSEHOLDER_MIN_SIZE &&
+            (ulen - m) >= wlen_blocked)
+          HessenbergBlockedInternal::invoke(member, n, A22, as0, as1, t, 1,
+                                            work);
+        else
+          HessenbergInternal::invoke(member, n, A22, as0, as1, t, 1, work);
+        member.team_barrier();
+
+        /// Z = diag(I, Q, I)
+        SetInternal::invoke(member, m, m, one, zero, Z, zs0, zs1);
+        member.team_barrier();
+        HessenbergFormQ_Internal::invoke(member, n, A22, as0, as1, t, 1, Z22,
+                                         zs0, zs1, work);
+        member.team_barrier();
+        SetInternal::invoke(member, Uplo::Lower(), m, m, 2, zero, A, as0, as1);
+        member.team_barrier();
+      }
+
+      /// step 3: Schur decomposition H = Z T Z^H
+      {
+#if defined(TINES_ENABLE_SCHUR_MULTISHIFT)
+        /// large matrices use the multishift QR with the scratch space U
+        const int r_val = SchurMultiShiftInternal::invoke(
+          member, n, A22, as0, as1, Z22, zs0, zs1, er + ilo * ers, ers,
+          ei + ilo * eis, eis, blks + ilo * bs, bs, U, ulen);
+#else
+        const int r_val = SchurInternal::invoke(
+          member, n, A22, as0, as1, Z22, zs0, zs1, er + ilo * ers, ers,
+          ei + ilo * eis, eis, blks + ilo * bs, bs);
+#endif
+        Kokkos::single(Kokkos::PerTeam(member), [=]() {
+          TINES_CHECK_ERROR(r_val, "Error: SchurInternal fails");
+        });
+        member.team_barrier();
+
+        /// apply Z22 to the off diagonal blocks; A12 := A12 Z22 and
+        /// A23 := Z22^H A23
+        if (ilo > 0) {
+          real_type *A12 = A + ilo * as1;
+          GemmInternal::invoke(member, ilo, n, n, one, A12, as0, as1, Z22, zs0,
+                               zs1, zero, U, n, 1);
+          member.team_barrier();
+          CopyInternal::invoke(member, Trans::NoTranspose(), ilo, n, U, n, 1,
+                               A12, as0, as1);
+          member.team_barrier();
+        }
+        if (ihi + 1 < m) {
+          const int n23 = m - ihi - 1;
+          real_type *A23 = A + ilo * as0 + (ihi + 1) * as1;
+          GemmInternal::invoke(member, n, n23, n, one, Z22, zs1, zs0, A23, as0,
+                               as1, zero, U, n23, 1);
+          member.team_barrier();
+          CopyInternal::invoke(member, Trans::NoTranspose(), n, n23, U, n23, 1,
+                               A23, as0, as1);
+          member.team_barrier();
+        }
+
+        /// eigenvalues isolated by the balancing
+        Kokkos::parallel_for(Kokkos::TeamVectorRange(member, m - n),
+                             [&](const int &ii) {
+                               const int i = ii < ilo ? ii : ii + n;
+                               er[i * ers] = A[i * (as0 + as1)];
+                               ei[i * eis] = zero;
+                               blks[i * bs] = 1;
+                             });
+        member.team_barrier();
+      }
+      return 0;
+    }
+
+    ///
+    /// The matrix is balanced first; the Hessenberg reduction and the Schur
+    /// decomposition work on the block A(ilo:ihi,ilo:ihi) only and the
+    /// eigenvalues isolated by the permutation are read from the diagonal.
+    ///
     template <typename MemberType, typename RealType>
     KOKKOS_INLINE_FUNCTION static int
     invoke(const MemberType &member, const int m, RealType *__restrict__ A,
@@ -63,6 +178,13 @@ namespace Tines {
         wlen_now -= span;
       }
 
+      real_type *scale = w_now;
+      {
+        const int span = m;
+        w_now += span;
+        wlen_now -= span;
+      }
+
       real_type *U = w_now;
       const int us0 = m, us1 = 1;
       {
@@ -71,55 +193,125 @@ namespace Tines {
         wlen_now -= span;
       }
 
-      member.team_barrier();
-      /// step 1: Hessenberg reduction A = Q H Q^H
+      /// step 1-3: balancing, Hessenberg reduction and Schur decomposition
+      int ilo(0), ihi(m - 1);
+      schur(member, m, A, as0, as1, er, ers, ei, eis, Z, zs0, zs1, blks, bs,
+            scale, U, m * m + wlen_now, ilo, ihi);
+      const int n = ihi - ilo + 1;
+
+      /// step 4: Eigenvectors  T = V S V^{-1}, UL = (Q Z)V, UR = V^{-1} (Q Z)^H
       {
-        real_type *t = w_now;
-        {
-          const int span = m;
-          w_now += span;
-          wlen_now -= span;
-        }
         real_type *work = w_now;
         {
           const int span = m;
           w_now += span;
           wlen_now -= span;
         }
-
-        HessenbergInternal::invoke(member, m, A, as0, as1, t, 1, work);
+        const int r_val = RightEigenvectorSchurInternal::invoke(
+          member, m, blks, bs, A, as0, as1, U, us0, us1, work);
+        Kokkos::single(Kokkos::PerTeam(member), [=]() {
+          TINES_CHECK_ERROR(r_val,
+                            "Error: RightEigenvectorSchurInternal fails");
+        });
         member.team_barrier();
-        HessenbergFormQ_Internal::invoke(member, m, A, as0, as1, t, 1, Z, zs0,
-                                         zs1, work);
+        /// UR = V^{-1} Z^H Q^H = V^{-1} (Q Z)^H
+        GemmInternal::invoke(member, m, m, m, one, Z, zs0, zs1, U, us0, us1,
+                             zero, UR, urs0, urs1);
         member.team_barrier();
-        SetInternal::invoke(member, Uplo::Lower(), m, m, 2, zero, A, as0, as1);
+
+        /// step 5: back transformation of the balancing, UR := P D UR and
+        /// normalize the eigenvectors again
+        if (n < m || ilo < ihi) {
+          BalanceBackTransformInternal::invoke(member, m, ilo, ihi, scale, 1,
+                                               m, UR, urs0, urs1);
+          normalize(member, m, m, blks, bs, UR, urs0, urs1, work);
+        }
         {
           /// retrive the workspace for householder and its application
-          const int span = 2 * m;
+          const int span = m;
           w_now -= span;
           wlen_now += span;
         }
         member.team_barrier();
       }
 
-      /// step 2: Schur decomposition H = Z T Z^H
       {
-        const int r_val = SchurInternal::invoke(
-          member, m, A, as0, as1, Z, zs0, zs1, er, ers, ei, eis, blks, bs);
-        Kokkos::single(Kokkos::PerTeam(member), [=]() {
-          TINES_CHECK_ERROR(r_val, "Error: SchurInternal fails");
-        });
-        member.team_barrier();
+        /// retrive the workspace for householder and its application
+        const int span = 2 * m * m + 2 * m;
+        w_now -= span;
+        wlen_now += span;
       }
+      return 0;
+    }
 
-      /// step 3: Eigenvectors  T = V S V^{-1}, UL = (Q Z)V, UR = V^{-1} (Q Z)^H
+    ///
+    /// Left and right eigenvectors; the right eigenvectors are normalized and
+    /// the left eigenvectors are scaled such that UL^H UR = I where a complex
+    /// pair is stored in two consecutive columns of UL and UR. The left
+    /// eigenvectors are computed from the Schur form directly and replace
+    /// the inversion of UR. The workspace is the same as the solve for the
+    /// right eigenvectors.
+    ///
+    template <typename MemberType, typename RealType>
+    KOKKOS_INLINE_FUNCTION static int
+    invoke(const MemberType &member, const int m, RealType *__restrict__ A,
+           const int as0, const int as1, RealType *__restrict__ er,
+           const int ers, RealType *__restrict__ ei, const int eis,
+           RealType *__restrict__ UL, const int uls0, const int uls1,
+           RealType *__restrict__ UR, const int urs0, const int urs1,
+           RealType *__restrict__ W, const int wlen) {
+      using real_type = RealType;
+      const real_type one(1), zero(0);
+
+      /// step 0: input workspace check
+      real_type *w_now = W;
+      int wlen_now = wlen;
+
+      real_type *Z = w_now;
+      const int zs0 = m, zs1 = 1;
+      {
+        const int span = m * m;
+        w_now += span;
+        wlen_now -= span;
+      }
+
+      int *blks = (int *)w_now;
+      const int bs = 1;
+      {
+        const int span = m;
+        w_now += span;
+        wlen_now -= span;
+      }
+
+      real_type *scale = w_now;
+      {
+        const int span = m;
+        w_now += span;
+        wlen_now -= span;
+      }
+
+      real_type *U = w_now;
+      const int us0 = m, us1 = 1;
+      {
+        const int span = m * m;
+        w_now += span;
+        wlen_now -= span;
+      }
+
+      /// step 1-3: balancing, Hessenberg reduction and Schur decomposition
+      int ilo(0), ihi(m - 1);
+      schur(member, m, A, as0, as1, er, ers, ei, eis, Z, zs0, zs1, blks, bs,
+            scale, U, m * m + wlen_now, ilo, ihi);
+
+      real_type *work = w_now;
+      {
+        const int span = m;
+        w_now += span;
+        wlen_now -= span;
+      }
+
+      /// step 4: right eigenvectors, UR = Z V
       {
-        real_type *work = w_now;
-        {
-          const int span = m;
-          w_now += span;
-          wlen_now -= span;
-        }
         const int r_val = RightEigenvectorSchurInternal::invoke(
           member, m, blks, bs, A, as0, as1, U, us0, us1, work);
         Kokkos::single(Kokkos::PerTeam(member), [=]() {
@@ -127,26 +319,343 @@ namespace Tines {
                             "Error: RightEigenvectorSchurInternal fails");
         });
         member.team_barrier();
-        /// UR = V^{-1} Z^H Q^H = V^{-1} (Q Z)^H
         GemmInternal::invoke(member, m, m, m, one, Z, zs0, zs1, U, us0, us1,
                              zero, UR, urs0, urs1);
+        member.team_barrier();
+      }
+
+      /// step 5: left eigenvectors, UL = Z V
+      {
+        const int r_val = LeftEigenvectorSchurInternal::invoke(
+          member, m, blks, bs, A, as0, as1, U, us0, us1);
+        Kokkos::single(Kokkos::PerTeam(member), [=]() {
+          TINES_CHECK_ERROR(r_val, "Error: LeftEigenvectorSchurInternal fails");
+        });
+        member.team_barrier();
+        GemmInternal::invoke(member, m, m, m, one, Z, zs0, zs1, U, us0, us1,
+                             zero, UL, uls0, uls1);
+        member.team_barrier();
+      }
+
+      /// step 6: back transformation of the balancing; UR := P D UR and
+      /// UL := P D^{-1} UL
+      BalanceBackTransformInternal::invoke(member, Side::Right(), m, ilo, ihi,
+                                           scale, 1, m, UR, urs0, urs1);
+      BalanceBackTransformInternal::invoke(member, Side::Left(), m, ilo, ihi,
+                                           scale, 1, m, UL, uls0, uls1);
+
+      /// step 7: normalization
+      normalize(member, m, m, blks, bs, UR, urs0, urs1, work);
+      biorthonormalize(member, m, ei, eis, UL, uls0, uls1, UR, urs0, urs1);
+      return 0;
+    }
+
+    ///
+    /// Selected right eigenvectors only; all eigenvalues are computed and
+    /// select (see Tines_EigenvalueSelect.hpp) picks eigenvalues of interest.
+    /// On exit, nsel is the number of computed eigenvectors, sel(i) is the
+    /// index of the eigenvalue of the i-th eigenvector and UR(:,i) holds the
+    /// eigenvector. A complex pair is stored as (j, j+1) in sel with the real
+    /// and imaginary parts in consecutive columns of UR. sel needs m entries
+    /// and UR needs urn >= nsel columns. The workspace is the same as the
+    /// solve for all eigenvectors.
+    ///
+    template <typename MemberType, typename RealType, typename SelectorType>
+    KOKKOS_INLINE_FUNCTION static int
+    invoke(const MemberType &member, const int m, RealType *__restrict__ A,
+           const int as0, const int as1, RealType *__restrict__ er,
+           const int ers, RealType *__restrict__ ei, const int eis,
+           const SelectorType &select, int *__restrict__ sel, const int ss,
+           int &nsel, RealType *__restrict__ UR, const int urs0,
+           const int urs1, const int urn, RealType *__restrict__ W,
+           const int wlen) {
+      using real_type = RealType;
+
+      /// step 0: input workspace check
+      real_type *w_now = W;
+      int wlen_now = wlen;
+
+      real_type *Z = w_now;
+      const int zs0 = m, zs1 = 1;
+      {
+        const int span = m * m;
+        w_now += span;
+        wlen_now -= span;
+      }
+
+      int *blks = (int *)w_now;
+      const int bs = 1;
+      {
+        const int span = m;
+        w_now += span;
+        wlen_now -= span;
+      }
+
+      real_type *scale = w_now;
+      {
+        const int span = m;
+        w_now += span;
+        wlen_now -= span;
+      }
+
+      /// step 1-3: balancing, Hessenberg reduction and Schur decomposition
+      int ilo(0), ihi(m - 1);
+      schur(member, m, A, as0, as1, er, ers, ei, eis, Z, zs0, zs1, blks, bs,
+            scale, w_now, wlen_now, ilo, ihi);
+
+      /// step 4: selection; a selected complex pair is expanded to two
+      /// consecutive entries in place from the back
+      auto blk_size = [blks, bs](const int j) {
+        const int blk = blks[j * bs];
+        return blk < 0 ? -blk : blk;
+      };
+      Kokkos::single(
+        Kokkos::PerTeam(member),
+        [=](int &val) {
+          const int nblk =
+            select(m, er, ers, ei, eis, (const int *)blks, bs, sel, ss);
+          int ncol(0);
+          for (int b = 0; b < nblk; ++b)
+            ncol += (blk_size(sel[b * ss]) == 2 ? 2 : 1);
+          for (int b = nblk - 1, c = ncol; b >= 0; --b) {
+            const int j = sel[b * ss];
+            if (blk_size(j) == 2)
+              sel[(--c) * ss] = j + 1;
+            sel[(--c) * ss] = j;
+          }
+          val = ncol;
+        },
+        nsel);
+      member.team_barrier();
+      Kokkos::single(Kokkos::PerTeam(member), [=]() {
+        TINES_CHECK_ERROR(nsel > urn,
+                          "Error: UR is too small for selected eigenvectors");
+      });
+
+      /// step 5: selected eigenvectors, UR(:,i) = Z x_i
+      {
+        const int r_val = RightEigenvectorSchurSelectiveInternal::invoke(
+          member, m, blks, bs, A, as0, as1, Z, zs0, zs1, nsel, sel, ss, UR,
+          urs0, urs1, w_now);
+        Kokkos::single(Kokkos::PerTeam(member), [=]() {
+          TINES_CHECK_ERROR(
+            r_val, "Error: RightEigenvectorSchurSelectiveInternal fails");
+        });
+        member.team_barrier();
+      }
+
+      /// step 6: back transformation of the balancing and normalization
+      {
+        int *cblks = (int *)w_now;
+        real_type *work = w_now + m;
+        BalanceBackTransformInternal::invoke(member, m, ilo, ihi, scale, 1,
+                                             nsel, UR, urs0, urs1);
+        Kokkos::parallel_for(
+          Kokkos::TeamVectorRange(member, nsel),
+          [&](const int &i) { cblks[i] = blk_size(sel[i * ss]); });
+        member.team_barrier();
+        normalize(member, m, nsel, cblks, 1, UR, urs0, urs1, work);
+      }
+      return 0;
+    }
+
+    ///
+    /// Eigenvalues only; Q and Z are not formed and eigenvectors are not
+    /// computed. The workspace requires 3m at least. When more workspace is
+    /// given, the blocked Hessenberg reduction and the multishift QR use it.
+    ///
+    template <typename MemberType, typename RealType>
+    KOKKOS_INLINE_FUNCTION static int
+    invoke(const MemberType &member, const int m, RealType *__restrict__ A,
+           const int as0, const int as1, RealType *__restrict__ er,
+           const int ers, RealType *__restrict__ ei, const int eis,
+           RealType *__restrict__ W, const int wlen) {
+      using real_type = RealType;
+      const real_type zero(0);
+
+      /// step 0: input workspace check
+      real_type *w_now = W;
+      int wlen_now = wlen;
+
+      int *blks = (int *)w_now;
+      const int bs = 1;
+      {
+        const int span = m;
+        w_now += span;
+        wlen_now -= span;
+      }
+
+      /// step 1: balancing; scale is not needed after this step
+      int ilo(0), ihi(m - 1);
+      BalanceInternal::invoke(member, m, A, as0, as1, w_now, 1, ilo, ihi);
+      member.team_barrier();
+
+      const int n = ihi - ilo + 1;
+      real_type *A22 = A + ilo * (as0 + as1);
+
+      /// step 2: Hessenberg reduction A22 = Q H Q^H, Q is not formed
+      {
+        real_type *t = w_now;
+        {
+          const int span = m;
+          w_now += span;
+          wlen_now -= span;
+        }
+        real_type *work = w_now;
         {
-          /// retrive the workspace for householder and its application
           const int span = m;
+          w_now += span;
+          wlen_now -= span;
+        }
+
+        int wlen_blocked(0);
+        HessenbergBlockedInternal::workspace(n, wlen_blocked);
+        if (n > TINES_BLOCKED_HOUSEHOLDER_MIN_SIZE &&
+            (wlen_now + m) >= wlen_blocked)
+          HessenbergBlockedInternal::invoke(member, n, A22, as0, as1, t, 1,
+                                            work);
+        else
+          HessenbergInternal::invoke(member, n, A22, as0, as1, t, 1, work);
+        member.team_barrier();
+        SetInternal::invoke(member, Uplo::Lower(), n, n, 2, zero, A22, as0,
+                            as1);
+        {
+          const int span = 2 * m;
           w_now -= span;
           wlen_now += span;
         }
         member.team_barrier();
       }
 
+      /// step 3: eigenvalues from the Schur form without Schur vectors
       {
-        /// retrive the workspace for householder and its application
-        const int span = 2 * m * m + m;
-        w_now -= span;
-        wlen_now += span;
+#if defined(TINES_ENABLE_SCHUR_MULTISHIFT)
+        const int r_val = SchurMultiShiftInternal::invoke(
+          member, n, A22, as0, as1, (real_type *)nullptr, 0, 0, er + ilo * ers,
+          ers, ei + ilo * eis, eis, blks + ilo * bs, bs, w_now, wlen_now);
+#else
+        const int r_val = SchurInternal::invoke(
+          member, n, A22, as0, as1, (real_type *)nullptr, 0, 0, er + ilo * ers,
+          ers, ei + ilo * eis, eis, blks + ilo * bs, bs);
+#endif
+        Kokkos::single(Kokkos::PerTeam(member), [=]() {
+          TINES_CHECK_ERROR(r_val, "Error: SchurInternal fails");
+        });
+
+        /// eigenvalues isolated by the balancing
+        Kokkos::parallel_for(Kokkos::TeamVectorRange(member, m - n),
+                             [&](const int &ii) {
+                               const int i = ii < ilo ? ii : ii + n;
+                               er[i * ers] = A[i * (as0 + as1)];
+                               ei[i * eis] = zero;
+                             });
+        member.team_barrier();
       }
       return 0;
     }
+
+    ///
+    /// Normalize n eigenvectors of length m; blks(j) is the block size of
+    /// the column j and a complex pair stored in two columns is normalized
+    /// with its complex norm.
+    ///
+    template <typename MemberType, typename RealType>
+    KOKKOS_INLINE_FUNCTION static int
+    normalize(const MemberType &member, const int m, const int n,
+              const int *__restrict__ blks, const int bs,
+              RealType *__restrict__ V, const int vs0, const int vs1,
+              RealType *__restrict__ w) {
+      using real_type = RealType;
+      using ats = ArithTraits<real_type>;
+      Kokkos::parallel_for(
+        Kokkos::TeamThreadRange(member, n), [&](const int &j) {
+          const int tmp_blk = blks[j * bs];
+          const int blk = tmp_blk < 0 ? -tmp_blk : tmp_blk;
+          if (blk == 1 || blk == 2) {
+            real_type norm(0);
+            Kokkos::parallel_reduce(
+              Kokkos::ThreadVectorRange(member, m * blk),
+              [&](const int &k, real_type &update) {
+                const int i = k % m, jj = j + k / m;
+                const real_type val = V[i * vs0 + jj * vs1];
+                update += val * val;
+              },
+              norm);
+            Kokkos::single(Kokkos::PerThread(member), [&]() {
+              w[j] = norm;
+              if (blk == 2)
+                w[j + 1] = norm;
+            });
+          }
+        });
+      member.team_barrier();
+      Kokkos::parallel_for(
+        Kokkos::TeamThreadRange(member, n), [&](const int &j) {
+          const real_type norm = ats::sqrt(w[j]);
+          Kokkos::parallel_for(
+            Kokkos::ThreadVectorRange(member, m),
+            [&](const int &i) { V[i * vs0 + j * vs1] /= norm; });
+        });
+      member.team_barrier();
+      return 0;
+    }
+
+    ///
+    /// Scale left eigenvectors such that UL^H UR = I; a complex pair is
+    /// identified by ei(j) > 0 for the first column.
+    ///
+    template <typename MemberType, typename RealType>
+    KOKKOS_INLINE_FUNCTION static int
+    biorthonormalize(const MemberType &member, const int m,
+                     const RealType *__restrict__ ei, const int eis,
+                     RealType *__restrict__ UL, const int uls0, const int uls1,
+                     const RealType *__restrict__ UR, const int urs0,
+                     const int urs1) {
+      using real_type = RealType;
+      const real_type zero(0);
+      Kokkos::parallel_for(
+        Kokkos::TeamThreadRange(member, m), [&](const int &j) {
+          const real_type eij = ei[j * eis];
+          if (eij == zero) {
+            /// real eigen vectors; u := u / (u^T v)
+            real_type *ul = UL + j * uls1;
+            const real_type *ur = UR + j * urs1;
+            real_type c(0);
+            Kokkos::parallel_reduce(
+              Kokkos::ThreadVectorRange(member, m),
+              [&](const int &i, real_type &update) {
+                update += ul[i * uls0] * ur[i * urs0];
+              },
+              c);
+            Kokkos::parallel_for(Kokkos::ThreadVectorRange(member, m),
+                                 [&](const int &i) { ul[i * uls0] /= c; });
+          } else if (eij > zero && (j + 1) < m) {
+            /// complex eigen vectors; u := u / conj(u^H v)
+            real_type *ulr = UL + j * uls1, *uli = ulr + uls1;
+            const real_type *urr = UR + j * urs1, *uri = urr + urs1;
+            Kokkos::complex<real_type> c(0);
+            Kokkos::parallel_reduce(
+              Kokkos::ThreadVectorRange(member, m),
+              [&](const int &i, Kokkos::complex<real_type> &update) {
+                const real_type a = ulr[i * uls0], b = uli[i * uls0],
+                                x = urr[i * urs0], y = uri[i * urs0];
+                update += Kokkos::complex<real_type>(a * x + b * y,
+                                                     a * y - b * x);
+              },
+              c);
+            const real_type c2 = c.real() * c.real() + c.imag() * c.imag();
+            const real_type cr = c.real() / c2, ci = c.imag() / c2;
+            Kokkos::parallel_for(
+              Kokkos::ThreadVectorRange(member, m), [&](const int &i) {
+                const real_type a = ulr[i * uls0], b = uli[i * uls0];
+                ulr[i * uls0] = a * cr - b * ci;
+                uli[i * uls0] = a * ci + b * cr;
+              });
+          }
+        });
+      member.team_barrier();
+      return 0;
+    }
   };
 
 } // namespace Tines
@@ -0,0 +1,113 @@
+/*----------------------------------------------------------------------------------
+Tines - Time Integrator, Newton and Eigen Solver -  version 1.0
+Copyright (2021) NTESS
+https://github.com/sandialabs/Tines
+
+Copyright 2021 National Technology & Engineering Solutions of Sandia, LLC (NTESS). 
+Under the terms of Contract DE-NA0003525 with NTESS, the U.S. Government retains 
+certain rights in this software.
+
+This file is part of Tines. Tines is open-source software: you can redistribute it
+and/or modify it under the terms of BSD 2-Clause License
+(https://opensource.org/licenses/BSD-2-Clause). A copy of the license is also
+provided under the main directory
+Questions? Kyungjoo Kim <kyukim@sandia.gov>, or
+	   Oscar Diaz-Ibarra at <odiazib@sandia.gov>, or
+	   Cosmin Safta at <csafta@sandia.gov>, or
+	   Habib Najm at <hnnajm@sandia.gov>
+
+Sandia National Laboratories, New Mexico, USA
+----------------------------------------------------------------------------------*/
+#ifndef __TINES_SOLVE_EIGENVALUES_SYMMETRIC_PROBLEM_INTERNAL_HPP__
+#define __TINES_SOLVE_EIGENVALUES_SYMMETRIC_PROBLEM_INTERNAL_HPP__
+
+#include "Tines_HessenbergFormQ_Internal.hpp"
+#include "Tines_Internal.hpp"
+#include "Tines_SymmetricTridiagonalQL_Internal.hpp"
+#include "Tines_Tridiagonal_Internal.hpp"
+
+namespace Tines {
+
+  ///
+  /// Eigen decomposition of a real symmetric matrix A = V D V^T
+  ///   1) tridiagonal reduction A = Q T Q^T
+  ///   2) implicit QL iterations T = Z D Z^T
+  ///   3) eigenvectors V = Q Z
+  /// The eigenvalues are real and sorted in ascending order and the
+  /// eigenvectors are orthonormal. Only the lower triangular part of A is
+  /// referenced and A is overwritten. The workspace requires 3m.
+  ///
+  struct SolveEigenvaluesSymmetricProblemInternal {
+    template <typename MemberType, typename RealType>
+    KOKKOS_INLINE_FUNCTION static int
+    invoke(const MemberType &member, const int m, RealType *__restrict__ A,
+           const int as0, const int as1, RealType *__restrict__ e,
+           const int es, RealType *__restrict__ V, const int vs0,
+           const int vs1, RealType *__restrict__ W, const int wlen) {
+      using real_type = RealType;
+
+      Kokkos::single(Kokkos::PerTeam(member), [=]() {
+        TINES_CHECK_ERROR(wlen < 3 * m, "Error: workspace is too small");
+      });
+
+      /// subdiagonal f, tau t and work w; the QL sweeps reuse t and w
+      real_type *f = W, *t = W + m, *w = W + 2 * m;
+
+      /// step 1: A = Q T Q^T
+      TridiagonalInternal::invoke(member, m, A, as0, as1, t, 1, w);
+      member.team_barrier();
+      Kokkos::parallel_for(Kokkos::TeamVectorRange(member, m),
+                           [&](const int &i) {
+                             e[i * es] = A[i * (as0 + as1)];
+                             if (i < (m - 1))
+                               f[i] = A[(i + 1) * as0 + i * as1];
+                           });
+
+      /// V = Q
+      HessenbergFormQ_Internal::invoke(member, m, A, as0, as1, t, 1, V, vs0,
+                                       vs1, w);
+      member.team_barrier();
+
+      /// step 2-3: T = Z D Z^T and V := Q Z
+      const int r_val = SymmetricTridiagonalQL_Internal::invoke(
+        member, m, e, es, f, 1, V, vs0, vs1, t);
+      return r_val;
+    }
+
+    ///
+    /// Eigenvalues only; Q is not formed and the workspace requires 3m.
+    ///
+    template <typename MemberType, typename RealType>
+    KOKKOS_INLINE_FUNCTION static int
+    invoke(const MemberType &member, const int m, RealType *__restrict__ A,
+           const int as0, const int as1, RealType *__restrict__ e,
+           const int es, RealType *__restrict__ W, const int wlen) {
+      using real_type = RealType;
+
+      Kokkos::single(Kokkos::PerTeam(member), [=]() {
+        TINES_CHECK_ERROR(wlen < 3 * m, "Error: workspace is too small");
+      });
+
+      real_type *f = W, *t = W + m, *w = W + 2 * m;
+
+      /// step 1: A = Q T Q^T
+      TridiagonalInternal::invoke(member, m, A, as0, as1, t, 1, w);
+      member.team_barrier();
+      Kokkos::parallel_for(Kokkos::TeamVectorRange(member, m),
+                           [&](const int &i) {
+                             e[i * es] = A[i * (as0 + as1)];
+                             if (i < (m - 1))
+                               f[i] = A[(i + 1) * as0 + i * as1];
+                           });
+      member.team_barrier();
+
+      /// step 2: T = Z D Z^T without Z
+      const int r_val = SymmetricTridiagonalQL_Internal::invoke(
+        member, m, e, es, f, 1, (real_type *)nullptr, 0, 0, t);
+      return r_val;
+    }
+  };
+
+} // namespace Tines
+
+#endif
@@ -0,0 +1,102 @@
+/*----------------------------------------------------------------------------------
+Tines - Time Integrator, Newton and Eigen Solver -  version 1.0
+Copyright (2021) NTESS
+https://github.com/sandialabs/Tines
+
+Copyright 2021 National Technology & Engineering Solutions of Sandia, LLC (NTESS). 
+Under the terms of Contract DE-NA0003525 with NTESS, the U.S. Government retains 
+certain rights in this software.
+
+This file is part of Tines. Tines is open-source software: you can redistribute it
+and/or modify it under the terms of BSD 2-Clause License
+(https://opensource.org/licenses/BSD-2-Clause). A copy of the license is also
+provided under the main directory
+Questions? Kyungjoo Kim <kyukim@sandia.gov>, or
+	   Oscar Diaz-Ibarra at <odiazib@sandia.gov>, or
+	   Cosmin Safta at <csafta@sandia.gov>, or
+	   Habib Najm at <hnnajm@sandia.gov>
+
+Sandia National Laboratories, New Mexico, USA
+----------------------------------------------------------------------------------*/
+#ifndef __TINES_SOLVE_LU_INTERNAL_HPP__
+#define __TINES_SOLVE_LU_INTERNAL_HPP__
+
+#include "Tines_Internal.hpp"
+
+#include "Tines_ApplyPivot_Internal.hpp"
+#include "Tines_Copy_Internal.hpp"
+
+#include "Tines_Trsm_Internal.hpp"
+#include "Tines_Trsv_Internal.hpp"
+
+namespace Tines {
+
+  struct SolveLU_Internal {
+    ///
+    /// x = U^{-1} L^{-1} P b where LU factors are given by LU_Internal
+    ///
+    template <typename MemberType, typename ValueType, typename IntType>
+    KOKKOS_INLINE_FUNCTION static int
+    invoke(const MemberType &member, const int m, const ValueType *LU,
+           const int as0, const int as1, const IntType *p, const int ps0,
+           /* */ ValueType *x, const int xs0,
+           /* */ ValueType *b, const int bs0) {
+      using value_type = ValueType;
+      const value_type one(1);
+
+      /// x = P b
+      if (x != b) {
+        CopyInternal::invoke(member, m, b, bs0, x, xs0);
+        member.team_barrier();
+      }
+      ApplyPivotVectorForwardInternal::invoke(member, m, p, ps0, x, xs0);
+      member.team_barrier();
+
+      /// x = L^{-1} x
+      TrsvInternalLower::invoke(member, true, m, one, LU, as0, as1, x, xs0);
+      member.team_barrier();
+
+      /// x = U^{-1} x
+      TrsvInternalUpper::invoke(member, false, m, one, LU, as0, as1, x, xs0);
+      member.team_barrier();
+
+      return 0;
+    }
+
+    template <typename MemberType, typename ValueType, typename IntType>
+    KOKKOS_INLINE_FUNCTION static int
+    invoke(const MemberType &member, const int m, const int nrhs,
+           const ValueType *LU, const int as0, const int as1, const IntType *p,
+           const int ps0,
+           /* */ ValueType *X, const int xs0, const int xs1,
+           /* */ ValueType *B, const int bs0, const int bs1) {
+      using value_type = ValueType;
+      const value_type one(1);
+
+      /// X = P B
+      if (X != B) {
+        CopyInternal::invoke(member, Trans::NoTranspose(), m, nrhs, B, bs0, bs1,
+                             X, xs0, xs1);
+        member.team_barrier();
+      }
+      ApplyPivotMatrixForwardInternal::invoke(member, m, nrhs, p, ps0, X, xs0,
+                                              xs1);
+      member.team_barrier();
+
+      /// X = L^{-1} X
+      TrsmInternalLeftLower::invoke(member, true, m, nrhs, one, LU, as0, as1, X,
+                                    xs0, xs1);
+      member.team_barrier();
+
+      /// X = U^{-1} X
+      TrsmInternalLeftUpper::invoke(member, false, m, nrhs, one, LU, as0, as1,
+                                    X, xs0, xs1);
+      member.team_barrier();
+
+      return 0;
+    }
+  };
+
+} // namespace Tines
+
+#endif
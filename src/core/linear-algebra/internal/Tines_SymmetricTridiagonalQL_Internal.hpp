@@ -0,0 +1,214 @@
+/*----------------------------------------------------------------------------------
+Tines - Time Integrator, Newton and Eigen Solver -  version 1.0
+Copyright (2021) NTESS
+https://github.com/sandialabs/Tines
+
+Copyright 2021 National Technology & Engineering Solutions of Sandia, LLC (NTESS). 
+Under the terms of Contract DE-NA0003525 with NTESS, the U.S. Government retains 
+certain rights in this software.
+
+This file is part of Tines. Tines is open-source software: you can redistribute it
+and/or modify it under the terms of BSD 2-Clause License
+(https://opensource.org/licenses/BSD-2-Clause). A copy of the license is also
+provided under the main directory
+Questions? Kyungjoo Kim <kyukim@sandia.gov>, or
+	   Oscar Diaz-Ibarra at <odiazib@sandia.gov>, or
+	   Cosmin Safta at <csafta@sandia.gov>, or
+	   Habib Najm at <hnnajm@sandia.gov>
+
+Sandia National Laboratories, New Mexico, USA
+----------------------------------------------------------------------------------*/
+#ifndef __TINES_SYMMETRIC_TRIDIAGONAL_QL_INTERNAL_HPP__
+#define __TINES_SYMMETRIC_TRIDIAGONAL_QL_INTERNAL_HPP__
+
+#include "Tines_Internal.hpp"
+
+namespace Tines {
+
+  ///
+  /// Eigenvalues and eigenvectors of a symmetric tridiagonal matrix by the
+  /// implicit QL method with Wilkinson shifts (EISPACK tql2)
+  ///   T = Z D Z^T
+  /// Parameters:
+  ///   [in]m
+  ///     A dimension of the tridiagonal matrix T.
+  ///   [in/out]d, [in]ds
+  ///     Diagonal of T; on exit, eigenvalues in ascending order.
+  ///   [in/out]e, [in]es
+  ///     Subdiagonal of T, e(i) = T(i+1,i) for i = 0:m-2; e(m-1) is used as
+  ///     workspace. On exit, e is destroyed.
+  ///   [in/out]Z, [in]zs0, [in]zs1
+  ///     When Z is not a null pointer, the rotations are accumulated such
+  ///     that Z := Z Q where T = Q D Q^T; with Z = I on entry, the columns of
+  ///     Z are the eigenvectors of T and with the Q of the tridiagonal
+  ///     reduction of A, those are the eigenvectors of A.
+  ///   [in]w
+  ///     workspace of length 2m; the Givens rotations of a QL sweep are
+  ///     stored and they are applied to the rows of Z in parallel.
+  ///   [in]user_max_iteration(30)
+  ///     Maximum number of QL sweeps for an eigenvalue. When an eigenvalue
+  ///     does not converge, the routine returns -1.
+  ///
+  struct SymmetricTridiagonalQL_Internal {
+    template <typename MemberType, typename RealType>
+    KOKKOS_INLINE_FUNCTION static int
+    invoke(const MemberType &member, const int m,
+           /* */ RealType *__restrict__ d, const int ds,
+           /* */ RealType *__restrict__ e, const int es,
+           /* */ RealType *__restrict__ Z, const int zs0, const int zs1,
+           /* */ RealType *__restrict__ w, const int user_max_iteration = -1) {
+      using real_type = RealType;
+      using ats = ArithTraits<real_type>;
+
+      const real_type zero(0), one(1), two(2), eps = ats::epsilon();
+      const int max_iteration =
+        user_max_iteration < 0 ? 30 : user_max_iteration;
+      const bool wantz = Z != nullptr;
+
+      real_type *__restrict__ cs = w, *__restrict__ sn = w + m;
+
+      int r_val(0);
+      if (m <= 1)
+        return r_val;
+
+      Kokkos::single(Kokkos::PerTeam(member),
+                     [=]() { e[(m - 1) * es] = zero; });
+      member.team_barrier();
+
+      auto hypot = [](const real_type a, const real_type b) {
+        const real_type abs_a = ats::abs(a), abs_b = ats::abs(b);
+        const real_type big = abs_a > abs_b ? abs_a : abs_b,
+                        small = abs_a > abs_b ? abs_b : abs_a;
+        if (big == real_type(0))
+          return real_type(0);
+        const real_type r = small / big;
+        return big * ats::sqrt(real_type(1) + r * r);
+      };
+
+      for (int l = 0; l < m && r_val == 0; ++l) {
+        for (int iter = 0;; ++iter) {
+          /// a QL sweep on the unreduced block l:k; the rotations i = lo:k-1
+          /// are recorded and the block end k is returned; k = l means that
+          /// d(l) is converged
+          Kokkos::pair<int, int> range(l, l);
+          Kokkos::single(
+            Kokkos::PerTeam(member),
+            [=](Kokkos::pair<int, int> &val) {
+              int k = l;
+              for (; k < (m - 1); ++k) {
+                const real_type dd =
+                  ats::abs(d[k * ds]) + ats::abs(d[(k + 1) * ds]);
+                if (ats::abs(e[k * es]) <= eps * dd)
+                  break;
+              }
+              val.first = k;
+              val.second = k;
+              if (k == l || iter == max_iteration)
+                return;
+
+              /// Wilkinson shift
+              real_type g = (d[(l + 1) * ds] - d[l * ds]) / (two * e[l * es]);
+              real_type r = hypot(g, one);
+              g = d[k * ds] - d[l * ds] +
+                  e[l * es] / (g + (g < zero ? -ats::abs(r) : ats::abs(r)));
+
+              real_type s(1), c(1), p(0);
+              int i = k - 1;
+              for (; i >= l; --i) {
+                real_type f = s * e[i * es];
+                const real_type b = c * e[i * es];
+                r = hypot(f, g);
+                e[(i + 1) * es] = r;
+                if (r == zero) {
+                  /// recover from underflow
+                  d[(i + 1) * ds] -= p;
+                  e[k * es] = zero;
+                  break;
+                }
+                s = f / r;
+                c = g / r;
+                g = d[(i + 1) * ds] - p;
+                r = (d[i * ds] - g) * s + two * c * b;
+                p = s * r;
+                d[(i + 1) * ds] = g + p;
+                g = c * r - b;
+                cs[i] = c;
+                sn[i] = s;
+              }
+              val.second = i + 1;
+              if (r == zero && i >= l)
+                return;
+              d[l * ds] -= p;
+              e[l * es] = g;
+              e[k * es] = zero;
+            },
+            range);
+          member.team_barrier();
+
+          const int k = range.first, lo = range.second;
+          if (k == l)
+            break;
+          if (iter == max_iteration) {
+            r_val = -1;
+            break;
+          }
+
+          /// apply the rotations to the columns lo:k of Z; each row is
+          /// independent
+          if (wantz) {
+            Kokkos::parallel_for(
+              Kokkos::TeamVectorRange(member, m), [&](const int &r) {
+                real_type *z = Z + r * zs0;
+                for (int i = k - 1; i >= lo; --i) {
+                  const real_type f = z[(i + 1) * zs1], z_i = z[i * zs1];
+                  z[(i + 1) * zs1] = sn[i] * z_i + cs[i] * f;
+                  z[i * zs1] = cs[i] * z_i - sn[i] * f;
+                }
+              });
+            member.team_barrier();
+          }
+        }
+      }
+
+      /// sort eigenvalues in ascending order; the interchanges of the
+      /// selection sort are recorded and applied to the rows of Z
+      int *__restrict__ perm = (int *)w;
+      Kokkos::single(Kokkos::PerTeam(member), [=]() {
+        for (int i = 0; i < (m - 1); ++i) {
+          int k = i;
+          real_type p = d[i * ds];
+          for (int j = i + 1; j < m; ++j)
+            if (d[j * ds] < p) {
+              k = j;
+              p = d[j * ds];
+            }
+          perm[i] = k;
+          if (k != i) {
+            d[k * ds] = d[i * ds];
+            d[i * ds] = p;
+          }
+        }
+      });
+      member.team_barrier();
+      if (wantz) {
+        Kokkos::parallel_for(Kokkos::TeamVectorRange(member, m),
+                             [&](const int &r) {
+                               real_type *z = Z + r * zs0;
+                               for (int i = 0; i < (m - 1); ++i) {
+                                 const int k = perm[i];
+                                 if (k != i) {
+                                   const real_type tmp = z[i * zs1];
+                                   z[i * zs1] = z[k * zs1];
+                                   z[k * zs1] = tmp;
+                                 }
+                               }
+                             });
+        member.team_barrier();
+      }
+      return r_val;
+    }
+  };
+
+} // namespace Tines
+
+#endif
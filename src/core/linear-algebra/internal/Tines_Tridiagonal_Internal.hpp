@@ -0,0 +1,127 @@
+/*----------------------------------------------------------------------------------
+Tines - Time Integrator, Newton and Eigen Solver -  version 1.0
+Copyright (2021) NTESS
+https://github.com/sandialabs/Tines
+
+Copyright 2021 National Technology & Engineering Solutions of Sandia, LLC (NTESS). 
+Under the terms of Contract DE-NA0003525 with NTESS, the U.S. Government retains 
+certain rights in this software.
+
+This file is part of Tines. Tines is open-source software: you can redistribute it
+and/or modify it under the terms of BSD 2-Clause License
+(https://opensource.org/licenses/BSD-2-Clause). A copy of the license is also
+provided under the main directory
+Questions? Kyungjoo Kim <kyukim@sandia.gov>, or
+	   Oscar Diaz-Ibarra at <odiazib@sandia.gov>, or
+	   Cosmin Safta at <csafta@sandia.gov>, or
+	   Habib Najm at <hnnajm@sandia.gov>
+
+Sandia National Laboratories, New Mexico, USA
+----------------------------------------------------------------------------------*/
+#ifndef __TINES_TRIDIAGONAL_INTERNAL_HPP__
+#define __TINES_TRIDIAGONAL_INTERNAL_HPP__
+
+#include "Tines_Householder_Internal.hpp"
+#include "Tines_Internal.hpp"
+
+namespace Tines {
+
+  ///
+  /// Householder reduction of a symmetric matrix to tridiagonal form
+  ///   A = Q T Q^T
+  /// Parameters:
+  ///   [in]m
+  ///     A dimension of the square matrix A.
+  ///   [in/out]A, [in]as0, [in]as1
+  ///     Real symmetric matrix A(m x m) of which the lower triangular part is
+  ///     referenced. On exit, the diagonal and the first subdiagonal hold T
+  ///     and the Householder vectors are stored below the first subdiagonal
+  ///     in the same way as the Hessenberg reduction; Q is formed by
+  ///     HessenbergFormQ_Internal. The strictly upper triangular part is
+  ///     overwritten.
+  ///   [out]t, [in]ts
+  ///     tau of m-1 Householder reflectors.
+  ///   [in]w
+  ///     workspace of length m.
+  ///
+  struct TridiagonalInternal {
+    template <typename MemberType, typename RealType>
+    KOKKOS_INLINE_FUNCTION static int
+    invoke(const MemberType &member, const int m,
+           /* */ RealType *__restrict__ A, const int as0, const int as1,
+           /* */ RealType *__restrict__ t, const int ts,
+           /* */ RealType *__restrict__ w) {
+      using real_type = RealType;
+      const real_type one(1), half(0.5);
+
+      /// the update below uses the full matrix; copy the lower triangular
+      /// part to the upper triangular part
+      Kokkos::parallel_for(
+        Kokkos::TeamThreadRange(member, m), [&](const int &i) {
+          Kokkos::parallel_for(Kokkos::ThreadVectorRange(member, i),
+                               [&](const int &j) {
+                                 A[j * as0 + i * as1] = A[i * as0 + j * as1];
+                               });
+        });
+      member.team_barrier();
+
+      for (int k = 0; k < (m - 1); ++k) {
+        const int n = m - k - 1;
+        real_type *a21 = A + (k + 1) * as0 + k * as1,
+                  *A22 = A + (k + 1) * (as0 + as1), *tau = t + k * ts;
+
+        /// u = [1; u2] and H = I - u u^T / tau
+        LeftHouseholderInternal::invoke(member, n - 1, a21, a21 + as0, as0,
+                                        tau);
+        member.team_barrier();
+
+        auto u = [a21, as0, one](const int i) -> real_type {
+          return i == 0 ? one : a21[i * as0];
+        };
+        const real_type inv_tau = one / *tau;
+
+        /// p = A22 u / tau
+        Kokkos::parallel_for(
+          Kokkos::TeamThreadRange(member, n), [&](const int &i) {
+            real_type val(0);
+            Kokkos::parallel_reduce(
+              Kokkos::ThreadVectorRange(member, n),
+              [&](const int &j, real_type &update) {
+                update += A22[i * as0 + j * as1] * u(j);
+              },
+              val);
+            Kokkos::single(Kokkos::PerThread(member),
+                           [&]() { w[i] = val * inv_tau; });
+          });
+        member.team_barrier();
+
+        /// q = p - (u^T p / 2 tau) u
+        real_type alpha(0);
+        Kokkos::parallel_reduce(
+          Kokkos::TeamVectorRange(member, n),
+          [&](const int &i, real_type &update) { update += u(i) * w[i]; },
+          alpha);
+        alpha *= half * inv_tau;
+        Kokkos::parallel_for(Kokkos::TeamVectorRange(member, n),
+                             [&](const int &i) { w[i] -= alpha * u(i); });
+        member.team_barrier();
+
+        /// A22 := H A22 H = A22 - u q^T - q u^T
+        Kokkos::parallel_for(
+          Kokkos::TeamThreadRange(member, n), [&](const int &i) {
+            const real_type u_i = u(i), q_i = w[i];
+            Kokkos::parallel_for(Kokkos::ThreadVectorRange(member, n),
+                                 [&](const int &j) {
+                                   A22[i * as0 + j * as1] -=
+                                     (u_i * w[j] + q_i * u(j));
+                                 });
+          });
+        member.team_barrier();
+      }
+      return 0;
+    }
+  };
+
+} // namespace Tines
+
+#endif
@@ -0,0 +1,120 @@
+/*----------------------------------------------------------------------------------
+Tines - Time Integrator, Newton and Eigen Solver -  version 1.0
+Copyright (2021) NTESS
+https://github.com/sandialabs/Tines
+
+Copyright 2021 National Technology & Engineering Solutions of Sandia, LLC (NTESS). 
+Under the terms of Contract DE-NA0003525 with NTESS, the U.S. Government retains 
+certain rights in this software.
+
+This file is part of Tines. Tines is open-source software: you can redistribute it
+and/or modify it under the terms of BSD 2-Clause License
+(https://opensource.org/licenses/BSD-2-Clause). A copy of the license is also
+provided under the main directory
+Questions? Kyungjoo Kim <kyukim@sandia.gov>, or
+	   Oscar Diaz-Ibarra at <odiazib@sandia.gov>, or
+	   Cosmin Safta at <csafta@sandia.gov>, or
+	   Habib Najm at <hnnajm@sandia.gov>
+
+Sandia National Laboratories, New Mexico, USA
+----------------------------------------------------------------------------------*/
+#ifndef __TINES_BDF_HPP__
+#define __TINES_BDF_HPP__
+
+namespace Tines {
+
+  ///
+  /// Nordsieck array of the variable order BDF methods (orders 1 - 5)
+  /// - row j of z stores dt^j u^{(j)} / j! of the m variables
+  /// - the corrector uses the fixed coefficients of the constant step BDF
+  ///   and a step size change rescales the array (Hindmarsh, LSODE)
+  ///
+  template <typename RealType> struct BDF_Nordsieck {
+    using real_type = RealType;
+
+    static constexpr int max_order = 5;
+
+    ///
+    /// coefficients l of order q; l(x) = prod_{i=1}^{q} (1 + x/i) normalized
+    /// with l_1 = 1 so that the corrected array is z + l e where
+    /// e = dt f(u) - z_1 of the predicted array
+    ///
+    KOKKOS_INLINE_FUNCTION
+    static void computeCoefficients(const int q, /* */ real_type *l) {
+      for (int j = 0; j <= max_order; ++j)
+        l[j] = real_type(0);
+      l[0] = real_type(1);
+      for (int i = 1; i <= q; ++i)
+        for (int j = i; j > 0; --j)
+          l[j] += l[j - 1] / real_type(i);
+      const real_type l1 = l[1];
+      for (int j = 0; j <= q; ++j)
+        l[j] /= l1;
+    }
+
+    /// l_0 of order q; 1 / sum_{i=1}^{q} 1/i
+    KOKKOS_INLINE_FUNCTION
+    static real_type getLeadingCoefficient(const int q) {
+      real_type val(0);
+      for (int i = 1; i <= q; ++i)
+        val += real_type(1) / real_type(i);
+      return real_type(1) / val;
+    }
+
+    KOKKOS_INLINE_FUNCTION
+    static real_type getFactorial(const int q) {
+      real_type val(1);
+      for (int i = 2; i <= q; ++i)
+        val *= real_type(i);
+      return val;
+    }
+
+    /// z = z P where P is the Pascal triangle matrix; Taylor expansion to the
+    /// next time step
+    template <typename MemberType, typename ZViewType>
+    KOKKOS_INLINE_FUNCTION static void predict(const MemberType &member,
+                                               const int q, const int m,
+                                               const ZViewType &z) {
+      Kokkos::parallel_for(Kokkos::TeamVectorRange(member, m),
+                           [&](const int &k) {
+                             for (int i = 0; i < q; ++i)
+                               for (int j = q; j > i; --j)
+                                 z(j - 1, k) += z(j, k);
+                           });
+      member.team_barrier();
+    }
+
+    /// inverse of predict; the array is restored for a retried time step
+    template <typename MemberType, typename ZViewType>
+    KOKKOS_INLINE_FUNCTION static void retract(const MemberType &member,
+                                               const int q, const int m,
+                                               const ZViewType &z) {
+      Kokkos::parallel_for(Kokkos::TeamVectorRange(member, m),
+                           [&](const int &k) {
+                             for (int i = 0; i < q; ++i)
+                               for (int j = q; j > i; --j)
+                                 z(j - 1, k) -= z(j, k);
+                           });
+      member.team_barrier();
+    }
+
+    /// z_j = eta^j z_j for the time step size changed by the factor eta
+    template <typename MemberType, typename ZViewType>
+    KOKKOS_INLINE_FUNCTION static void
+    rescale(const MemberType &member, const int q, const int m,
+            const real_type &eta, const ZViewType &z) {
+      Kokkos::parallel_for(Kokkos::TeamVectorRange(member, m),
+                           [&](const int &k) {
+                             real_type scale(1);
+                             for (int j = 1; j <= q; ++j) {
+                               scale *= eta;
+                               z(j, k) *= scale;
+                             }
+                           });
+      member.team_barrier();
+    }
+  };
+
+} // namespace Tines
+
+#endif
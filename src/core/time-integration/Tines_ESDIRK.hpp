@@ -0,0 +1,281 @@
+/*----------------------------------------------------------------------------------
+Tines - Time Integrator, Newton and Eigen Solver -  version 1.0
+Copyright (2021) NTESS
+https://github.com/sandialabs/Tines
+
+Copyright 2021 National Technology & Engineering Solutions of Sandia, LLC (NTESS). 
+Under the terms of Contract DE-NA0003525 with NTESS, the U.S. Government retains 
+certain rights in this software.
+
+This file is part of Tines. Tines is open-source software: you can redistribute it
+and/or modify it under the terms of BSD 2-Clause License
+(https://opensource.org/licenses/BSD-2-Clause). A copy of the license is also
+provided under the main directory
+Questions? Kyungjoo Kim <kyukim@sandia.gov>, or
+	   Oscar Diaz-Ibarra at <odiazib@sandia.gov>, or
+	   Cosmin Safta at <csafta@sandia.gov>, or
+	   Habib Najm at <hnnajm@sandia.gov>
+
+Sandia National Laboratories, New Mexico, USA
+----------------------------------------------------------------------------------*/
+#ifndef __TINES_ESDIRK_HPP__
+#define __TINES_ESDIRK_HPP__
+
+namespace Tines {
+
+  ///
+  /// Butcher tableau of a stiffly accurate ESDIRK method with an embedded
+  /// error estimate
+  /// - the first stage is explicit and the diagonal of A is gamma
+  /// - b is the last row of A (stiffly accurate) and bhat is the embedded
+  ///   weights
+  ///
+  template <typename RealType> struct ESDIRK_Tableau {
+    using real_type = RealType;
+
+    static constexpr int max_number_of_stages = 6;
+
+    /// available methods (Kennedy and Carpenter)
+    enum : int {
+      /// ESDIRK3(2)4L[2]SA; order 3 with embedded order 2
+      ESDIRK32 = 0,
+      /// ESDIRK4(3)6L[2]SA; order 4 with embedded order 3
+      ESDIRK43 = 1
+    };
+
+    int _number_of_stages, _order, _embedded_order;
+    real_type _gamma;
+    real_type _A[max_number_of_stages][max_number_of_stages];
+    real_type _bhat[max_number_of_stages], _c[max_number_of_stages];
+
+    KOKKOS_INLINE_FUNCTION
+    ESDIRK_Tableau(const int method = ESDIRK32) {
+      for (int i = 0; i < max_number_of_stages; ++i) {
+        for (int j = 0; j < max_number_of_stages; ++j)
+          _A[i][j] = real_type(0);
+        _bhat[i] = real_type(0);
+        _c[i] = real_type(0);
+      }
+      switch (method) {
+      case ESDIRK43:
+        setESDIRK43();
+        break;
+      case ESDIRK32:
+      default:
+        setESDIRK32();
+        break;
+      }
+      for (int i = 0; i < _number_of_stages; ++i)
+        for (int j = 0; j <= i; ++j)
+          _c[i] += _A[i][j];
+    }
+
+    KOKKOS_INLINE_FUNCTION
+    int getNumberOfStages() const { return _number_of_stages; }
+
+    /// b_i - bhat_i; the weights of the error estimate
+    KOKKOS_INLINE_FUNCTION
+    real_type getErrorWeight(const int i) const {
+      return _A[_number_of_stages - 1][i] - _bhat[i];
+    }
+
+    KOKKOS_INLINE_FUNCTION
+    void setESDIRK32() {
+      const real_type g(1767732205903.0 / 4055673282236.0);
+      _number_of_stages = 4;
+      _order = 3;
+      _embedded_order = 2;
+      _gamma = g;
+
+      _A[1][0] = g;
+      _A[1][1] = g;
+
+      _A[2][0] = 2746238789719.0 / 10658868560708.0;
+      _A[2][1] = -640167445237.0 / 6845629431997.0;
+      _A[2][2] = g;
+
+      _A[3][0] = 1471266399579.0 / 7840856788654.0;
+      _A[3][1] = -4482444167858.0 / 7529755066697.0;
+      _A[3][2] = 11266239266428.0 / 11593286722821.0;
+      _A[3][3] = g;
+
+      _bhat[0] = 2756255671327.0 / 12835298489170.0;
+      _bhat[1] = -10771552573575.0 / 22201958757719.0;
+      _bhat[2] = 9247589265047.0 / 10645013368117.0;
+      _bhat[3] = 2193209047091.0 / 5459859503100.0;
+    }
+
+    KOKKOS_INLINE_FUNCTION
+    void setESDIRK43() {
+      const real_type g(0.25);
+      _number_of_stages = 6;
+      _order = 4;
+      _embedded_order = 3;
+      _gamma = g;
+
+      _A[1][0] = g;
+      _A[1][1] = g;
+
+      _A[2][0] = 8611.0 / 62500.0;
+      _A[2][1] = -1743.0 / 31250.0;
+      _A[2][2] = g;
+
+      _A[3][0] = 5012029.0 / 34652500.0;
+      _A[3][1] = -654441.0 / 2922500.0;
+      _A[3][2] = 174375.0 / 388108.0;
+      _A[3][3] = g;
+
+      _A[4][0] = 15267082809.0 / 155376265600.0;
+      _A[4][1] = -71443401.0 / 120774400.0;
+      _A[4][2] = 730878875.0 / 902184768.0;
+      _A[4][3] = 2285395.0 / 8070912.0;
+      _A[4][4] = g;
+
+      _A[5][0] = 82889.0 / 524892.0;
+      _A[5][1] = 0.0;
+      _A[5][2] = 15625.0 / 83664.0;
+      _A[5][3] = 69875.0 / 102672.0;
+      _A[5][4] = -2260.0 / 8211.0;
+      _A[5][5] = g;
+
+      _bhat[0] = 4586570599.0 / 29645900160.0;
+      _bhat[1] = 0.0;
+      _bhat[2] = 178811875.0 / 945068544.0;
+      _bhat[3] = 814220225.0 / 1159782912.0;
+      _bhat[4] = -3700637.0 / 11593932.0;
+      _bhat[5] = 61727.0 / 225920.0;
+    }
+  };
+
+  ///
+  /// Nonlinear problem of an implicit ESDIRK stage
+  ///   z - dt gamma f(z) - rhs = 0 for time ODEs
+  ///   g(z) = 0 for constraints
+  /// where rhs = u_n + dt sum_{j<i} a_ij k_j; the given z is used as the
+  /// initial guess of the Newton solver. The BDF corrector has the same form
+  /// and is solved with this problem (TimeIntegratorBDF)
+  ///
+  template <typename ValueType, typename DeviceType,
+            template <typename, typename> class ProblemType>
+  struct ESDIRK_Stage {
+    using value_type = ValueType;
+    using device_type = DeviceType;
+    using scalar_type = typename ats<value_type>::scalar_type;
+
+    using real_type = scalar_type;
+    using real_type_1d_view_type = value_type_1d_view<real_type, device_type>;
+    using real_type_2d_view_type = value_type_2d_view<real_type, device_type>;
+
+    using problem_type = ProblemType<value_type, device_type>;
+
+    /// compile-time number of equations of the problem (0 if unknown)
+    static constexpr int static_number_of_equations =
+      ProblemStaticNumberOfEquations<problem_type>::value;
+
+    problem_type _problem;
+
+    /// dt gamma
+    real_type _scale;
+    real_type_1d_view_type _rhs;
+
+    /// optional; when it is given, the problem Jacobian is kept here
+    real_type_2d_view_type _Jprob;
+
+    KOKKOS_INLINE_FUNCTION
+    ESDIRK_Stage() : _problem(), _scale(), _rhs(), _Jprob() {}
+
+    KOKKOS_INLINE_FUNCTION
+    int getNumberOfTimeODEs() const { return _problem.getNumberOfTimeODEs(); }
+
+    KOKKOS_INLINE_FUNCTION
+    int getNumberOfConstraints() const {
+      return _problem.getNumberOfConstraints();
+    }
+
+    KOKKOS_INLINE_FUNCTION
+    int getNumberOfEquations() const { return _problem.getNumberOfEquations(); }
+
+    template <typename MemberType>
+    KOKKOS_INLINE_FUNCTION void
+    computeInitValues(const MemberType &member,
+                      const real_type_1d_view_type &u) const {
+      /// do nothing; u is initialized by the time integrator
+    }
+
+    /// the iteration matrix is I - scale * J_prob for time ODEs
+    KOKKOS_INLINE_FUNCTION
+    real_type getJacobianScale() const { return _scale; }
+
+    template <typename MemberType>
+    KOKKOS_INLINE_FUNCTION void
+    computeIterationMatrix(const MemberType &member,
+                           const real_type_2d_view_type &J) const {
+      const real_type one(1), zero(0);
+      const int m = _problem.getNumberOfTimeODEs(),
+                n = _problem.getNumberOfEquations();
+
+      Kokkos::parallel_for(
+        Kokkos::TeamThreadRange(member, m), [&](const int &i) {
+          Kokkos::parallel_for(Kokkos::ThreadVectorRange(member, n),
+                               [&](const int &j) {
+                                 const real_type val = J(i, j);
+                                 J(i, j) = (i == j ? one : zero) - _scale * val;
+                               });
+        });
+      member.team_barrier();
+    }
+
+    template <typename MemberType>
+    KOKKOS_INLINE_FUNCTION void
+    computeJacobian(const MemberType &member, const real_type_1d_view_type &u,
+                    const real_type_2d_view_type &J) const {
+      /// evaluate problem Jacobian (n x n)
+      _problem.computeJacobian(member, u, J);
+
+      /// keep the problem Jacobian for reuse
+      if (_Jprob.span() > 0) {
+        const int n = _problem.getNumberOfEquations();
+        CopyInternal::invoke(member, Trans::NoTranspose(), n, n, J.data(),
+                             J.stride(0), J.stride(1), _Jprob.data(),
+                             _Jprob.stride(0), _Jprob.stride(1));
+        member.team_barrier();
+      }
+
+      computeIterationMatrix(member, J);
+    }
+
+    /// J is computed from the kept problem Jacobian with the current scale
+    template <typename MemberType>
+    KOKKOS_INLINE_FUNCTION void
+    computeJacobianUsingCache(const MemberType &member,
+                              const real_type_2d_view_type &J) const {
+      const int n = _problem.getNumberOfEquations();
+      CopyInternal::invoke(member, Trans::NoTranspose(), n, n, _Jprob.data(),
+                           _Jprob.stride(0), _Jprob.stride(1), J.data(),
+                           J.stride(0), J.stride(1));
+      member.team_barrier();
+      computeIterationMatrix(member, J);
+    }
+
+    template <typename MemberType>
+    KOKKOS_INLINE_FUNCTION void
+    computeFunction(const MemberType &member, const real_type_1d_view_type &u,
+                    const real_type_1d_view_type &f) const {
+      const int m = _problem.getNumberOfTimeODEs();
+
+      /// evaluate problem function (n x 1)
+      _problem.computeFunction(member, u, f);
+
+      /// modify time ODE parts for the implicit stage
+      Kokkos::parallel_for(Kokkos::TeamVectorRange(member, m),
+                           [&](const int &i) {
+                             const real_type val = f(i);
+                             f(i) = (u(i) - _rhs(i)) - _scale * val;
+                           });
+      member.team_barrier();
+    }
+  };
+
+} // namespace Tines
+
+#endif
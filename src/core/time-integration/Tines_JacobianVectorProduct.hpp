@@ -0,0 +1,153 @@
+/*----------------------------------------------------------------------------------
+Tines - Time Integrator, Newton and Eigen Solver -  version 1.0
+Copyright (2021) NTESS
+https://github.com/sandialabs/Tines
+
+Copyright 2021 National Technology & Engineering Solutions of Sandia, LLC (NTESS). 
+Under the terms of Contract DE-NA0003525 with NTESS, the U.S. Government retains 
+certain rights in this software.
+
+This file is part of Tines. Tines is open-source software: you can redistribute it
+and/or modify it under the terms of BSD 2-Clause License
+(https://opensource.org/licenses/BSD-2-Clause). A copy of the license is also
+provided under the main directory
+Questions? Kyungjoo Kim <kyukim@sandia.gov>, or
+	   Oscar Diaz-Ibarra at <odiazib@sandia.gov>, or
+	   Cosmin Safta at <csafta@sandia.gov>, or
+	   Habib Najm at <hnnajm@sandia.gov>
+
+Sandia National Laboratories, New Mexico, USA
+----------------------------------------------------------------------------------*/
+#ifndef __TINES_JACOBIAN_VECTOR_PRODUCT_HPP__
+#define __TINES_JACOBIAN_VECTOR_PRODUCT_HPP__
+
+namespace Tines {
+
+  ///
+  /// Jv = J(x) v using a single directional derivative of f with
+  /// SFad<real_type,1>; the jacobian is not formed. The problem should
+  /// provide computeFunction templated on the view types (see SacadoJacobian)
+  ///
+  template <typename ValueType, typename DeviceType>
+  struct JacobianVectorProductSacado {
+    using value_type = ValueType;
+    using device_type = DeviceType;
+    using scalar_type = typename ats<value_type>::scalar_type;
+
+    using real_type = scalar_type;
+    using real_type_1d_view_type = value_type_1d_view<real_type, device_type>;
+
+    using fad_type = Sacado::Fad::SFad<real_type, 1>;
+    using fad_type_1d_view_type = value_type_1d_view<fad_type, device_type>;
+
+    static_assert(!ats<value_type>::is_sacado,
+                  "ValueType should be a built-in scalar type");
+
+    KOKKOS_INLINE_FUNCTION
+    static void workspace(const int m, int &wlen) { wlen = 4 * m; }
+
+    /// f is f(x), which is not used for the AD product
+    template <typename MemberType, typename ProblemType>
+    KOKKOS_INLINE_FUNCTION static void
+    invoke(const MemberType &member, const ProblemType &problem,
+           const real_type_1d_view_type &x, const real_type_1d_view_type &f,
+           const real_type_1d_view_type &v, const real_type_1d_view_type &Jv,
+           const real_type_1d_view_type &work) {
+      const int m = problem.getNumberOfEquations();
+
+      real_type *wptr = work.data();
+      fad_type_1d_view_type xs(wptr, m, 2);
+      wptr += 2 * m;
+      fad_type_1d_view_type fs(wptr, m, 2);
+      wptr += 2 * m;
+      assert(int(wptr - work.data()) <= int(work.span()) &&
+             "Error: workspace is smaller than required");
+
+      /// seed the direction v
+      Kokkos::parallel_for(Kokkos::TeamVectorRange(member, m),
+                           [&](const int &i) {
+                             xs(i) = fad_type(1, x(i));
+                             xs(i).fastAccessDx(0) = v(i);
+                           });
+      member.team_barrier();
+
+      problem.computeFunction(member, xs, fs);
+      member.team_barrier();
+
+      Kokkos::parallel_for(
+        Kokkos::TeamVectorRange(member, m),
+        [&](const int &i) { Jv(i) = fs(i).fastAccessDx(0); });
+      member.team_barrier();
+    }
+  };
+
+  ///
+  /// Jv = (f(x + h v) - f(x)) / h with h = sqrt(eps) (1 + |x|) / |v|
+  ///
+  template <typename ValueType, typename DeviceType>
+  struct JacobianVectorProductFiniteDifference {
+    using value_type = ValueType;
+    using device_type = DeviceType;
+    using scalar_type = typename ats<value_type>::scalar_type;
+
+    using real_type = scalar_type;
+    using real_type_1d_view_type = value_type_1d_view<real_type, device_type>;
+
+    KOKKOS_INLINE_FUNCTION
+    static void workspace(const int m, int &wlen) { wlen = 2 * m; }
+
+    template <typename MemberType, typename ProblemType>
+    KOKKOS_INLINE_FUNCTION static void
+    invoke(const MemberType &member, const ProblemType &problem,
+           const real_type_1d_view_type &x, const real_type_1d_view_type &f,
+           const real_type_1d_view_type &v, const real_type_1d_view_type &Jv,
+           const real_type_1d_view_type &work) {
+      using ats_real = ats<real_type>;
+      const int m = problem.getNumberOfEquations();
+      const real_type zero(0), one(1);
+
+      real_type *wptr = work.data();
+      real_type_1d_view_type xh(wptr, m);
+      wptr += m;
+      real_type_1d_view_type fh(wptr, m);
+      wptr += m;
+      assert(int(wptr - work.data()) <= int(work.span()) &&
+             "Error: workspace is smaller than required");
+
+      real_type norm_x(0), norm_v(0);
+      Kokkos::parallel_reduce(
+        Kokkos::TeamVectorRange(member, m),
+        [&](const int &i, real_type &update) { update += x(i) * x(i); },
+        norm_x);
+      Kokkos::parallel_reduce(
+        Kokkos::TeamVectorRange(member, m),
+        [&](const int &i, real_type &update) { update += v(i) * v(i); },
+        norm_v);
+      norm_x = ats_real::sqrt(norm_x);
+      norm_v = ats_real::sqrt(norm_v);
+
+      if (norm_v == zero) {
+        Kokkos::parallel_for(Kokkos::TeamVectorRange(member, m),
+                             [&](const int &i) { Jv(i) = zero; });
+      } else {
+        const real_type h =
+          ats_real::sqrt(ats_real::epsilon()) * (one + norm_x) / norm_v;
+        Kokkos::parallel_for(Kokkos::TeamVectorRange(member, m),
+                             [&](const int &i) { xh(i) = x(i) + h * v(i); });
+        member.team_barrier();
+
+        problem.computeFunction(member, xh, fh);
+        member.team_barrier();
+
+        const real_type hinv = one / h;
+        Kokkos::parallel_for(
+          Kokkos::TeamVectorRange(member, m),
+          [&](const int &i) { Jv(i) = (fh(i) - f(i)) * hinv; });
+      }
+      member.team_barrier();
+    }
+  };
+
+} // namespace Tines
+
+#endif
@@ -0,0 +1,470 @@
+/*----------------------------------------------------------------------------------
+Tines - Time Integrator, Newton and Eigen Solver -  version 1.0
+Copyright (2021) NTESS
+https://github.com/sandialabs/Tines
+
+Copyright 2021 National Technology & Engineering Solutions of Sandia, LLC (NTESS). 
+Under the terms of Contract DE-NA0003525 with NTESS, the U.S. Government retains 
+certain rights in this software.
+
+This file is part of Tines. Tines is open-source software: you can redistribute it
+and/or modify it under the terms of BSD 2-Clause License
+(https://opensource.org/licenses/BSD-2-Clause). A copy of the license is also
+provided under the main directory
+Questions? Kyungjoo Kim <kyukim@sandia.gov>, or
+	   Oscar Diaz-Ibarra at <odiazib@sandia.gov>, or
+	   Cosmin Safta at <csafta@sandia.gov>, or
+	   Habib Najm at <hnnajm@sandia.gov>
+
+Sandia National Laboratories, New Mexico, USA
+----------------------------------------------------------------------------------*/
+#ifndef __TINES_NEWTON_KRYLOV_SOLVER_HPP__
+#define __TINES_NEWTON_KRYLOV_SOLVER_HPP__
+
+namespace Tines {
+
+  ///
+  /// Block Jacobi preconditioner for the Newton-Krylov solver; the problem
+  /// provides the block diagonal part of an (approximate) jacobian
+  ///   P(i,j) = J(i, (i/BlockSize)*BlockSize + j), j < BlockSize
+  /// through
+  ///   template <typename MemberType>
+  ///   KOKKOS_INLINE_FUNCTION void
+  ///   computeJacobianBlockDiagonal(const MemberType &member,
+  ///                                const real_type_1d_view_type &x,
+  ///                                const real_type_2d_view_type &P) const;
+  /// BlockSize = 1 is a diagonal scaling and BlockSize = m uses a dense
+  /// user-supplied approximate jacobian. BlockSize = 0 is no preconditioning
+  /// and the problem does not need to provide the block diagonal.
+  ///
+  template <typename ValueType, typename DeviceType, int BlockSize>
+  struct NewtonKrylovPreconditioner {
+    using value_type = ValueType;
+    using device_type = DeviceType;
+    using scalar_type = typename ats<value_type>::scalar_type;
+
+    using real_type = scalar_type;
+    using real_type_1d_view_type = value_type_1d_view<real_type, device_type>;
+    using real_type_2d_view_type = value_type_2d_view<real_type, device_type>;
+
+    /// blocks and pivots
+    KOKKOS_INLINE_FUNCTION
+    static void workspace(const int m, int &wlen) {
+      wlen = m * BlockSize + m;
+    }
+
+    /// compute and factorize the blocks (LU with partial pivoting) where a
+    /// team thread factorizes a block
+    template <typename MemberType, typename ProblemType>
+    KOKKOS_INLINE_FUNCTION static void
+    compute(const MemberType &member, const ProblemType &problem,
+            const real_type_1d_view_type &x,
+            const real_type_1d_view_type &work) {
+      using ats_real = ats<real_type>;
+      const int m = problem.getNumberOfEquations();
+      const int nblocks = (m + BlockSize - 1) / BlockSize;
+      const real_type zero(0), one(1);
+
+      real_type *P = work.data();
+      int *piv = (int *)(P + m * BlockSize);
+      problem.computeJacobianBlockDiagonal(
+        member, x, real_type_2d_view_type(P, m, BlockSize));
+      member.team_barrier();
+
+      Kokkos::parallel_for(
+        Kokkos::TeamThreadRange(member, nblocks), [&](const int &b) {
+          Kokkos::single(Kokkos::PerThread(member), [&]() {
+            const int r0 = b * BlockSize,
+                      mb = (m - r0) < BlockSize ? (m - r0) : BlockSize;
+            real_type *A = P + r0 * BlockSize;
+            int *p = piv + r0;
+            for (int k = 0; k < mb; ++k) {
+              int ip = k;
+              for (int i = k + 1; i < mb; ++i)
+                if (ats_real::abs(A[i * BlockSize + k]) >
+                    ats_real::abs(A[ip * BlockSize + k]))
+                  ip = i;
+              p[k] = ip;
+              if (ip != k)
+                for (int j = 0; j < mb; ++j) {
+                  const real_type tmp = A[k * BlockSize + j];
+                  A[k * BlockSize + j] = A[ip * BlockSize + j];
+                  A[ip * BlockSize + j] = tmp;
+                }
+              /// a singular block falls back to the identity on the pivot
+              if (A[k * BlockSize + k] == zero)
+                A[k * BlockSize + k] = one;
+              const real_type inv_akk = one / A[k * BlockSize + k];
+              for (int i = k + 1; i < mb; ++i) {
+                const real_type lik = A[i * BlockSize + k] * inv_akk;
+                A[i * BlockSize + k] = lik;
+                for (int j = k + 1; j < mb; ++j)
+                  A[i * BlockSize + j] -= lik * A[k * BlockSize + j];
+              }
+            }
+          });
+        });
+      member.team_barrier();
+    }
+
+    /// z = P^{-1} v; v and z can be the same
+    template <typename MemberType>
+    KOKKOS_INLINE_FUNCTION static void
+    apply(const MemberType &member, const int m,
+          const real_type_1d_view_type &v, const real_type_1d_view_type &z,
+          const real_type_1d_view_type &work) {
+      const int nblocks = (m + BlockSize - 1) / BlockSize;
+      const real_type *P = work.data();
+      const int *piv = (const int *)(P + m * BlockSize);
+
+      Kokkos::parallel_for(
+        Kokkos::TeamThreadRange(member, nblocks), [&](const int &b) {
+          Kokkos::single(Kokkos::PerThread(member), [&]() {
+            const int r0 = b * BlockSize,
+                      mb = (m - r0) < BlockSize ? (m - r0) : BlockSize;
+            const real_type *A = P + r0 * BlockSize;
+            const int *p = piv + r0;
+            real_type y[BlockSize] = {};
+            for (int i = 0; i < mb; ++i)
+              y[i] = v(r0 + i);
+            for (int k = 0; k < mb; ++k) {
+              const real_type tmp = y[k];
+              y[k] = y[p[k]];
+              y[p[k]] = tmp;
+            }
+            for (int i = 1; i < mb; ++i)
+              for (int j = 0; j < i; ++j)
+                y[i] -= A[i * BlockSize + j] * y[j];
+            for (int i = mb - 1; i >= 0; --i) {
+              for (int j = i + 1; j < mb; ++j)
+                y[i] -= A[i * BlockSize + j] * y[j];
+              y[i] /= A[i * BlockSize + i];
+            }
+            for (int i = 0; i < mb; ++i)
+              z(r0 + i) = y[i];
+          });
+        });
+      member.team_barrier();
+    }
+  };
+
+  template <typename ValueType, typename DeviceType>
+  struct NewtonKrylovPreconditioner<ValueType, DeviceType, 0> {
+    using value_type = ValueType;
+    using device_type = DeviceType;
+    using scalar_type = typename ats<value_type>::scalar_type;
+
+    using real_type = scalar_type;
+    using real_type_1d_view_type = value_type_1d_view<real_type, device_type>;
+
+    KOKKOS_INLINE_FUNCTION
+    static void workspace(const int m, int &wlen) { wlen = 0; }
+
+    template <typename MemberType, typename ProblemType>
+    KOKKOS_INLINE_FUNCTION static void
+    compute(const MemberType &member, const ProblemType &problem,
+            const real_type_1d_view_type &x,
+            const real_type_1d_view_type &work) {}
+
+    template <typename MemberType>
+    KOKKOS_INLINE_FUNCTION static void
+    apply(const MemberType &member, const int m,
+          const real_type_1d_view_type &v, const real_type_1d_view_type &z,
+          const real_type_1d_view_type &work) {
+      if (v.data() != z.data()) {
+        Kokkos::parallel_for(Kokkos::TeamVectorRange(member, m),
+                             [&](const int &i) { z(i) = v(i); });
+        member.team_barrier();
+      }
+    }
+  };
+
+  ///
+  /// Matrix-free Newton-Krylov solver; the Newton update J dx = f is solved
+  /// by a right preconditioned restarted GMRES(krylov_dim) where J v is
+  /// computed by JacobianVectorProductType (finite difference or Sacado
+  /// directional derivative). A Newton iteration costs O(krylov iterations)
+  /// function evaluations and the jacobian is never formed; the linear
+  /// system is solved up to || f - J dx || <= linear_rtol || f ||.
+  ///
+  template <typename ValueType, typename DeviceType,
+            typename JacobianVectorProductType =
+              JacobianVectorProductFiniteDifference<ValueType, DeviceType>,
+            int PreconditionerBlockSize = 0>
+  struct NewtonKrylovSolver {
+    using value_type = ValueType;
+    using device_type = DeviceType;
+    using scalar_type = typename ats<value_type>::scalar_type;
+
+    using real_type = scalar_type;
+    using real_type_1d_view_type = value_type_1d_view<real_type, device_type>;
+    using real_type_2d_view_type = value_type_2d_view<real_type, device_type>;
+
+    using jacobian_vector_product_type = JacobianVectorProductType;
+    using preconditioner_type =
+      NewtonKrylovPreconditioner<value_type, device_type,
+                                 PreconditionerBlockSize>;
+
+    KOKKOS_INLINE_FUNCTION
+    static void workspace(const int m, const int krylov_dim, int &wlen) {
+      const int k = krylov_dim;
+      /// V, H, givens rotations (c, s) and g, z
+      const int wlen_gmres = m * (k + 1) + (k + 1) * k + 2 * k + (k + 1) + m;
+
+      int wlen_jacobian_vector_product(0), wlen_preconditioner(0);
+      jacobian_vector_product_type::workspace(m, wlen_jacobian_vector_product);
+      preconditioner_type::workspace(m, wlen_preconditioner);
+
+      wlen = wlen_gmres + wlen_jacobian_vector_product + wlen_preconditioner;
+    }
+
+    ///
+    /// right preconditioned restarted GMRES for J(x) dx = f starting from
+    /// dx = 0; the preconditioner should be computed on input
+    ///
+    template <typename MemberType, typename ProblemType>
+    KOKKOS_INLINE_FUNCTION static void
+    solveLinearSystemGMRES(const MemberType &member,
+                           /// input
+                           const ProblemType &problem, const int krylov_dim,
+                           const int max_restart, const real_type &linear_rtol,
+                           const real_type_1d_view_type &x,
+                           const real_type_1d_view_type &f,
+                           /// output
+                           const real_type_1d_view_type &dx,
+                           /// workspace
+                           const real_type_1d_view_type &work,
+                           /// output
+                           /* */ int &linear_iter_count) {
+      using ats_real = ats<real_type>;
+      const int m = problem.getNumberOfEquations(), k = krylov_dim;
+      const real_type zero(0), one(1);
+
+      real_type *wptr = work.data();
+      /// krylov vectors are stored in the rows of V
+      real_type *Vptr = wptr;
+      real_type_2d_view_type V(wptr, k + 1, m);
+      wptr += (k + 1) * m;
+      real_type_2d_view_type H(wptr, k + 1, k);
+      wptr += (k + 1) * k;
+      real_type *cs = wptr;
+      wptr += k;
+      real_type *sn = wptr;
+      wptr += k;
+      real_type *g = wptr;
+      wptr += k + 1;
+      real_type_1d_view_type z(wptr, m);
+      wptr += m;
+
+      int wlen_jacobian_vector_product(0), wlen_preconditioner(0);
+      jacobian_vector_product_type::workspace(m, wlen_jacobian_vector_product);
+      preconditioner_type::workspace(m, wlen_preconditioner);
+      real_type_1d_view_type work_jacobian_vector_product(
+        wptr, wlen_jacobian_vector_product);
+      wptr += wlen_jacobian_vector_product;
+      real_type_1d_view_type work_preconditioner(wptr, wlen_preconditioner);
+      wptr += wlen_preconditioner;
+      assert(int(wptr - work.data()) <= int(work.span()) &&
+             "Error: workspace is smaller than required");
+
+      auto norm2 = [&](const real_type_1d_view_type &v) {
+        real_type sum(0);
+        Kokkos::parallel_reduce(
+          Kokkos::TeamVectorRange(member, m),
+          [&](const int &i, real_type &update) { update += v(i) * v(i); },
+          sum);
+        return ats_real::sqrt(sum);
+      };
+      auto column = [&](const int j) {
+        return real_type_1d_view_type(Vptr + j * m, m);
+      };
+
+      /// r = f with dx = 0
+      Kokkos::parallel_for(Kokkos::TeamVectorRange(member, m),
+                           [&](const int &i) {
+                             dx(i) = zero;
+                             V(0, i) = f(i);
+                           });
+      member.team_barrier();
+
+      const real_type norm_f = norm2(f);
+      const real_type target = linear_rtol * norm_f;
+      real_type beta = norm_f;
+
+      for (int restart = 0; restart <= max_restart && beta > target;
+           ++restart) {
+        {
+          const real_type beta_inv = one / beta;
+          Kokkos::parallel_for(Kokkos::TeamVectorRange(member, m),
+                               [&](const int &i) { V(0, i) *= beta_inv; });
+          Kokkos::single(Kokkos::PerTeam(member), [&]() {
+            g[0] = beta;
+            for (int i = 1; i <= k; ++i)
+              g[i] = zero;
+          });
+          member.team_barrier();
+        }
+
+        /// arnoldi with modified Gram-Schmidt
+        int kk(0);
+        real_type resid(beta);
+        for (int j = 0; j < k && resid > target; ++j) {
+          const auto vj = column(j), vj1 = column(j + 1);
+
+          /// v_{j+1} = J M^{-1} v_j
+          preconditioner_type::apply(member, m, vj, z, work_preconditioner);
+          jacobian_vector_product_type::invoke(member, problem, x, f, z, vj1,
+                                               work_jacobian_vector_product);
+          ++linear_iter_count;
+
+          for (int i = 0; i <= j; ++i) {
+            const auto vi = column(i);
+            real_type hij(0);
+            Kokkos::parallel_reduce(
+              Kokkos::TeamVectorRange(member, m),
+              [&](const int &l, real_type &update) {
+                update += vi(l) * vj1(l);
+              },
+              hij);
+            Kokkos::parallel_for(Kokkos::TeamVectorRange(member, m),
+                                 [&](const int &l) { vj1(l) -= hij * vi(l); });
+            Kokkos::single(Kokkos::PerTeam(member), [&]() { H(i, j) = hij; });
+            member.team_barrier();
+          }
+          const real_type hj1j = norm2(vj1);
+          if (hj1j > zero) {
+            const real_type hj1j_inv = one / hj1j;
+            Kokkos::parallel_for(Kokkos::TeamVectorRange(member, m),
+                                 [&](const int &l) { vj1(l) *= hj1j_inv; });
+          }
+
+          /// apply the givens rotations to the new column of H and update g
+          Kokkos::single(
+            Kokkos::PerTeam(member),
+            [&](real_type &val) {
+              H(j + 1, j) = hj1j;
+              for (int i = 0; i < j; ++i) {
+                const real_type tmp = cs[i] * H(i, j) + sn[i] * H(i + 1, j);
+                H(i + 1, j) = -sn[i] * H(i, j) + cs[i] * H(i + 1, j);
+                H(i, j) = tmp;
+              }
+              const real_type a = H(j, j), b = H(j + 1, j),
+                              r = ats_real::sqrt(a * a + b * b);
+              cs[j] = r > zero ? a / r : one;
+              sn[j] = r > zero ? b / r : zero;
+              H(j, j) = r;
+              H(j + 1, j) = zero;
+              g[j + 1] = -sn[j] * g[j];
+              g[j] = cs[j] * g[j];
+              val = ats_real::abs(g[j + 1]);
+            },
+            resid);
+          member.team_barrier();
+          kk = j + 1;
+
+          /// happy breakdown; the krylov subspace is invariant
+          if (hj1j == zero)
+            break;
+        }
+
+        /// y = H^{-1} g stored in g
+        Kokkos::single(Kokkos::PerTeam(member), [&]() {
+          for (int i = kk - 1; i >= 0; --i) {
+            for (int l = i + 1; l < kk; ++l)
+              g[i] -= H(i, l) * g[l];
+            g[i] = H(i, i) == zero ? zero : g[i] / H(i, i);
+          }
+        });
+        member.team_barrier();
+
+        /// dx = dx + M^{-1} V y
+        Kokkos::parallel_for(Kokkos::TeamVectorRange(member, m),
+                             [&](const int &i) {
+                               real_type val(0);
+                               for (int l = 0; l < kk; ++l)
+                                 val += V(l, i) * g[l];
+                               z(i) = val;
+                             });
+        member.team_barrier();
+        preconditioner_type::apply(member, m, z, z, work_preconditioner);
+        Kokkos::parallel_for(Kokkos::TeamVectorRange(member, m),
+                             [&](const int &i) { dx(i) += z(i); });
+        member.team_barrier();
+
+        /// the true residual r = f - J dx for the next restart
+        beta = resid;
+        if (beta > target && restart < max_restart) {
+          const auto v0 = column(0);
+          jacobian_vector_product_type::invoke(member, problem, x, f, dx, v0,
+                                               work_jacobian_vector_product);
+          ++linear_iter_count;
+          Kokkos::parallel_for(Kokkos::TeamVectorRange(member, m),
+                               [&](const int &i) { v0(i) = f(i) - v0(i); });
+          member.team_barrier();
+          beta = norm2(v0);
+        }
+      }
+    }
+
+    template <typename MemberType, typename ProblemType>
+    KOKKOS_INLINE_FUNCTION static void
+    invoke(const MemberType &member,
+           /// intput
+           const ProblemType &problem, const real_type &atol,
+           const real_type &rtol, const int &max_iter, const int &krylov_dim,
+           const int &max_restart, const real_type &linear_rtol,
+           /// input/output
+           const real_type_1d_view_type &x,
+           /// workspace
+           const real_type_1d_view_type &dx, const real_type_1d_view_type &f,
+           const real_type_1d_view_type &work,
+           /// output
+           /* */ int &iter_count,
+           /* */ int &converge,
+           /* */ int &linear_iter_count) {
+      using newton_solver_type = NewtonSolver<value_type, device_type>;
+      converge = false;
+      linear_iter_count = 0;
+
+      /// the problem is square
+      const int m = problem.getNumberOfEquations();
+      int wlen(0);
+      workspace(m, krylov_dim, wlen);
+      assert(wlen <= int(work.extent(0)) &&
+             "Error: given workspace is smaller than required");
+
+      int wlen_preconditioner(0);
+      preconditioner_type::workspace(m, wlen_preconditioner);
+      const real_type_1d_view_type work_preconditioner(
+        work.data() + wlen - wlen_preconditioner, wlen_preconditioner);
+
+      int iter = 0;
+#if !defined(TINES_ENABLE_NEWTON_WRMS)
+      real_type norm2_f0(0);
+#endif
+      problem.computeInitValues(member, x);
+      for (; iter < max_iter && !converge; ++iter) {
+        problem.computeFunction(member, x, f);
+        preconditioner_type::compute(member, problem, x, work_preconditioner);
+
+        /// solve the equation: dx = -J^{-1} f(x);
+        solveLinearSystemGMRES(member, problem, krylov_dim, max_restart,
+                               linear_rtol, x, f, dx, work,
+                               linear_iter_count);
+
+#if defined(TINES_ENABLE_NEWTON_WRMS)
+        newton_solver_type::updateSolutionAndCheckConvergenceUsingWrmsNorm(
+          member, atol, rtol, m, x, dx, f, converge);
+#else
+        newton_solver_type::updateSolutionAndCheckConvergence(
+          member, atol, rtol, m, x, dx, f, norm2_f0, converge);
+#endif
+      }
+      /// record the final number of iterations
+      iter_count = iter;
+    }
+  };
+
+} // namespace Tines
+
+#endif
@@ -23,6 +23,88 @@ Sandia National Laboratories, New Mexico, USA
 
 namespace Tines {
 
+  ///
+  /// A problem may expose its number of equations at compile time e.g.,
+  ///   static constexpr int static_number_of_equations = 3;
+  /// then the Newton solver uses the fixed size LU kernels when the size is
+  /// not larger than TINES_STATIC_SIZE_MAX; otherwise, the value is zero
+  ///
+  template <typename ProblemType, typename = void>
+  struct ProblemStaticNumberOfEquations {
+    static constexpr int value = 0;
+  };
+
+  template <typename ProblemType>
+  struct ProblemStaticNumberOfEquations<
+    ProblemType, decltype((void)ProblemType::static_number_of_equations)> {
+    static constexpr int value = ProblemType::static_number_of_equations;
+  };
+
+  /// linear solver dispatch for the Newton solver
+  template <int M, bool IsStatic = (M > 0 && M <= TINES_STATIC_SIZE_MAX)>
+  struct NewtonLinearSolver {
+    template <typename MemberType, typename AViewType, typename WViewType>
+    KOKKOS_INLINE_FUNCTION static int
+    device_factorize(const MemberType &member, const bool use_lu,
+                     const AViewType &A, const WViewType &W,
+                     int &matrix_rank) {
+      return SolveLinearSystem::device_factorize(member, use_lu, A, W,
+                                                 matrix_rank);
+    }
+
+    template <typename MemberType, typename AViewType, typename XViewType,
+              typename BViewType, typename WViewType>
+    KOKKOS_INLINE_FUNCTION static int
+    device_solve_factorized(const MemberType &member, const AViewType &A,
+                            const XViewType &X, const BViewType &B,
+                            const WViewType &W) {
+      return SolveLinearSystem::device_solve_factorized(member, A, X, B, W);
+    }
+
+    template <typename MemberType, typename AViewType, typename XViewType,
+              typename BViewType, typename WViewType>
+    KOKKOS_INLINE_FUNCTION static int
+    device_invoke_lu(const MemberType &member, const AViewType &A,
+                     const XViewType &X, const BViewType &B,
+                     const WViewType &W, int &matrix_rank) {
+      return SolveLinearSystem::device_invoke_lu(member, A, X, B, W,
+                                                 matrix_rank);
+    }
+  };
+
+  template <int M> struct NewtonLinearSolver<M, true> {
+    template <typename MemberType, typename AViewType, typename WViewType>
+    KOKKOS_INLINE_FUNCTION static int
+    device_factorize(const MemberType &member, const bool use_lu,
+                     const AViewType &A, const WViewType &W,
+                     int &matrix_rank) {
+      return (use_lu ? SolveLinearSystemStatic<M>::device_factorize(
+                         member, A, W, matrix_rank)
+                     : SolveLinearSystem::device_factorize(member, false, A, W,
+                                                           matrix_rank));
+    }
+
+    template <typename MemberType, typename AViewType, typename XViewType,
+              typename BViewType, typename WViewType>
+    KOKKOS_INLINE_FUNCTION static int
+    device_solve_factorized(const MemberType &member, const AViewType &A,
+                            const XViewType &X, const BViewType &B,
+                            const WViewType &W) {
+      return SolveLinearSystemStatic<M>::device_solve_factorized(member, A, X,
+                                                                 B, W);
+    }
+
+    template <typename MemberType, typename AViewType, typename XViewType,
+              typename BViewType, typename WViewType>
+    KOKKOS_INLINE_FUNCTION static int
+    device_invoke_lu(const MemberType &member, const AViewType &A,
+                     const XViewType &X, const BViewType &B,
+                     const WViewType &W, int &matrix_rank) {
+      return SolveLinearSystemStatic<M>::device_invoke_lu(member, A, X, B, W,
+                                                          matrix_rank);
+    }
+  };
+
   template <typename ValueType, typename DeviceType> struct NewtonSolver {
     using value_type = ValueType;
     using device_type = DeviceType;
@@ -127,9 +209,14 @@ namespace Tines {
       assert(wlen <= int(work.extent(0)) &&
              "Error: given workspace is smaller than required");
 
+      using linear_solver_type =
+        NewtonLinearSolver<ProblemStaticNumberOfEquations<ProblemType>::value>;
+
       bool is_valid(true);
       int iter = 0;
-      // real_type norm2_f0(0);
+#if !defined(TINES_ENABLE_NEWTON_WRMS)
+      real_type norm2_f0(0);
+#endif
       problem.computeInitValues(member, x);
       for (; iter < max_iter && !converge; ++iter) {
         problem.computeJacobian(member, x, J);
@@ -140,8 +227,14 @@ namespace Tines {
         if (is_valid) {
           /// solve the equation: dx = -J^{-1} f(x);
           int matrix_rank(0);
+#if defined(TINES_ENABLE_NEWTON_LU)
+          /// lu with partial pivoting falls back to utv when it is not reliable
+          linear_solver_type::device_invoke_lu(member, J, dx, f, work,
+                                               matrix_rank);
+#else
           Tines::SolveLinearSystem ::invoke(member, J, dx, f, work,
                                             matrix_rank);
+#endif
 
 #if defined(TINES_ENABLE_NEWTON_WRMS)
           updateSolutionAndCheckConvergenceUsingWrmsNorm(member, atol, rtol, m,
@@ -158,6 +251,134 @@ namespace Tines {
       /// record the final number of iterations
       iter_count = iter;
     }
+
+    /// factorize J in place; the factors in J and work are used by the
+    /// modified Newton
+    ///  - StaticM is the compile-time size of J (0 if unknown)
+    template <int StaticM = 0, typename MemberType>
+    KOKKOS_INLINE_FUNCTION static void
+    factorize(const MemberType &member, const real_type_2d_view_type &J,
+              const real_type_1d_view_type &work) {
+#if defined(TINES_ENABLE_NEWTON_LU)
+      const bool use_lu(true);
+#else
+      const bool use_lu(false);
+#endif
+      int matrix_rank(0);
+      NewtonLinearSolver<StaticM>::device_factorize(member, use_lu, J, work,
+                                                    matrix_rank);
+    }
+
+    template <typename MemberType>
+    KOKKOS_INLINE_FUNCTION static void
+    computeNormWrms(const MemberType &member, const real_type &atol,
+                    const real_type &rtol, const int m,
+                    const real_type_1d_view_type &x,
+                    const real_type_1d_view_type &dx, real_type &norm) {
+      const real_type one(1);
+
+      real_type sum(0);
+      Kokkos::parallel_reduce(
+        Kokkos::TeamVectorRange(member, m),
+        [&](const int &i, real_type &val) {
+          const real_type w_at_i =
+            one / (rtol * ats<real_type>::abs(x(i)) + atol);
+          const real_type mult_val = ats<real_type>::abs(dx(i)) * w_at_i;
+          val += mult_val * mult_val;
+        },
+        sum);
+      norm = ats<real_type>::sqrt(sum / real_type(m));
+    }
+
+    ///
+    /// Modified Newton; the Jacobian and its factorization are reused across
+    /// iterations and they are refreshed only when the contraction rate
+    /// estimated by || dx_{n} || / || dx_{n-1} || exceeds
+    /// max_contraction_rate. The factorization is kept in J and work.
+    /// When is_jacobian_factorized is true on input, the given factorization
+    /// is used from the first iteration.
+    ///
+    template <typename MemberType, typename ProblemType>
+    KOKKOS_INLINE_FUNCTION static void
+    invoke(const MemberType &member,
+           /// intput
+           const ProblemType &problem, const real_type &atol,
+           const real_type &rtol, const int &max_iter,
+           const real_type &max_contraction_rate,
+           /// input/output
+           const real_type_1d_view_type &x,
+           /// workspace
+           const real_type_1d_view_type &dx, const real_type_1d_view_type &f,
+           const real_type_2d_view_type &J,
+           const real_type_1d_view_type &work, // workspace
+           /// input/output
+           /* */ int &is_jacobian_factorized,
+           /// output
+           /* */ int &iter_count,
+           /* */ int &converge,
+           /* */ int &jacobian_count) {
+      converge = false;
+      jacobian_count = 0;
+
+      /// the problem is square
+      const int m = problem.getNumberOfEquations();
+      int wlen(0);
+      workspace(m, wlen);
+      assert(wlen <= int(work.extent(0)) &&
+             "Error: given workspace is smaller than required");
+
+      constexpr int static_m =
+        ProblemStaticNumberOfEquations<ProblemType>::value;
+
+      bool is_valid(true);
+      int iter = 0;
+      real_type norm_dx_prev(-1);
+#if !defined(TINES_ENABLE_NEWTON_WRMS)
+      real_type norm2_f0(0);
+#endif
+      problem.computeInitValues(member, x);
+      for (; iter < max_iter && !converge && is_valid; ++iter) {
+        if (!is_jacobian_factorized) {
+          problem.computeJacobian(member, x, J);
+          /// sanity check this also needs cmake option
+          Tines::CheckNanInf::invoke(member, J, is_valid);
+          if (is_valid) {
+            factorize<static_m>(member, J, work);
+            is_jacobian_factorized = true;
+            ++jacobian_count;
+            norm_dx_prev = -1;
+          } else {
+            printf("Error: J contains either Nan or Inf\n");
+            converge = false;
+          }
+        }
+
+        if (is_valid) {
+          problem.computeFunction(member, x, f);
+
+          /// solve the equation: dx = -J^{-1} f(x);
+          NewtonLinearSolver<static_m>::device_solve_factorized(member, J, dx,
+                                                                f, work);
+
+#if defined(TINES_ENABLE_NEWTON_WRMS)
+          updateSolutionAndCheckConvergenceUsingWrmsNorm(member, atol, rtol, m,
+                                                         x, dx, f, converge);
+#else
+          updateSolutionAndCheckConvergence(member, atol, rtol, m, x, dx, f,
+                                            norm2_f0, converge);
+#endif
+          /// refresh the jacobian when the contraction rate degrades
+          real_type norm_dx(0);
+          computeNormWrms(member, atol, rtol, m, x, dx, norm_dx);
+          if (norm_dx_prev > real_type(0) &&
+              norm_dx > max_contraction_rate * norm_dx_prev)
+            is_jacobian_factorized = false;
+          norm_dx_prev = norm_dx;
+        }
+      }
+      /// record the final number of iterations
+      iter_count = iter;
+    }
   };
 
 } // namespace Tines
@@ -35,6 +35,7 @@ namespace Tines {
     using real_type = scalar_type;
     using real_type_1d_view_type = value_type_1d_view<real_type, device_type>;
     using real_type_2d_view_type = value_type_2d_view<real_type, device_type>;
+    using int_type_1d_view_type = value_type_1d_view<int, device_type>;
 
     template <typename MemberType,
               template <typename, typename> class ProblemType>
@@ -157,6 +158,128 @@ namespace Tines {
       }
     }
 
+    ///
+    /// Colored jacobian; all columns of a color (NumericalJacobianColoring)
+    /// are perturbed together and the jacobian entries outside of the
+    /// sparsity pattern are set to zero. The number of function evaluations
+    /// is 2 ncolors instead of 2 m. x_0 is a workspace of m to keep x.
+    ///
+    template <typename MemberType,
+              template <typename, typename> class ProblemType>
+    KOKKOS_INLINE_FUNCTION static void
+    invoke(const MemberType &member,
+           const ProblemType<real_type, device_type> &problem,
+           const real_type &fac_min, const real_type &fac_max,
+           const real_type_1d_view_type &fac, const int &ncolors,
+           const int_type_1d_view_type &color,
+           const int_type_1d_view_type &col_ptr,
+           const int_type_1d_view_type &row_idx,
+           const real_type_1d_view_type &x, const real_type_1d_view_type &x_0,
+           const real_type_1d_view_type &f_0, const real_type_1d_view_type &f_h,
+           const real_type_2d_view_type &J) {
+      const real_type eps = ats<real_type>::epsilon();
+      const real_type eps_1_2 = ats<real_type>::sqrt(eps);     // U
+      const real_type eps_1_4 = ats<real_type>::sqrt(eps_1_2); // bu
+      const real_type eps_1_8 = ats<real_type>::sqrt(eps_1_4);
+      const real_type eps_3_4 = eps_1_2 * eps_1_4; // bl
+      const real_type eps_7_8 = eps / (eps_1_8);   // br
+      const real_type zero(0), half(0.5), two(2);
+      const real_type eps_2_1_2 = ats<real_type>::sqrt(two * eps); // U
+      const real_type fac_min_use = fac_min <= zero ? (eps_3_4) : fac_min;
+      const real_type fac_max_use = fac_max <= zero ? (eps_2_1_2) : fac_max;
+
+      /// J should be square
+      const int m = J.extent(0);
+
+      /// initialization fac if necessary, keep x and zero out J
+      Kokkos::parallel_for(Kokkos::TeamVectorRange(member, m),
+                           [&](const int &i) {
+                             fac(i) = (fac(i) == zero ? eps_1_2 : fac(i));
+                             x_0(i) = x(i);
+                           });
+      Set::invoke(member, zero, J);
+
+      /// loop over colors
+      for (int c = 0; c < ncolors; ++c) {
+        /// force fac between facmin and famax and modify x vector
+        member.team_barrier();
+        Kokkos::parallel_for(
+          Kokkos::TeamVectorRange(member, m), [&](const int &j) {
+            if (color(j) == c) {
+              const real_type fac_at_j = fac(j);
+              fac(j) = (fac_at_j < fac_min_use
+                          ? fac_min_use
+                          : fac_at_j > fac_max_use ? fac_max_use : fac_at_j);
+              x(j) = x_0(j) - ats<real_type>::abs(fac(j) * x_0(j)) - eps;
+            }
+          });
+
+        /// compute f_0
+        member.team_barrier();
+        problem.computeFunction(member, x, f_0);
+
+        /// modify x vector
+        member.team_barrier();
+        Kokkos::parallel_for(
+          Kokkos::TeamVectorRange(member, m), [&](const int &j) {
+            if (color(j) == c)
+              x(j) = x_0(j) + ats<real_type>::abs(fac(j) * x_0(j)) + eps;
+          });
+
+        /// compute f_h
+        member.team_barrier();
+        problem.computeFunction(member, x, f_h);
+
+        /// roll back the input vector and compute jacobian at the columns
+        member.team_barrier();
+        Kokkos::parallel_for(
+          Kokkos::TeamVectorRange(member, m), [&](const int &j) {
+            if (color(j) == c) {
+              const real_type x_at_j = x_0(j);
+              const real_type h = ats<real_type>::abs(fac(j) * x_at_j) + eps;
+              x(j) = x_at_j;
+
+              /// the column j owns its rows in this color
+              int k(-1);
+              real_type diff(-1);
+              for (int l = col_ptr(j), lend = col_ptr(j + 1); l < lend; ++l) {
+                const int i = row_idx(l);
+                const real_type df = f_h(i) - f_0(i);
+                J(i, j) = half * df / h;
+                if (ats<real_type>::abs(df) > diff) {
+                  diff = ats<real_type>::abs(df);
+                  k = i;
+                }
+              }
+              if (k >= 0) {
+                const real_type abs_f_h_at_k = ats<real_type>::abs(f_h(k));
+                const real_type abs_f_0_at_k = ats<real_type>::abs(f_0(k));
+                const real_type scale =
+                  abs_f_h_at_k > abs_f_0_at_k ? abs_f_h_at_k : abs_f_0_at_k;
+                const real_type check =
+                  abs_f_h_at_k < abs_f_0_at_k ? abs_f_h_at_k : abs_f_0_at_k;
+                if (check == zero) {
+                  /// fac(j) is accepted
+                } else if (diff > eps_1_4 * scale) {
+                  /// truncation error is dominant; decrease fac
+                  fac(j) *= eps_1_2;
+                } else if ((eps_7_8 * scale < diff) &&
+                           (diff < eps_3_4 * scale)) {
+                  /// round off error is dominant; increase fac
+                  fac(j) /= eps_1_2;
+                } else if (diff < eps_7_8 * scale) {
+                  /// round off error is dominant; increase fac rapidly
+                  fac(j) = ats<real_type>::sqrt(fac(j));
+                } else {
+                  /// fac is not changed
+                }
+              }
+            }
+          });
+      }
+      member.team_barrier();
+    }
+
     template <template <typename, typename> class ProblemType>
     KOKKOS_INLINE_FUNCTION static void
     workspace(const ProblemType<real_type, device_type> &problem, int &wlen) {
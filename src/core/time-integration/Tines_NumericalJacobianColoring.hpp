@@ -0,0 +1,114 @@
+/*----------------------------------------------------------------------------------
+Tines - Time Integrator, Newton and Eigen Solver -  version 1.0
+Copyright (2021) NTESS
+https://github.com/sandialabs/Tines
+
+Copyright 2021 National Technology & Engineering Solutions of Sandia, LLC (NTESS). 
+Under the terms of Contract DE-NA0003525 with NTESS, the U.S. Government retains 
+certain rights in this software.
+
+This file is part of Tines. Tines is open-source software: you can redistribute it
+and/or modify it under the terms of BSD 2-Clause License
+(https://opensource.org/licenses/BSD-2-Clause). A copy of the license is also
+provided under the main directory
+Questions? Kyungjoo Kim <kyukim@sandia.gov>, or
+	   Oscar Diaz-Ibarra at <odiazib@sandia.gov>, or
+	   Cosmin Safta at <csafta@sandia.gov>, or
+	   Habib Najm at <hnnajm@sandia.gov>
+
+Sandia National Laboratories, New Mexico, USA
+----------------------------------------------------------------------------------*/
+#ifndef __TINES_NUMERICAL_JACOBIAN_COLORING_HPP__
+#define __TINES_NUMERICAL_JACOBIAN_COLORING_HPP__
+
+namespace Tines {
+  ///
+  /// Column coloring of a sparse jacobian (Curtis-Powell-Reid); columns of
+  /// the same color do not share a row so that they can be perturbed together
+  /// in a finite difference jacobian.
+  ///   [in]m
+  ///     the number of rows and columns
+  ///   [in]col_ptr, [in]row_idx
+  ///     sparsity pattern in the compressed column storage; the row indices
+  ///     of the nonzeros in the jth column are row_idx(l) for
+  ///     l = col_ptr(j):col_ptr(j+1)-1
+  ///   [out]color
+  ///     color of the jth column in [0, ncolors)
+  ///   [in]work
+  ///     integer workspace of 2m+1+nnz
+  /// The number of colors is returned.
+  ///
+  struct NumericalJacobianColoring {
+    KOKKOS_INLINE_FUNCTION
+    static void workspace(const int m, const int nnz, int &wlen) {
+      wlen = 2 * m + 1 + nnz;
+    }
+
+    KOKKOS_INLINE_FUNCTION
+    static int invoke(const int m, const int *__restrict__ col_ptr,
+                      const int *__restrict__ row_idx,
+                      /* */ int *__restrict__ color,
+                      /* */ int *__restrict__ work) {
+      const int nnz = col_ptr[m];
+      int *__restrict__ row_ptr = work;
+      int *__restrict__ col_idx = row_ptr + m + 1;
+      int *__restrict__ mark = col_idx + nnz;
+
+      /// row compressed storage of the pattern
+      for (int i = 0; i <= m; ++i)
+        row_ptr[i] = 0;
+      for (int l = 0; l < nnz; ++l)
+        ++row_ptr[row_idx[l] + 1];
+      for (int i = 0; i < m; ++i)
+        row_ptr[i + 1] += row_ptr[i];
+      for (int i = 0; i < m; ++i)
+        mark[i] = row_ptr[i];
+      for (int j = 0; j < m; ++j)
+        for (int l = col_ptr[j]; l < col_ptr[j + 1]; ++l)
+          col_idx[mark[row_idx[l]]++] = j;
+
+      /// greedy coloring; mark(c) == j if the color c is used by a column
+      /// sharing a row with the column j
+      for (int j = 0; j < m; ++j) {
+        color[j] = -1;
+        mark[j] = -1;
+      }
+      int ncolors(0);
+      for (int j = 0; j < m; ++j) {
+        for (int l = col_ptr[j]; l < col_ptr[j + 1]; ++l) {
+          const int i = row_idx[l];
+          for (int q = row_ptr[i]; q < row_ptr[i + 1]; ++q) {
+            const int c = color[col_idx[q]];
+            if (c >= 0)
+              mark[c] = j;
+          }
+        }
+        int c(0);
+        for (; c < ncolors && mark[c] == j; ++c)
+          ;
+        color[j] = c;
+        ncolors += (c == ncolors);
+      }
+      return ncolors;
+    }
+
+    template <typename IntViewType>
+    KOKKOS_INLINE_FUNCTION static int invoke(const IntViewType &col_ptr,
+                                             const IntViewType &row_idx,
+                                             const IntViewType &color,
+                                             const IntViewType &work) {
+      static_assert(IntViewType::rank == 1, "view is not rank-1 view");
+      const int m = color.extent(0);
+      assert(col_ptr.stride(0) == 1 && row_idx.stride(0) == 1 &&
+             color.stride(0) == 1 && work.stride(0) == 1 &&
+             "Error: views are not contiguous");
+      assert(int(work.extent(0)) >= (2 * m + 1 + col_ptr(m)) &&
+             "Error: workspace is smaller than required");
+      return invoke(m, col_ptr.data(), row_idx.data(), color.data(),
+                    work.data());
+    }
+  };
+
+} // namespace Tines
+
+#endif
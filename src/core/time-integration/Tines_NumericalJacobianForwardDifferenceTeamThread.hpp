@@ -0,0 +1,210 @@
+/*----------------------------------------------------------------------------------
+Tines - Time Integrator, Newton and Eigen Solver -  version 1.0
+Copyright (2021) NTESS
+https://github.com/sandialabs/Tines
+
+Copyright 2021 National Technology & Engineering Solutions of Sandia, LLC (NTESS). 
+Under the terms of Contract DE-NA0003525 with NTESS, the U.S. Government retains 
+certain rights in this software.
+
+This file is part of Tines. Tines is open-source software: you can redistribute it
+and/or modify it under the terms of BSD 2-Clause License
+(https://opensource.org/licenses/BSD-2-Clause). A copy of the license is also
+provided under the main directory
+Questions? Kyungjoo Kim <kyukim@sandia.gov>, or
+	   Oscar Diaz-Ibarra at <odiazib@sandia.gov>, or
+	   Cosmin Safta at <csafta@sandia.gov>, or
+	   Habib Najm at <hnnajm@sandia.gov>
+
+Sandia National Laboratories, New Mexico, USA
+----------------------------------------------------------------------------------*/
+#ifndef __TINES_NUMERICAL_JACOBIAN_FORWARD_DIFFERENCE_TEAM_THREAD_HPP__
+#define __TINES_NUMERICAL_JACOBIAN_FORWARD_DIFFERENCE_TEAM_THREAD_HPP__
+
+namespace Tines {
+  ///
+  /// J_{ij} = { df_i/dx_j }
+  ///
+  /// Columns are distributed over team threads; each thread perturbs its own
+  /// copy of x and evaluates the function independently. The problem should
+  /// provide computeFunctionPerThread(member, x, f) that is invoked by a
+  /// single team thread; it may use ThreadVectorRange and
+  /// Kokkos::single(Kokkos::PerThread(member)) but it must not use team level
+  /// parallel patterns nor team barriers. computeFunction is used for f_0.
+  ///
+  template <typename ValueType, typename DeviceType>
+  struct NumericalJacobianForwardDifferenceTeamThread {
+    using value_type = ValueType;
+    using device_type = DeviceType;
+    using scalar_type = typename ats<value_type>::scalar_type;
+
+    using real_type = scalar_type;
+    using real_type_1d_view_type = value_type_1d_view<real_type, device_type>;
+    using real_type_2d_view_type = value_type_2d_view<real_type, device_type>;
+
+    ///
+    /// [in] x - input values; x is not modified
+    /// [scratch] f_0 - function values at x (m)
+    /// [scratch] xt, ft - perturbed x and f for each team thread
+    ///                    (team_size x m)
+    ///
+    template <typename MemberType,
+              template <typename, typename> class ProblemType>
+    KOKKOS_INLINE_FUNCTION static void
+    invoke(const MemberType &member,
+           const ProblemType<value_type, device_type> &problem,
+           const real_type &fac_min, const real_type &fac_max,
+           const real_type_1d_view_type &fac, const real_type_1d_view_type &x,
+           const real_type_1d_view_type &f_0,
+           const real_type_2d_view_type &xt, const real_type_2d_view_type &ft,
+           const real_type_2d_view_type &J) {
+      const real_type eps = ats<real_type>::epsilon();
+      const real_type eps_1_2 = ats<real_type>::sqrt(eps);     // U
+      const real_type eps_1_4 = ats<real_type>::sqrt(eps_1_2); // bu
+      const real_type eps_1_8 = ats<real_type>::sqrt(eps_1_4);
+      const real_type eps_3_4 = eps_1_2 * eps_1_4; // bl
+      const real_type eps_7_8 = eps / (eps_1_8);   // br
+      const real_type zero(0), two(2);
+      const real_type eps_2_1_2 = ats<real_type>::sqrt(two * eps); // U
+      const real_type fac_min_use = fac_min <= zero ? (eps_3_4) : fac_min;
+      const real_type fac_max_use = fac_max <= zero ? (eps_2_1_2) : fac_max;
+
+      /// J should be square
+      const int m = J.extent(0);
+      assert(int(xt.extent(0)) >= member.team_size() &&
+             int(ft.extent(0)) >= member.team_size() &&
+             "Error: per thread workspace is smaller than the team size");
+
+      /// initialization fac if necessary
+      Kokkos::parallel_for(
+        Kokkos::TeamVectorRange(member, m),
+        [&](const int &i) { fac(i) = (fac(i) == zero ? eps_1_2 : fac(i)); });
+
+      /// each thread keeps its own copy of x
+      {
+        const int tid = member.team_rank();
+        Kokkos::parallel_for(Kokkos::ThreadVectorRange(member, m),
+                             [&](const int &i) { xt(tid, i) = x(i); });
+      }
+
+      /// compute f_0
+      member.team_barrier();
+      problem.computeFunction(member, x, f_0);
+
+      /// loop over columns; a team thread computes a column
+      member.team_barrier();
+      Kokkos::parallel_for(
+        Kokkos::TeamThreadRange(member, m), [&](const int &j) {
+          const int tid = member.team_rank();
+          const real_type_1d_view_type x_h(&xt(tid, 0), m);
+          const real_type_1d_view_type f_h(&ft(tid, 0), m);
+
+          /// force fac between facmin and famax
+          const real_type fac_at_j = fac(j);
+          const real_type fac_use =
+            (fac_at_j < fac_min_use
+               ? fac_min_use
+               : fac_at_j > fac_max_use ? fac_max_use : fac_at_j);
+
+          /// modify x vector
+          const real_type x_at_j = x(j);
+          const real_type h = ats<real_type>::abs(fac_use * x_at_j) + eps;
+          Kokkos::single(Kokkos::PerThread(member),
+                         [&]() { x_h(j) = x_at_j + h; });
+
+          /// compute f_h
+          problem.computeFunctionPerThread(member, x_h, f_h);
+
+          /// roll back the input vector
+          Kokkos::single(Kokkos::PerThread(member), [&]() { x_h(j) = x_at_j; });
+
+          /// compute jacobian at jth column
+          Kokkos::parallel_for(
+            Kokkos::ThreadVectorRange(member, m),
+            [&](const int &i) { J(i, j) = (f_h(i) - f_0(i)) / h; });
+
+          /// find location k
+          using reducer_value_type =
+            typename Kokkos::MaxLoc<real_type, int>::value_type;
+          reducer_value_type value;
+          Kokkos::MaxLoc<real_type, int> reducer_value(value);
+          Kokkos::parallel_reduce(
+            Kokkos::ThreadVectorRange(member, m),
+            [&](const int &i, reducer_value_type &update) {
+              const real_type val = ats<real_type>::abs(f_h(i) - f_0(i));
+              if (val > update.val) {
+                update.val = val;
+                update.loc = i;
+              }
+            },
+            reducer_value);
+          const int k = value.loc;
+
+          const real_type diff = ats<real_type>::abs(f_h(k) - f_0(k));
+          const real_type abs_f_h_at_k = ats<real_type>::abs(f_h(k));
+          const real_type abs_f_0_at_k = ats<real_type>::abs(f_0(k));
+          const real_type scale =
+            abs_f_h_at_k > abs_f_0_at_k ? abs_f_h_at_k : abs_f_0_at_k;
+          const real_type check =
+            abs_f_h_at_k < abs_f_0_at_k ? abs_f_h_at_k : abs_f_0_at_k;
+
+          Kokkos::single(Kokkos::PerThread(member), [&]() {
+            real_type fac_new = fac_use;
+            if (check == zero) {
+              /// fac(i) is accepted and compute jacobian with fac change
+            } else if (diff > eps_1_4 * scale) {
+              /// truncation error is dominant; decrease fac
+              fac_new *= eps_1_2;
+            } else if ((eps_7_8 * scale < diff) && (diff < eps_3_4 * scale)) {
+              /// round off error is dominant; increase fac
+              fac_new /= eps_1_2;
+            } else if (diff < eps_7_8 * scale) {
+              /// round off error is dominant; increase fac rapidly
+              fac_new = ats<real_type>::sqrt(fac_new);
+            } else {
+              /// fac is not changed
+            }
+            fac(j) = fac_new;
+          });
+        });
+      member.team_barrier();
+    }
+
+    /// m - # of equations of the problem
+    /// team_size - # of threads in a team
+    template <template <typename, typename> class ProblemType>
+    KOKKOS_INLINE_FUNCTION static void
+    workspace(const ProblemType<value_type, device_type> &problem,
+              const int team_size, int &wlen) {
+      const int m = problem.getNumberOfEquations();
+      wlen = m + 2 * team_size * m;
+    }
+
+    template <typename MemberType,
+              template <typename, typename> class ProblemType>
+    KOKKOS_INLINE_FUNCTION static void
+    invoke(const MemberType &member,
+           const ProblemType<value_type, device_type> &problem,
+           const real_type &fac_min, const real_type &fac_max,
+           const real_type_1d_view_type &fac, const real_type_1d_view_type &x,
+           const real_type_2d_view_type &J,
+           const real_type_1d_view_type &work) {
+      real_type *wptr = work.data();
+      const int m = problem.getNumberOfEquations(),
+                team_size = member.team_size();
+      real_type_1d_view_type f_0(wptr, m);
+      wptr += f_0.span();
+      real_type_2d_view_type xt(wptr, team_size, m);
+      wptr += xt.span();
+      real_type_2d_view_type ft(wptr, team_size, m);
+      wptr += ft.span();
+      assert(int(wptr - work.data()) <= int(work.span()) &&
+             "Error: workspace is smaller than required");
+
+      invoke(member, problem, fac_min, fac_max, fac, x, f_0, xt, ft, J);
+    }
+  };
+
+} // namespace Tines
+
+#endif
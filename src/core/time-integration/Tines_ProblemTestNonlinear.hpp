@@ -0,0 +1,146 @@
+/*----------------------------------------------------------------------------------
+Tines - Time Integrator, Newton and Eigen Solver -  version 1.0
+Copyright (2021) NTESS
+https://github.com/sandialabs/Tines
+
+Copyright 2021 National Technology & Engineering Solutions of Sandia, LLC (NTESS). 
+Under the terms of Contract DE-NA0003525 with NTESS, the U.S. Government retains 
+certain rights in this software.
+
+This file is part of Tines. Tines is open-source software: you can redistribute it
+and/or modify it under the terms of BSD 2-Clause License
+(https://opensource.org/licenses/BSD-2-Clause). A copy of the license is also
+provided under the main directory
+Questions? Kyungjoo Kim <kyukim@sandia.gov>, or
+	   Oscar Diaz-Ibarra at <odiazib@sandia.gov>, or
+	   Cosmin Safta at <csafta@sandia.gov>, or
+	   Habib Najm at <hnnajm@sandia.gov>
+
+Sandia National Laboratories, New Mexico, USA
+----------------------------------------------------------------------------------*/
+#ifndef __TINES_PROBLEM_TEST_NONLINEAR_HPP__
+#define __TINES_PROBLEM_TEST_NONLINEAR_HPP__
+
+#include "Tines_Internal.hpp"
+
+namespace Tines {
+
+  template <typename ValueType, typename DeviceType>
+  struct ProblemTestNonlinear {
+    using value_type = ValueType;
+    using device_type = DeviceType;
+    using scalar_type = typename ats<value_type>::scalar_type;
+
+    using real_type = scalar_type;
+    using real_type_0d_view_type = value_type_0d_view<real_type, device_type>;
+    using real_type_1d_view_type = value_type_1d_view<real_type, device_type>;
+    using real_type_2d_view_type = value_type_2d_view<real_type, device_type>;
+
+    static_assert(!ats<value_type>::is_sacado,
+                  "This problem must be templated with built-in scalar");
+
+    static constexpr int static_number_of_equations = 3;
+
+    KOKKOS_DEFAULTED_FUNCTION
+    ProblemTestNonlinear() = default;
+
+    /// u = exp(z) where z solves the linear system of ProblemTestTrBDF2,
+    /// dz/dt = A z; the Jacobian depends on the state
+    /// du_i/dt = u_i (A log u)_i
+    /// J_ij = delta_ij (A log u)_i + u_i A_ij / u_j
+    /// T = [0, 10], u(0) = (e, 1, 1/e)^T
+    /// exact solution is u_i(t) = exp(z_i(t))
+
+    KOKKOS_INLINE_FUNCTION
+    int getNumberOfTimeODEs() const { return 3; }
+
+    KOKKOS_INLINE_FUNCTION
+    int getNumberOfConstraints() const { return 0; }
+
+    KOKKOS_INLINE_FUNCTION
+    int getNumberOfEquations() const {
+      return getNumberOfTimeODEs() + getNumberOfConstraints();
+    }
+
+    KOKKOS_INLINE_FUNCTION
+    void workspace(int &wlen) const {
+      /// we do not use numerical jacobian for this example
+      wlen = 0;
+    }
+
+    template <typename MemberType>
+    KOKKOS_INLINE_FUNCTION void
+    computeInitValues(const MemberType &member,
+                      const real_type_1d_view_type &x) const {
+      /// do nothing; we use solution from the previous timestep
+    }
+
+    KOKKOS_INLINE_FUNCTION
+    static real_type getA(const int i, const int j) {
+      const real_type A[3][3] = {{-20.0, -0.25, -19.75},
+                                 {20.0, -20.25, 0.25},
+                                 {20.0, -19.75, -0.25}};
+      return A[i][j];
+    }
+
+    template <typename MemberType>
+    KOKKOS_INLINE_FUNCTION void
+    computeJacobian(const MemberType &member, const real_type_1d_view_type &x,
+                    const real_type_2d_view_type &J) const {
+      Kokkos::single(Kokkos::PerTeam(member), [&]() {
+        for (int i = 0; i < 3; ++i) {
+          real_type Az(0);
+          for (int j = 0; j < 3; ++j)
+            Az += getA(i, j) * ats<real_type>::log(x(j));
+          for (int j = 0; j < 3; ++j)
+            J(i, j) = (i == j ? Az : real_type(0)) + x(i) * getA(i, j) / x(j);
+        }
+      });
+      member.team_barrier();
+    }
+
+    template <typename MemberType>
+    KOKKOS_INLINE_FUNCTION void
+    computeFunction(const MemberType &member, const real_type_1d_view_type &x,
+                    const real_type_1d_view_type &f) const {
+      Kokkos::single(Kokkos::PerTeam(member), [&]() {
+        for (int i = 0; i < 3; ++i) {
+          real_type Az(0);
+          for (int j = 0; j < 3; ++j)
+            Az += getA(i, j) * ats<real_type>::log(x(j));
+          f(i) = x(i) * Az;
+        }
+      });
+      member.team_barrier();
+    }
+
+    template <typename MemberType>
+    KOKKOS_INLINE_FUNCTION real_type
+    computeError(const MemberType &member, const real_type &t,
+                 const real_type_1d_view_type &x) const {
+      const real_type e_slow = ats<real_type>::exp(-0.5 * t),
+                      e_fast = ats<real_type>::exp(-20.0 * t),
+                      c = ats<real_type>::cos(20.0 * t),
+                      s = ats<real_type>::sin(20.0 * t);
+      const real_type z0 = 0.5 * (e_slow + e_fast * (c + s)),
+                      z1 = 0.5 * (e_slow - e_fast * (c - s)),
+                      z2 = -0.5 * (e_slow + e_fast * (c - s));
+      const real_type x0 = ats<real_type>::exp(z0),
+                      x1 = ats<real_type>::exp(z1),
+                      x2 = ats<real_type>::exp(z2);
+
+      const real_type abs_x0 = ats<real_type>::abs(x0 - x(0));
+      const real_type abs_x1 = ats<real_type>::abs(x1 - x(1));
+      const real_type abs_x2 = ats<real_type>::abs(x2 - x(2));
+
+      const real_type err_norm = ats<real_type>::sqrt(
+        abs_x0 * abs_x0 + abs_x1 * abs_x1 + abs_x2 * abs_x2);
+      const real_type sol_norm =
+        ats<real_type>::sqrt(x0 * x0 + x1 * x1 + x2 * x2);
+      return err_norm / sol_norm / 3.0;
+    }
+  };
+
+} // namespace Tines
+
+#endif
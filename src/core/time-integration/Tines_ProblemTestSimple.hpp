@@ -67,12 +67,18 @@ namespace Tines {
       return getNumberOfTimeODEs() + getNumberOfConstraints();
     }
 
+    /// sacado jacobian; the derivative length is the number of equations
+    using sacado_jacobian_type = SacadoJacobian<real_type, device_type, 3>;
+    real_type_1d_view_type _work_sacado;
+
     KOKKOS_INLINE_FUNCTION
     void workspace(int &wlen) const {
       const int m = getNumberOfEquations();
       const int wlen_numeric_jacobian = 2 * m;
+      int wlen_sacado_jacobian(0);
+      sacado_jacobian_type::workspace(*this, wlen_sacado_jacobian);
 
-      wlen = wlen_numeric_jacobian;
+      wlen = wlen_numeric_jacobian + wlen_sacado_jacobian;
     }
 
     KOKKOS_INLINE_FUNCTION
@@ -86,10 +92,14 @@ namespace Tines {
     KOKKOS_INLINE_FUNCTION
     void setWorkspace(const real_type_1d_view_type &work) {
       const int m = getNumberOfEquations();
-      assert(2 * m <= int(work.extent(0)) &&
+      int wlen(0);
+      workspace(wlen);
+      assert(wlen <= int(work.extent(0)) &&
              "Error: workspace is smaller than required");
       _f_0 = real_type_1d_view_type(work.data() + 0 * m, m);
       _f_h = real_type_1d_view_type(work.data() + 1 * m, m);
+      _work_sacado =
+        real_type_1d_view_type(work.data() + 2 * m, wlen - 2 * m);
     }
 
     template <typename MemberType>
@@ -103,16 +113,32 @@ namespace Tines {
       member.team_barrier();
     }
 
+    /// x and f can be real or sacado views
+    template <typename MemberType, typename XViewType, typename FViewType>
+    KOKKOS_INLINE_FUNCTION void computeFunction(const MemberType &member,
+                                                const XViewType &x,
+                                                const FViewType &f) const {
+      using ats_x = ats<typename XViewType::non_const_value_type>;
+      Kokkos::single(Kokkos::PerTeam(member), [&]() {
+        f(0) = 3 * x(0) - ats_x::cos(x(1) * x(2)) - 1.5;
+        f(1) = 4 * x(0) * x(0) - 625 * x(1) * x(1) + 2 * x(2) - 1;
+        f(2) = 20 * x(2) + ats_x::exp(-x(0) * x(1)) + 9;
+      });
+      member.team_barrier();
+    }
+
+    /// function evaluated by a team thread; used when columns of a numerical
+    /// jacobian are computed concurrently
     template <typename MemberType>
     KOKKOS_INLINE_FUNCTION void
-    computeFunction(const MemberType &member, const real_type_1d_view_type &x,
-                    const real_type_1d_view_type &f) const {
-      Kokkos::single(Kokkos::PerTeam(member), [&]() {
+    computeFunctionPerThread(const MemberType &member,
+                             const real_type_1d_view_type &x,
+                             const real_type_1d_view_type &f) const {
+      Kokkos::single(Kokkos::PerThread(member), [&]() {
         f(0) = 3 * x(0) - ats<value_type>::cos(x(1) * x(2)) - 1.5;
         f(1) = 4 * x(0) * x(0) - 625 * x(1) * x(1) + 2 * x(2) - 1;
         f(2) = 20 * x(2) + ats<value_type>::exp(-x(0) * x(1)) + 9;
       });
-      member.team_barrier();
     }
 
     template <typename MemberType>
@@ -147,12 +173,36 @@ namespace Tines {
       member.team_barrier();
     }
 
+    /// block diagonal part of the jacobian P(i,j) = J(i, (i/bs)*bs + j)
+    /// where bs = P.extent(1); it preconditions the newton-krylov solver
+    template <typename MemberType>
+    KOKKOS_INLINE_FUNCTION void
+    computeJacobianBlockDiagonal(const MemberType &member,
+                                 const real_type_1d_view_type &x,
+                                 const real_type_2d_view_type &P) const {
+      const int m = getNumberOfEquations(), bs = P.extent(1);
+      Kokkos::single(Kokkos::PerTeam(member), [&]() {
+        const value_type s = ats<value_type>::sin(x(1) * x(2)),
+                         e = ats<value_type>::exp(-x(0) * x(1));
+        const value_type J[3][3] = {{3, x(2) * s, x(1) * s},
+                                    {8 * x(0), -1250 * x(1), 2},
+                                    {-x(1) * e, -x(0) * e, 20}};
+        for (int i = 0; i < m; ++i)
+          for (int j = 0; j < bs; ++j) {
+            const int c = (i / bs) * bs + j;
+            P(i, j) = c < m ? J[i][c] : value_type(0);
+          }
+      });
+      member.team_barrier();
+    }
+
     /// this one is used in time integration nonlinear solve
     template <typename MemberType>
     KOKKOS_INLINE_FUNCTION void
     computeAnalyticJacobianUsingSacado(const MemberType &member,
                                        const real_type_1d_view_type &x,
                                        const real_type_2d_view_type &J) const {
+      sacado_jacobian_type::invoke(member, *this, x, J, _work_sacado);
       member.team_barrier();
     }
 
@@ -0,0 +1,306 @@
+/*----------------------------------------------------------------------------------
+Tines - Time Integrator, Newton and Eigen Solver -  version 1.0
+Copyright (2021) NTESS
+https://github.com/sandialabs/Tines
+
+Copyright 2021 National Technology & Engineering Solutions of Sandia, LLC (NTESS). 
+Under the terms of Contract DE-NA0003525 with NTESS, the U.S. Government retains 
+certain rights in this software.
+
+This file is part of Tines. Tines is open-source software: you can redistribute it
+and/or modify it under the terms of BSD 2-Clause License
+(https://opensource.org/licenses/BSD-2-Clause). A copy of the license is also
+provided under the main directory
+Questions? Kyungjoo Kim <kyukim@sandia.gov>, or
+	   Oscar Diaz-Ibarra at <odiazib@sandia.gov>, or
+	   Cosmin Safta at <csafta@sandia.gov>, or
+	   Habib Najm at <hnnajm@sandia.gov>
+
+Sandia National Laboratories, New Mexico, USA
+----------------------------------------------------------------------------------*/
+#ifndef __TINES_PROBLEM_TEST_SPARSE_HPP__
+#define __TINES_PROBLEM_TEST_SPARSE_HPP__
+
+#include "Tines_Internal.hpp"
+
+namespace Tines {
+
+  template <typename ValueType, typename DeviceType> struct ProblemTestSparse {
+    using value_type = ValueType;
+    using device_type = DeviceType;
+    using scalar_type = typename ats<value_type>::scalar_type;
+
+    using real_type = scalar_type;
+    using real_type_1d_view_type = value_type_1d_view<real_type, device_type>;
+    using real_type_2d_view_type = value_type_2d_view<real_type, device_type>;
+    using int_type_1d_view_type = value_type_1d_view<int, device_type>;
+
+    static_assert(!ats<value_type>::is_sacado,
+                  "This problem must be templated with built-in scalar");
+
+    /// numeric jacobian workspace
+    real_type _fac_min, _fac_max;
+    real_type_1d_view_type _fac, _x_0, _f_0, _f_h;
+
+    /// jacobian coloring
+    int _ncolors;
+    int_type_1d_view_type _color, _col_ptr, _row_idx;
+
+    KOKKOS_DEFAULTED_FUNCTION
+    ProblemTestSparse() = default;
+
+    /// system of equations f (reaction-diffusion like chain with the last
+    /// variable e.g., temperature coupled to all equations)
+    /// f_i     = x_{i-1} - 2 x_i + x_{i+1} + exp(-x_{m-1}) x_i^2, i < m-1
+    /// f_{m-1} = x_{m-2} - 2 x_{m-1} + x_{m-1}^2 / 10
+    /// the jacobian is tridiagonal with a dense last column; 4 colors are
+    /// enough to compute a numerical jacobian
+    KOKKOS_INLINE_FUNCTION
+    int getNumberOfTimeODEs() const { return 30; }
+
+    KOKKOS_INLINE_FUNCTION
+    int getNumberOfConstraints() const { return 0; }
+
+    KOKKOS_INLINE_FUNCTION
+    int getNumberOfEquations() const {
+      return getNumberOfTimeODEs() + getNumberOfConstraints();
+    }
+
+    KOKKOS_INLINE_FUNCTION
+    int getNumberOfJacobianNonZeros() const {
+      const int m = getNumberOfEquations();
+      /// tridiagonal part of m-1 columns and the last column
+      return (3 * (m - 1) - 1) + m;
+    }
+
+    /// sparsity pattern of the jacobian in the compressed column storage
+    template <typename MemberType>
+    KOKKOS_INLINE_FUNCTION void
+    computeJacobianSparsityPattern(const MemberType &member,
+                                   const int_type_1d_view_type &col_ptr,
+                                   const int_type_1d_view_type &row_idx) const {
+      const int m = getNumberOfEquations();
+      Kokkos::single(Kokkos::PerTeam(member), [&]() {
+        int nnz(0);
+        for (int j = 0; j < m; ++j) {
+          col_ptr(j) = nnz;
+          const int ibeg = j == (m - 1) ? 0 : (j > 0 ? j - 1 : 0);
+          const int iend = j == (m - 1) ? m : (j + 2 < m ? j + 2 : m);
+          for (int i = ibeg; i < iend; ++i)
+            row_idx(nnz++) = i;
+        }
+        col_ptr(m) = nnz;
+      });
+      member.team_barrier();
+    }
+
+    KOKKOS_INLINE_FUNCTION
+    void workspace(int &wlen) const {
+      const int m = getNumberOfEquations();
+      const int wlen_numeric_jacobian = 3 * m;
+
+      wlen = wlen_numeric_jacobian;
+    }
+
+    KOKKOS_INLINE_FUNCTION
+    void setFaction(const real_type fac_min, const real_type fac_max,
+                    const real_type_1d_view_type &fac) {
+      _fac_min = fac_min;
+      _fac_max = fac_max;
+      _fac = fac;
+    }
+
+    KOKKOS_INLINE_FUNCTION
+    void setJacobianColoring(const int ncolors,
+                             const int_type_1d_view_type &color,
+                             const int_type_1d_view_type &col_ptr,
+                             const int_type_1d_view_type &row_idx) {
+      _ncolors = ncolors;
+      _color = color;
+      _col_ptr = col_ptr;
+      _row_idx = row_idx;
+    }
+
+    KOKKOS_INLINE_FUNCTION
+    void setWorkspace(const real_type_1d_view_type &work) {
+      const int m = getNumberOfEquations();
+      assert(3 * m <= int(work.extent(0)) &&
+             "Error: workspace is smaller than required");
+      _x_0 = real_type_1d_view_type(work.data() + 0 * m, m);
+      _f_0 = real_type_1d_view_type(work.data() + 1 * m, m);
+      _f_h = real_type_1d_view_type(work.data() + 2 * m, m);
+    }
+
+    template <typename MemberType>
+    KOKKOS_INLINE_FUNCTION void
+    computeInitValues(const MemberType &member,
+                      const real_type_1d_view_type &x) const {
+      const value_type one(1), tenth(0.1);
+      const int m = getNumberOfEquations();
+      Kokkos::parallel_for(
+        Kokkos::TeamVectorRange(member, m),
+        [&](const int &i) { x(i) = one + tenth * value_type(i) / m; });
+      member.team_barrier();
+    }
+
+    /// x and f can be real or sacado views
+    template <typename MemberType, typename XViewType, typename FViewType>
+    KOKKOS_INLINE_FUNCTION void computeFunction(const MemberType &member,
+                                                const XViewType &x,
+                                                const FViewType &f) const {
+      using x_value_type = typename XViewType::non_const_value_type;
+      const int m = getNumberOfEquations();
+      const real_type zero(0), two(2), ten(10);
+      const x_value_type e = ats<x_value_type>::exp(-x(m - 1));
+      Kokkos::parallel_for(
+        Kokkos::TeamVectorRange(member, m), [&](const int &i) {
+          const x_value_type x_im1 = i > 0 ? x_value_type(x(i - 1)) : zero;
+          const x_value_type x_ip1 = i + 1 < m ? x_value_type(x(i + 1)) : zero;
+          f(i) = x_im1 - two * x(i) + x_ip1;
+          if (i < (m - 1))
+            f(i) += e * x(i) * x(i);
+          else
+            f(i) += x(i) * x(i) / ten;
+        });
+      member.team_barrier();
+    }
+
+    /// function evaluated by a team thread
+    template <typename MemberType>
+    KOKKOS_INLINE_FUNCTION void
+    computeFunctionPerThread(const MemberType &member,
+                             const real_type_1d_view_type &x,
+                             const real_type_1d_view_type &f) const {
+      const int m = getNumberOfEquations();
+      const value_type zero(0), two(2), ten(10);
+      const value_type e = ats<value_type>::exp(-x(m - 1));
+      Kokkos::parallel_for(
+        Kokkos::ThreadVectorRange(member, m), [&](const int &i) {
+          const value_type x_im1 = i > 0 ? x(i - 1) : zero;
+          const value_type x_ip1 = i + 1 < m ? x(i + 1) : zero;
+          f(i) = x_im1 - two * x(i) + x_ip1;
+          if (i < (m - 1))
+            f(i) += e * x(i) * x(i);
+          else
+            f(i) += x(i) * x(i) / ten;
+        });
+    }
+
+    template <typename MemberType>
+    KOKKOS_INLINE_FUNCTION void
+    computeNumericalJacobian(const MemberType &member,
+                             const real_type_1d_view_type &x,
+                             const real_type_2d_view_type &J) const {
+      NumericalJacobianForwardDifference<real_type, device_type>::invoke(
+        member, *this, _fac_min, _fac_max, _fac, _ncolors, _color, _col_ptr,
+        _row_idx, x, _x_0, _f_0, _f_h, J);
+      member.team_barrier();
+    }
+
+    template <typename MemberType>
+    KOKKOS_INLINE_FUNCTION void
+    computeAnalyticJacobian(const MemberType &member,
+                            const real_type_1d_view_type &x,
+                            const real_type_2d_view_type &J) const {
+      const int m = getNumberOfEquations();
+      const value_type zero(0), one(1), two(2), ten(10);
+      const value_type e = ats<value_type>::exp(-x(m - 1));
+      Kokkos::parallel_for(
+        Kokkos::TeamVectorRange(member, m), [&](const int &i) {
+          for (int j = 0; j < m; ++j)
+            J(i, j) = zero;
+          if (i > 0)
+            J(i, i - 1) = one;
+          if (i < (m - 1)) {
+            J(i, i) = -two + two * e * x(i);
+            J(i, i + 1) = one;
+            J(i, m - 1) -= e * x(i) * x(i);
+          } else {
+            J(i, i) = -two + two * x(i) / ten;
+          }
+        });
+      member.team_barrier();
+    }
+
+    /// block diagonal part of the jacobian P(i,j) = J(i, (i/bs)*bs + j)
+    /// where bs = P.extent(1); it preconditions the newton-krylov solver
+    template <typename MemberType>
+    KOKKOS_INLINE_FUNCTION void
+    computeJacobianBlockDiagonal(const MemberType &member,
+                                 const real_type_1d_view_type &x,
+                                 const real_type_2d_view_type &P) const {
+      const int m = getNumberOfEquations(), bs = P.extent(1);
+      const value_type zero(0), one(1), two(2), ten(10);
+      const value_type e = ats<value_type>::exp(-x(m - 1));
+      Kokkos::parallel_for(
+        Kokkos::TeamVectorRange(member, m), [&](const int &i) {
+          const int c0 = (i / bs) * bs;
+          for (int j = 0; j < bs; ++j) {
+            const int c = c0 + j;
+            value_type val(0);
+            if (c == i - 1 || c == i + 1)
+              val = one;
+            if (i < (m - 1)) {
+              if (c == i)
+                val = -two + two * e * x(i);
+              if (c == (m - 1))
+                val -= e * x(i) * x(i);
+            } else if (c == i) {
+              val = -two + two * x(i) / ten;
+            }
+            P(i, j) = c < m ? val : zero;
+          }
+        });
+      member.team_barrier();
+    }
+
+    /// this one is used in time integration nonlinear solve
+    template <typename MemberType>
+    KOKKOS_INLINE_FUNCTION void
+    computeJacobian(const MemberType &member, const real_type_1d_view_type &x,
+                    const real_type_2d_view_type &J) const {
+#if defined(TINES_TEST_NUMERIC_JACOBIAN)
+      computeNumericalJacobian(member, x, J);
+#else
+      computeAnalyticJacobian(member, x, J);
+#endif
+      member.team_barrier();
+    }
+
+    ///
+    /// Test only interface (not used in real problem struct
+    ///
+    template <typename MemberType>
+    KOKKOS_INLINE_FUNCTION void computeNumericalJacobianForwardDifference(
+      const MemberType &member, const real_type_1d_view_type &x,
+      const real_type_2d_view_type &J) const {
+      NumericalJacobianForwardDifference<real_type, device_type>::invoke(
+        member, *this, _fac_min, _fac_max, _fac, _ncolors, _color, _col_ptr,
+        _row_idx, x, _x_0, _f_0, _f_h, J);
+      member.team_barrier();
+    }
+
+    template <typename MemberType>
+    KOKKOS_INLINE_FUNCTION void computeNumericalJacobianCentralDifference(
+      const MemberType &member, const real_type_1d_view_type &x,
+      const real_type_2d_view_type &J) const {
+      NumericalJacobianCentralDifference<real_type, device_type>::invoke(
+        member, *this, _fac_min, _fac_max, _fac, _ncolors, _color, _col_ptr,
+        _row_idx, x, _x_0, _f_0, _f_h, J);
+      member.team_barrier();
+    }
+
+    template <typename MemberType>
+    KOKKOS_INLINE_FUNCTION void computeNumericalJacobianRichardsonExtrapolation(
+      const MemberType &member, const real_type_1d_view_type &x,
+      const real_type_2d_view_type &J) const {
+      NumericalJacobianRichardsonExtrapolation<real_type, device_type>::invoke(
+        member, *this, _fac_min, _fac_max, _fac, _ncolors, _color, _col_ptr,
+        _row_idx, x, _x_0, _f_0, _f_h, J);
+      member.team_barrier();
+    }
+  };
+
+} // namespace Tines
+
+#endif
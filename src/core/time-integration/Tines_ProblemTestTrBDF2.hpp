@@ -38,6 +38,10 @@ namespace Tines {
     static_assert(!ats<value_type>::is_sacado,
                   "This problem must be templated with built-in scalar");
 
+    /// the size is known at compile time; the Newton solver uses the fixed
+    /// size kernels
+    static constexpr int static_number_of_equations = 3;
+
     KOKKOS_DEFAULTED_FUNCTION
     ProblemTestTrBDF2() = default;
 
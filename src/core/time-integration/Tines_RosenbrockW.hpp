@@ -0,0 +1,161 @@
+/*----------------------------------------------------------------------------------
+Tines - Time Integrator, Newton and Eigen Solver -  version 1.0
+Copyright (2021) NTESS
+https://github.com/sandialabs/Tines
+
+Copyright 2021 National Technology & Engineering Solutions of Sandia, LLC (NTESS). 
+Under the terms of Contract DE-NA0003525 with NTESS, the U.S. Government retains 
+certain rights in this software.
+
+This file is part of Tines. Tines is open-source software: you can redistribute it
+and/or modify it under the terms of BSD 2-Clause License
+(https://opensource.org/licenses/BSD-2-Clause). A copy of the license is also
+provided under the main directory
+Questions? Kyungjoo Kim <kyukim@sandia.gov>, or
+	   Oscar Diaz-Ibarra at <odiazib@sandia.gov>, or
+	   Cosmin Safta at <csafta@sandia.gov>, or
+	   Habib Najm at <hnnajm@sandia.gov>
+
+Sandia National Laboratories, New Mexico, USA
+----------------------------------------------------------------------------------*/
+#ifndef __TINES_ROSENBROCK_W_HPP__
+#define __TINES_ROSENBROCK_W_HPP__
+
+namespace Tines {
+
+  ///
+  /// Coefficients of a Rosenbrock-W method with an embedded error estimate
+  /// - the method is given by (alpha, Gamma, b, bhat) with the constant
+  ///   diagonal gamma of Gamma
+  /// - the stages are solved in the transformed variables of Hairer and
+  ///   Wanner; U_i = sum_j gamma_ij k_j avoids Jacobian-vector products
+  ///     (I - dt gamma J) U_i = dt gamma f(u_n + sum_{j<i} a_ij U_j)
+  ///                          + gamma sum_{j<i} c_ij U_j
+  ///     u_{n+1} = u_n + sum_i m_i U_i
+  ///   where a = alpha Gamma^{-1}, c = diag(1/gamma) - Gamma^{-1} and
+  ///   m = b Gamma^{-1}
+  ///
+  template <typename RealType> struct RosenbrockW_Tableau {
+    using real_type = RealType;
+
+    static constexpr int max_number_of_stages = 4;
+
+    /// available methods
+    enum : int {
+      /// ROS34PW2 (Rang and Angermann); order 3 with embedded order 2,
+      /// stiffly accurate and suited for index-1 DAEs
+      ROS34PW2 = 0
+    };
+
+    int _number_of_stages, _order, _embedded_order;
+    real_type _gamma;
+
+    /// transformed coefficients
+    real_type _a[max_number_of_stages][max_number_of_stages];
+    real_type _c[max_number_of_stages][max_number_of_stages];
+    real_type _m[max_number_of_stages], _mhat[max_number_of_stages];
+
+    KOKKOS_INLINE_FUNCTION
+    RosenbrockW_Tableau(const int method = ROS34PW2) {
+      real_type alpha[max_number_of_stages][max_number_of_stages],
+        Gamma[max_number_of_stages][max_number_of_stages],
+        b[max_number_of_stages], bhat[max_number_of_stages];
+      for (int i = 0; i < max_number_of_stages; ++i) {
+        for (int j = 0; j < max_number_of_stages; ++j) {
+          alpha[i][j] = real_type(0);
+          Gamma[i][j] = real_type(0);
+        }
+        b[i] = real_type(0);
+        bhat[i] = real_type(0);
+      }
+      switch (method) {
+      case ROS34PW2:
+      default:
+        setROS34PW2(alpha, Gamma, b, bhat);
+        break;
+      }
+      setTransformedCoefficients(alpha, Gamma, b, bhat);
+    }
+
+    KOKKOS_INLINE_FUNCTION
+    int getNumberOfStages() const { return _number_of_stages; }
+
+    KOKKOS_INLINE_FUNCTION
+    void setROS34PW2(real_type alpha[][max_number_of_stages],
+                     real_type Gamma[][max_number_of_stages], real_type *b,
+                     real_type *bhat) {
+      const real_type g(4.3586652150845900e-01);
+      _number_of_stages = 4;
+      _order = 3;
+      _embedded_order = 2;
+      _gamma = g;
+
+      alpha[1][0] = 8.7173304301691801e-01;
+      alpha[2][0] = 8.4457060015369423e-01;
+      alpha[2][1] = -1.1299064236484185e-01;
+      alpha[3][2] = 1.0;
+
+      Gamma[1][0] = -8.7173304301691801e-01;
+      Gamma[2][0] = -9.0338057013044082e-01;
+      Gamma[2][1] = 5.4180672388095326e-02;
+      Gamma[3][0] = 2.4212380706095346e-01;
+      Gamma[3][1] = -1.2232505839045147e+00;
+      Gamma[3][2] = 5.4526025533510214e-01;
+      for (int i = 0; i < _number_of_stages; ++i)
+        Gamma[i][i] = g;
+
+      b[0] = 2.4212380706095346e-01;
+      b[1] = -1.2232505839045147e+00;
+      b[2] = 1.5452602553351020e+00;
+      b[3] = 4.3586652150845900e-01;
+
+      bhat[0] = 3.7810903145819369e-01;
+      bhat[1] = -9.6042292212423178e-02;
+      bhat[2] = 5.0000000000000000e-01;
+      bhat[3] = 2.1793326075422950e-01;
+    }
+
+    KOKKOS_INLINE_FUNCTION
+    void setTransformedCoefficients(
+      const real_type alpha[][max_number_of_stages],
+      const real_type Gamma[][max_number_of_stages], const real_type *b,
+      const real_type *bhat) {
+      const int s = _number_of_stages;
+
+      /// inverse of the lower triangular Gamma
+      real_type Ginv[max_number_of_stages][max_number_of_stages];
+      for (int i = 0; i < max_number_of_stages; ++i)
+        for (int j = 0; j < max_number_of_stages; ++j)
+          Ginv[i][j] = real_type(0);
+      for (int i = 0; i < s; ++i) {
+        Ginv[i][i] = real_type(1) / Gamma[i][i];
+        for (int j = 0; j < i; ++j) {
+          real_type val(0);
+          for (int k = j; k < i; ++k)
+            val += Gamma[i][k] * Ginv[k][j];
+          Ginv[i][j] = -val / Gamma[i][i];
+        }
+      }
+
+      for (int i = 0; i < max_number_of_stages; ++i) {
+        for (int j = 0; j < max_number_of_stages; ++j) {
+          real_type val(0);
+          for (int k = 0; k < s; ++k)
+            val += alpha[i][k] * Ginv[k][j];
+          _a[i][j] = (i < s && j < i) ? val : real_type(0);
+          _c[i][j] = (i < s && j < i) ? -Ginv[i][j] : real_type(0);
+        }
+        real_type m(0), mhat(0);
+        for (int k = 0; k < s; ++k) {
+          m += b[k] * Ginv[k][i];
+          mhat += bhat[k] * Ginv[k][i];
+        }
+        _m[i] = i < s ? m : real_type(0);
+        _mhat[i] = i < s ? mhat : real_type(0);
+      }
+    }
+  };
+
+} // namespace Tines
+
+#endif
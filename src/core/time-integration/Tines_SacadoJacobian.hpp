@@ -0,0 +1,168 @@
+/*----------------------------------------------------------------------------------
+Tines - Time Integrator, Newton and Eigen Solver -  version 1.0
+Copyright (2021) NTESS
+https://github.com/sandialabs/Tines
+
+Copyright 2021 National Technology & Engineering Solutions of Sandia, LLC (NTESS). 
+Under the terms of Contract DE-NA0003525 with NTESS, the U.S. Government retains 
+certain rights in this software.
+
+This file is part of Tines. Tines is open-source software: you can redistribute it
+and/or modify it under the terms of BSD 2-Clause License
+(https://opensource.org/licenses/BSD-2-Clause). A copy of the license is also
+provided under the main directory
+Questions? Kyungjoo Kim <kyukim@sandia.gov>, or
+	   Oscar Diaz-Ibarra at <odiazib@sandia.gov>, or
+	   Cosmin Safta at <csafta@sandia.gov>, or
+	   Habib Najm at <hnnajm@sandia.gov>
+
+Sandia National Laboratories, New Mexico, USA
+----------------------------------------------------------------------------------*/
+#ifndef __TINES_SACADO_JACOBIAN_HPP__
+#define __TINES_SACADO_JACOBIAN_HPP__
+
+namespace Tines {
+  ///
+  /// J_{ij} = { df_i/dx_j } using forward AD with SFad<real_type,N>
+  ///
+  /// The derivative length N is fixed at compile time; columns are seeded in
+  /// chunks of N directions, i.e., the function is evaluated ceil(m/N) times
+  /// for a dense jacobian or ceil(ncolors/N) times for a colored jacobian.
+  /// The problem should provide computeFunction templated on the view types
+  /// so that it can be evaluated with SFad views e.g.,
+  ///
+  ///   template <typename MemberType, typename XViewType, typename FViewType>
+  ///   KOKKOS_INLINE_FUNCTION void
+  ///   computeFunction(const MemberType &member, const XViewType &x,
+  ///                   const FViewType &f) const;
+  ///
+  template <typename ValueType, typename DeviceType, int N>
+  struct SacadoJacobian {
+    using value_type = ValueType;
+    using device_type = DeviceType;
+    using scalar_type = typename ats<value_type>::scalar_type;
+
+    using real_type = scalar_type;
+    using real_type_1d_view_type = value_type_1d_view<real_type, device_type>;
+    using real_type_2d_view_type = value_type_2d_view<real_type, device_type>;
+    using int_type_1d_view_type = value_type_1d_view<int, device_type>;
+
+    using fad_type = Sacado::Fad::SFad<real_type, N>;
+    using fad_type_1d_view_type = value_type_1d_view<fad_type, device_type>;
+
+    static_assert(!ats<value_type>::is_sacado,
+                  "ValueType should be a built-in scalar type");
+
+    template <template <typename, typename> class ProblemType>
+    KOKKOS_INLINE_FUNCTION static void
+    workspace(const ProblemType<value_type, device_type> &problem, int &wlen) {
+      const int m = problem.getNumberOfEquations();
+      wlen = 2 * m * (N + 1);
+    }
+
+    ///
+    /// dense jacobian
+    ///
+    template <typename MemberType,
+              template <typename, typename> class ProblemType>
+    KOKKOS_INLINE_FUNCTION static void
+    invoke(const MemberType &member,
+           const ProblemType<value_type, device_type> &problem,
+           const real_type_1d_view_type &s, const real_type_2d_view_type &J,
+           const real_type_1d_view_type &work) {
+      const int m = problem.getNumberOfEquations();
+
+      real_type *wptr = work.data();
+      fad_type_1d_view_type x(wptr, m, N + 1);
+      wptr += m * (N + 1);
+      fad_type_1d_view_type f(wptr, m, N + 1);
+      wptr += m * (N + 1);
+      assert(int(wptr - work.data()) <= int(work.span()) &&
+             "Error: workspace is smaller than required");
+
+      for (int c0 = 0; c0 < m; c0 += N) {
+        const int nc = (m - c0) < N ? (m - c0) : N;
+
+        /// seed columns c0:c0+nc-1
+        Kokkos::parallel_for(
+          Kokkos::TeamVectorRange(member, m), [&](const int &i) {
+            const int k = i - c0;
+            x(i) = (k >= 0 && k < nc) ? fad_type(N, k, s(i))
+                                      : fad_type(N, s(i));
+          });
+        member.team_barrier();
+
+        problem.computeFunction(member, x, f);
+        member.team_barrier();
+
+        /// extract jacobian
+        Kokkos::parallel_for(
+          Kokkos::TeamThreadRange(member, m), [&](const int &i) {
+            Kokkos::parallel_for(
+              Kokkos::ThreadVectorRange(member, nc),
+              [&](const int &k) { J(i, c0 + k) = f(i).fastAccessDx(k); });
+          });
+        member.team_barrier();
+      }
+    }
+
+    ///
+    /// colored jacobian (see NumericalJacobianColoring); a derivative
+    /// direction is shared by the columns of a color and the entries outside
+    /// of the sparsity pattern are set to zero
+    ///
+    template <typename MemberType,
+              template <typename, typename> class ProblemType>
+    KOKKOS_INLINE_FUNCTION static void
+    invoke(const MemberType &member,
+           const ProblemType<value_type, device_type> &problem,
+           const int &ncolors, const int_type_1d_view_type &color,
+           const int_type_1d_view_type &col_ptr,
+           const int_type_1d_view_type &row_idx,
+           const real_type_1d_view_type &s, const real_type_2d_view_type &J,
+           const real_type_1d_view_type &work) {
+      const int m = problem.getNumberOfEquations();
+      const real_type zero(0);
+
+      real_type *wptr = work.data();
+      fad_type_1d_view_type x(wptr, m, N + 1);
+      wptr += m * (N + 1);
+      fad_type_1d_view_type f(wptr, m, N + 1);
+      wptr += m * (N + 1);
+      assert(int(wptr - work.data()) <= int(work.span()) &&
+             "Error: workspace is smaller than required");
+
+      Set::invoke(member, zero, J);
+      for (int c0 = 0; c0 < ncolors; c0 += N) {
+        const int nc = (ncolors - c0) < N ? (ncolors - c0) : N;
+
+        /// seed colors c0:c0+nc-1
+        Kokkos::parallel_for(
+          Kokkos::TeamVectorRange(member, m), [&](const int &i) {
+            const int k = color(i) - c0;
+            x(i) = (k >= 0 && k < nc) ? fad_type(N, k, s(i))
+                                      : fad_type(N, s(i));
+          });
+        member.team_barrier();
+
+        problem.computeFunction(member, x, f);
+        member.team_barrier();
+
+        /// scatter the compressed jacobian
+        Kokkos::parallel_for(
+          Kokkos::TeamVectorRange(member, m), [&](const int &j) {
+            const int k = color(j) - c0;
+            if (k >= 0 && k < nc)
+              for (int l = col_ptr(j), lend = col_ptr(j + 1); l < lend; ++l) {
+                const int i = row_idx(l);
+                J(i, j) = f(i).fastAccessDx(k);
+              }
+          });
+        member.team_barrier();
+      }
+    }
+  };
+
+} // namespace Tines
+
+#endif
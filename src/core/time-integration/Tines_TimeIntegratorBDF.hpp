@@ -0,0 +1,445 @@
+/*----------------------------------------------------------------------------------
+Tines - Time Integrator, Newton and Eigen Solver -  version 1.0
+Copyright (2021) NTESS
+https://github.com/sandialabs/Tines
+
+Copyright 2021 National Technology & Engineering Solutions of Sandia, LLC (NTESS). 
+Under the terms of Contract DE-NA0003525 with NTESS, the U.S. Government retains 
+certain rights in this software.
+
+This file is part of Tines. Tines is open-source software: you can redistribute it
+and/or modify it under the terms of BSD 2-Clause License
+(https://opensource.org/licenses/BSD-2-Clause). A copy of the license is also
+provided under the main directory
+Questions? Kyungjoo Kim <kyukim@sandia.gov>, or
+	   Oscar Diaz-Ibarra at <odiazib@sandia.gov>, or
+	   Cosmin Safta at <csafta@sandia.gov>, or
+	   Habib Najm at <hnnajm@sandia.gov>
+
+Sandia National Laboratories, New Mexico, USA
+----------------------------------------------------------------------------------*/
+#ifndef __TINES_TIME_INTEGRATOR_BDF_HPP__
+#define __TINES_TIME_INTEGRATOR_BDF_HPP__
+
+namespace Tines {
+
+  ///
+  /// Adaptive variable order BDF time integration (orders 1 - 5)
+  /// - the history is a Nordsieck array kept in the workspace
+  /// - the corrector z - dt l_0 f(z) - rhs = 0 is solved by the Newton
+  ///   solver of TrBDF2 reusing the Jacobian across time steps
+  /// - the step size is controlled by TimeStepSizeController; the step size
+  ///   and the order are changed after q + 1 steps with the same step size
+  ///   and order where the order that allows the largest step is selected.
+  ///   As the step size is held between the changes, the elementary
+  ///   controller is used
+  ///
+  template <typename ValueType, typename DeviceType>
+  struct TimeIntegratorBDF {
+    using value_type = ValueType;
+    using device_type = DeviceType;
+    using scalar_type = typename ats<value_type>::scalar_type;
+
+    using real_type = scalar_type;
+    using real_type_0d_view_type = value_type_0d_view<real_type, device_type>;
+    using real_type_1d_view_type = value_type_1d_view<real_type, device_type>;
+    using real_type_2d_view_type = value_type_2d_view<real_type, device_type>;
+
+    using nordsieck_type = BDF_Nordsieck<real_type>;
+    using statistics_type = TimeIntegratorStatistics<real_type>;
+
+    KOKKOS_INLINE_FUNCTION
+    static void workspace(const int m, int &wlen) {
+      using newton_solver_type = NewtonSolver<value_type, device_type>;
+      int wlen_newton(0);
+      newton_solver_type::workspace(m, wlen_newton);
+      const int wlen_this =
+        ((nordsieck_type::max_order + 1) * m /* z */ +
+         5 * m /* y, rhs, e, e_prev, w */ + 2 * m + m * m /* dx, f, J */ +
+         m * m /* Jprob */);
+      wlen = (wlen_newton + wlen_this);
+    }
+
+    ///
+    /// integrate from (t_beg, vals) to t_end; the interface follows
+    /// TimeIntegratorTrBDF2 with the maximum order of the method
+    ///
+    template <typename MemberType,
+              template <typename, typename> class ProblemType>
+    KOKKOS_INLINE_FUNCTION static int invoke(
+      const MemberType &member,
+      /// problem
+      const ProblemType<value_type, device_type> &problem,
+      /// input method; the maximum order (1 - 5)
+      const int &max_order,
+      /// input iteration
+      const int &max_num_newton_iterations, const int &max_num_time_iterations,
+      const real_type_1d_view_type &tol_newton,
+      const real_type_2d_view_type &tol_time,
+      /// input jacobian reuse; zero disables the reuse
+      const real_type &jacobian_reuse_dt_ratio,
+      /// input step size controller
+      const real_type &safety, const real_type &factor_min,
+      const real_type &factor_max,
+      /// input time step and time range
+      const real_type &dt_in, const real_type &dt_min, const real_type &dt_max,
+      const real_type &t_beg, const real_type &t_end,
+      /// input (initial condition)
+      const real_type_1d_view_type &vals,
+      /// output (final output conditions)
+      const real_type_0d_view_type &t_out, const real_type_0d_view_type &dt_out,
+      const real_type_1d_view_type &vals_out,
+      /// output (statistics)
+      /* */ statistics_type &stats,
+      /// workspace
+      const real_type_1d_view_type &work) {
+      using newton_solver_type = NewtonSolver<value_type, device_type>;
+      using stage_type = ESDIRK_Stage<value_type, device_type, ProblemType>;
+      using trbdf2_integrator_type =
+        TimeIntegratorTrBDF2<value_type, device_type>;
+
+      /// return value; when it fails it return non-zero value
+      int r_val(0);
+
+      /// const values
+      const real_type zero(0), one(1), half(0.5), minus_one(-1);
+
+      /// step size increases smaller than this are not taken as they require
+      /// rescaling the Nordsieck array
+      const real_type eta_threshold(1.5);
+
+      /// early return
+      stats.reset();
+      if (dt_in < zero) {
+        stats.setFailureReason(statistics_type::InvalidTimeStep);
+        return 3;
+      }
+
+      const int m = problem.getNumberOfEquations(),
+                m_ode = problem.getNumberOfTimeODEs();
+      const int q_max = (max_order < 1 ? 1
+                         : max_order > nordsieck_type::max_order
+                           ? nordsieck_type::max_order
+                           : max_order);
+
+      const TimeStepSizeController<real_type> controller(safety, factor_min,
+                                                         factor_max, false);
+
+      stage_type stage;
+      stage._problem = problem;
+
+      /// workspace
+      auto wptr = work.data();
+
+      int wlen_newton(0);
+      newton_solver_type::workspace(m, wlen_newton);
+      auto work_newton = real_type_1d_view_type(wptr, wlen_newton);
+      wptr += wlen_newton;
+
+      /// nordsieck array
+      auto z =
+        real_type_2d_view_type(wptr, nordsieck_type::max_order + 1, m);
+      wptr += (nordsieck_type::max_order + 1) * m;
+
+      auto y = real_type_1d_view_type(wptr, m);
+      wptr += m;
+      auto rhs = real_type_1d_view_type(wptr, m);
+      wptr += m;
+      auto e = real_type_1d_view_type(wptr, m);
+      wptr += m;
+      auto e_prev = real_type_1d_view_type(wptr, m);
+      wptr += m;
+      auto w = real_type_1d_view_type(wptr, m);
+      wptr += m;
+
+      /// newton workspace
+      auto dx = real_type_1d_view_type(wptr, m);
+      wptr += m;
+      auto f = real_type_1d_view_type(wptr, m);
+      wptr += m;
+      auto J = real_type_2d_view_type(wptr, m, m);
+      wptr += m * m;
+
+      /// problem jacobian kept for reuse
+      auto Jprob = real_type_2d_view_type(wptr, m, m);
+      wptr += m * m;
+      stage._Jprob = Jprob;
+      stage._rhs = rhs;
+
+      /// error check
+      const int workspace_used(wptr - work.data()),
+        workspace_extent(work.extent(0));
+
+      assert(workspace_used <= workspace_extent &&
+             "Error: workspace is used more than allocated");
+
+      /// initial nordsieck array of order one; z_0 = u and z_1 = dt u'
+      /// where the derivatives of constraints are unknown and set zero
+      real_type t(t_beg), dt(dt_in), dt_z(dt_in);
+      int q(1);
+      {
+        Kokkos::parallel_for(Kokkos::TeamVectorRange(member, m),
+                             [&](const int &k) { y(k) = vals(k); });
+        member.team_barrier();
+        problem.computeFunction(member, y, f);
+        ++stats.num_function_evaluations;
+        Kokkos::parallel_for(Kokkos::TeamVectorRange(member, m),
+                             [&](const int &k) {
+                               z(0, k) = y(k);
+                               z(1, k) = k < m_ode ? dt_z * f(k) : zero;
+                               for (int j = 2; j <= q_max; ++j)
+                                 z(j, k) = zero;
+                             });
+        member.team_barrier();
+      }
+
+      /// jacobian state shared by time steps
+      int is_jacobian_factorized(false), is_jacobian_kept(false);
+      real_type jacobian_scale(0);
+
+      /// step size control state
+      int is_rejected(false), num_steps_at_order(0),
+        num_consecutive_rejections(0);
+
+      /// corrector coefficients of the current order
+      real_type l[nordsieck_type::max_order + 1];
+
+      /// time integration
+      int iter(0);
+      for (; iter < max_num_time_iterations && dt != zero; ++iter) {
+        dt = (dt > dt_min ? dt : dt_min);
+        /// dt_min should not step over the end of the time window
+        dt = ((t + dt) > t_end) ? t_end - t : dt;
+        if (dt != dt_z) {
+          nordsieck_type::rescale(member, q, m, dt / dt_z, z);
+          dt_z = dt;
+          num_steps_at_order = 0;
+        }
+
+        nordsieck_type::computeCoefficients(q, l);
+        nordsieck_type::predict(member, q, m, z);
+
+        int converge(false);
+        for (int attempt = 0; attempt < 4 && !converge; ++attempt) {
+          /// try again with half time step
+          if (attempt > 0) {
+            nordsieck_type::retract(member, q, m, z);
+            dt *= half;
+            dt = (dt > dt_min ? dt : dt_min);
+            nordsieck_type::rescale(member, q, m, dt / dt_z, z);
+            dt_z = dt;
+            num_steps_at_order = 0;
+            nordsieck_type::predict(member, q, m, z);
+          }
+          stage._scale = dt * l[0];
+
+          /// rhs = z_0 - l_0 z_1 of the predicted array; the predicted
+          /// solution is the initial guess
+          Kokkos::parallel_for(Kokkos::TeamVectorRange(member, m),
+                               [&](const int &k) {
+                                 rhs(k) = z(0, k) - l[0] * z(1, k);
+                                 y(k) = z(0, k);
+                               });
+          member.team_barrier();
+
+          int newton_iteration_count(0), jacobian_evaluation_count(0),
+            factorization_count(0);
+          trbdf2_integrator_type::solveNewtonWithJacobianReuse(
+            member, stage, max_num_newton_iterations, tol_newton,
+            jacobian_reuse_dt_ratio, y, dx, f, J, work_newton,
+            is_jacobian_factorized, is_jacobian_kept, jacobian_scale, converge,
+            newton_iteration_count, jacobian_evaluation_count,
+            factorization_count);
+          stats.num_newton_iterations += newton_iteration_count;
+          stats.num_jacobian_evaluations += jacobian_evaluation_count;
+          stats.num_factorizations += factorization_count;
+          stats.num_linear_solves += newton_iteration_count;
+          stats.num_function_evaluations += newton_iteration_count;
+        }
+
+        if (!converge) {
+          Kokkos::single(Kokkos::PerTeam(member), [&]() {
+            printf("Warning: TimeIntegratorBDF, sample (%d) fails to "
+                   "converge with current time step %e\n",
+                   int(member.league_rank()), dt);
+          });
+          r_val = 1;
+          break;
+        }
+
+        /// correction e = (u - z_0) / l_0; the local error of order q is
+        /// l_0^2 / (q + 1) e
+        real_type err(0);
+        {
+          const real_type err_coeff = l[0] * l[0] / real_type(q + 1);
+          Kokkos::parallel_for(Kokkos::TeamVectorRange(member, m),
+                               [&](const int &k) {
+                                 e(k) = (y(k) - z(0, k)) / l[0];
+                                 w(k) = err_coeff * e(k);
+                               });
+          member.team_barrier();
+          TimeStepSizeController<real_type>::computeWrmsNorm(
+            member, tol_time, m_ode, w, y, err);
+        }
+
+        if (err > one && dt > dt_min) {
+          /// reject the step; the array is restored and the step is retried
+          nordsieck_type::retract(member, q, m, z);
+          ++stats.num_rejected_time_steps;
+          ++num_consecutive_rejections;
+          if (num_consecutive_rejections >= 3 && q > 1) {
+            /// the history is not reliable; restart with order one
+            Kokkos::parallel_for(Kokkos::TeamVectorRange(member, m),
+                                 [&](const int &k) { y(k) = z(0, k); });
+            member.team_barrier();
+            problem.computeFunction(member, y, f);
+            ++stats.num_function_evaluations;
+            Kokkos::parallel_for(Kokkos::TeamVectorRange(member, m),
+                                 [&](const int &k) {
+                                   z(1, k) = k < m_ode ? dt_z * f(k) : zero;
+                                   for (int j = 2; j <= q_max; ++j)
+                                     z(j, k) = zero;
+                                 });
+            member.team_barrier();
+            q = 1;
+            dt *= factor_min;
+          } else {
+            dt *= controller.computeFactor(err, zero, is_rejected,
+                                           real_type(q + 1));
+          }
+          dt = dt < dt_min ? dt_min : dt;
+          num_steps_at_order = 0;
+          is_rejected = true;
+          continue;
+        }
+
+        /// correct the nordsieck array
+        Kokkos::parallel_for(Kokkos::TeamVectorRange(member, m),
+                             [&](const int &k) {
+                               for (int j = 0; j <= q; ++j)
+                                 z(j, k) += l[j] * e(k);
+                             });
+        member.team_barrier();
+
+        stats.acceptTimeStep(dt);
+        t += dt;
+        ++num_steps_at_order;
+        num_consecutive_rejections = 0;
+
+        /// the step size and the order are kept for q + 1 steps after a
+        /// change; then the order of q - 1, q or q + 1 is selected with the
+        /// largest step size
+        real_type eta(one);
+        int q_new(q);
+        if (num_steps_at_order > q) {
+          eta = controller.computeFactor(err, zero, is_rejected,
+                                         real_type(q + 1));
+          if (q > 1) {
+            /// local error of order q - 1 from z_q = dt^q u^{(q)} / q!
+            const real_type err_coeff =
+              nordsieck_type::getLeadingCoefficient(q - 1) / real_type(q) *
+              nordsieck_type::getFactorial(q);
+            real_type err_down(0);
+            Kokkos::parallel_for(Kokkos::TeamVectorRange(member, m_ode),
+                                 [&](const int &k) {
+                                   w(k) = err_coeff * z(q, k);
+                                 });
+            member.team_barrier();
+            TimeStepSizeController<real_type>::computeWrmsNorm(
+              member, tol_time, m_ode, w, y, err_down);
+            const real_type eta_down =
+              controller.computeFactor(err_down, zero, false, real_type(q));
+            if (eta_down > eta) {
+              eta = eta_down;
+              q_new = q - 1;
+            }
+          }
+          if (q < q_max) {
+            /// local error of order q + 1 from the difference of the
+            /// corrections of the last two steps with the same step size
+            const real_type err_coeff =
+              nordsieck_type::getLeadingCoefficient(q + 1) /
+              real_type(q + 2) * l[0];
+            real_type err_up(0);
+            Kokkos::parallel_for(Kokkos::TeamVectorRange(member, m_ode),
+                                 [&](const int &k) {
+                                   w(k) = err_coeff * (e(k) - e_prev(k));
+                                 });
+            member.team_barrier();
+            TimeStepSizeController<real_type>::computeWrmsNorm(
+              member, tol_time, m_ode, w, y, err_up);
+            const real_type eta_up =
+              controller.computeFactor(err_up, zero, false, real_type(q + 2));
+            if (eta_up > eta) {
+              eta = eta_up;
+              q_new = q + 1;
+            }
+          }
+
+          if (q_new != q) {
+            /// z_{q+1} = dt^{q+1} u^{(q+1)} / (q+1)! is estimated from the
+            /// correction; for a lower order z_q is dropped
+            const int q_cur = q;
+            Kokkos::parallel_for(Kokkos::TeamVectorRange(member, m),
+                                 [&](const int &k) {
+                                   if (q_new > q_cur)
+                                     z(q_new, k) =
+                                       l[q_cur] * e(k) / real_type(q_new);
+                                   else
+                                     z(q_cur, k) = zero;
+                                 });
+            member.team_barrier();
+            q = q_new;
+            num_steps_at_order = 0;
+          }
+
+          /// small increases are not worth rescaling the nordsieck array
+          if (eta > one && eta < eta_threshold)
+            eta = one;
+        }
+
+        dt = dt_z * eta;
+        dt = dt < dt_min ? dt_min : dt > dt_max ? dt_max : dt;
+        dt = ((t + dt) > t_end) ? t_end - t : dt;
+        is_rejected = false;
+        Kokkos::parallel_for(Kokkos::TeamVectorRange(member, m),
+                             [&](const int &k) { e_prev(k) = e(k); });
+        member.team_barrier();
+      }
+
+      stats.num_time_iterations = iter;
+      stats.setFailureReason(r_val != 0    ? statistics_type::NewtonFailure
+                             : dt != zero ? statistics_type::MaxTimeIterations
+                                          : statistics_type::Success);
+
+      /// finalize with output for next iterations of time solutions
+      if (r_val == 0) {
+        Kokkos::parallel_for(Kokkos::TeamVectorRange(member, m),
+                             [&](const int &k) {
+                               vals_out(k) = z(0, k);
+                               if (k == 0) {
+                                 t_out() = t;
+                                 dt_out() = dt;
+                               }
+                             });
+      } else {
+        /// if newton fails, set values with zero, t_out becomes t_end and
+        /// dt_out is minus one
+        Kokkos::parallel_for(Kokkos::TeamVectorRange(member, m),
+                             [&](const int &k) {
+                               vals_out(k) = zero;
+                               if (k == 0) {
+                                 t_out() = t_end;
+                                 dt_out() = minus_one;
+                               }
+                             });
+      }
+      member.team_barrier();
+
+      return r_val;
+    }
+  };
+
+} // namespace Tines
+
+#endif
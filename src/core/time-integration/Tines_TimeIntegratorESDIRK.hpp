@@ -0,0 +1,333 @@
+/*----------------------------------------------------------------------------------
+Tines - Time Integrator, Newton and Eigen Solver -  version 1.0
+Copyright (2021) NTESS
+https://github.com/sandialabs/Tines
+
+Copyright 2021 National Technology & Engineering Solutions of Sandia, LLC (NTESS). 
+Under the terms of Contract DE-NA0003525 with NTESS, the U.S. Government retains 
+certain rights in this software.
+
+This file is part of Tines. Tines is open-source software: you can redistribute it
+and/or modify it under the terms of BSD 2-Clause License
+(https://opensource.org/licenses/BSD-2-Clause). A copy of the license is also
+provided under the main directory
+Questions? Kyungjoo Kim <kyukim@sandia.gov>, or
+	   Oscar Diaz-Ibarra at <odiazib@sandia.gov>, or
+	   Cosmin Safta at <csafta@sandia.gov>, or
+	   Habib Najm at <hnnajm@sandia.gov>
+
+Sandia National Laboratories, New Mexico, USA
+----------------------------------------------------------------------------------*/
+#ifndef __TINES_TIME_INTEGRATOR_ESDIRK_HPP__
+#define __TINES_TIME_INTEGRATOR_ESDIRK_HPP__
+
+namespace Tines {
+
+  ///
+  /// Adaptive ESDIRK time integration driven by a Butcher tableau
+  /// - each implicit stage is solved by the Newton solver of TrBDF2 reusing
+  ///   the Jacobian; all stages share the iteration matrix I - dt gamma J so
+  ///   a factorization is reused across stages and time steps
+  /// - the embedded method gives the local error estimate and the step size
+  ///   is controlled by TimeStepSizeController
+  ///
+  template <typename ValueType, typename DeviceType>
+  struct TimeIntegratorESDIRK {
+    using value_type = ValueType;
+    using device_type = DeviceType;
+    using scalar_type = typename ats<value_type>::scalar_type;
+
+    using real_type = scalar_type;
+    using real_type_0d_view_type = value_type_0d_view<real_type, device_type>;
+    using real_type_1d_view_type = value_type_1d_view<real_type, device_type>;
+    using real_type_2d_view_type = value_type_2d_view<real_type, device_type>;
+
+    using tableau_type = ESDIRK_Tableau<real_type>;
+    using statistics_type = TimeIntegratorStatistics<real_type>;
+
+    KOKKOS_INLINE_FUNCTION
+    static void workspace(const int m, int &wlen) {
+      using newton_solver_type = NewtonSolver<value_type, device_type>;
+      int wlen_newton(0);
+      newton_solver_type::workspace(m, wlen_newton);
+      const int s = tableau_type::max_number_of_stages;
+      const int wlen_this = (4 * m /* un, z, rhs, e */ + s * m /* K */ +
+                             2 * m + m * m /* dx, f, J */ + m * m /* Jprob */);
+      wlen = (wlen_newton + wlen_this);
+    }
+
+    ///
+    /// integrate from (t_beg, vals) to t_end; the interface follows
+    /// TimeIntegratorTrBDF2 with the tableau of the method
+    ///
+    template <typename MemberType,
+              template <typename, typename> class ProblemType>
+    KOKKOS_INLINE_FUNCTION static int invoke(
+      const MemberType &member,
+      /// problem
+      const ProblemType<value_type, device_type> &problem,
+      /// input method
+      const tableau_type &tableau,
+      /// input iteration
+      const int &max_num_newton_iterations, const int &max_num_time_iterations,
+      const real_type_1d_view_type &tol_newton,
+      const real_type_2d_view_type &tol_time,
+      /// input jacobian reuse; zero disables the reuse
+      const real_type &jacobian_reuse_dt_ratio,
+      /// input step size controller
+      const real_type &safety, const real_type &factor_min,
+      const real_type &factor_max, const int &use_pi_controller,
+      /// input time step and time range
+      const real_type &dt_in, const real_type &dt_min, const real_type &dt_max,
+      const real_type &t_beg, const real_type &t_end,
+      /// input (initial condition)
+      const real_type_1d_view_type &vals,
+      /// output (final output conditions)
+      const real_type_0d_view_type &t_out, const real_type_0d_view_type &dt_out,
+      const real_type_1d_view_type &vals_out,
+      /// output (statistics)
+      /* */ statistics_type &stats,
+      /// workspace
+      const real_type_1d_view_type &work) {
+      using newton_solver_type = NewtonSolver<value_type, device_type>;
+      using stage_type = ESDIRK_Stage<value_type, device_type, ProblemType>;
+      using trbdf2_integrator_type =
+        TimeIntegratorTrBDF2<value_type, device_type>;
+
+      /// return value; when it fails it return non-zero value
+      int r_val(0);
+
+      /// const values
+      const real_type zero(0), half(0.5), minus_one(-1);
+
+      /// early return
+      stats.reset();
+      if (dt_in < zero) {
+        stats.setFailureReason(statistics_type::InvalidTimeStep);
+        return 3;
+      }
+
+      const int m = problem.getNumberOfEquations(),
+                m_ode = problem.getNumberOfTimeODEs();
+      const int s = tableau.getNumberOfStages();
+      const real_type gamma = tableau._gamma;
+
+      const TimeStepSizeController<real_type> controller(
+        safety, factor_min, factor_max, use_pi_controller);
+      /// the local error of the embedded method is O(dt^{q})
+      const real_type q(tableau._embedded_order + 1);
+
+      stage_type stage;
+      stage._problem = problem;
+
+      /// workspace
+      auto wptr = work.data();
+
+      int wlen_newton(0);
+      newton_solver_type::workspace(m, wlen_newton);
+      auto work_newton = real_type_1d_view_type(wptr, wlen_newton);
+      wptr += wlen_newton;
+
+      auto un = real_type_1d_view_type(wptr, m);
+      wptr += m;
+      auto z = real_type_1d_view_type(wptr, m);
+      wptr += m;
+      auto rhs = real_type_1d_view_type(wptr, m);
+      wptr += m;
+      auto e = real_type_1d_view_type(wptr, m);
+      wptr += m;
+
+      /// stage derivatives
+      auto K = real_type_2d_view_type(wptr, tableau_type::max_number_of_stages,
+                                      m);
+      wptr += tableau_type::max_number_of_stages * m;
+
+      /// newton workspace
+      auto dx = real_type_1d_view_type(wptr, m);
+      wptr += m;
+      auto f = real_type_1d_view_type(wptr, m);
+      wptr += m;
+      auto J = real_type_2d_view_type(wptr, m, m);
+      wptr += m * m;
+
+      /// problem jacobian kept for reuse
+      auto Jprob = real_type_2d_view_type(wptr, m, m);
+      wptr += m * m;
+      stage._Jprob = Jprob;
+      stage._rhs = rhs;
+
+      /// error check
+      const int workspace_used(wptr - work.data()),
+        workspace_extent(work.extent(0));
+
+      assert(workspace_used <= workspace_extent &&
+             "Error: workspace is used more than allocated");
+
+      /// initial conditions
+      Kokkos::parallel_for(Kokkos::TeamVectorRange(member, m),
+                           [&](const int &k) {
+                             un(k) = vals(k);
+                             z(k) = vals(k);
+                           });
+      member.team_barrier();
+
+      /// jacobian state shared by stages and time steps
+      int is_jacobian_factorized(false), is_jacobian_kept(false);
+      real_type jacobian_scale(0);
+
+      /// step size control state; the error of the last accepted step
+      real_type err_prev(0);
+      int is_rejected(false);
+
+      /// time integration
+      real_type t(t_beg), dt(dt_in);
+      int iter(0);
+      for (; iter < max_num_time_iterations && dt != zero; ++iter) {
+        /// explicit first stage; un is not changed by a rejected step
+        if (!is_rejected) {
+          auto k0 = real_type_1d_view_type(&K(0, 0), m);
+          problem.computeFunction(member, un, k0);
+          ++stats.num_function_evaluations;
+        }
+
+        int converge(false);
+        for (int attempt = 0; attempt < 4 && !converge; ++attempt) {
+          /// try again with half time step
+          if (attempt > 0)
+            dt *= half;
+          dt = (dt > dt_min ? dt : dt_min);
+          /// dt_min should not step over the end of the time window
+          dt = ((t + dt) > t_end) ? t_end - t : dt;
+          stage._scale = dt * gamma;
+
+          converge = true;
+          for (int i = 1; i < s && converge; ++i) {
+            /// rhs = un + dt sum_{j<i} a_ij k_j; z starts from the previous
+            /// stage
+            Kokkos::parallel_for(
+              Kokkos::TeamVectorRange(member, m), [&](const int &k) {
+                real_type val(0);
+                if (k < m_ode)
+                  for (int j = 0; j < i; ++j)
+                    val += tableau._A[i][j] * K(j, k);
+                rhs(k) = un(k) + dt * val;
+                if (i == 1)
+                  z(k) = un(k);
+              });
+            member.team_barrier();
+
+            int newton_iteration_count(0), jacobian_evaluation_count(0),
+              factorization_count(0);
+            trbdf2_integrator_type::solveNewtonWithJacobianReuse(
+              member, stage, max_num_newton_iterations, tol_newton,
+              jacobian_reuse_dt_ratio, z, dx, f, J, work_newton,
+              is_jacobian_factorized, is_jacobian_kept, jacobian_scale,
+              converge, newton_iteration_count, jacobian_evaluation_count,
+              factorization_count);
+            stats.num_newton_iterations += newton_iteration_count;
+            stats.num_jacobian_evaluations += jacobian_evaluation_count;
+            stats.num_factorizations += factorization_count;
+            stats.num_linear_solves += newton_iteration_count;
+            stats.num_function_evaluations += newton_iteration_count;
+
+            /// k_i = (z - rhs) / (dt gamma) avoids an extra function
+            /// evaluation
+            if (converge) {
+              Kokkos::parallel_for(
+                Kokkos::TeamVectorRange(member, m), [&](const int &k) {
+                  K(i, k) =
+                    (k < m_ode ? (z(k) - rhs(k)) / stage._scale : zero);
+                });
+              member.team_barrier();
+            }
+          }
+        }
+
+        if (!converge) {
+          Kokkos::single(Kokkos::PerTeam(member), [&]() {
+            printf("Warning: TimeIntegratorESDIRK, sample (%d) fails to "
+                   "converge with current time step %e\n",
+                   int(member.league_rank()), dt);
+          });
+          r_val = 1;
+          break;
+        }
+
+        /// error estimate; z is the solution of the stiffly accurate method
+        real_type err(0);
+        {
+          Kokkos::parallel_for(Kokkos::TeamVectorRange(member, m_ode),
+                               [&](const int &k) {
+                                 real_type val(0);
+                                 for (int j = 0; j < s; ++j)
+                                   val += tableau.getErrorWeight(j) * K(j, k);
+                                 e(k) = dt * val;
+                               });
+          member.team_barrier();
+          TimeStepSizeController<real_type>::computeWrmsNorm(
+            member, tol_time, m_ode, e, z, err);
+        }
+
+        if (err > real_type(1) && dt > dt_min) {
+          /// reject the step; un is kept and the step is retried
+          const real_type factor =
+            controller.computeFactor(err, err_prev, is_rejected, q);
+          dt *= factor;
+          dt = dt < dt_min ? dt_min : dt;
+          is_rejected = true;
+          ++stats.num_rejected_time_steps;
+          continue;
+        }
+
+        stats.acceptTimeStep(dt);
+        t += dt;
+        {
+          const real_type factor =
+            controller.computeFactor(err, err_prev, is_rejected, q);
+          dt *= factor;
+          dt = dt < dt_min ? dt_min : dt > dt_max ? dt_max : dt;
+        }
+        dt = ((t + dt) > t_end) ? t_end - t : dt;
+        err_prev = err;
+        is_rejected = false;
+        Kokkos::parallel_for(Kokkos::TeamVectorRange(member, m),
+                             [&](const int &k) { un(k) = z(k); });
+        member.team_barrier();
+      }
+
+      stats.num_time_iterations = iter;
+      stats.setFailureReason(r_val != 0    ? statistics_type::NewtonFailure
+                             : dt != zero ? statistics_type::MaxTimeIterations
+                                          : statistics_type::Success);
+
+      /// finalize with output for next iterations of time solutions
+      if (r_val == 0) {
+        Kokkos::parallel_for(Kokkos::TeamVectorRange(member, m),
+                             [&](const int &k) {
+                               vals_out(k) = un(k);
+                               if (k == 0) {
+                                 t_out() = t;
+                                 dt_out() = dt;
+                               }
+                             });
+      } else {
+        /// if newton fails, set values with zero, t_out becomes t_end and
+        /// dt_out is minus one
+        Kokkos::parallel_for(Kokkos::TeamVectorRange(member, m),
+                             [&](const int &k) {
+                               vals_out(k) = zero;
+                               if (k == 0) {
+                                 t_out() = t_end;
+                                 dt_out() = minus_one;
+                               }
+                             });
+      }
+      member.team_barrier();
+
+      return r_val;
+    }
+  };
+
+} // namespace Tines
+
+#endif
@@ -0,0 +1,318 @@
+/*----------------------------------------------------------------------------------
+Tines - Time Integrator, Newton and Eigen Solver -  version 1.0
+Copyright (2021) NTESS
+https://github.com/sandialabs/Tines
+
+Copyright 2021 National Technology & Engineering Solutions of Sandia, LLC (NTESS). 
+Under the terms of Contract DE-NA0003525 with NTESS, the U.S. Government retains 
+certain rights in this software.
+
+This file is part of Tines. Tines is open-source software: you can redistribute it
+and/or modify it under the terms of BSD 2-Clause License
+(https://opensource.org/licenses/BSD-2-Clause). A copy of the license is also
+provided under the main directory
+Questions? Kyungjoo Kim <kyukim@sandia.gov>, or
+	   Oscar Diaz-Ibarra at <odiazib@sandia.gov>, or
+	   Cosmin Safta at <csafta@sandia.gov>, or
+	   Habib Najm at <hnnajm@sandia.gov>
+
+Sandia National Laboratories, New Mexico, USA
+----------------------------------------------------------------------------------*/
+#ifndef __TINES_TIME_INTEGRATOR_ROSENBROCK_W_HPP__
+#define __TINES_TIME_INTEGRATOR_ROSENBROCK_W_HPP__
+
+namespace Tines {
+
+  ///
+  /// Adaptive linearly implicit Rosenbrock-W time integration
+  /// - a time step factorizes the iteration matrix I - dt gamma J once and
+  ///   solves a linear system per stage; no Newton iteration is used
+  /// - as a W-method tolerates an approximate Jacobian, the problem Jacobian
+  ///   is evaluated every jacobian_update_interval accepted steps and the
+  ///   factorization is reused while dt and J are not changed
+  /// - constraints (index-1 DAEs) solve J U_i = -g(y_i) in their rows
+  /// - the embedded method gives the local error estimate and the step size
+  ///   is controlled by TimeStepSizeController
+  ///
+  template <typename ValueType, typename DeviceType>
+  struct TimeIntegratorRosenbrockW {
+    using value_type = ValueType;
+    using device_type = DeviceType;
+    using scalar_type = typename ats<value_type>::scalar_type;
+
+    using real_type = scalar_type;
+    using real_type_0d_view_type = value_type_0d_view<real_type, device_type>;
+    using real_type_1d_view_type = value_type_1d_view<real_type, device_type>;
+    using real_type_2d_view_type = value_type_2d_view<real_type, device_type>;
+
+    using tableau_type = RosenbrockW_Tableau<real_type>;
+    using statistics_type = TimeIntegratorStatistics<real_type>;
+
+    KOKKOS_INLINE_FUNCTION
+    static void workspace(const int m, int &wlen) {
+      using newton_solver_type = NewtonSolver<value_type, device_type>;
+      int wlen_linear(0);
+      newton_solver_type::workspace(m, wlen_linear);
+      const int s = tableau_type::max_number_of_stages;
+      const int wlen_this = (6 * m /* un, u, y, fy, rhs, e */ +
+                             s * m /* U */ + 2 * m * m /* W, Jprob */);
+      wlen = (wlen_linear + wlen_this);
+    }
+
+    ///
+    /// integrate from (t_beg, vals) to t_end; the interface follows
+    /// TimeIntegratorTrBDF2 with the tableau of the method
+    ///
+    template <typename MemberType,
+              template <typename, typename> class ProblemType>
+    KOKKOS_INLINE_FUNCTION static int invoke(
+      const MemberType &member,
+      /// problem
+      const ProblemType<value_type, device_type> &problem,
+      /// input method
+      const tableau_type &tableau,
+      /// input iteration
+      const int &max_num_time_iterations,
+      const real_type_2d_view_type &tol_time,
+      /// input jacobian update; one evaluates J every accepted step
+      const int &jacobian_update_interval,
+      /// input step size controller
+      const real_type &safety, const real_type &factor_min,
+      const real_type &factor_max, const int &use_pi_controller,
+      /// input time step and time range
+      const real_type &dt_in, const real_type &dt_min, const real_type &dt_max,
+      const real_type &t_beg, const real_type &t_end,
+      /// input (initial condition)
+      const real_type_1d_view_type &vals,
+      /// output (final output conditions)
+      const real_type_0d_view_type &t_out, const real_type_0d_view_type &dt_out,
+      const real_type_1d_view_type &vals_out,
+      /// output (statistics)
+      /* */ statistics_type &stats,
+      /// workspace
+      const real_type_1d_view_type &work) {
+      using newton_solver_type = NewtonSolver<value_type, device_type>;
+      constexpr int static_m =
+        ProblemStaticNumberOfEquations<ProblemType<value_type, device_type>>::
+          value;
+      using linear_solver_type = NewtonLinearSolver<static_m>;
+
+      /// const values
+      const real_type zero(0), one(1);
+
+      /// early return
+      stats.reset();
+      if (dt_in < zero) {
+        stats.setFailureReason(statistics_type::InvalidTimeStep);
+        return 3;
+      }
+
+      const int m = problem.getNumberOfEquations(),
+                m_ode = problem.getNumberOfTimeODEs();
+      const int s = tableau.getNumberOfStages();
+      const real_type gamma = tableau._gamma;
+
+      const TimeStepSizeController<real_type> controller(
+        safety, factor_min, factor_max, use_pi_controller);
+      /// the local error of the embedded method is O(dt^{q})
+      const real_type q(tableau._embedded_order + 1);
+
+      /// workspace
+      auto wptr = work.data();
+
+      int wlen_linear(0);
+      newton_solver_type::workspace(m, wlen_linear);
+      auto work_linear = real_type_1d_view_type(wptr, wlen_linear);
+      wptr += wlen_linear;
+
+      auto un = real_type_1d_view_type(wptr, m);
+      wptr += m;
+      auto u = real_type_1d_view_type(wptr, m);
+      wptr += m;
+      auto y = real_type_1d_view_type(wptr, m);
+      wptr += m;
+      auto fy = real_type_1d_view_type(wptr, m);
+      wptr += m;
+      auto rhs = real_type_1d_view_type(wptr, m);
+      wptr += m;
+      auto e = real_type_1d_view_type(wptr, m);
+      wptr += m;
+
+      /// stage increments
+      auto U = real_type_2d_view_type(wptr, tableau_type::max_number_of_stages,
+                                      m);
+      wptr += tableau_type::max_number_of_stages * m;
+
+      /// iteration matrix and problem jacobian
+      auto W = real_type_2d_view_type(wptr, m, m);
+      wptr += m * m;
+      auto Jprob = real_type_2d_view_type(wptr, m, m);
+      wptr += m * m;
+
+      /// error check
+      const int workspace_used(wptr - work.data()),
+        workspace_extent(work.extent(0));
+
+      assert(workspace_used <= workspace_extent &&
+             "Error: workspace is used more than allocated");
+
+      /// initial conditions
+      Kokkos::parallel_for(Kokkos::TeamVectorRange(member, m),
+                           [&](const int &k) { un(k) = vals(k); });
+      member.team_barrier();
+
+      /// jacobian state; the factorization is valid for factorized_dt
+      int num_steps_since_jacobian(0), is_jacobian_updated(false),
+        is_factorized(false);
+      real_type factorized_dt(0);
+
+      /// step size control state; the error of the last accepted step
+      real_type err_prev(0);
+      int is_rejected(false);
+
+      /// time integration
+      real_type t(t_beg), dt(dt_in);
+      int iter(0);
+      for (; iter < max_num_time_iterations && dt != zero; ++iter) {
+        dt = (dt > dt_min ? dt : dt_min);
+        /// dt_min should not step over the end of the time window
+        dt = ((t + dt) > t_end) ? t_end - t : dt;
+
+        /// evaluate the problem jacobian at un
+        if (!is_jacobian_updated ||
+            num_steps_since_jacobian >= jacobian_update_interval) {
+          problem.computeJacobian(member, un, Jprob);
+          ++stats.num_jacobian_evaluations;
+          num_steps_since_jacobian = 0;
+          is_jacobian_updated = true;
+          is_factorized = false;
+        }
+
+        /// W = I - dt gamma J for time ODEs and J for constraints
+        if (!is_factorized || factorized_dt != dt) {
+          const real_type scale = dt * gamma;
+          Kokkos::parallel_for(
+            Kokkos::TeamThreadRange(member, m), [&](const int &i) {
+              Kokkos::parallel_for(
+                Kokkos::ThreadVectorRange(member, m), [&](const int &j) {
+                  const real_type val = Jprob(i, j);
+                  W(i, j) =
+                    i < m_ode ? (i == j ? one : zero) - scale * val : val;
+                });
+            });
+          member.team_barrier();
+          newton_solver_type::template factorize<static_m>(member, W,
+                                                           work_linear);
+          ++stats.num_factorizations;
+          is_factorized = true;
+          factorized_dt = dt;
+        }
+
+        for (int i = 0; i < s; ++i) {
+          /// y = un + sum_{j<i} a_ij U_j
+          Kokkos::parallel_for(Kokkos::TeamVectorRange(member, m),
+                               [&](const int &k) {
+                                 real_type val(0);
+                                 for (int j = 0; j < i; ++j)
+                                   val += tableau._a[i][j] * U(j, k);
+                                 y(k) = un(k) + val;
+                               });
+          member.team_barrier();
+
+          problem.computeFunction(member, y, fy);
+          ++stats.num_function_evaluations;
+
+          Kokkos::parallel_for(Kokkos::TeamVectorRange(member, m),
+                               [&](const int &k) {
+                                 if (k < m_ode) {
+                                   real_type val(0);
+                                   for (int j = 0; j < i; ++j)
+                                     val += tableau._c[i][j] * U(j, k);
+                                   rhs(k) = gamma * (dt * fy(k) + val);
+                                 } else {
+                                   rhs(k) = -fy(k);
+                                 }
+                               });
+          member.team_barrier();
+
+          auto Ui = real_type_1d_view_type(&U(i, 0), m);
+          linear_solver_type::device_solve_factorized(member, W, Ui, rhs,
+                                                      work_linear);
+          member.team_barrier();
+          ++stats.num_linear_solves;
+        }
+
+        /// solution and error estimate
+        real_type err(0);
+        {
+          Kokkos::parallel_for(Kokkos::TeamVectorRange(member, m),
+                               [&](const int &k) {
+                                 real_type val(0), val_err(0);
+                                 for (int j = 0; j < s; ++j) {
+                                   val += tableau._m[j] * U(j, k);
+                                   val_err += (tableau._m[j] -
+                                               tableau._mhat[j]) *
+                                              U(j, k);
+                                 }
+                                 u(k) = un(k) + val;
+                                 e(k) = val_err;
+                               });
+          member.team_barrier();
+          TimeStepSizeController<real_type>::computeWrmsNorm(
+            member, tol_time, m_ode, e, u, err);
+        }
+
+        /// a nan error is rejected with the smallest factor
+        const bool is_err_nan = !(err == err);
+        if ((is_err_nan || err > one) && dt > dt_min) {
+          /// reject the step; un and the jacobian are kept
+          const real_type factor =
+            is_err_nan
+              ? factor_min
+              : controller.computeFactor(err, err_prev, is_rejected, q);
+          dt *= factor;
+          dt = dt < dt_min ? dt_min : dt;
+          is_rejected = true;
+          ++stats.num_rejected_time_steps;
+          continue;
+        }
+
+        stats.acceptTimeStep(dt);
+        t += dt;
+        {
+          const real_type factor =
+            controller.computeFactor(err, err_prev, is_rejected, q);
+          dt *= factor;
+          dt = dt < dt_min ? dt_min : dt > dt_max ? dt_max : dt;
+        }
+        dt = ((t + dt) > t_end) ? t_end - t : dt;
+        err_prev = err;
+        is_rejected = false;
+        ++num_steps_since_jacobian;
+        Kokkos::parallel_for(Kokkos::TeamVectorRange(member, m),
+                             [&](const int &k) { un(k) = u(k); });
+        member.team_barrier();
+      }
+
+      stats.num_time_iterations = iter;
+      stats.setFailureReason(dt != zero ? statistics_type::MaxTimeIterations
+                                        : statistics_type::Success);
+
+      /// finalize with output for next iterations of time solutions
+      Kokkos::parallel_for(Kokkos::TeamVectorRange(member, m),
+                           [&](const int &k) {
+                             vals_out(k) = un(k);
+                             if (k == 0) {
+                               t_out() = t;
+                               dt_out() = dt;
+                             }
+                           });
+      member.team_barrier();
+
+      return 0;
+    }
+  };
+
+} // namespace Tines
+
+#endif
@@ -0,0 +1,146 @@
+/*----------------------------------------------------------------------------------
+Tines - Time Integrator, Newton and Eigen Solver -  version 1.0
+Copyright (2021) NTESS
+https://github.com/sandialabs/Tines
+
+Copyright 2021 National Technology & Engineering Solutions of Sandia, LLC (NTESS). 
+Under the terms of Contract DE-NA0003525 with NTESS, the U.S. Government retains 
+certain rights in this software.
+
+This file is part of Tines. Tines is open-source software: you can redistribute it
+and/or modify it under the terms of BSD 2-Clause License
+(https://opensource.org/licenses/BSD-2-Clause). A copy of the license is also
+provided under the main directory
+Questions? Kyungjoo Kim <kyukim@sandia.gov>, or
+	   Oscar Diaz-Ibarra at <odiazib@sandia.gov>, or
+	   Cosmin Safta at <csafta@sandia.gov>, or
+	   Habib Najm at <hnnajm@sandia.gov>
+
+Sandia National Laboratories, New Mexico, USA
+----------------------------------------------------------------------------------*/
+#ifndef __TINES_TIME_INTEGRATOR_STATISTICS_HPP__
+#define __TINES_TIME_INTEGRATOR_STATISTICS_HPP__
+
+namespace Tines {
+
+  ///
+  /// Statistics of time integration
+  /// - a sample records its work counters, the range of accepted time step
+  ///   sizes and the reason why it does not reach the end of the time window
+  /// - append accumulates a later segment of the same sample (e.g., a chunk
+  ///   of the compacted batch driver) and join accumulates samples of a batch
+  /// - counters are 64 bit as they are summed over large batches
+  ///
+  template <typename RealType> struct TimeIntegratorStatistics {
+    using real_type = RealType;
+    using counter_type = int64_t;
+
+    /// failure reasons; the values match the return values of the time
+    /// integrator except MaxTimeIterations which is not an error
+    enum : int {
+      Success = 0,
+      NewtonFailure = 1,
+      MaxTimeIterations = 2,
+      InvalidTimeStep = 3
+    };
+
+    /// samples and samples with a non-zero failure reason
+    counter_type num_samples;
+    counter_type num_failures;
+    int failure_reason;
+
+    /// accepted + rejected time steps
+    counter_type num_time_iterations;
+    counter_type num_accepted_time_steps;
+    counter_type num_rejected_time_steps;
+
+    /// newton iterations solve a linear system each; function evaluations
+    /// do not include those used by a numerical jacobian of the problem
+    counter_type num_newton_iterations;
+    counter_type num_jacobian_evaluations;
+    counter_type num_factorizations;
+    counter_type num_linear_solves;
+    counter_type num_function_evaluations;
+
+    /// the range of accepted time step sizes; valid when
+    /// num_accepted_time_steps is positive
+    real_type dt_min;
+    real_type dt_max;
+
+    KOKKOS_INLINE_FUNCTION
+    TimeIntegratorStatistics() { reset(); }
+
+    KOKKOS_INLINE_FUNCTION
+    void reset() {
+      num_samples = 0;
+      num_failures = 0;
+      failure_reason = Success;
+      num_time_iterations = 0;
+      num_accepted_time_steps = 0;
+      num_rejected_time_steps = 0;
+      num_newton_iterations = 0;
+      num_jacobian_evaluations = 0;
+      num_factorizations = 0;
+      num_linear_solves = 0;
+      num_function_evaluations = 0;
+      dt_min = real_type(0);
+      dt_max = real_type(0);
+    }
+
+    /// record an accepted time step
+    KOKKOS_INLINE_FUNCTION
+    void acceptTimeStep(const real_type &dt) {
+      dt_min = (num_accepted_time_steps == 0 || dt < dt_min) ? dt : dt_min;
+      dt_max = (num_accepted_time_steps == 0 || dt > dt_max) ? dt : dt_max;
+      ++num_accepted_time_steps;
+    }
+
+    /// set the failure reason of a single sample
+    KOKKOS_INLINE_FUNCTION
+    void setFailureReason(const int &reason) {
+      num_samples = 1;
+      failure_reason = reason;
+      num_failures = (reason != Success);
+    }
+
+    /// work counters and the range of time step sizes
+    KOKKOS_INLINE_FUNCTION
+    void accumulate(const TimeIntegratorStatistics &b) {
+      if (b.num_accepted_time_steps > 0) {
+        const bool is_empty = (num_accepted_time_steps == 0);
+        dt_min = (is_empty || b.dt_min < dt_min) ? b.dt_min : dt_min;
+        dt_max = (is_empty || b.dt_max > dt_max) ? b.dt_max : dt_max;
+      }
+      num_time_iterations += b.num_time_iterations;
+      num_accepted_time_steps += b.num_accepted_time_steps;
+      num_rejected_time_steps += b.num_rejected_time_steps;
+      num_newton_iterations += b.num_newton_iterations;
+      num_jacobian_evaluations += b.num_jacobian_evaluations;
+      num_factorizations += b.num_factorizations;
+      num_linear_solves += b.num_linear_solves;
+      num_function_evaluations += b.num_function_evaluations;
+    }
+
+    /// b continues this sample; the failure reason of b is kept
+    KOKKOS_INLINE_FUNCTION
+    void append(const TimeIntegratorStatistics &b) {
+      accumulate(b);
+      num_samples = b.num_samples;
+      num_failures = b.num_failures;
+      failure_reason = b.failure_reason;
+    }
+
+    /// b is another sample; the largest failure reason is kept
+    KOKKOS_INLINE_FUNCTION
+    void join(const TimeIntegratorStatistics &b) {
+      accumulate(b);
+      num_samples += b.num_samples;
+      num_failures += b.num_failures;
+      failure_reason =
+        b.failure_reason > failure_reason ? b.failure_reason : failure_reason;
+    }
+  };
+
+} // namespace Tines
+
+#endif
@@ -34,6 +34,8 @@ namespace Tines {
     using real_type_1d_view_type = value_type_1d_view<real_type, device_type>;
     using real_type_2d_view_type = value_type_2d_view<real_type, device_type>;
 
+    using statistics_type = TimeIntegratorStatistics<real_type>;
+
     KOKKOS_INLINE_FUNCTION
     static void workspace(const int m, int &wlen) {
       using newton_solver_type = NewtonSolver<value_type, device_type>;
@@ -43,11 +45,95 @@ namespace Tines {
       newton_solver_type::workspace(m, wlen_newton); /// utv workspace
       int wlen_trbdf(0);
       trbdf2_type::workspace(m, wlen_trbdf); /// un, unr, fn
-      const int wlen_this = (2 * m /* u, fnr */ + 2 * m + m * m /* dx, f, J */);
+      const int wlen_this = (2 * m /* u, fnr */ + 2 * m + m * m /* dx, f, J */ +
+                             m * m /* J_prob */);
 
       wlen = (wlen_newton + wlen_trbdf + wlen_this);
     }
 
+    ///
+    /// Newton solve for a TrBDF2 stage reusing the Jacobian
+    /// - the factorization in J and work is reused when the scale of the
+    ///   iteration matrix, I - scale J_prob, is changed less than
+    ///   jacobian_reuse_dt_ratio
+    /// - otherwise, the iteration matrix is rebuilt from the kept problem
+    ///   Jacobian and refactorized
+    /// - the modified Newton refreshes the Jacobian when its convergence
+    ///   stalls; a failed solve invalidates the factorization
+    /// - when jacobian_reuse_dt_ratio is not positive, the Jacobian is
+    ///   evaluated and factorized every Newton iteration
+    ///
+    template <typename MemberType, typename TrBDF2PartType>
+    KOKKOS_INLINE_FUNCTION static void solveNewtonWithJacobianReuse(
+      const MemberType &member, const TrBDF2PartType &part,
+      const int &max_num_newton_iterations,
+      const real_type_1d_view_type &tol_newton,
+      const real_type &jacobian_reuse_dt_ratio,
+      /// input/output
+      const real_type_1d_view_type &x,
+      /// workspace
+      const real_type_1d_view_type &dx, const real_type_1d_view_type &f,
+      const real_type_2d_view_type &J, const real_type_1d_view_type &work,
+      /// input/output (jacobian state)
+      /* */ int &is_jacobian_factorized, int &is_jacobian_kept,
+      /* */ real_type &jacobian_scale,
+      /// output
+      /* */ int &converge, int &newton_iteration_count,
+      /* */ int &jacobian_evaluation_count, int &factorization_count) {
+      using newton_solver_type = NewtonSolver<value_type, device_type>;
+
+      const real_type zero(0), one(1);
+
+      /// the max contraction rate before the modified newton refreshes J
+      const real_type max_contraction_rate(0.5);
+
+      newton_iteration_count = 0;
+      jacobian_evaluation_count = 0;
+      factorization_count = 0;
+
+      if (jacobian_reuse_dt_ratio > zero) {
+        const real_type scale = part.getJacobianScale();
+        if (is_jacobian_factorized) {
+          const real_type ratio =
+            ats<real_type>::abs(scale / jacobian_scale - one);
+          if (ratio > jacobian_reuse_dt_ratio) {
+            is_jacobian_factorized = false;
+            if (is_jacobian_kept) {
+              part.computeJacobianUsingCache(member, J);
+              newton_solver_type::template factorize<
+                ProblemStaticNumberOfEquations<TrBDF2PartType>::value>(
+                member, J, work);
+              is_jacobian_factorized = true;
+              jacobian_scale = scale;
+              ++factorization_count;
+            }
+          }
+        }
+
+        int jacobian_count(0);
+        newton_solver_type::invoke(
+          member, part, tol_newton(0), tol_newton(1), max_num_newton_iterations,
+          max_contraction_rate, x, dx, f, J, work, is_jacobian_factorized,
+          newton_iteration_count, converge, jacobian_count);
+        if (jacobian_count > 0) {
+          is_jacobian_kept = true;
+          jacobian_scale = scale;
+        }
+        jacobian_evaluation_count += jacobian_count;
+        factorization_count += jacobian_count;
+
+        /// try again with a fresh jacobian
+        if (!converge)
+          is_jacobian_factorized = false;
+      } else {
+        newton_solver_type::invoke(
+          member, part, tol_newton(0), tol_newton(1), max_num_newton_iterations,
+          x, dx, f, J, work, newton_iteration_count, converge);
+        jacobian_evaluation_count = newton_iteration_count;
+        factorization_count = newton_iteration_count;
+      }
+    }
+
     template <typename MemberType,
               template <typename, typename> class ProblemType>
     KOKKOS_INLINE_FUNCTION static int invoke(
@@ -68,6 +154,71 @@ namespace Tines {
       const real_type_1d_view_type &vals_out,
       /// workspace
       const real_type_1d_view_type &work) {
+      /// reuse the factorization while dt changes less than 30 percent
+      const real_type jacobian_reuse_dt_ratio(0.3);
+      /// default step size controller (see TrBDF2::computeTimeStepSizeFactor)
+      const real_type safety(0.9), factor_min(0.2), factor_max(5);
+      const int use_pi_controller(true);
+      /// no dense output
+      const real_type_1d_view_type t_dense;
+      const real_type_2d_view_type vals_dense;
+      statistics_type stats;
+      return invoke(member, problem, max_num_newton_iterations,
+                    max_num_time_iterations, tol_newton, tol_time,
+                    jacobian_reuse_dt_ratio, safety, factor_min, factor_max,
+                    use_pi_controller, dt_in, dt_min, dt_max, t_beg, t_end,
+                    vals, t_dense, t_out, dt_out, vals_out, vals_dense, stats,
+                    work);
+    }
+
+    ///
+    /// TrBDF2 time integration with error controlled step sizes
+    /// - a step is accepted when the error norm of its local error estimate
+    ///   is not larger than one (or dt reaches dt_min); otherwise, it is
+    ///   rejected and retried with a smaller dt; the norm is WRMS when
+    ///   TINES_ENABLE_TRBDF2_WRMS is on and max_i |e_i|/(rtol_i |u_i|) if not
+    /// - the next dt is dt * factor where factor = safety err^{-1/3} or
+    ///   the PI controller using the error of the previous accepted step;
+    ///   the factor is clamped to [factor_min, factor_max]
+    /// - the solution at the sorted times t_dense (n_dense) in [t_beg, t_end]
+    ///   is interpolated on the accepted steps and stored in vals_dense
+    ///   (n_dense x m) without extra stage solves, so dt_max does not need
+    ///   to be capped by the output interval; empty views disable it
+    /// - stats is reset on entry and reports the statistics of the
+    ///   integration (see TimeIntegratorStatistics); num_time_iterations
+    ///   counts both accepted and rejected steps
+    ///
+    template <typename MemberType,
+              template <typename, typename> class ProblemType>
+    KOKKOS_INLINE_FUNCTION static int invoke(
+      const MemberType &member,
+      /// problem
+      const ProblemType<value_type, device_type> &problem,
+      /// input iteration and qoi index to store
+      const int &max_num_newton_iterations, const int &max_num_time_iterations,
+      const real_type_1d_view_type &tol_newton,
+      const real_type_2d_view_type &tol_time,
+      /// input jacobian reuse; zero disables the reuse
+      const real_type &jacobian_reuse_dt_ratio,
+      /// input step size controller
+      const real_type &safety, const real_type &factor_min,
+      const real_type &factor_max, const int &use_pi_controller,
+      /// input time step and time range
+      const real_type &dt_in, const real_type &dt_min, const real_type &dt_max,
+      const real_type &t_beg, const real_type &t_end,
+      /// input (initial condition)
+      const real_type_1d_view_type &vals,
+      /// input (dense output times)
+      const real_type_1d_view_type &t_dense,
+      /// output (final output conditions)
+      const real_type_0d_view_type &t_out, const real_type_0d_view_type &dt_out,
+      const real_type_1d_view_type &vals_out,
+      /// output (dense output)
+      const real_type_2d_view_type &vals_dense,
+      /// output (statistics)
+      /* */ statistics_type &stats,
+      /// workspace
+      const real_type_1d_view_type &work) {
       using newton_solver_type = NewtonSolver<value_type, device_type>;
       using trbdf2_type = TrBDF2<value_type, device_type>;
       using trbdf2_part1_type =
@@ -79,11 +230,14 @@ namespace Tines {
       int r_val(0);
 
       /// const values
-      const real_type zero(0), half(1 / 2), /*two(2), */ minus_one(-1);
+      const real_type zero(0), one(1), half(0.5), minus_one(-1);
 
       /// early return
-      if (dt_in < zero)
+      stats.reset();
+      if (dt_in < zero) {
+        stats.setFailureReason(statistics_type::InvalidTimeStep);
         return 3;
+      }
 
       /// data structure here is temperature, mass fractions of species...
       const int m = problem.getNumberOfEquations(),
@@ -91,6 +245,8 @@ namespace Tines {
 
       /// time stepping object
       trbdf2_type trbdf;
+      trbdf.setTimeStepSizeController(safety, factor_min, factor_max,
+                                      use_pi_controller);
       trbdf2_part1_type trbdf_part1;
       trbdf2_part2_type trbdf_part2;
 
@@ -132,6 +288,12 @@ namespace Tines {
       auto J = real_type_2d_view_type(wptr, m, m);
       wptr += m * m;
 
+      /// problem jacobian kept for reuse
+      auto Jprob = real_type_2d_view_type(wptr, m, m);
+      wptr += m * m;
+      trbdf_part1._Jprob = Jprob;
+      trbdf_part2._Jprob = Jprob;
+
       /// error check
       const int workspace_used(wptr - work.data()),
         workspace_extent(work.extent(0));
@@ -147,27 +309,58 @@ namespace Tines {
                            });
       member.team_barrier();
 
+      /// jacobian state shared by stages and time steps
+      int is_jacobian_factorized(false), is_jacobian_kept(false);
+      real_type jacobian_scale(0);
+
+      /// step size control state; the error of the last accepted step
+      real_type err_prev(0);
+      int is_rejected(false);
+
       /// time integration
       real_type t(t_beg), dt(dt_in);
-      for (int iter = 0; iter < max_num_time_iterations && dt != zero; ++iter) {
+      int iter(0);
+
+      /// dense output at t_beg
+      int idx_dense(0);
+      for (const int n_dense = t_dense.extent(0);
+           idx_dense < n_dense && t_dense(idx_dense) <= t; ++idx_dense) {
+        const int k = idx_dense;
+        Kokkos::parallel_for(Kokkos::TeamVectorRange(member, m),
+                             [&](const int &i) { vals_dense(k, i) = un(i); });
+      }
+      member.team_barrier();
+      for (; iter < max_num_time_iterations && dt != zero; ++iter) {
         {
           int converge(0);
           for (int i = 0; i < 4 && converge == 0; ++i) {
             int converge_part1(0);
             {
               dt = (dt > dt_min ? dt : dt_min);
+              /// dt_min should not step over the end of the time window
+              dt = ((t + dt) > t_end) ? t_end - t : dt;
               trbdf_part1._dt = dt;
 
               problem.computeFunction(member, un, fn);
-
-              int newton_iteration_count(0);
-              newton_solver_type::invoke(
-                member, trbdf_part1, tol_newton(0), tol_newton(1),
-                max_num_newton_iterations, unr, dx, f, J, work_newton,
-                newton_iteration_count, converge_part1);
+              ++stats.num_function_evaluations;
+
+              int newton_iteration_count(0), jacobian_evaluation_count(0),
+                factorization_count(0);
+              solveNewtonWithJacobianReuse(
+                member, trbdf_part1, max_num_newton_iterations, tol_newton,
+                jacobian_reuse_dt_ratio, unr, dx, f, J, work_newton,
+                is_jacobian_factorized, is_jacobian_kept, jacobian_scale,
+                converge_part1, newton_iteration_count,
+                jacobian_evaluation_count, factorization_count);
+              stats.num_newton_iterations += newton_iteration_count;
+              stats.num_jacobian_evaluations += jacobian_evaluation_count;
+              stats.num_factorizations += factorization_count;
+              stats.num_linear_solves += newton_iteration_count;
+              stats.num_function_evaluations += newton_iteration_count;
 
               if (converge_part1) {
                 problem.computeFunction(member, unr, fnr);
+                ++stats.num_function_evaluations;
               } else {
                 /// try again with half time step
                 dt *= half;
@@ -179,13 +372,22 @@ namespace Tines {
             {
               trbdf_part2._dt = dt;
 
-              int newton_iteration_count(0);
-              newton_solver_type::invoke(
-                member, trbdf_part2, tol_newton(0), tol_newton(1),
-                max_num_newton_iterations, u, dx, f, J, work_newton,
-                newton_iteration_count, converge_part2);
+              int newton_iteration_count(0), jacobian_evaluation_count(0),
+                factorization_count(0);
+              solveNewtonWithJacobianReuse(
+                member, trbdf_part2, max_num_newton_iterations, tol_newton,
+                jacobian_reuse_dt_ratio, u, dx, f, J, work_newton,
+                is_jacobian_factorized, is_jacobian_kept, jacobian_scale,
+                converge_part2, newton_iteration_count,
+                jacobian_evaluation_count, factorization_count);
+              stats.num_newton_iterations += newton_iteration_count;
+              stats.num_jacobian_evaluations += jacobian_evaluation_count;
+              stats.num_factorizations += factorization_count;
+              stats.num_linear_solves += newton_iteration_count;
+              stats.num_function_evaluations += newton_iteration_count;
               if (converge_part2) {
                 problem.computeFunction(member, u, f);
+                ++stats.num_function_evaluations;
               } else {
                 dt *= half;
                 continue;
@@ -195,10 +397,34 @@ namespace Tines {
           }
 
           if (converge) {
+            real_type err(0);
+            trbdf.computeError(member, tol_time, m_ode, fn, fnr, f, u, dt,
+                               err);
+            if (err > one && dt > dt_min) {
+              /// reject the step; un is kept and the step is retried
+              const real_type factor =
+                trbdf.computeTimeStepSizeFactor(err, err_prev, is_rejected);
+              dt *= factor;
+              dt = dt < dt_min ? dt_min : dt;
+              is_rejected = true;
+              ++stats.num_rejected_time_steps;
+              member.team_barrier();
+              continue;
+            }
+
+            trbdf.computeDenseOutput(member, m, m_ode, t, dt, un, fn, u, f,
+                                     t_dense, vals_dense, idx_dense);
+            stats.acceptTimeStep(dt);
             t += dt;
-            trbdf.computeTimeStepSize(member, dt_min, dt_max, tol_time, m_ode,
-                                      fn, fnr, f, u, dt);
+            {
+              const real_type factor =
+                trbdf.computeTimeStepSizeFactor(err, err_prev, is_rejected);
+              dt *= factor;
+              dt = dt < dt_min ? dt_min : dt > dt_max ? dt_max : dt;
+            }
             dt = ((t + dt) > t_end) ? t_end - t : dt;
+            err_prev = err;
+            is_rejected = false;
             Kokkos::parallel_for(Kokkos::TeamVectorRange(member, m),
                                  [&](const int &k) { un(k) = u(k); });
 #if defined(TINES_PROBLEM_TEST_TRBDF2)
@@ -225,12 +451,19 @@ namespace Tines {
         member.team_barrier();
       }
 
+      /// iter counts attempts; rejected steps are included
+      stats.num_time_iterations = iter;
+      stats.setFailureReason(r_val != 0    ? statistics_type::NewtonFailure
+                             : dt != zero ? statistics_type::MaxTimeIterations
+                                          : statistics_type::Success);
+
       {
-        /// finalize with output for next iterations of time solutions
+        /// finalize with output for next iterations of time solutions; un is
+        /// the solution at t as u may hold a rejected step
         if (r_val == 0) {
           Kokkos::parallel_for(Kokkos::TeamVectorRange(member, m),
                                [&](const int &k) {
-                                 vals_out(k) = u(k);
+                                 vals_out(k) = un(k);
                                  if (k == 0) {
                                    t_out() = t;
                                    dt_out() = dt;
@@ -258,4 +491,6 @@ namespace Tines {
 
 } // namespace Tines
 
+#include "Tines_TimeIntegratorTrBDF2_Device.hpp"
+
 #endif
@@ -0,0 +1,580 @@
+/*----------------------------------------------------------------------------------
+Tines - Time Integrator, Newton and Eigen Solver -  version 1.0
+Copyright (2021) NTESS
+https://github.com/sandialabs/Tines
+
+Copyright 2021 National Technology & Engineering Solutions of Sandia, LLC (NTESS). 
+Under the terms of Contract DE-NA0003525 with NTESS, the U.S. Government retains 
+certain rights in this software.
+
+This file is part of Tines. Tines is open-source software: you can redistribute it
+and/or modify it under the terms of BSD 2-Clause License
+(https://opensource.org/licenses/BSD-2-Clause). A copy of the license is also
+provided under the main directory
+Questions? Kyungjoo Kim <kyukim@sandia.gov>, or
+	   Oscar Diaz-Ibarra at <odiazib@sandia.gov>, or
+	   Cosmin Safta at <csafta@sandia.gov>, or
+	   Habib Najm at <hnnajm@sandia.gov>
+
+Sandia National Laboratories, New Mexico, USA
+----------------------------------------------------------------------------------*/
+#ifndef __TINES_TIME_INTEGRATOR_TRBDF2_DEVICE_HPP__
+#define __TINES_TIME_INTEGRATOR_TRBDF2_DEVICE_HPP__
+
+namespace Tines {
+
+  ///
+  /// Batched TrBDF2 time integration
+  /// - each sample is integrated by a team of the league
+  /// - the problem object is copied to the device and shared by all samples
+  /// - per sample inputs (tolerances and time windows) are broadcasted when
+  ///   their leading extent is one
+  ///
+  template <typename SpT> struct TimeIntegratorTrBDF2Device {
+    using device_type = typename UseThisDevice<SpT>::type;
+
+    using real_type = double;
+    using real_type_0d_view_type = value_type_0d_view<real_type, device_type>;
+    using real_type_1d_view_type = value_type_1d_view<real_type, device_type>;
+    using real_type_2d_view_type = value_type_2d_view<real_type, device_type>;
+    using real_type_3d_view_type = value_type_3d_view<real_type, device_type>;
+
+    using int_type_0d_view_type = value_type_0d_view<int, device_type>;
+    using int_type_1d_view_type = value_type_1d_view<int, device_type>;
+
+    using time_integrator_type = TimeIntegratorTrBDF2<real_type, device_type>;
+
+    using statistics_type = TimeIntegratorStatistics<real_type>;
+    using statistics_type_1d_view_type =
+      value_type_1d_view<statistics_type, device_type>;
+
+    ///
+    /// workspace length for a single sample; the batch workspace is np x wlen
+    ///
+    inline static void workspace(const int m, int &wlen) {
+      time_integrator_type::workspace(m, wlen);
+    }
+
+    ///
+    /// guess team and vector sizes for the number of samples and equations
+    ///
+    inline static void getTeamSize(const int np, const int m, int &team_size,
+                                   int &vector_size) {
+      team_size = 1;
+      vector_size = 1;
+#if defined(KOKKOS_ENABLE_CUDA)
+      if (std::is_same<SpT, Kokkos::Cuda>::value) {
+        /// vector lanes work on a row of the Jacobian and the team works on
+        /// rows; a sample rarely exposes more than a warp of parallelism
+        if (m <= 16) {
+          vector_size = 4;
+          team_size = 8;
+        } else if (m <= 64) {
+          vector_size = 8;
+          team_size = 8;
+        } else if (m <= 128) {
+          vector_size = 16;
+          team_size = 8;
+        } else {
+          vector_size = 32;
+          team_size = 8;
+        }
+        /// batch parallelism cannot occupy the whole device; use larger teams
+        if (np < 10000)
+          team_size *= 2;
+      }
+#endif
+    }
+
+    ///
+    /// integrate sample i from (t_beg, dt_in, vals) for at most
+    /// max_num_time_iterations
+    ///
+    template <typename MemberType,
+              template <typename, typename> class ProblemType>
+    KOKKOS_INLINE_FUNCTION static int
+    invokeSample(const MemberType &member,
+                 const ProblemType<real_type, device_type> &problem,
+                 const int &i, const int &max_num_newton_iterations,
+                 const int &max_num_time_iterations,
+                 const real_type_2d_view_type &tol_newton,
+                 const real_type_3d_view_type &tol_time,
+                 const real_type &jacobian_reuse_dt_ratio,
+                 const real_type &dt_in, const real_type_1d_view_type &dt_min,
+                 const real_type_1d_view_type &dt_max, const real_type &t_beg,
+                 const real_type_1d_view_type &t_end,
+                 const real_type_2d_view_type &vals,
+                 const real_type_1d_view_type &t_out,
+                 const real_type_1d_view_type &dt_out,
+                 const real_type_2d_view_type &vals_out,
+                 const real_type_2d_view_type &work,
+                 /* */ statistics_type &stats) {
+      const auto sample = [i](const int n) { return n == 1 ? 0 : i; };
+
+      const auto _tol_newton =
+        Kokkos::subview(tol_newton, sample(tol_newton.extent(0)), Kokkos::ALL());
+      const auto _tol_time = Kokkos::subview(
+        tol_time, sample(tol_time.extent(0)), Kokkos::ALL(), Kokkos::ALL());
+
+      const real_type _dt_min = dt_min(sample(dt_min.extent(0)));
+      const real_type _dt_max = dt_max(sample(dt_max.extent(0)));
+      const real_type _t_end = t_end(sample(t_end.extent(0)));
+
+      const auto _vals = Kokkos::subview(vals, i, Kokkos::ALL());
+      const auto _vals_out = Kokkos::subview(vals_out, i, Kokkos::ALL());
+      const auto _t_out = real_type_0d_view_type(&t_out(i));
+      const auto _dt_out = real_type_0d_view_type(&dt_out(i));
+      const auto _work = Kokkos::subview(work, i, Kokkos::ALL());
+
+      /// default step size controller and no dense output
+      const real_type safety(0.9), factor_min(0.2), factor_max(5);
+      const int use_pi_controller(true);
+      const real_type_1d_view_type t_dense;
+      const real_type_2d_view_type vals_dense;
+      return time_integrator_type::invoke(
+        member, problem, max_num_newton_iterations, max_num_time_iterations,
+        _tol_newton, _tol_time, jacobian_reuse_dt_ratio, safety, factor_min,
+        factor_max, use_pi_controller, dt_in, _dt_min, _dt_max, t_beg, _t_end,
+        _vals, t_dense, _t_out, _dt_out, _vals_out, vals_dense, stats, _work);
+    }
+
+    ///
+    /// vals and vals_out are np x m; tol_newton is np x 2 and tol_time is
+    /// np x m x 2; dt_in, dt_min, dt_max, t_beg and t_end are np; work is
+    /// np x wlen; team_size and vector_size override the guess when positive;
+    /// the statistics of each sample are stored in stats (np) when it is given
+    /// (see aggregateStatistics)
+    ///
+    /// returns the number of samples failing to integrate
+    ///
+    template <template <typename, typename> class ProblemType>
+    static int invoke(const SpT &exec_instance,
+                      /// problem
+                      const ProblemType<real_type, device_type> &problem,
+                      /// input iteration
+                      const int &max_num_newton_iterations,
+                      const int &max_num_time_iterations,
+                      const real_type_2d_view_type &tol_newton,
+                      const real_type_3d_view_type &tol_time,
+                      /// input jacobian reuse; zero disables the reuse
+                      const real_type &jacobian_reuse_dt_ratio,
+                      /// input time step and time range
+                      const real_type_1d_view_type &dt_in,
+                      const real_type_1d_view_type &dt_min,
+                      const real_type_1d_view_type &dt_max,
+                      const real_type_1d_view_type &t_beg,
+                      const real_type_1d_view_type &t_end,
+                      /// input (initial condition)
+                      const real_type_2d_view_type &vals,
+                      /// output (final output conditions)
+                      const real_type_1d_view_type &t_out,
+                      const real_type_1d_view_type &dt_out,
+                      const real_type_2d_view_type &vals_out,
+                      /// workspace
+                      const real_type_2d_view_type &work,
+                      const int team_size_in = -1,
+                      const int vector_size_in = -1,
+                      /// output (statistics; optional)
+                      const statistics_type_1d_view_type &stats =
+                        statistics_type_1d_view_type()) {
+      TINES_CHECK_ERROR(!ValidExecutionSpace<SpT>::value,
+                        "Error: the given execution space is not implemented");
+      Kokkos::Profiling::pushRegion("Tines::TimeIntegratorTrBDF2Device");
+
+      const int np = vals.extent(0), m = vals.extent(1);
+
+      int wlen(0);
+      workspace(m, wlen);
+      TINES_CHECK_ERROR(int(work.extent(0)) < np || int(work.extent(1)) < wlen,
+                        "Error: workspace is too small");
+      TINES_CHECK_ERROR(int(vals_out.extent(0)) < np ||
+                          int(vals_out.extent(1)) < m,
+                        "Error: vals_out is too small");
+      const bool is_stats_given = (stats.extent(0) > 0);
+      TINES_CHECK_ERROR(is_stats_given && int(stats.extent(0)) < np,
+                        "Error: stats is too small");
+
+      int team_size(0), vector_size(0);
+      getTeamSize(np, m, team_size, vector_size);
+      if (team_size_in > 0)
+        team_size = team_size_in;
+      if (vector_size_in > 0)
+        vector_size = vector_size_in;
+
+      using policy_type = Kokkos::TeamPolicy<SpT>;
+      const policy_type policy(exec_instance, np, team_size, vector_size);
+
+      int num_failures(0);
+      Kokkos::parallel_reduce(
+        "Tines::TimeIntegratorTrBDF2Device::parallel_reduce", policy,
+        KOKKOS_LAMBDA(const typename policy_type::member_type &member,
+                      int &update) {
+          const int i = member.league_rank();
+          const auto sample = [i](const int n) { return n == 1 ? 0 : i; };
+          const real_type _dt_in = dt_in(sample(dt_in.extent(0)));
+          const real_type _t_beg = t_beg(sample(t_beg.extent(0)));
+
+          statistics_type _stats;
+          const int r_val = invokeSample(
+            member, problem, i, max_num_newton_iterations,
+            max_num_time_iterations, tol_newton, tol_time,
+            jacobian_reuse_dt_ratio, _dt_in, dt_min, dt_max, _t_beg, t_end,
+            vals, t_out, dt_out, vals_out, work, _stats);
+
+          Kokkos::single(Kokkos::PerTeam(member), [&]() {
+            update += (r_val != 0);
+            if (is_stats_given)
+              stats(i) = _stats;
+          });
+        },
+        num_failures);
+
+      Kokkos::Profiling::popRegion();
+      return num_failures;
+    }
+
+    ///
+    /// the same as above; the batch workspace is allocated here
+    ///
+    template <template <typename, typename> class ProblemType>
+    static int invoke(const SpT &exec_instance,
+                      const ProblemType<real_type, device_type> &problem,
+                      const int &max_num_newton_iterations,
+                      const int &max_num_time_iterations,
+                      const real_type_2d_view_type &tol_newton,
+                      const real_type_3d_view_type &tol_time,
+                      const real_type &jacobian_reuse_dt_ratio,
+                      const real_type_1d_view_type &dt_in,
+                      const real_type_1d_view_type &dt_min,
+                      const real_type_1d_view_type &dt_max,
+                      const real_type_1d_view_type &t_beg,
+                      const real_type_1d_view_type &t_end,
+                      const real_type_2d_view_type &vals,
+                      const real_type_1d_view_type &t_out,
+                      const real_type_1d_view_type &dt_out,
+                      const real_type_2d_view_type &vals_out) {
+      const int np = vals.extent(0), m = vals.extent(1);
+      int wlen(0);
+      workspace(m, wlen);
+      real_type_2d_view_type work(
+        Kokkos::ViewAllocateWithoutInitializing(
+          "Tines::TimeIntegratorTrBDF2Device::work"),
+        np, wlen);
+      return invoke(exec_instance, problem, max_num_newton_iterations,
+                    max_num_time_iterations, tol_newton, tol_time,
+                    jacobian_reuse_dt_ratio, dt_in, dt_min, dt_max, t_beg,
+                    t_end, vals, t_out, dt_out, vals_out, work);
+    }
+
+    ///
+    /// Load balanced batch integration with dynamic scheduling
+    /// - a league of (concurrency / team_size) teams is launched and each
+    ///   team takes the next sample from an atomic counter when it finishes
+    ///   its current sample
+    /// - stiff samples do not hold idle teams; suited for host spaces
+    ///
+    template <template <typename, typename> class ProblemType>
+    static int invokeDynamic(
+      const SpT &exec_instance,
+      const ProblemType<real_type, device_type> &problem,
+      const int &max_num_newton_iterations, const int &max_num_time_iterations,
+      const real_type_2d_view_type &tol_newton,
+      const real_type_3d_view_type &tol_time,
+      const real_type &jacobian_reuse_dt_ratio,
+      const real_type_1d_view_type &dt_in, const real_type_1d_view_type &dt_min,
+      const real_type_1d_view_type &dt_max, const real_type_1d_view_type &t_beg,
+      const real_type_1d_view_type &t_end, const real_type_2d_view_type &vals,
+      const real_type_1d_view_type &t_out, const real_type_1d_view_type &dt_out,
+      const real_type_2d_view_type &vals_out,
+      const int_type_1d_view_type &num_time_iterations,
+      const real_type_2d_view_type &work, const int team_size_in = -1,
+      const int vector_size_in = -1,
+      const statistics_type_1d_view_type &stats =
+        statistics_type_1d_view_type()) {
+      TINES_CHECK_ERROR(!ValidExecutionSpace<SpT>::value,
+                        "Error: the given execution space is not implemented");
+      Kokkos::Profiling::pushRegion(
+        "Tines::TimeIntegratorTrBDF2Device::Dynamic");
+
+      const int np = vals.extent(0), m = vals.extent(1);
+
+      int wlen(0);
+      workspace(m, wlen);
+      TINES_CHECK_ERROR(int(work.extent(0)) < np || int(work.extent(1)) < wlen,
+                        "Error: workspace is too small");
+      TINES_CHECK_ERROR(int(num_time_iterations.extent(0)) < np,
+                        "Error: num_time_iterations is too small");
+      const bool is_stats_given = (stats.extent(0) > 0);
+      TINES_CHECK_ERROR(is_stats_given && int(stats.extent(0)) < np,
+                        "Error: stats is too small");
+
+      int team_size(0), vector_size(0);
+      getTeamSize(np, m, team_size, vector_size);
+      if (team_size_in > 0)
+        team_size = team_size_in;
+      if (vector_size_in > 0)
+        vector_size = vector_size_in;
+
+      const int concurrency = exec_instance.concurrency();
+      const int league_size =
+        max(1, min(np, concurrency / (team_size * vector_size)));
+
+      /// next sample to be integrated
+      int_type_0d_view_type queue("Tines::TimeIntegratorTrBDF2Device::queue");
+
+      using policy_type = Kokkos::TeamPolicy<SpT>;
+      const policy_type policy(exec_instance, league_size, team_size,
+                               vector_size);
+
+      int num_failures(0);
+      Kokkos::parallel_reduce(
+        "Tines::TimeIntegratorTrBDF2Device::Dynamic::parallel_reduce", policy,
+        KOKKOS_LAMBDA(const typename policy_type::member_type &member,
+                      int &update) {
+          for (;;) {
+            int i(0);
+            Kokkos::single(
+              Kokkos::PerTeam(member),
+              [&](int &val) { val = Kokkos::atomic_fetch_add(&queue(), 1); },
+              i);
+            if (i >= np)
+              break;
+
+            const auto sample = [i](const int n) { return n == 1 ? 0 : i; };
+            const real_type _dt_in = dt_in(sample(dt_in.extent(0)));
+            const real_type _t_beg = t_beg(sample(t_beg.extent(0)));
+
+            statistics_type _stats;
+            const int r_val = invokeSample(
+              member, problem, i, max_num_newton_iterations,
+              max_num_time_iterations, tol_newton, tol_time,
+              jacobian_reuse_dt_ratio, _dt_in, dt_min, dt_max, _t_beg, t_end,
+              vals, t_out, dt_out, vals_out, work, _stats);
+
+            Kokkos::single(Kokkos::PerTeam(member), [&]() {
+              num_time_iterations(i) = _stats.num_time_iterations;
+              update += (r_val != 0);
+              if (is_stats_given)
+                stats(i) = _stats;
+            });
+          }
+        },
+        num_failures);
+
+      Kokkos::Profiling::popRegion();
+      return num_failures;
+    }
+
+    ///
+    /// Load balanced batch integration with compaction
+    /// - samples are integrated by chunks of max_num_time_iterations_per_chunk
+    ///   time iterations; after a chunk, the samples reaching the end of the
+    ///   time window (or failing) are removed from the index list and the rest
+    ///   is relaunched as a compacted league
+    /// - t_out, dt_out and vals_out hold the restart state between chunks
+    /// - the jacobian cache is rebuilt at the beginning of each chunk
+    /// - the statistics of the chunks of a sample are appended in stats
+    ///
+    template <template <typename, typename> class ProblemType>
+    static int invokeCompacted(
+      const SpT &exec_instance,
+      const ProblemType<real_type, device_type> &problem,
+      const int &max_num_newton_iterations, const int &max_num_time_iterations,
+      const int &max_num_time_iterations_per_chunk,
+      const real_type_2d_view_type &tol_newton,
+      const real_type_3d_view_type &tol_time,
+      const real_type &jacobian_reuse_dt_ratio,
+      const real_type_1d_view_type &dt_in, const real_type_1d_view_type &dt_min,
+      const real_type_1d_view_type &dt_max, const real_type_1d_view_type &t_beg,
+      const real_type_1d_view_type &t_end, const real_type_2d_view_type &vals,
+      const real_type_1d_view_type &t_out, const real_type_1d_view_type &dt_out,
+      const real_type_2d_view_type &vals_out,
+      const int_type_1d_view_type &num_time_iterations,
+      const real_type_2d_view_type &work, const int team_size_in = -1,
+      const int vector_size_in = -1,
+      const statistics_type_1d_view_type &stats =
+        statistics_type_1d_view_type()) {
+      TINES_CHECK_ERROR(!ValidExecutionSpace<SpT>::value,
+                        "Error: the given execution space is not implemented");
+      TINES_CHECK_ERROR(max_num_time_iterations_per_chunk <= 0,
+                        "Error: chunk size should be positive");
+      Kokkos::Profiling::pushRegion(
+        "Tines::TimeIntegratorTrBDF2Device::Compacted");
+
+      const int np = vals.extent(0), m = vals.extent(1);
+
+      int wlen(0);
+      workspace(m, wlen);
+      TINES_CHECK_ERROR(int(work.extent(0)) < np || int(work.extent(1)) < wlen,
+                        "Error: workspace is too small");
+      TINES_CHECK_ERROR(int(num_time_iterations.extent(0)) < np,
+                        "Error: num_time_iterations is too small");
+      const bool is_stats_given = (stats.extent(0) > 0);
+      TINES_CHECK_ERROR(is_stats_given && int(stats.extent(0)) < np,
+                        "Error: stats is too small");
+
+      int team_size(0), vector_size(0);
+      getTeamSize(np, m, team_size, vector_size);
+      if (team_size_in > 0)
+        team_size = team_size_in;
+      if (vector_size_in > 0)
+        vector_size = vector_size_in;
+
+      /// index lists of active samples and sample status
+      /// (0 - active, 1 - done, 2 - failed)
+      int_type_1d_view_type index("Tines::TimeIntegratorTrBDF2Device::index",
+                                  np);
+      int_type_1d_view_type index_next(
+        "Tines::TimeIntegratorTrBDF2Device::index_next", np);
+      int_type_1d_view_type status("Tines::TimeIntegratorTrBDF2Device::status",
+                                   np);
+
+      using range_policy_type = Kokkos::RangePolicy<SpT>;
+      Kokkos::parallel_for(
+        "Tines::TimeIntegratorTrBDF2Device::Compacted::initialize",
+        range_policy_type(exec_instance, 0, np), KOKKOS_LAMBDA(const int &i) {
+          const auto sample = [i](const int n) { return n == 1 ? 0 : i; };
+          index(i) = i;
+          status(i) = 0;
+          num_time_iterations(i) = 0;
+          if (is_stats_given)
+            stats(i).reset();
+          t_out(i) = t_beg(sample(t_beg.extent(0)));
+          dt_out(i) = dt_in(sample(dt_in.extent(0)));
+          for (int k = 0; k < m; ++k)
+            vals_out(i, k) = vals(i, k);
+        });
+
+      using policy_type = Kokkos::TeamPolicy<SpT>;
+      for (int num_active = np; num_active > 0;) {
+        const policy_type policy(exec_instance, num_active, team_size,
+                                 vector_size);
+        Kokkos::parallel_for(
+          "Tines::TimeIntegratorTrBDF2Device::Compacted::parallel_for", policy,
+          KOKKOS_LAMBDA(const typename policy_type::member_type &member) {
+            const int i = index(member.league_rank());
+            const int remaining =
+              max_num_time_iterations - num_time_iterations(i);
+            const int chunk = min(remaining, max_num_time_iterations_per_chunk);
+
+            /// restart from the state at the end of the previous chunk
+            const real_type _dt_in = dt_out(i), _t_beg = t_out(i);
+
+            statistics_type _stats;
+            const int r_val = invokeSample(
+              member, problem, i, max_num_newton_iterations, chunk, tol_newton,
+              tol_time, jacobian_reuse_dt_ratio, _dt_in, dt_min, dt_max,
+              _t_beg, t_end, vals_out, t_out, dt_out, vals_out, work, _stats);
+
+            Kokkos::single(Kokkos::PerTeam(member), [&]() {
+              num_time_iterations(i) += _stats.num_time_iterations;
+              if (is_stats_given)
+                stats(i).append(_stats);
+              /// dt becomes zero when the time window is completed
+              const bool is_done =
+                (dt_out(i) == real_type(0) ||
+                 num_time_iterations(i) >= max_num_time_iterations);
+              status(i) = (r_val != 0 ? 2 : is_done ? 1 : 0);
+            });
+          });
+
+        /// compact the index list to the samples to be continued
+        int num_active_next(0);
+        Kokkos::parallel_scan(
+          "Tines::TimeIntegratorTrBDF2Device::Compacted::parallel_scan",
+          range_policy_type(exec_instance, 0, num_active),
+          KOKKOS_LAMBDA(const int &k, int &update, const bool &is_final) {
+            const int i = index(k);
+            if (status(i) == 0) {
+              if (is_final)
+                index_next(update) = i;
+              ++update;
+            }
+          },
+          num_active_next);
+
+        {
+          const auto tmp = index;
+          index = index_next;
+          index_next = tmp;
+        }
+        num_active = num_active_next;
+      }
+
+      int num_failures(0);
+      Kokkos::parallel_reduce(
+        "Tines::TimeIntegratorTrBDF2Device::Compacted::parallel_reduce",
+        range_policy_type(exec_instance, 0, np),
+        KOKKOS_LAMBDA(const int &i, int &update) {
+          update += (status(i) == 2);
+        },
+        num_failures);
+
+      Kokkos::Profiling::popRegion();
+      return num_failures;
+    }
+
+    ///
+    /// Load balanced batch integration
+    /// - host spaces use dynamic scheduling with an atomic counter
+    /// - device spaces relaunch compacted leagues of unfinished samples every
+    ///   max_num_time_iterations_per_chunk time iterations
+    /// - num_time_iterations reports the time steps taken by each sample
+    ///
+    template <template <typename, typename> class ProblemType>
+    static int invokeLoadBalanced(
+      const SpT &exec_instance,
+      const ProblemType<real_type, device_type> &problem,
+      const int &max_num_newton_iterations, const int &max_num_time_iterations,
+      const int &max_num_time_iterations_per_chunk,
+      const real_type_2d_view_type &tol_newton,
+      const real_type_3d_view_type &tol_time,
+      const real_type &jacobian_reuse_dt_ratio,
+      const real_type_1d_view_type &dt_in, const real_type_1d_view_type &dt_min,
+      const real_type_1d_view_type &dt_max, const real_type_1d_view_type &t_beg,
+      const real_type_1d_view_type &t_end, const real_type_2d_view_type &vals,
+      const real_type_1d_view_type &t_out, const real_type_1d_view_type &dt_out,
+      const real_type_2d_view_type &vals_out,
+      const int_type_1d_view_type &num_time_iterations,
+      const real_type_2d_view_type &work, const int team_size_in = -1,
+      const int vector_size_in = -1,
+      const statistics_type_1d_view_type &stats =
+        statistics_type_1d_view_type()) {
+      int r_val(0);
+      if (std::is_same<typename device_type::memory_space,
+                       Kokkos::HostSpace>::value) {
+        r_val = invokeDynamic(
+          exec_instance, problem, max_num_newton_iterations,
+          max_num_time_iterations, tol_newton, tol_time,
+          jacobian_reuse_dt_ratio, dt_in, dt_min, dt_max, t_beg, t_end, vals,
+          t_out, dt_out, vals_out, num_time_iterations, work, team_size_in,
+          vector_size_in, stats);
+      } else {
+        r_val = invokeCompacted(
+          exec_instance, problem, max_num_newton_iterations,
+          max_num_time_iterations, max_num_time_iterations_per_chunk,
+          tol_newton, tol_time, jacobian_reuse_dt_ratio, dt_in, dt_min, dt_max,
+          t_beg, t_end, vals, t_out, dt_out, vals_out, num_time_iterations,
+          work, team_size_in, vector_size_in, stats);
+      }
+      return r_val;
+    }
+
+    ///
+    /// aggregate the statistics of samples; the counters are summed, the
+    /// range of accepted time step sizes is merged and num_failures counts
+    /// the samples with a non-zero failure reason
+    ///
+    static void aggregateStatistics(const statistics_type_1d_view_type &stats,
+                                    /* */ statistics_type &stats_all) {
+      const auto stats_host =
+        Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(), stats);
+      stats_all.reset();
+      for (int i = 0, iend = stats_host.extent(0); i < iend; ++i)
+        stats_all.join(stats_host(i));
+    }
+  };
+
+} // namespace Tines
+
+#endif
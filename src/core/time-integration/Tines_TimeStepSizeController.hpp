@@ -0,0 +1,104 @@
+/*----------------------------------------------------------------------------------
+Tines - Time Integrator, Newton and Eigen Solver -  version 1.0
+Copyright (2021) NTESS
+https://github.com/sandialabs/Tines
+
+Copyright 2021 National Technology & Engineering Solutions of Sandia, LLC (NTESS). 
+Under the terms of Contract DE-NA0003525 with NTESS, the U.S. Government retains 
+certain rights in this software.
+
+This file is part of Tines. Tines is open-source software: you can redistribute it
+and/or modify it under the terms of BSD 2-Clause License
+(https://opensource.org/licenses/BSD-2-Clause). A copy of the license is also
+provided under the main directory
+Questions? Kyungjoo Kim <kyukim@sandia.gov>, or
+	   Oscar Diaz-Ibarra at <odiazib@sandia.gov>, or
+	   Cosmin Safta at <csafta@sandia.gov>, or
+	   Habib Najm at <hnnajm@sandia.gov>
+
+Sandia National Laboratories, New Mexico, USA
+----------------------------------------------------------------------------------*/
+#ifndef __TINES_TIME_STEP_SIZE_CONTROLLER_HPP__
+#define __TINES_TIME_STEP_SIZE_CONTROLLER_HPP__
+
+namespace Tines {
+
+  ///
+  /// Error based time step size control shared by the time integrators;
+  /// dt_new = dt * factor where factor is clamped to [factor_min, factor_max]
+  ///
+  template <typename RealType> struct TimeStepSizeController {
+    using real_type = RealType;
+
+    real_type _safety, _factor_min, _factor_max;
+    int _use_pi_controller;
+
+    KOKKOS_INLINE_FUNCTION
+    TimeStepSizeController()
+      : _safety(0.9), _factor_min(0.2), _factor_max(5),
+        _use_pi_controller(true) {}
+
+    KOKKOS_INLINE_FUNCTION
+    TimeStepSizeController(const real_type safety, const real_type factor_min,
+                           const real_type factor_max,
+                           const int use_pi_controller)
+      : _safety(safety), _factor_min(factor_min), _factor_max(factor_max),
+        _use_pi_controller(use_pi_controller) {}
+
+    ///
+    /// step size factor from the WRMS norm of the local error err where the
+    /// local error is O(dt^q)
+    /// - elementary controller, factor = safety err^{-1/q}
+    /// - PI controller (Gustafsson), factor = safety err^{-0.7/q}
+    ///   err_prev^{0.4/q} where err_prev is the error of the previous
+    ///   accepted step; it is used when err_prev is positive
+    /// - a rejected step (err > 1) uses the elementary controller and the
+    ///   step after a rejection does not grow (is_rejected)
+    ///
+    KOKKOS_INLINE_FUNCTION
+    real_type computeFactor(const real_type &err, const real_type &err_prev,
+                            const int &is_rejected, const real_type &q) const {
+      const real_type zero(0), one(1);
+      real_type factor(_factor_max);
+      if (err > zero) {
+        if (_use_pi_controller && err_prev > zero && err <= one)
+          factor = _safety * ats<real_type>::pow(err, -real_type(0.7) / q) *
+                   ats<real_type>::pow(err_prev, real_type(0.4) / q);
+        else
+          factor = _safety * ats<real_type>::pow(err, -one / q);
+      }
+      factor = factor < _factor_min ? _factor_min : factor;
+      factor = factor > _factor_max ? _factor_max : factor;
+      if ((is_rejected || err > one) && factor > one)
+        factor = one;
+      return factor;
+    }
+
+    ///
+    /// WRMS norm of the error estimate e of the first m variables with the
+    /// weights 1 / (tol(i,1) |u(i)| + tol(i,0))
+    ///
+    template <typename MemberType, typename TolViewType, typename EViewType,
+              typename UViewType>
+    KOKKOS_INLINE_FUNCTION static void
+    computeWrmsNorm(const MemberType &member, const TolViewType &tol,
+                    const int &m, const EViewType &e, const UViewType &u,
+                    /* */ real_type &norm) {
+      const real_type one(1);
+      real_type sum(0);
+      Kokkos::parallel_reduce(
+        Kokkos::TeamVectorRange(member, m),
+        [&](const int &i, real_type &update) {
+          const real_type w_at_i =
+            one / (tol(i, 1) * ats<real_type>::abs(u(i)) + tol(i, 0));
+          const real_type mult_val = ats<real_type>::abs(e(i)) * w_at_i;
+          update += mult_val * mult_val;
+        },
+        sum);
+      norm = m > 0 ? ats<real_type>::sqrt(sum / real_type(m)) : real_type(0);
+    }
+  };
+
+} // namespace Tines
+
+#endif
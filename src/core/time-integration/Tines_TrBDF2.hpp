@@ -34,22 +34,41 @@ namespace Tines {
 
     const real_type _gamma;
 
+    /// step size controller; dt_new = dt * factor where factor is clamped to
+    /// [_factor_min, _factor_max]
+    real_type _safety, _factor_min, _factor_max;
+    int _use_pi_controller;
+
+    KOKKOS_INLINE_FUNCTION
+    TrBDF2()
+      : _gamma(real_type(2) - ats<real_type>::sqrt(2)), _safety(0.9),
+        _factor_min(0.2), _factor_max(5), _use_pi_controller(true) {}
+
     KOKKOS_INLINE_FUNCTION
-    TrBDF2() : _gamma(real_type(2) - ats<real_type>::sqrt(2)) {}
+    void setTimeStepSizeController(const real_type safety,
+                                   const real_type factor_min,
+                                   const real_type factor_max,
+                                   const int use_pi_controller) {
+      _safety = safety;
+      _factor_min = factor_min;
+      _factor_max = factor_max;
+      _use_pi_controller = use_pi_controller;
+    }
 
+    /// WRMS norm of the local error estimate; a step is acceptable when the
+    /// norm is not larger than one
     template <typename MemberType>
-    KOKKOS_INLINE_FUNCTION void computeTimeStepSizeWrmsError(
-      const MemberType &member, const real_type &dtmin, const real_type &dtmax,
-      const real_type_2d_view_type &tol,
+    KOKKOS_INLINE_FUNCTION void computeWrmsError(
+      const MemberType &member, const real_type_2d_view_type &tol,
       const int &m, // vector length
       const real_type_1d_view_type &fn, const real_type_1d_view_type &fnr,
       const real_type_1d_view_type &fnp, const real_type_1d_view_type &u,
-      /* */ real_type &dt) {
+      const real_type &dt,
+      /* */ real_type &err) const {
       const real_type kr =
         (-3.0 * _gamma * _gamma + 4.0 * _gamma - 2.0) / (12.0 * (2.0 - _gamma));
       const real_type one(1), two(2), scal1(one / _gamma),
         scal2(one / (one - _gamma));
-      const real_type half(0.5);
 
       using reducer_value_type = typename Kokkos::Sum<real_type>::value_type;
       reducer_value_type norm;
@@ -67,7 +86,122 @@ namespace Tines {
           update += mult_val * mult_val;
         },
         reducer_value);
-      norm = (ats<real_type>::sqrt(norm / real_type(m)));
+      err = ats<real_type>::sqrt(norm / real_type(m));
+    }
+
+    /// max norm of the relative error estimate scaled by rtol; atol is not
+    /// used and a step is acceptable when the norm is not larger than one
+    template <typename MemberType>
+    KOKKOS_INLINE_FUNCTION void computeNormalizedError(
+      const MemberType &member, const real_type_2d_view_type &tol,
+      const int &m, // vector length
+      const real_type_1d_view_type &fn, const real_type_1d_view_type &fnr,
+      const real_type_1d_view_type &fnp, const real_type_1d_view_type &u,
+      const real_type &dt,
+      /* */ real_type &err) const {
+      const real_type kr =
+        (-3.0 * _gamma * _gamma + 4.0 * _gamma - 2.0) / (12.0 * (2.0 - _gamma));
+      const real_type one(1), two(2), scal1(one / _gamma),
+        scal2(one / (one - _gamma));
+
+      using reducer_value_type = typename Kokkos::Max<real_type>::value_type;
+      reducer_value_type norm;
+      Kokkos::Max<real_type> reducer_value(norm);
+      Kokkos::parallel_reduce(
+        Kokkos::TeamVectorRange(member, m),
+        [&](const int &i, reducer_value_type &update) {
+          /// error estimation
+          const real_type abs_est_err = ats<real_type>::abs(
+            two * kr * dt *
+            (scal1 * fn(i) - scal1 * scal2 * fnr(i) + scal2 * fnp(i)));
+          const real_type rel_est_err =
+            abs_est_err /
+            (ats<real_type>::abs(u(i)) + ats<real_type>::epsilon());
+          const real_type err_at_i = rel_est_err / tol(i, 1);
+          update = update > err_at_i ? update : err_at_i;
+        },
+        reducer_value);
+      err = norm;
+    }
+
+    /// error norm used for step acceptance; TINES_ENABLE_TRBDF2_WRMS selects
+    /// the WRMS norm, otherwise the normalized error is used
+    template <typename MemberType>
+    KOKKOS_INLINE_FUNCTION void computeError(
+      const MemberType &member, const real_type_2d_view_type &tol,
+      const int &m, // vector length
+      const real_type_1d_view_type &fn, const real_type_1d_view_type &fnr,
+      const real_type_1d_view_type &fnp, const real_type_1d_view_type &u,
+      const real_type &dt,
+      /* */ real_type &err) const {
+#if defined(TINES_ENABLE_TRBDF2_WRMS)
+      computeWrmsError(member, tol, m, fn, fnr, fnp, u, dt, err);
+#else
+      computeNormalizedError(member, tol, m, fn, fnr, fnp, u, dt, err);
+#endif
+    }
+
+    /// step size factor for the O(dt^3) local error (see TimeStepSizeController)
+    KOKKOS_INLINE_FUNCTION
+    real_type computeTimeStepSizeFactor(const real_type &err,
+                                        const real_type &err_prev,
+                                        const int &is_rejected) const {
+      const TimeStepSizeController<real_type> controller(
+        _safety, _factor_min, _factor_max, _use_pi_controller);
+      return controller.computeFactor(err, err_prev, is_rejected,
+                                      real_type(3));
+    }
+
+    ///
+    /// dense output on an accepted step [t, t + dt]; the solution at the
+    /// requested times t < t_dense(k) <= t + dt, k = idx, idx+1, ..., is
+    /// interpolated and stored in vals_dense(k, :) and idx is advanced
+    /// - time ODEs use the cubic Hermite interpolant of (un, fn) and (u, fnp)
+    ///   which needs no extra function evaluation
+    /// - constraints are linearly interpolated
+    /// - t_dense should be sorted in ascending order
+    ///
+    template <typename MemberType>
+    KOKKOS_INLINE_FUNCTION void computeDenseOutput(
+      const MemberType &member, const int &m, const int &m_ode,
+      const real_type &t, const real_type &dt,
+      const real_type_1d_view_type &un, const real_type_1d_view_type &fn,
+      const real_type_1d_view_type &u, const real_type_1d_view_type &fnp,
+      const real_type_1d_view_type &t_dense,
+      const real_type_2d_view_type &vals_dense,
+      /* */ int &idx) const {
+      const real_type one(1), two(2), three(3);
+      const int n_dense = t_dense.extent(0);
+      for (; idx < n_dense && t_dense(idx) <= t + dt; ++idx) {
+        const real_type s = (t_dense(idx) - t) / dt, s2 = s * s, s3 = s2 * s;
+        const real_type h00 = two * s3 - three * s2 + one,
+                        h10 = s3 - two * s2 + s, h01 = -two * s3 + three * s2,
+                        h11 = s3 - s2;
+        const int k = idx;
+        Kokkos::parallel_for(
+          Kokkos::TeamVectorRange(member, m), [&](const int &i) {
+            vals_dense(k, i) =
+              i < m_ode ? (h00 * un(i) + h10 * dt * fn(i) + h01 * u(i) +
+                           h11 * dt * fnp(i))
+                        : ((one - s) * un(i) + s * u(i));
+          });
+      }
+      member.team_barrier();
+    }
+
+    template <typename MemberType>
+    KOKKOS_INLINE_FUNCTION void computeTimeStepSizeWrmsError(
+      const MemberType &member, const real_type &dtmin, const real_type &dtmax,
+      const real_type_2d_view_type &tol,
+      const int &m, // vector length
+      const real_type_1d_view_type &fn, const real_type_1d_view_type &fnr,
+      const real_type_1d_view_type &fnp, const real_type_1d_view_type &u,
+      /* */ real_type &dt) {
+      const real_type one(1), two(2);
+      const real_type half(0.5);
+
+      real_type norm(0);
+      computeWrmsError(member, tol, m, fn, fnr, fnp, u, dt, norm);
       {
         /// WRMS is close to zero, the error is reasonably small
         /// we do not know how large is large enough to reduce time step size
@@ -165,16 +299,23 @@ namespace Tines {
 
     using problem_type = ProblemType<value_type, device_type>;
 
+    /// compile-time number of equations of the problem (0 if unknown)
+    static constexpr int static_number_of_equations =
+      ProblemStaticNumberOfEquations<problem_type>::value;
+
     problem_type _problem;
 
     const real_type _gamma;
     real_type _dt;
     real_type_1d_view_type _un, _fn;
 
+    /// optional; when it is given, the problem Jacobian is kept here
+    real_type_2d_view_type _Jprob;
+
     KOKKOS_INLINE_FUNCTION
     TrBDF2_Part1()
       : _problem(), _gamma(real_type(2) - ats<real_type>::sqrt(2)), _dt(),
-        _un(), _fn() {}
+        _un(), _fn(), _Jprob() {}
 
     KOKKOS_INLINE_FUNCTION
     void setWorkspace(real_type_1d_view_type &work) {
@@ -206,17 +347,18 @@ namespace Tines {
       member.team_barrier();
     }
 
+    /// the iteration matrix is I - scale * J_prob for time ODEs
+    KOKKOS_INLINE_FUNCTION
+    real_type getJacobianScale() const { return _gamma * _dt * real_type(0.5); }
+
     template <typename MemberType>
     KOKKOS_INLINE_FUNCTION void
-    computeJacobian(const MemberType &member, const real_type_1d_view_type &u,
-                    const real_type_2d_view_type &J) const {
+    computeIterationMatrix(const MemberType &member,
+                           const real_type_2d_view_type &J) const {
       const real_type one(1), zero(0), half(0.5);
       const int m = _problem.getNumberOfTimeODEs(),
                 n = _problem.getNumberOfEquations();
 
-      /// evaluate problem Jacobian (n x n)
-      _problem.computeJacobian(member, u, J);
-
       /// modify time ODE parts for the trapezoidal rule
       Kokkos::parallel_for(
         Kokkos::TeamThreadRange(member, m), [&](const int &i) {
@@ -230,6 +372,38 @@ namespace Tines {
       member.team_barrier();
     }
 
+    template <typename MemberType>
+    KOKKOS_INLINE_FUNCTION void
+    computeJacobian(const MemberType &member, const real_type_1d_view_type &u,
+                    const real_type_2d_view_type &J) const {
+      /// evaluate problem Jacobian (n x n)
+      _problem.computeJacobian(member, u, J);
+
+      /// keep the problem Jacobian for reuse
+      if (_Jprob.span() > 0) {
+        const int n = _problem.getNumberOfEquations();
+        CopyInternal::invoke(member, Trans::NoTranspose(), n, n, J.data(),
+                             J.stride(0), J.stride(1), _Jprob.data(),
+                             _Jprob.stride(0), _Jprob.stride(1));
+        member.team_barrier();
+      }
+
+      computeIterationMatrix(member, J);
+    }
+
+    /// J is computed from the kept problem Jacobian with the current dt
+    template <typename MemberType>
+    KOKKOS_INLINE_FUNCTION void
+    computeJacobianUsingCache(const MemberType &member,
+                              const real_type_2d_view_type &J) const {
+      const int n = _problem.getNumberOfEquations();
+      CopyInternal::invoke(member, Trans::NoTranspose(), n, n, _Jprob.data(),
+                           _Jprob.stride(0), _Jprob.stride(1), J.data(),
+                           J.stride(0), J.stride(1));
+      member.team_barrier();
+      computeIterationMatrix(member, J);
+    }
+
     template <typename MemberType>
     KOKKOS_INLINE_FUNCTION void
     computeFunction(const MemberType &member, const real_type_1d_view_type &u,
@@ -264,16 +438,23 @@ namespace Tines {
 
     using problem_type = ProblemType<value_type, device_type>;
 
+    /// compile-time number of equations of the problem (0 if unknown)
+    static constexpr int static_number_of_equations =
+      ProblemStaticNumberOfEquations<problem_type>::value;
+
     problem_type _problem;
 
     const real_type _gamma;
     real_type _dt;
     real_type_1d_view_type _un, _unr;
 
+    /// optional; when it is given, the problem Jacobian is kept here
+    real_type_2d_view_type _Jprob;
+
     KOKKOS_INLINE_FUNCTION
     TrBDF2_Part2()
       : _problem(), _gamma(real_type(2) - ats<real_type>::sqrt(2)), _dt(),
-        _un(), _unr() {}
+        _un(), _unr(), _Jprob() {}
 
     KOKKOS_INLINE_FUNCTION
     void setWorkspace(real_type_1d_view_type &work) {
@@ -305,15 +486,52 @@ namespace Tines {
       member.team_barrier();
     }
 
+    /// the iteration matrix is I - scale * J_prob for time ODEs
+    KOKKOS_INLINE_FUNCTION
+    real_type getJacobianScale() const {
+      const real_type one(1), two(2);
+      return (one - _gamma) / (two - _gamma) * _dt;
+    }
+
     template <typename MemberType>
     KOKKOS_INLINE_FUNCTION void
     computeJacobian(const MemberType &member, const real_type_1d_view_type &u,
                     const real_type_2d_view_type &J) const {
+      _problem.computeJacobian(member, u, J);
+
+      /// keep the problem Jacobian for reuse
+      if (_Jprob.span() > 0) {
+        const int n = _problem.getNumberOfEquations();
+        CopyInternal::invoke(member, Trans::NoTranspose(), n, n, J.data(),
+                             J.stride(0), J.stride(1), _Jprob.data(),
+                             _Jprob.stride(0), _Jprob.stride(1));
+        member.team_barrier();
+      }
+
+      computeIterationMatrix(member, J);
+    }
+
+    /// J is computed from the kept problem Jacobian with the current dt
+    template <typename MemberType>
+    KOKKOS_INLINE_FUNCTION void
+    computeJacobianUsingCache(const MemberType &member,
+                              const real_type_2d_view_type &J) const {
+      const int n = _problem.getNumberOfEquations();
+      CopyInternal::invoke(member, Trans::NoTranspose(), n, n, _Jprob.data(),
+                           _Jprob.stride(0), _Jprob.stride(1), J.data(),
+                           J.stride(0), J.stride(1));
+      member.team_barrier();
+      computeIterationMatrix(member, J);
+    }
+
+    template <typename MemberType>
+    KOKKOS_INLINE_FUNCTION void
+    computeIterationMatrix(const MemberType &member,
+                           const real_type_2d_view_type &J) const {
       const real_type one(1), two(2), zero(0);
       const int m = _problem.getNumberOfTimeODEs(),
                 n = _problem.getNumberOfEquations();
 
-      _problem.computeJacobian(member, u, J);
       Kokkos::parallel_for(
         Kokkos::TeamThreadRange(member, m), [&](const int &i) {
           Kokkos::parallel_for(
@@ -0,0 +1,195 @@
+/*----------------------------------------------------------------------------------
+Tines - Time Integrator, Newton and Eigen Solver -  version 1.0
+Copyright (2021) NTESS
+https://github.com/sandialabs/Tines
+
+Copyright 2021 National Technology & Engineering Solutions of Sandia, LLC (NTESS). 
+Under the terms of Contract DE-NA0003525 with NTESS, the U.S. Government retains 
+certain rights in this software.
+
+This file is part of Tines. Tines is open-source software: you can redistribute it
+and/or modify it under the terms of BSD 2-Clause License
+(https://opensource.org/licenses/BSD-2-Clause). A copy of the license is also
+provided under the main directory
+Questions? Kyungjoo Kim <kyukim@sandia.gov>, or
+	   Oscar Diaz-Ibarra at <odiazib@sandia.gov>, or
+	   Cosmin Safta at <csafta@sandia.gov>, or
+	   Habib Najm at <hnnajm@sandia.gov>
+
+Sandia National Laboratories, New Mexico, USA
+----------------------------------------------------------------------------------*/
+#include "Tines.hpp"
+
+int main(int argc, char **argv) {
+  Kokkos::initialize(argc, argv);
+  {
+    using real_type = double;
+    using complex_type = Kokkos::complex<real_type>;
+
+    using host_exec_space = Kokkos::DefaultHostExecutionSpace;
+    using host_memory_space = Kokkos::HostSpace;
+    using host_device_type = Kokkos::Device<host_exec_space, host_memory_space>;
+
+    using ats = Tines::ats<real_type>;
+    using Trans = Tines::Trans;
+
+    using real_type_1d_view_type =
+      Kokkos::View<real_type *, Kokkos::LayoutRight, host_device_type>;
+    using real_type_2d_view_type =
+      Kokkos::View<real_type **, Kokkos::LayoutRight, host_device_type>;
+    using complex_type_1d_view_type =
+      Kokkos::View<complex_type *, Kokkos::LayoutRight, host_device_type>;
+    using complex_type_2d_view_type =
+      Kokkos::View<complex_type **, Kokkos::LayoutRight, host_device_type>;
+
+    /// A = S P [T11 A12 A13; 0 A22 A23; 0 0 T33] P^T S^{-1} where T11 and
+    /// T33 are upper triangular, P is a permutation and S is a diagonal
+    /// scaling spanning many orders of magnitude
+    const int m = 20, m1 = 3, m3 = 4;
+    const real_type one(1), zero(0);
+    const auto member = Tines::HostSerialTeamMember();
+
+    real_type_2d_view_type A("A", m, m), B("B", m, m), C("C", m, m),
+      X("X", m, m), AX("AX", m, m), XB("XB", m, m), V("V", m, m);
+    real_type_1d_view_type scale("scale", m), er("er", m), ei("ei", m),
+      W("W", 3 * m * m + 2 * m);
+    {
+      Kokkos::Random_XorShift64_Pool<host_device_type> random(13718);
+      Kokkos::fill_random(C, random, real_type(1.0));
+      for (int i = 0; i < m; ++i)
+        for (int j = 0; j < m; ++j)
+          if ((j < m1 && i > j) || (i >= m - m3 && i > j))
+            C(i, j) = zero;
+
+      std::vector<int> perm(m);
+      for (int i = 0; i < m; ++i)
+        perm[i] = (7 * i + 3) % m;
+      for (int i = 0; i < m; ++i) {
+        const real_type si = std::pow(10.0, (i % 7) - 3);
+        for (int j = 0; j < m; ++j) {
+          const real_type sj = std::pow(10.0, (j % 7) - 3);
+          A(perm[i], perm[j]) = si * C(i, j) / sj;
+        }
+      }
+    }
+    Tines::Copy::invoke(member, A, B);
+
+    /// B = D^{-1} P^T A P D
+    int ilo(0), ihi(0);
+    Tines::Balance::invoke(member, B, scale, ilo, ihi);
+    std::cout << "Balance ilo = " << ilo << ", ihi = " << ihi << "\n";
+    Tines::showVector("scale", scale);
+
+    /// isolated eigenvalues
+    {
+      bool is_valid(ilo >= m1 && ihi <= m - m3 - 1);
+      for (int i = 0; i < m; ++i)
+        for (int j = 0; j < i; ++j)
+          if ((j < ilo || i > ihi) && B(i, j) != zero)
+            is_valid = false;
+      if (is_valid) {
+        std::cout << "PASS Balance isolated eigenvalues\n";
+      } else {
+        std::cout << "FAIL Balance isolated eigenvalues\n";
+      }
+    }
+
+    /// row and column norms of the balanced block are close to each other
+    {
+      real_type ratio_a(1), ratio_b(1);
+      for (int i = ilo; i <= ihi; ++i) {
+        real_type ca(0), ra(0), cb(0), rb(0);
+        for (int k = ilo; k <= ihi; ++k) {
+          ca += A(k, i) * A(k, i);
+          ra += A(i, k) * A(i, k);
+          cb += B(k, i) * B(k, i);
+          rb += B(i, k) * B(i, k);
+        }
+        const real_type qa = ats::sqrt(ca / ra), qb = ats::sqrt(cb / rb);
+        ratio_a = std::max(ratio_a, std::max(qa, one / qa));
+        ratio_b = std::max(ratio_b, std::max(qb, one / qb));
+      }
+      std::cout << "  max row/column norm ratio before " << ratio_a
+                << " after " << ratio_b << "\n";
+      if (ratio_b < 1e2) {
+        std::cout << "PASS Balance scaling\n";
+      } else {
+        std::cout << "FAIL Balance scaling\n";
+      }
+    }
+
+    /// X = P D; check A X = X B
+    {
+      Tines::SetIdentityMatrix::invoke(member, X);
+      Tines::BalanceBackTransform::invoke(member, ilo, ihi, scale, X);
+      Tines::Gemm<Trans::NoTranspose, Trans::NoTranspose>::invoke(
+        member, one, A, X, zero, AX);
+      Tines::Gemm<Trans::NoTranspose, Trans::NoTranspose>::invoke(
+        member, one, X, B, zero, XB);
+      real_type err(0), norm(0);
+      for (int i = 0; i < m; ++i)
+        for (int j = 0; j < m; ++j) {
+          const real_type diff = AX(i, j) - XB(i, j);
+          err += diff * diff;
+          norm += AX(i, j) * AX(i, j);
+        }
+      const real_type rel_err = ats::sqrt(err / norm);
+      const real_type threshold = ats::epsilon() * 100;
+      if (rel_err < threshold) {
+        std::cout << "PASS Balance similarity " << rel_err << "\n";
+      } else {
+        std::cout << "FAIL Balance similarity " << rel_err << "\n";
+      }
+    }
+
+    /// eigen pairs of the badly scaled matrix
+    {
+      complex_type_2d_view_type Ac("Ac", m, m), Vc("Vc", m, m), Rc("Rc", m, m);
+      complex_type_1d_view_type ec("ec", m);
+      for (int i = 0; i < m; ++i)
+        for (int j = 0; j < m; ++j)
+          Ac(i, j) = A(i, j);
+
+      Tines::Copy::invoke(member, A, B);
+      Tines::SolveEigenvaluesNonSymmetricProblem::invoke(member, B, er, ei, V,
+                                                         W);
+      Tines::EigendecompositionToComplex::invoke(member, er, ei, V, ec, Vc);
+      real_type rel_err(0);
+      Tines::EigendecompositionValidateRightEigenPairs::invoke(member, Ac, ec,
+                                                               Vc, Rc, rel_err);
+      const real_type threshold = ats::epsilon() * 1e4;
+      if (rel_err < threshold) {
+        std::cout << "PASS Balance Right Eigen pairs " << rel_err << "\n";
+      } else {
+        std::cout << "FAIL Balance Right Eigen pairs " << rel_err << "\n";
+      }
+
+      /// left eigen pairs are transformed back with D^{-1}
+      real_type_2d_view_type U("U", m, m);
+      complex_type_2d_view_type Uc("Uc", m, m);
+      Tines::Copy::invoke(member, A, B);
+      Tines::SolveEigenvaluesNonSymmetricProblem::invoke(member, B, er, ei, U,
+                                                         V, W);
+      Tines::EigendecompositionToComplex::invoke(member, er, ei, U, ec, Uc);
+
+      /// left eigenvectors are scaled for U^H V = I, not normalized
+      real_type norm_u(0);
+      for (int j = 0; j < m; ++j) {
+        real_type norm(0);
+        for (int i = 0; i < m; ++i)
+          norm += Kokkos::abs(Uc(i, j)) * Kokkos::abs(Uc(i, j));
+        norm_u = norm > norm_u ? norm : norm_u;
+      }
+      norm_u = ats::sqrt(norm_u);
+      Tines::EigendecompositionValidateLeftEigenPairs::invoke(member, Ac, ec,
+                                                              Uc, Rc, rel_err);
+      if (rel_err < threshold * norm_u) {
+        std::cout << "PASS Balance Left Eigen pairs " << rel_err << "\n";
+      } else {
+        std::cout << "FAIL Balance Left Eigen pairs " << rel_err << "\n";
+      }
+    }
+  }
+  Kokkos::finalize();
+  return 0;
+}
@@ -0,0 +1,135 @@
+/*----------------------------------------------------------------------------------
+Tines - Time Integrator, Newton and Eigen Solver -  version 1.0
+Copyright (2021) NTESS
+https://github.com/sandialabs/Tines
+
+Copyright 2021 National Technology & Engineering Solutions of Sandia, LLC (NTESS). 
+Under the terms of Contract DE-NA0003525 with NTESS, the U.S. Government retains 
+certain rights in this software.
+
+This file is part of Tines. Tines is open-source software: you can redistribute it
+and/or modify it under the terms of BSD 2-Clause License
+(https://opensource.org/licenses/BSD-2-Clause). A copy of the license is also
+provided under the main directory
+Questions? Kyungjoo Kim <kyukim@sandia.gov>, or
+	   Oscar Diaz-Ibarra at <odiazib@sandia.gov>, or
+	   Cosmin Safta at <csafta@sandia.gov>, or
+	   Habib Najm at <hnnajm@sandia.gov>
+
+Sandia National Laboratories, New Mexico, USA
+----------------------------------------------------------------------------------*/
+#include "Tines.hpp"
+
+int main(int argc, char **argv) {
+  Kokkos::initialize(argc, argv);
+  {
+    using real_type = double;
+
+    using host_exec_space = Kokkos::DefaultHostExecutionSpace;
+    using host_memory_space = Kokkos::HostSpace;
+    using host_device_type = Kokkos::Device<host_exec_space, host_memory_space>;
+
+    using ats = Tines::ats<real_type>;
+    using Trans = Tines::Trans;
+
+    using real_type_1d_view_type =
+      Kokkos::View<real_type *, Kokkos::LayoutRight, host_device_type>;
+    using real_type_2d_view_type =
+      Kokkos::View<real_type **, Kokkos::LayoutRight, host_device_type>;
+
+    /// the matrix size must be larger than the blocked algorithm threshold
+    int m = 3 * TINES_BLOCKED_HOUSEHOLDER_MIN_SIZE / 2 + 3;
+    if (argc == 2)
+      m = std::atoi(argv[1]);
+
+    const real_type one(1), zero(0);
+    const auto member = Tines::HostSerialTeamMember();
+    Kokkos::Random_XorShift64_Pool<host_device_type> random(13718);
+
+    const real_type margin = 1000, threshold = ats::epsilon() * margin;
+    auto compare = [=](const std::string &label, const real_type_2d_view_type &A,
+                       const real_type_2d_view_type &B) {
+      real_type err(0), norm(0);
+      for (int i = 0, iend = A.extent(0); i < iend; ++i)
+        for (int j = 0, jend = A.extent(1); j < jend; ++j) {
+          const real_type diff = ats::abs(A(i, j) - B(i, j));
+          err += diff * diff;
+          norm += B(i, j) * B(i, j);
+        }
+      const real_type rel_err = ats::sqrt(err / norm);
+      if (rel_err < threshold) {
+        std::cout << "PASS " << label << " " << rel_err << "\n\n";
+      } else {
+        std::cout << "FAIL " << label << " " << rel_err << "\n\n";
+      }
+    };
+
+    /// QR; a wide matrix is used so that the last panel is partial
+    {
+      const int n = m + 7;
+      real_type_2d_view_type A("A", m, n), Ab("Ab", m, n);
+      real_type_1d_view_type t("t", m), tb("tb", m);
+
+      int wlen(0);
+      Tines::QR::workspace(Ab, wlen);
+      real_type_1d_view_type w("w", n), wb("wb", wlen);
+      std::cout << "QR m = " << m << ", n = " << n
+                << ", blocked workspace = " << wlen << "\n";
+
+      Kokkos::fill_random(A, random, real_type(1.0));
+      Tines::Copy::invoke(member, A, Ab);
+
+      /// unblocked (small workspace) and blocked
+      Tines::QR::device_invoke(member, A, t, w);
+      Tines::QR::device_invoke(member, Ab, tb, wb);
+
+      real_type_2d_view_type T("T", 1, m), Tb("Tb", 1, m);
+      for (int i = 0; i < m; ++i) {
+        T(0, i) = t(i);
+        Tb(0, i) = tb(i);
+      }
+      compare("QR Blocked vs Unblocked (A)", Ab, A);
+      compare("QR Blocked vs Unblocked (t)", Tb, T);
+    }
+
+    /// Hessenberg
+    {
+      real_type_2d_view_type A("A", m, m), Ab("Ab", m, m), B("B", m, m),
+        Q("Q", m, m), QH("QH", m, m), QHQt("QHQt", m, m);
+      real_type_1d_view_type t("t", m), tb("tb", m);
+
+      int wlen(0);
+      Tines::Hessenberg::workspace(Ab, wlen);
+      real_type_1d_view_type w("w", m), wb("wb", wlen);
+      std::cout << "Hessenberg m = " << m
+                << ", blocked workspace = " << wlen << "\n";
+
+      Kokkos::fill_random(A, random, real_type(1.0));
+      Tines::Copy::invoke(member, A, Ab);
+      Tines::Copy::invoke(member, A, B);
+
+      Tines::Hessenberg::device_invoke(member, A, t, w);
+      Tines::Hessenberg::device_invoke(member, Ab, tb, wb);
+
+      real_type_2d_view_type T("T", 1, m - 1), Tb("Tb", 1, m - 1);
+      for (int i = 0; i < (m - 1); ++i) {
+        T(0, i) = t(i);
+        Tb(0, i) = tb(i);
+      }
+      compare("Hessenberg Blocked vs Unblocked (A)", Ab, A);
+      compare("Hessenberg Blocked vs Unblocked (t)", Tb, T);
+
+      /// B = Q H Q^T
+      Tines::HessenbergFormQ::invoke(member, Ab, tb, Q, w);
+      Tines::SetTriangularMatrix<Tines::Uplo::Lower>::invoke(member, 2, zero,
+                                                             Ab);
+      Tines::Gemm<Trans::NoTranspose, Trans::NoTranspose>::invoke(
+        member, one, Q, Ab, zero, QH);
+      Tines::Gemm<Trans::NoTranspose, Trans::Transpose>::invoke(
+        member, one, QH, Q, zero, QHQt);
+      compare("Hessenberg Blocked Decompose", QHQt, B);
+    }
+  }
+  Kokkos::finalize();
+  return 0;
+}
@@ -94,6 +94,59 @@ int main(int argc, char **argv) {
                   << "\n\n";
       }
     }
+
+#if defined(TINES_TEST_VIEW_INTERFACE)
+    /// register blocked kernel; tile remainders and strided/transposed
+    /// operands are compared against a reference triple loop
+    {
+      const int mm = 37, nn = 29, kk = 23;
+      Kokkos::View<real_type **, Kokkos::LayoutRight, host_device_type> AA(
+        "AA", mm, kk), BB("BB", kk, nn), CC("CC", mm, nn), RR("RR", mm, nn);
+      Kokkos::View<real_type **, Kokkos::LayoutLeft, host_device_type> BL(
+        "BL", kk, nn);
+      Kokkos::fill_random(AA, random, real_type(1.0));
+      Kokkos::fill_random(BB, random, real_type(1.0));
+      Tines::Copy::invoke(member, BB, BL);
+
+      const real_type alpha(1.5), beta(0.5);
+      auto check = [&](const std::string &label) {
+        real_type err(0), norm(0);
+        for (int i = 0; i < mm; ++i)
+          for (int j = 0; j < nn; ++j) {
+            const real_type diff = ats::abs(CC(i, j) - RR(i, j));
+            err += diff * diff;
+            norm += RR(i, j) * RR(i, j);
+          }
+        const real_type rel_err = ats::sqrt(err / norm);
+        const real_type margin = 100, threshold = ats::epsilon() * margin;
+        if (rel_err < threshold) {
+          std::cout << "PASS Gemm " << label << " " << rel_err << "\n\n";
+        } else {
+          std::cout << "FAIL Gemm " << label << " " << rel_err << "\n\n";
+        }
+      };
+      auto reference = [&]() {
+        Kokkos::fill_random(CC, random, real_type(1.0));
+        for (int i = 0; i < mm; ++i)
+          for (int j = 0; j < nn; ++j) {
+            real_type tmp(0);
+            for (int p = 0; p < kk; ++p)
+              tmp += AA(i, p) * BB(p, j);
+            RR(i, j) = beta * CC(i, j) + alpha * tmp;
+          }
+      };
+
+      reference();
+      Tines::Gemm<Trans::NoTranspose, Trans::NoTranspose>::invoke(
+        member, alpha, AA, BB, beta, CC);
+      check("Register Blocked (LayoutRight B)");
+
+      reference();
+      Tines::Gemm<Trans::NoTranspose, Trans::NoTranspose>::invoke(
+        member, alpha, AA, BL, beta, CC);
+      check("Register Blocked (LayoutLeft B)");
+    }
+#endif
   }
   Kokkos::finalize();
 
@@ -0,0 +1,141 @@
+/*----------------------------------------------------------------------------------
+Tines - Time Integrator, Newton and Eigen Solver -  version 1.0
+Copyright (2021) NTESS
+https://github.com/sandialabs/Tines
+
+Copyright 2021 National Technology & Engineering Solutions of Sandia, LLC (NTESS). 
+Under the terms of Contract DE-NA0003525 with NTESS, the U.S. Government retains 
+certain rights in this software.
+
+This file is part of Tines. Tines is open-source software: you can redistribute it
+and/or modify it under the terms of BSD 2-Clause License
+(https://opensource.org/licenses/BSD-2-Clause). A copy of the license is also
+provided under the main directory
+Questions? Kyungjoo Kim <kyukim@sandia.gov>, or
+	   Oscar Diaz-Ibarra at <odiazib@sandia.gov>, or
+	   Cosmin Safta at <csafta@sandia.gov>, or
+	   Habib Najm at <hnnajm@sandia.gov>
+
+Sandia National Laboratories, New Mexico, USA
+----------------------------------------------------------------------------------*/
+#include "Tines.hpp"
+
+int main(int argc, char **argv) {
+  Kokkos::initialize(argc, argv);
+  {
+    using real_type = double;
+
+    using exec_space = Kokkos::DefaultExecutionSpace;
+    using device_type = typename Tines::UseThisDevice<exec_space>::type;
+
+    exec_space::print_configuration(std::cout, false);
+
+    using ats = Tines::ats<real_type>;
+    using interleaved_type = Tines::InterleavedDevice<exec_space>;
+    constexpr int N = interleaved_type::vector_length;
+
+    /// np is not a multiple of the vector length to exercise padded lanes
+    const int np = 10 * N + 3, m = 7;
+    const int npack = interleaved_type::getNumberOfPacks(np);
+    std::cout << "np " << np << " m " << m << " vector length " << N
+              << " npack " << npack << "\n";
+
+    Tines::value_type_3d_view<real_type, device_type> A("A", np, m, m);
+    Tines::value_type_2d_view<real_type, device_type> x("x", np, m);
+    Tines::value_type_2d_view<real_type, device_type> b("b", np, m);
+    Tines::value_type_2d_view<real_type, device_type> y("y", np, m);
+
+    Tines::value_type_4d_view<real_type, device_type> Ai("Ai", npack, m, m, N);
+    Tines::value_type_3d_view<real_type, device_type> xi("xi", npack, m, N);
+    Tines::value_type_3d_view<real_type, device_type> bi("bi", npack, m, N);
+    Tines::value_type_3d_view<real_type, device_type> ti("ti", npack, m, N);
+    Tines::value_type_3d_view<int, device_type> pi("pi", npack, m, N);
+
+    Kokkos::Random_XorShift64_Pool<device_type> random(13718);
+    Kokkos::fill_random(A, random, real_type(1.0));
+    Kokkos::fill_random(x, random, real_type(1.0));
+
+    const real_type one(1), zero(0);
+    const auto exec = exec_space();
+
+    /// b = A x with the interleaved gemv, validated against a plain loop
+    interleaved_type::pack(exec, A, Ai);
+    interleaved_type::pack(exec, x, xi);
+    interleaved_type::gemv(exec, one, Ai, xi, zero, bi);
+    interleaved_type::unpack(exec, bi, b);
+    Kokkos::fence();
+
+    const auto A_host =
+      Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(), A);
+    const auto x_host =
+      Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(), x);
+    const auto b_host =
+      Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(), b);
+
+    const real_type margin = 1e4, threshold = ats::epsilon() * margin;
+    std::cout << "This test is validated against a threshold " << threshold
+              << "\n";
+    {
+      real_type err(0), norm(0);
+      for (int p = 0; p < np; ++p)
+        for (int i = 0; i < m; ++i) {
+          real_type val(0);
+          for (int j = 0; j < m; ++j)
+            val += A_host(p, i, j) * x_host(p, j);
+          const real_type diff = ats::abs(val - b_host(p, i));
+          err += diff * diff;
+          norm += val * val;
+        }
+      const real_type rel_err = ats::sqrt(err / norm);
+      if (rel_err < threshold) {
+        std::cout << "PASS Interleaved Gemv " << rel_err << "\n";
+      } else {
+        std::cout << "FAIL Interleaved Gemv " << rel_err << "\n";
+      }
+    }
+
+    /// solve A y = b and compare y against x; the padded lanes solve an
+    /// identity system and must not produce nan
+    auto check_solution = [&](const std::string &label) {
+      interleaved_type::unpack(exec, bi, y);
+      Kokkos::fence();
+      const auto y_host =
+        Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(), y);
+      const auto bi_host =
+        Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(), bi);
+
+      real_type err(0), norm(0);
+      for (int p = 0; p < np; ++p)
+        for (int i = 0; i < m; ++i) {
+          const real_type diff = ats::abs(y_host(p, i) - x_host(p, i));
+          err += diff * diff;
+          norm += x_host(p, i) * x_host(p, i);
+        }
+      bool padded_is_finite(true);
+      for (int s = np; s < npack * N; ++s)
+        for (int i = 0; i < m; ++i)
+          padded_is_finite &= std::isfinite(bi_host(s / N, i, s % N));
+
+      const real_type rel_err = ats::sqrt(err / norm);
+      if (rel_err < threshold && padded_is_finite) {
+        std::cout << "PASS Interleaved " << label << " " << rel_err << "\n";
+      } else {
+        std::cout << "FAIL Interleaved " << label << " " << rel_err
+                  << (padded_is_finite ? "" : " (padded lanes are not finite)")
+                  << "\n";
+      }
+    };
+
+    interleaved_type::pack(exec, A, Ai);
+    interleaved_type::pack(exec, b, bi);
+    interleaved_type::solveLU(exec, Ai, pi, bi);
+    check_solution("SolveLU");
+
+    interleaved_type::pack(exec, A, Ai);
+    interleaved_type::pack(exec, b, bi);
+    interleaved_type::solveQR(exec, Ai, ti, bi);
+    check_solution("SolveQR");
+  }
+  Kokkos::finalize();
+  return 0;
+}
@@ -0,0 +1,189 @@
+/*----------------------------------------------------------------------------------
+Tines - Time Integrator, Newton and Eigen Solver -  version 1.0
+Copyright (2021) NTESS
+https://github.com/sandialabs/Tines
+
+Copyright 2021 National Technology & Engineering Solutions of Sandia, LLC (NTESS). 
+Under the terms of Contract DE-NA0003525 with NTESS, the U.S. Government retains 
+certain rights in this software.
+
+This file is part of Tines. Tines is open-source software: you can redistribute it
+and/or modify it under the terms of BSD 2-Clause License
+(https://opensource.org/licenses/BSD-2-Clause). A copy of the license is also
+provided under the main directory
+Questions? Kyungjoo Kim <kyukim@sandia.gov>, or
+	   Oscar Diaz-Ibarra at <odiazib@sandia.gov>, or
+	   Cosmin Safta at <csafta@sandia.gov>, or
+	   Habib Najm at <hnnajm@sandia.gov>
+
+Sandia National Laboratories, New Mexico, USA
+----------------------------------------------------------------------------------*/
+#include "Tines.hpp"
+
+int main(int argc, char **argv) {
+  Kokkos::initialize(argc, argv);
+  {
+    using real_type = double;
+
+    using host_exec_space = Kokkos::DefaultHostExecutionSpace;
+    using host_memory_space = Kokkos::HostSpace;
+    using host_device_type = Kokkos::Device<host_exec_space, host_memory_space>;
+
+    using ats = Tines::ats<real_type>;
+    using Trans = Tines::Trans;
+    using Uplo = Tines::Uplo;
+
+    using real_type_1d_view_type =
+      Kokkos::View<real_type *, Kokkos::LayoutRight, host_device_type>;
+    using real_type_2d_view_type =
+      Kokkos::View<real_type **, Kokkos::LayoutRight, host_device_type>;
+    using int_type_1d_view_type =
+      Kokkos::View<int *, Kokkos::LayoutRight, host_device_type>;
+
+    /// matrix sizes must be larger than the multishift threshold
+    std::vector<int> sizes = {TINES_SCHUR_MULTISHIFT_MIN_SIZE + 20, 150, 254};
+    if (argc == 2)
+      sizes = std::vector<int>(1, std::atoi(argv[1]));
+
+    const real_type one(1), zero(0);
+    const auto member = Tines::HostSerialTeamMember();
+    Kokkos::Random_XorShift64_Pool<host_device_type> random(13718);
+
+    for (const int m : sizes) {
+      real_type_2d_view_type A("A", m, m), B("B", m, m), Q("Q", m, m),
+        QQ("QQ", m, m);
+      real_type_2d_view_type Ab("Ab", m, m), Qb("Qb", m, m);
+      real_type_1d_view_type er("er", m), ei("ei", m), erb("erb", m),
+        eib("eib", m);
+      int_type_1d_view_type b("b", m), bb("bb", m);
+
+      int wlen(0);
+      Tines::Schur::workspace(A, wlen);
+      real_type_1d_view_type w("w", wlen);
+      std::cout << "Schur m = " << m << ", multishift workspace = " << wlen
+                << "\n";
+
+      Kokkos::fill_random(A, random, real_type(1.0));
+      Tines::SetTriangularMatrix<Uplo::Lower>::invoke(member, 2, zero, A);
+      Tines::Copy::invoke(member, A, B);
+
+      /// power sums of eigenvalues, trace(A) and trace(A^2)
+      real_type tr1(0), tr2(0), norm_a(0);
+      for (int i = 0; i < m; ++i) {
+        tr1 += A(i, i);
+        for (int j = 0; j < m; ++j) {
+          tr2 += A(i, j) * A(j, i);
+          norm_a += A(i, j) * A(i, j);
+        }
+      }
+      Tines::Copy::invoke(member, A, Ab);
+      Tines::SetIdentityMatrix::invoke(member, Q);
+      Tines::SetIdentityMatrix::invoke(member, Qb);
+
+      /// reference; francis double shift
+      Kokkos::Timer timer;
+      const int r_val_b = Tines::Schur::invoke(member, Ab, Qb, erb, eib, bb);
+      const real_type t_b = timer.seconds();
+
+      /// A = Q T Q^H with multishift QR and aggressive early deflation
+      timer.reset();
+      const int r_val = Tines::Schur::invoke(member, A, Q, er, ei, b, w);
+      const real_type t_ms = timer.seconds();
+      std::cout << "  time double shift " << t_b << " multishift " << t_ms
+                << "\n";
+      if (r_val != 0 || r_val_b != 0) {
+        std::cout << "FAIL Schur MultiShift does not converge " << r_val << " "
+                  << r_val_b << "\n";
+        continue;
+      }
+
+      /// QQ = Q Q'
+      Tines::Gemm<Trans::NoTranspose, Trans::Transpose>::invoke(member, one, Q,
+                                                                Q, zero, QQ);
+      {
+        real_type err(0);
+        for (int i = 0; i < m; ++i)
+          for (int j = 0; j < m; ++j) {
+            const real_type diff = ats::abs(QQ(i, j) - (i == j ? one : zero));
+            err += diff * diff;
+          }
+        const real_type rel_err = ats::sqrt(err / m);
+        const real_type threshold = ats::epsilon() * 100;
+        if (rel_err < threshold) {
+          std::cout << "PASS Schur MultiShift Q Orthogonality " << rel_err
+                    << "\n";
+        } else {
+          std::cout << "FAIL Schur MultiShift Q Orthogonality " << rel_err
+                    << "\n";
+        }
+      }
+
+      /// T is quasi upper triangular and 2x2 blocks hold complex pairs
+      {
+        bool is_valid(true);
+        for (int i = 0; i < m; ++i)
+          for (int j = 0; j < i; ++j) {
+            const bool is_block = (j == i - 1) && b(j) == -2;
+            if (!is_block && A(i, j) != zero)
+              is_valid = false;
+          }
+        for (int i = 0; i < m; ++i) {
+          if (b(i) == -2)
+            is_valid &= (ei(i) > zero && ei(i + 1) == -ei(i) && b(i + 1) == 0);
+          else if (b(i) == 1)
+            is_valid &= (ei(i) == zero && A(i, i) == er(i));
+        }
+        if (is_valid) {
+          std::cout << "PASS Schur MultiShift quasi triangular form\n";
+        } else {
+          std::cout << "FAIL Schur MultiShift quasi triangular form\n";
+        }
+      }
+
+      /// B = A - QTQ^H
+      {
+        real_type norm(0);
+        for (int i = 0; i < m; ++i)
+          for (int j = 0; j < m; ++j)
+            norm += B(i, j) * B(i, j);
+        Tines::Gemm<Trans::NoTranspose, Trans::NoTranspose>::invoke(
+          member, one, Q, A, zero, QQ);
+        Tines::Gemm<Trans::NoTranspose, Trans::Transpose>::invoke(
+          member, -one, QQ, Q, one, B);
+        real_type err(0);
+        for (int i = 0; i < m; ++i)
+          for (int j = 0; j < m; ++j)
+            err += B(i, j) * B(i, j);
+        const real_type rel_err = ats::sqrt(err / norm);
+        const real_type threshold = ats::epsilon() * 100 * m;
+        if (rel_err < threshold) {
+          std::cout << "PASS Schur MultiShift " << rel_err << "\n";
+        } else {
+          std::cout << "FAIL Schur MultiShift " << rel_err << "\n";
+        }
+      }
+
+      /// eigenvalues of a random matrix are ill conditioned; check the well
+      /// conditioned power sums instead
+      {
+        real_type s1(0), s2(0);
+        for (int i = 0; i < m; ++i) {
+          s1 += er(i);
+          s2 += er(i) * er(i) - ei(i) * ei(i);
+        }
+        const real_type rel_err =
+          (ats::abs(s1 - tr1) * ats::sqrt(norm_a) + ats::abs(s2 - tr2)) /
+          norm_a;
+        const real_type threshold = ats::epsilon() * 100 * m;
+        if (rel_err < threshold) {
+          std::cout << "PASS Schur MultiShift eigenvalues " << rel_err << "\n\n";
+        } else {
+          std::cout << "FAIL Schur MultiShift eigenvalues " << rel_err
+                    << "\n\n";
+        }
+      }
+    }
+  }
+  Kokkos::finalize();
+  return 0;
+}
@@ -81,6 +81,11 @@ int main(int argc, char **argv) {
     }
     Tines::showMatrix("Ac", Ac);
 
+    /// keep another copy for the eigenvalues only solve
+    Kokkos::View<real_type **, Kokkos::LayoutRight, host_device_type> B("B", m,
+                                                                        m);
+    Tines::Copy::invoke(member, A, B);
+
     /// A = V^{-1} S V
 #if defined(TINES_TEST_VIEW_INTERFACE)
     Tines::SolveEigenvaluesNonSymmetricProblem::invoke(member, A, er, ei, V, W);
@@ -119,6 +124,168 @@ int main(int argc, char **argv) {
         std::cout << "FAIL Right Eigen pairs " << rel_err << "\n";
       }
     }
+
+    /// left and right eigenvectors; UL^H A = eig UL^H and UL^H UR = I
+    {
+      Kokkos::View<real_type **, Kokkos::LayoutRight, host_device_type> C(
+        "C", m, m), UL("UL", m, m), UR("UR", m, m);
+      Kokkos::View<complex_type **, Kokkos::LayoutRight, host_device_type> ULc(
+        "ULc", m, m), URc("URc", m, m);
+      {
+        auto Ac_real = Kokkos::subview(Ar, Kokkos::ALL(), Kokkos::ALL(), 0);
+        Tines::Copy::invoke(member, Ac_real, C);
+      }
+      Tines::SolveEigenvaluesNonSymmetricProblem::invoke(member, C, er, ei, UL,
+                                                         UR, W);
+      Tines::EigendecompositionToComplex::invoke(member, er, ei, UL, ec, ULc);
+      Tines::EigendecompositionToComplex::invoke(member, er, ei, UR, ec, URc);
+
+      /// biorthogonality; the eigenvalues are well separated for this matrix
+      {
+        real_type err(0);
+        for (int i = 0; i < m; ++i)
+          for (int j = 0; j < m; ++j) {
+            complex_type g(0);
+            for (int k = 0; k < m; ++k)
+              g += atsc::conj(ULc(k, i)) * URc(k, j);
+            const complex_type diff = g - complex_type(i == j ? 1 : 0);
+            err += diff.real() * diff.real() + diff.imag() * diff.imag();
+          }
+        const real_type rel_err = ats::sqrt(err / m);
+        const real_type margin = 1e6, threshold = ats::epsilon() * margin;
+        if (rel_err < threshold) {
+          std::cout << "PASS Biorthogonal Eigen vectors " << rel_err << "\n";
+        } else {
+          std::cout << "FAIL Biorthogonal Eigen vectors " << rel_err << "\n";
+        }
+      }
+
+      /// left eigen pairs; ULc is overwritten
+      {
+        real_type rel_err(0);
+        Tines::EigendecompositionValidateLeftEigenPairs::invoke(
+          member, Ac, ec, ULc, Rc, rel_err);
+        const real_type margin = 1e6, threshold = ats::epsilon() * margin;
+        if (rel_err < threshold) {
+          std::cout << "PASS Left Eigen pairs " << rel_err << "\n";
+        } else {
+          std::cout << "FAIL Left Eigen pairs " << rel_err << "\n";
+        }
+      }
+    }
+
+    /// selected eigenvectors only; residuals of the selected eigen pairs
+    {
+      Kokkos::View<real_type **, Kokkos::LayoutRight, host_device_type> C(
+        "C", m, m), U("U", m, m);
+      Kokkos::View<int *, Kokkos::LayoutRight, host_device_type> sel("sel", m);
+      auto check = [&](const std::string &label, const auto &select) {
+        auto Ac_real = Kokkos::subview(Ar, Kokkos::ALL(), Kokkos::ALL(), 0);
+        Tines::Copy::invoke(member, Ac_real, C);
+        int nsel(0);
+        Tines::SolveEigenvaluesNonSymmetricProblem::invoke(
+          member, C, er, ei, select, sel, nsel, U, W);
+
+        real_type err(0), norm(0);
+        for (int i = 0; i < m; ++i)
+          for (int j = 0; j < m; ++j)
+            norm += Ac_real(i, j) * Ac_real(i, j);
+        for (int k = 0; k < nsel; ++k) {
+          const int l = sel(k);
+          const bool is_complex = ei(l) != real_type(0);
+          const complex_type lambda(er(l), ei(l));
+          for (int i = 0; i < m; ++i) {
+            complex_type r(0);
+            for (int j = 0; j < m; ++j) {
+              const complex_type v =
+                is_complex ? complex_type(U(j, k), U(j, k + 1)) : U(j, k);
+              r += Ac_real(i, j) * v;
+            }
+            const complex_type v =
+              is_complex ? complex_type(U(i, k), U(i, k + 1)) : U(i, k);
+            r -= lambda * v;
+            err += r.real() * r.real() + r.imag() * r.imag();
+          }
+          k += is_complex;
+        }
+        const real_type rel_err = ats::sqrt(err / norm);
+        const real_type margin = 1e6, threshold = ats::epsilon() * margin;
+        if (nsel > 0 && rel_err < threshold) {
+          std::cout << "PASS Selected Right Eigen pairs (" << label
+                    << ") nsel = " << nsel << ", " << rel_err << "\n";
+        } else {
+          std::cout << "FAIL Selected Right Eigen pairs (" << label
+                    << ") nsel = " << nsel << ", " << rel_err << "\n";
+        }
+        return nsel;
+      };
+
+      /// top-3 by real part; no unselected eigenvalue has a larger real part
+      {
+        const int nsel = check("largest real part",
+                               Tines::EigenvalueSelectLargestRealPart(3));
+        real_type min_sel(0), max_rest(0);
+        for (int i = 0; i < m; ++i) {
+          bool is_selected(false);
+          for (int k = 0; k < nsel; ++k)
+            is_selected |= (sel(k) == i);
+          if (is_selected)
+            min_sel = (min_sel == 0 || er(i) < min_sel) ? er(i) : min_sel;
+          else
+            max_rest = (max_rest == 0 || er(i) > max_rest) ? er(i) : max_rest;
+        }
+        if (nsel >= 3 && nsel <= 4 && min_sel >= max_rest) {
+          std::cout << "PASS Selected eigenvalues (largest real part)\n";
+        } else {
+          std::cout << "FAIL Selected eigenvalues (largest real part)\n";
+        }
+      }
+      check("magnitude", Tines::EigenvalueSelectMagnitudeAbove<real_type>(0.5));
+      {
+        const int idx[2] = {0, m - 1};
+        check("indices", Tines::EigenvalueSelectIndices(idx, 2));
+      }
+    }
+
+    /// eigenvalues only; compare with the eigenvalues from the eigen pairs
+    {
+      Kokkos::View<real_type **, Kokkos::LayoutRight, host_device_type> f(
+        "f", 2, m);
+      auto fr = Kokkos::subview(f, 0, Kokkos::ALL());
+      auto fi = Kokkos::subview(f, 1, Kokkos::ALL());
+      int wlen(0);
+      Tines::SolveEigenvaluesNonSymmetricProblem::workspace(B, wlen);
+      Kokkos::View<real_type *, Kokkos::LayoutRight, host_device_type> WW(
+        "WW", wlen);
+#if defined(TINES_TEST_VIEW_INTERFACE)
+      Tines::SolveEigenvaluesNonSymmetricProblem::invoke(member, B, fr, fi, WW);
+#elif defined(TINES_TEST_TPL_POINTER_INTERFACE)
+      Tines::SolveEigenvaluesNonSymmetricProblemWithoutEigenvectors_HostTPL(
+        m, B.data(), B.stride(0), B.stride(1), fr.data(), fi.data());
+#endif
+      Tines::showVector("fr", fr);
+      Tines::showVector("fi", fi);
+
+      real_type err(0), norm(0);
+      for (int i = 0; i < m; ++i) {
+        real_type dist(-1);
+        for (int j = 0; j < m; ++j) {
+          const real_type dr = fr(i) - er(j), di = fi(i) - ei(j),
+                          d = ats::sqrt(dr * dr + di * di);
+          dist = (dist < 0 || d < dist) ? d : dist;
+        }
+        err = dist > err ? dist : err;
+        const real_type e = ats::sqrt(er(i) * er(i) + ei(i) * ei(i));
+        norm = e > norm ? e : norm;
+      }
+      const real_type rel_err = err / norm;
+      const real_type margin = 1e6, threshold = ats::epsilon() * margin;
+      if (rel_err < threshold) {
+        std::cout << "PASS Eigenvalues only " << rel_err << "\n";
+      } else {
+        std::cout << "FAIL Eigenvalues only " << rel_err << "\n";
+      }
+    }
   }
   Kokkos::finalize();
 
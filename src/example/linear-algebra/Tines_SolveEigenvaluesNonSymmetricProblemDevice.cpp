@@ -69,6 +69,10 @@ int main(int argc, char **argv) {
       Kokkos::deep_copy(Ac_real, A_host);
     }
 
+    /// keep a copy for the eigenvalues only solve
+    Tines::value_type_3d_view<real_type, device_type> B("B", np, m, m);
+    Kokkos::deep_copy(B, A);
+
     /// A = V^{-1} S V
     double t_eigensolve(0);
     {
@@ -81,6 +85,25 @@ int main(int argc, char **argv) {
       printf("Time per problem %e\n", t_eigensolve / double(np));
     }
 
+    /// eigenvalues only
+    Tines::value_type_2d_view<real_type, device_type> fr("fr", np, m);
+    Tines::value_type_2d_view<real_type, device_type> fi("fi", np, m);
+    {
+      int wlen_eig(0);
+      Tines::SolveEigenvaluesNonSymmetricProblem::workspace(
+        Kokkos::subview(B, 0, Kokkos::ALL(), Kokkos::ALL()), wlen_eig);
+      Tines::value_type_2d_view<real_type, device_type> WW("WW", np, wlen_eig);
+
+      Kokkos::fence();
+      Kokkos::Impl::Timer timer;
+      Tines::SolveEigenvaluesNonSymmetricProblemDevice<exec_space>::invoke(
+        exec_space(), B, fr, fi, WW, use_tpl_if_avail);
+      Kokkos::fence();
+      const double t_eigenvalues = timer.seconds();
+      printf("Time per problem (eigenvalues only) %e\n",
+             t_eigenvalues / double(np));
+    }
+
     ///
     const real_type threshold = 1e-6; // ats::sqrt(ats::epsilon());
     std::cout << "This solver is tested against a threshold " << threshold
@@ -95,6 +118,10 @@ int main(int argc, char **argv) {
         Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(), ei);
       const auto V_host =
         Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(), V);
+      const auto fr_host =
+        Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(), fr);
+      const auto fi_host =
+        Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(), fi);
 
       const auto Ac_host =
         Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(), Ac);
@@ -124,6 +151,31 @@ int main(int argc, char **argv) {
           std::cout << "FAIL Right Eigen pairs " << err << " at problem (" << i
                     << ")\n";
         }
+
+        /// eigenvalues only solve finds the same eigenvalues
+        real_type err_eig(0), norm_eig(0);
+        for (int k = 0; k < m; ++k) {
+          real_type dist(-1);
+          for (int l = 0; l < m; ++l) {
+            const real_type dr = fr_host(i, k) - er_host(i, l),
+                            di = fi_host(i, k) - ei_host(i, l),
+                            d = ats::sqrt(dr * dr + di * di);
+            dist = (dist < 0 || d < dist) ? d : dist;
+          }
+          err_eig = dist > err_eig ? dist : err_eig;
+          const real_type e = ats::sqrt(er_host(i, k) * er_host(i, k) +
+                                        ei_host(i, k) * ei_host(i, k));
+          norm_eig = e > norm_eig ? e : norm_eig;
+        }
+        err_eig /= norm_eig;
+        if (err_eig < threshold) {
+          if (i <= 40)
+            std::cout << "PASS Eigenvalues only " << err_eig << " at problem ("
+                      << i << ")\n";
+        } else {
+          std::cout << "FAIL Eigenvalues only " << err_eig << " at problem ("
+                    << i << ")\n";
+        }
       }
     }
   }
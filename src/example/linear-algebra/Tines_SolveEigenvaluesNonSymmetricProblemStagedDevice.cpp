@@ -0,0 +1,210 @@
+/*----------------------------------------------------------------------------------
+Tines - Time Integrator, Newton and Eigen Solver -  version 1.0
+Copyright (2021) NTESS
+https://github.com/sandialabs/Tines
+
+Copyright 2021 National Technology & Engineering Solutions of Sandia, LLC (NTESS). 
+Under the terms of Contract DE-NA0003525 with NTESS, the U.S. Government retains 
+certain rights in this software.
+
+This file is part of Tines. Tines is open-source software: you can redistribute it
+and/or modify it under the terms of BSD 2-Clause License
+(https://opensource.org/licenses/BSD-2-Clause). A copy of the license is also
+provided under the main directory
+Questions? Kyungjoo Kim <kyukim@sandia.gov>, or
+	   Oscar Diaz-Ibarra at <odiazib@sandia.gov>, or
+	   Cosmin Safta at <csafta@sandia.gov>, or
+	   Habib Najm at <hnnajm@sandia.gov>
+
+Sandia National Laboratories, New Mexico, USA
+----------------------------------------------------------------------------------*/
+#include "Tines.hpp"
+
+int main(int argc, char **argv) {
+  Kokkos::initialize(argc, argv);
+  {
+    using real_type = double;
+    using complex_type = Kokkos::complex<real_type>;
+
+    using exec_space = Kokkos::DefaultExecutionSpace;
+    using device_type = typename Tines::UseThisDevice<exec_space>::type;
+
+    using host_exec_space = Kokkos::DefaultHostExecutionSpace;
+    using host_device_type =
+      typename Tines::UseThisDevice<host_exec_space>::type;
+
+    using staged_type =
+      Tines::SolveEigenvaluesNonSymmetricProblemStagedDevice<exec_space>;
+
+    exec_space::print_configuration(std::cout, false);
+
+    int np = 20, m = 60;
+    if (argc == 3) {
+      np = std::atoi(argv[1]);
+      m = std::atoi(argv[2]);
+    }
+    printf("Testing np %d, m %d\n", np, m);
+
+    Tines::value_type_3d_view<real_type, device_type> A("A", np, m, m);
+    Tines::value_type_3d_view<real_type, device_type> B("B", np, m, m);
+    Tines::value_type_2d_view<real_type, device_type> er("er", np, m);
+    Tines::value_type_2d_view<real_type, device_type> ei("ei", np, m);
+    Tines::value_type_3d_view<real_type, device_type> V("V", np, m, m);
+
+    int wlen(0);
+    staged_type::workspace(m, wlen);
+    wlen = wlen > (3 * m * m + 2 * m) ? wlen : (3 * m * m + 2 * m);
+    Tines::value_type_2d_view<real_type, device_type> W("W", np, wlen);
+
+    /// validation on host
+    Tines::value_type_3d_view<complex_type, host_device_type> Ac("Ac", np, m,
+                                                                 m);
+    Tines::value_type_1d_view<complex_type, host_device_type> ec("ec", m);
+    Tines::value_type_2d_view<complex_type, host_device_type> Vc("Vc", m, m);
+    Tines::value_type_2d_view<complex_type, host_device_type> Rc("Rc", m, m);
+
+    /// randomize matrices
+    Kokkos::Random_XorShift64_Pool<device_type> random(13718);
+    Kokkos::fill_random(B, random, real_type(1.0));
+    {
+      auto B_host = Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(), B);
+      for (int p = 0; p < np; ++p)
+        for (int i = 0; i < m; ++i)
+          for (int j = 0; j < m; ++j)
+            Ac(p, i, j) = complex_type(B_host(p, i, j), 0);
+    }
+
+    const real_type threshold = 1e-6;
+    const auto member = Tines::HostSerialTeamMember();
+    auto validate = [&](const std::string label, const int nfail) {
+      if (nfail > 0)
+        std::cout << "FAIL " << label << " QR iteration does not converge for "
+                  << nfail << " problems\n";
+      const auto er_host =
+        Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(), er);
+      const auto ei_host =
+        Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(), ei);
+      const auto V_host =
+        Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(), V);
+      real_type err_max(0);
+      for (int i = 0; i < np; ++i) {
+        Tines::EigendecompositionToComplex::invoke(
+          member, Kokkos::subview(er_host, i, Kokkos::ALL()),
+          Kokkos::subview(ei_host, i, Kokkos::ALL()),
+          Kokkos::subview(V_host, i, Kokkos::ALL(), Kokkos::ALL()), ec, Vc);
+        real_type err(0);
+        Tines::EigendecompositionValidateRightEigenPairs::invoke(
+          member, Kokkos::subview(Ac, i, Kokkos::ALL(), Kokkos::ALL()), ec, Vc,
+          Rc, err);
+        err_max = err > err_max ? err : err_max;
+      }
+      if (err_max < threshold) {
+        std::cout << "PASS " << label << " Right Eigen pairs " << err_max
+                  << "\n";
+      } else {
+        std::cout << "FAIL " << label << " Right Eigen pairs " << err_max
+                  << "\n";
+      }
+    };
+
+    /// the stages balance the matrices as the team solver does; each
+    /// eigenvalue matches one of the team solver's eigenvalues up to round off
+    Tines::value_type_2d_view<real_type, host_device_type> er_ref("er_ref", np,
+                                                                   m);
+    Tines::value_type_2d_view<real_type, host_device_type> ei_ref("ei_ref", np,
+                                                                   m);
+    auto compare = [&](const std::string label) {
+      const auto er_host =
+        Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(), er);
+      const auto ei_host =
+        Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(), ei);
+      real_type diff(0);
+      for (int p = 0; p < np; ++p) {
+        real_type scale(1);
+        for (int i = 0; i < m; ++i)
+          scale = std::max(scale, std::hypot(er_ref(p, i), ei_ref(p, i)));
+        for (int i = 0; i < m; ++i) {
+          real_type dist = std::hypot(er_host(p, i) - er_ref(p, 0),
+                                      ei_host(p, i) - ei_ref(p, 0));
+          for (int j = 1; j < m; ++j)
+            dist = std::min(dist, std::hypot(er_host(p, i) - er_ref(p, j),
+                                             ei_host(p, i) - ei_ref(p, j)));
+          diff = std::max(diff, dist / scale);
+        }
+      }
+      if (diff < threshold) {
+        std::cout << "PASS " << label << " Eigenvalues agree with Default "
+                  << diff << "\n";
+      } else {
+        std::cout << "FAIL " << label << " Eigenvalues differ from Default "
+                  << diff << "\n";
+      }
+    };
+
+    auto run = [&](const std::string prefix) {
+      /// team solver; a team solves a whole problem
+      {
+        Kokkos::deep_copy(A, B);
+        Kokkos::fence();
+        Kokkos::Impl::Timer timer;
+        const int nfail =
+          Tines::SolveEigenvaluesNonSymmetricProblemDevice<exec_space>::invoke(
+            exec_space(), A, er, ei, V, W);
+        Kokkos::fence();
+        const double t = timer.seconds();
+        printf("Time per problem (default) %e\n", t / double(np));
+        validate(prefix + "Default", nfail);
+        Kokkos::deep_copy(er_ref, er);
+        Kokkos::deep_copy(ei_ref, ei);
+      }
+
+      /// batched stages resident on device
+      {
+        Kokkos::deep_copy(A, B);
+        Kokkos::fence();
+        Kokkos::Impl::Timer timer;
+        const int nfail = staged_type::invoke(exec_space(), A, er, ei, V, W);
+        Kokkos::fence();
+        const double t = timer.seconds();
+        printf("Time per problem (staged, schur on device) %e\n",
+               t / double(np));
+        validate(prefix + "Staged Schur on device", nfail);
+        compare(prefix + "Staged Schur on device");
+      }
+
+      /// batched stages with the Schur decomposition on host
+      {
+        Kokkos::deep_copy(A, B);
+        Kokkos::fence();
+        Kokkos::Impl::Timer timer;
+        const bool schur_on_host = true;
+        const int nfail =
+          staged_type::invoke(exec_space(), A, er, ei, V, W, schur_on_host);
+        Kokkos::fence();
+        const double t = timer.seconds();
+        printf("Time per problem (staged, schur on host) %e\n",
+               t / double(np));
+        validate(prefix + "Staged Schur on host", nfail);
+        compare(prefix + "Staged Schur on host");
+      }
+    };
+    run("");
+
+    /// graded matrices, A := D A D^{-1} with D = diag(10^(16i/m)), whose
+    /// eigenvectors are inaccurate without balancing
+    {
+      auto B_host = Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(), B);
+      for (int p = 0; p < np; ++p)
+        for (int i = 0; i < m; ++i)
+          for (int j = 0; j < m; ++j) {
+            B_host(p, i, j) *= std::pow(10.0, 16.0 * real_type(i - j) / m);
+            Ac(p, i, j) = complex_type(B_host(p, i, j), 0);
+          }
+      Kokkos::deep_copy(B, B_host);
+    }
+    run("Graded ");
+  }
+  Kokkos::finalize();
+
+  return 0;
+}
@@ -0,0 +1,187 @@
+/*----------------------------------------------------------------------------------
+Tines - Time Integrator, Newton and Eigen Solver -  version 1.0
+Copyright (2021) NTESS
+https://github.com/sandialabs/Tines
+
+Copyright 2021 National Technology & Engineering Solutions of Sandia, LLC (NTESS). 
+Under the terms of Contract DE-NA0003525 with NTESS, the U.S. Government retains 
+certain rights in this software.
+
+This file is part of Tines. Tines is open-source software: you can redistribute it
+and/or modify it under the terms of BSD 2-Clause License
+(https://opensource.org/licenses/BSD-2-Clause). A copy of the license is also
+provided under the main directory
+Questions? Kyungjoo Kim <kyukim@sandia.gov>, or
+	   Oscar Diaz-Ibarra at <odiazib@sandia.gov>, or
+	   Cosmin Safta at <csafta@sandia.gov>, or
+	   Habib Najm at <hnnajm@sandia.gov>
+
+Sandia National Laboratories, New Mexico, USA
+----------------------------------------------------------------------------------*/
+#include "Tines.hpp"
+
+int main(int argc, char **argv) {
+#if defined(TINES_TEST_VIEW_INTERFACE)
+  std::cout << "SolveEigenvaluesSymmetricProblem testing View interface\n";
+#elif defined(TINES_TEST_TPL_POINTER_INTERFACE)
+  std::cout << "SolveEigenvaluesSymmetricProblem testing Pointer interface\n";
+#else
+  throw std::logic_error("Error: TEST macro is not defined");
+#endif
+
+  Kokkos::initialize(argc, argv);
+  {
+    using real_type = double;
+
+    using host_exec_space = Kokkos::DefaultHostExecutionSpace;
+    using host_memory_space = Kokkos::HostSpace;
+    using host_device_type = Kokkos::Device<host_exec_space, host_memory_space>;
+
+    using ats = Tines::ats<real_type>;
+    using real_type_1d_view_type =
+      Kokkos::View<real_type *, Kokkos::LayoutRight, host_device_type>;
+    using real_type_2d_view_type =
+      Kokkos::View<real_type **, Kokkos::LayoutRight, host_device_type>;
+
+    const auto member = Tines::HostSerialTeamMember();
+    Kokkos::Random_XorShift64_Pool<host_device_type> random(13718);
+
+    const real_type margin = 1e6, threshold = ats::epsilon() * margin;
+    auto check = [&](const std::string &label, const real_type err) {
+      if (err < threshold) {
+        std::cout << "PASS " << label << " " << err << "\n";
+      } else {
+        std::cout << "FAIL " << label << " " << err << "\n";
+      }
+    };
+
+    const int msizes[3] = {10, 40, 150};
+    for (const int m : msizes) {
+      std::cout << "Testing m " << m << "\n";
+      real_type_2d_view_type A("A", m, m), B("B", m, m), V("V", m, m);
+      real_type_1d_view_type e("e", m), f("f", m);
+
+      int wlen(0);
+      Tines::SolveEigenvaluesSymmetricProblem::workspace(A, wlen);
+      real_type_1d_view_type W("W", wlen);
+
+      /// random symmetric matrix B = (R + R^T)/2
+      Kokkos::fill_random(B, random, real_type(1.0));
+      for (int i = 0; i < m; ++i)
+        for (int j = 0; j < i; ++j)
+          B(i, j) = B(j, i) = (B(i, j) + B(j, i)) / real_type(2);
+      if (m == 10)
+        Tines::showMatrix("B", B);
+
+      /// A = V diag(e) V^T
+      Tines::Copy::invoke(member, B, A);
+#if defined(TINES_TEST_VIEW_INTERFACE)
+      Tines::SolveEigenvaluesSymmetricProblem::invoke(member, A, e, V, W);
+#elif defined(TINES_TEST_TPL_POINTER_INTERFACE)
+      {
+        const int mm = A.extent(0);
+        real_type *Aptr = A.data(), *eptr = e.data(), *Vptr = V.data();
+        const int as0 = A.stride(0), as1 = A.stride(1), vs0 = V.stride(0),
+                  vs1 = V.stride(1);
+        Tines::SolveEigenvaluesSymmetricProblem_HostTPL(mm, Aptr, as0, as1,
+                                                        eptr, Vptr, vs0, vs1);
+      }
+#endif
+      if (m == 10) {
+        Tines::showVector("e", e);
+        Tines::showMatrix("V", V);
+      }
+
+      real_type norm(0);
+      for (int i = 0; i < m; ++i)
+        for (int j = 0; j < m; ++j)
+          norm += B(i, j) * B(i, j);
+      norm = ats::sqrt(norm);
+
+      /// check B V - V diag(e)
+      {
+        real_type err(0);
+        for (int i = 0; i < m; ++i)
+          for (int j = 0; j < m; ++j) {
+            real_type r(-V(i, j) * e(j));
+            for (int k = 0; k < m; ++k)
+              r += B(i, k) * V(k, j);
+            err += r * r;
+          }
+        check("Eigen pairs", ats::sqrt(err) / norm);
+      }
+
+      /// check V^T V - I
+      {
+        real_type err(0);
+        for (int i = 0; i < m; ++i)
+          for (int j = 0; j < m; ++j) {
+            real_type g(i == j ? -1 : 0);
+            for (int k = 0; k < m; ++k)
+              g += V(k, i) * V(k, j);
+            err += g * g;
+          }
+        check("Orthonormal Eigen vectors", ats::sqrt(err / m));
+      }
+
+      /// eigenvalues are sorted in ascending order
+      {
+        bool is_sorted(true);
+        for (int i = 1; i < m; ++i)
+          is_sorted &= e(i - 1) <= e(i);
+        if (is_sorted)
+          std::cout << "PASS Ascending Eigen values\n";
+        else
+          std::cout << "FAIL Ascending Eigen values\n";
+      }
+
+      /// eigenvalues only
+      {
+        Tines::Copy::invoke(member, B, A);
+#if defined(TINES_TEST_VIEW_INTERFACE)
+        Tines::SolveEigenvaluesSymmetricProblem::invoke(member, A, f, W);
+#elif defined(TINES_TEST_TPL_POINTER_INTERFACE)
+        Tines::SolveEigenvaluesSymmetricProblemWithoutEigenvectors_HostTPL(
+          m, A.data(), A.stride(0), A.stride(1), f.data());
+#endif
+        real_type err(0);
+        for (int i = 0; i < m; ++i)
+          err += (e(i) - f(i)) * (e(i) - f(i));
+        check("Eigen values only", ats::sqrt(err) / norm);
+      }
+
+      /// native team implementation against the solution above
+      {
+        real_type_2d_view_type U("U", m, m);
+        Tines::Copy::invoke(member, B, A);
+        const int r_val =
+          Tines::SolveEigenvaluesSymmetricProblem::device_invoke(member, A, f,
+                                                                 U, W);
+        if (r_val != 0)
+          std::cout << "FAIL QL iteration does not converge\n";
+
+        real_type err(0);
+        for (int i = 0; i < m; ++i)
+          err += (e(i) - f(i)) * (e(i) - f(i));
+        check("Device Eigen values", ats::sqrt(err) / norm);
+
+        /// eigenvectors agree up to sign; this matrix has distinct eigenvalues
+        err = 0;
+        for (int j = 0; j < m; ++j) {
+          real_type d(0);
+          for (int i = 0; i < m; ++i)
+            d += U(i, j) * V(i, j);
+          const real_type s = d < 0 ? -1 : 1;
+          for (int i = 0; i < m; ++i) {
+            const real_type diff = U(i, j) - s * V(i, j);
+            err += diff * diff;
+          }
+        }
+        check("Device Eigen vectors", ats::sqrt(err / m));
+      }
+    }
+  }
+  Kokkos::finalize();
+
+  return 0;
+}
@@ -0,0 +1,134 @@
+/*----------------------------------------------------------------------------------
+Tines - Time Integrator, Newton and Eigen Solver -  version 1.0
+Copyright (2021) NTESS
+https://github.com/sandialabs/Tines
+
+Copyright 2021 National Technology & Engineering Solutions of Sandia, LLC (NTESS). 
+Under the terms of Contract DE-NA0003525 with NTESS, the U.S. Government retains 
+certain rights in this software.
+
+This file is part of Tines. Tines is open-source software: you can redistribute it
+and/or modify it under the terms of BSD 2-Clause License
+(https://opensource.org/licenses/BSD-2-Clause). A copy of the license is also
+provided under the main directory
+Questions? Kyungjoo Kim <kyukim@sandia.gov>, or
+	   Oscar Diaz-Ibarra at <odiazib@sandia.gov>, or
+	   Cosmin Safta at <csafta@sandia.gov>, or
+	   Habib Najm at <hnnajm@sandia.gov>
+
+Sandia National Laboratories, New Mexico, USA
+----------------------------------------------------------------------------------*/
+#include "Tines.hpp"
+
+int main(int argc, char **argv) {
+  Kokkos::initialize(argc, argv);
+  {
+    using real_type = double;
+
+    using exec_space = Kokkos::DefaultExecutionSpace;
+    using device_type = typename Tines::UseThisDevice<exec_space>::type;
+
+    using ats = Tines::ats<real_type>;
+
+    exec_space::print_configuration(std::cout, false);
+
+    int np = 20, m = 60;
+    if (argc == 3) {
+      np = std::atoi(argv[1]);
+      m = std::atoi(argv[2]);
+    }
+    printf("Testing np %d, m %d\n", np, m);
+
+    Tines::value_type_3d_view<real_type, device_type> A("A", np, m, m);
+    Tines::value_type_3d_view<real_type, device_type> B("B", np, m, m);
+    Tines::value_type_2d_view<real_type, device_type> e("e", np, m);
+    Tines::value_type_2d_view<real_type, device_type> ei("ei", np, m);
+    Tines::value_type_3d_view<real_type, device_type> V("V", np, m, m);
+
+    /// the workspace of the nonsymmetric solver is large enough for both
+    const int wlen = 3 * m * m + 2 * m;
+    Tines::value_type_2d_view<real_type, device_type> W("W", np, wlen);
+
+    /// random symmetric matrices
+    Kokkos::Random_XorShift64_Pool<device_type> random(13718);
+    Kokkos::fill_random(B, random, real_type(1.0));
+    Kokkos::parallel_for(
+      Kokkos::RangePolicy<exec_space>(0, np), KOKKOS_LAMBDA(const int &p) {
+        for (int i = 0; i < m; ++i)
+          for (int j = 0; j < i; ++j)
+            B(p, i, j) = B(p, j, i) = (B(p, i, j) + B(p, j, i)) / real_type(2);
+      });
+    Kokkos::fence();
+
+    /// symmetric solver
+    double t_sym(0);
+    {
+      Kokkos::deep_copy(A, B);
+      Kokkos::fence();
+      Kokkos::Impl::Timer timer;
+      const int nfail =
+        Tines::SolveEigenvaluesSymmetricProblemDevice<exec_space>::invoke(
+          exec_space(), A, e, V, W);
+      Kokkos::fence();
+      t_sym = timer.seconds();
+      printf("Time per problem (symmetric) %e\n", t_sym / double(np));
+      if (nfail > 0)
+        std::cout << "FAIL QL iteration does not converge for " << nfail
+                  << " problems\n";
+    }
+
+    /// validation on host; B V - V diag(e) and V^T V - I
+    {
+      const auto B_host =
+        Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(), B);
+      const auto e_host =
+        Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(), e);
+      const auto V_host =
+        Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(), V);
+      real_type err_pair(0), err_orth(0);
+      for (int p = 0; p < np; ++p) {
+        real_type norm(0), ep(0), eo(0);
+        for (int i = 0; i < m; ++i)
+          for (int j = 0; j < m; ++j) {
+            real_type r(-V_host(p, i, j) * e_host(p, j)), g(i == j ? -1 : 0);
+            for (int k = 0; k < m; ++k) {
+              r += B_host(p, i, k) * V_host(p, k, j);
+              g += V_host(p, k, i) * V_host(p, k, j);
+            }
+            norm += B_host(p, i, j) * B_host(p, i, j);
+            ep += r * r;
+            eo += g * g;
+          }
+        ep = ats::sqrt(ep / norm);
+        eo = ats::sqrt(eo / m);
+        err_pair = ep > err_pair ? ep : err_pair;
+        err_orth = eo > err_orth ? eo : err_orth;
+      }
+      const real_type margin = 1e6, threshold = ats::epsilon() * margin;
+      if (err_pair < threshold)
+        std::cout << "PASS Eigen pairs " << err_pair << "\n";
+      else
+        std::cout << "FAIL Eigen pairs " << err_pair << "\n";
+      if (err_orth < threshold)
+        std::cout << "PASS Orthonormal Eigen vectors " << err_orth << "\n";
+      else
+        std::cout << "FAIL Orthonormal Eigen vectors " << err_orth << "\n";
+    }
+
+    /// general solver on the same matrices for comparison
+    {
+      Kokkos::deep_copy(A, B);
+      Kokkos::fence();
+      Kokkos::Impl::Timer timer;
+      Tines::SolveEigenvaluesNonSymmetricProblemDevice<exec_space>::invoke(
+        exec_space(), A, e, ei, V, W);
+      Kokkos::fence();
+      const double t_nonsym = timer.seconds();
+      printf("Time per problem (nonsymmetric) %e, speedup %e\n",
+             t_nonsym / double(np), t_nonsym / t_sym);
+    }
+  }
+  Kokkos::finalize();
+
+  return 0;
+}
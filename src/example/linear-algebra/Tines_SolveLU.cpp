@@ -0,0 +1,218 @@
+/*----------------------------------------------------------------------------------
+Tines - Time Integrator, Newton and Eigen Solver -  version 1.0
+Copyright (2021) NTESS
+https://github.com/sandialabs/Tines
+
+Copyright 2021 National Technology & Engineering Solutions of Sandia, LLC (NTESS). 
+Under the terms of Contract DE-NA0003525 with NTESS, the U.S. Government retains 
+certain rights in this software.
+
+This file is part of Tines. Tines is open-source software: you can redistribute it
+and/or modify it under the terms of BSD 2-Clause License
+(https://opensource.org/licenses/BSD-2-Clause). A copy of the license is also
+provided under the main directory
+Questions? Kyungjoo Kim <kyukim@sandia.gov>, or
+	   Oscar Diaz-Ibarra at <odiazib@sandia.gov>, or
+	   Cosmin Safta at <csafta@sandia.gov>, or
+	   Habib Najm at <hnnajm@sandia.gov>
+
+Sandia National Laboratories, New Mexico, USA
+----------------------------------------------------------------------------------*/
+#include "Tines.hpp"
+
+int main(int argc, char **argv) {
+#if defined(TINES_TEST_VIEW_INTERFACE)
+  std::cout << "SolveLU testing View interface\n";
+#elif defined(TINES_TEST_TPL_POINTER_INTERFACE)
+  std::cout << "SolveLU testing Pointer interface\n";
+#else
+  throw std::logic_error("Error: TEST macro is not defined");
+#endif
+
+  Kokkos::initialize(argc, argv);
+  {
+    using real_type = double;
+
+    using host_exec_space = Kokkos::DefaultHostExecutionSpace;
+    using host_memory_space = Kokkos::HostSpace;
+    using host_device_type = Kokkos::Device<host_exec_space, host_memory_space>;
+
+    using ats = Tines::ats<real_type>;
+    using Trans = Tines::Trans;
+
+    const int m = 12, nrhs = 3;
+
+    Kokkos::View<real_type **, Kokkos::LayoutRight, host_device_type> A("A", m,
+                                                                        m);
+    Kokkos::View<real_type **, Kokkos::LayoutRight, host_device_type> Acopy(
+      "Acopy", m, m);
+    Kokkos::View<real_type **, Kokkos::LayoutRight, host_device_type> X(
+      "X", m, nrhs);
+    Kokkos::View<real_type **, Kokkos::LayoutRight, host_device_type> B(
+      "B", m, nrhs);
+    Kokkos::View<int *, Kokkos::LayoutRight, host_device_type> p("p", m);
+
+    const real_type one(1), zero(0);
+    const auto member = Tines::HostSerialTeamMember();
+
+    auto check_residual = [&](const std::string &label) {
+      real_type err(0), norm(0);
+      for (int k = 0; k < nrhs; ++k) {
+        for (int i = 0; i < m; ++i) {
+          real_type tmp(0);
+          for (int j = 0; j < m; ++j)
+            tmp += Acopy(i, j) * X(j, k);
+          err += (tmp - B(i, k)) * (tmp - B(i, k));
+          norm += B(i, k) * B(i, k);
+        }
+      }
+      const real_type rel_err = ats::sqrt(err / norm);
+      const real_type margin = 1000, threshold = ats::epsilon() * margin;
+      if (rel_err < threshold) {
+        std::cout << "PASS " << label << " " << rel_err << "\n";
+      } else {
+        std::cout << "FAIL " << label << " " << rel_err << "\n";
+      }
+    };
+
+    Kokkos::Random_XorShift64_Pool<host_device_type> random(13718);
+    Kokkos::fill_random(A, random, real_type(1.0));
+
+    /// x = 1 2 3 ... m
+    for (int i = 0; i < m; ++i)
+      for (int j = 0; j < nrhs; ++j)
+        X(i, j) = i + 1 + j * 10;
+    Tines::Gemm<Trans::NoTranspose, Trans::NoTranspose>::invoke(member, one, A,
+                                                               X, zero, B);
+    Tines::Copy::invoke(member, A, Acopy);
+    Tines::showMatrix("A", A);
+
+    /// Factorize A and solve for multiple right hand sides
+    {
+      int matrix_rank(0);
+      real_type pivot_growth(0);
+      Tines::SetMatrix::invoke(member, zero, X);
+#if defined(TINES_TEST_VIEW_INTERFACE)
+      Tines::LU::invoke(member, A, p, matrix_rank, pivot_growth);
+      Tines::SolveLU::invoke(member, A, p, X, B);
+#elif defined(TINES_TEST_TPL_POINTER_INTERFACE)
+      Tines::LU_HostTPL(m, m, A.data(), A.stride(0), A.stride(1), p.data(),
+                        matrix_rank, pivot_growth);
+      Tines::SolveLU_HostTPL(m, nrhs, A.data(), A.stride(0), A.stride(1),
+                             p.data(), X.data(), X.stride(0), X.stride(1),
+                             B.data(), B.stride(0), B.stride(1));
+#endif
+      std::cout << "matrix rank = " << matrix_rank
+                << ", pivot growth = " << pivot_growth << "\n";
+      Tines::showMatrix("X (solved)", X);
+      check_residual("SolveLU (multiple rhs)");
+    }
+
+    /// Reuse the factors for a single right hand side
+    {
+      auto x = Kokkos::subview(X, Kokkos::ALL(), 0);
+      auto b = Kokkos::subview(B, Kokkos::ALL(), 0);
+      Tines::SetVector::invoke(member, zero, x);
+#if defined(TINES_TEST_VIEW_INTERFACE)
+      Tines::SolveLU::invoke(member, A, p, x, b);
+#elif defined(TINES_TEST_TPL_POINTER_INTERFACE)
+      Tines::SolveLU_HostTPL(m, A.data(), A.stride(0), A.stride(1), p.data(),
+                             x.data(), x.stride(0), b.data(), b.stride(0));
+#endif
+      Tines::showVector("x (solved)", x);
+      check_residual("SolveLU (single rhs)");
+    }
+
+    /// Solve linear system with LU; a rank deficient matrix falls back to UTV
+    {
+      int wlen;
+      Tines::SolveLinearSystem::workspace(A, B, wlen);
+      Kokkos::View<real_type *, Kokkos::LayoutRight, host_device_type> w("w",
+                                                                         wlen);
+      const int r = 4;
+      Kokkos::View<real_type **, Kokkos::LayoutRight, host_device_type> R(
+        "R", m, r);
+      Kokkos::fill_random(R, random, real_type(1.0));
+
+      /// keep the full rank problem
+      Kokkos::View<real_type **, Kokkos::LayoutRight, host_device_type> A0(
+        "A0", m, m);
+      Kokkos::View<real_type **, Kokkos::LayoutRight, host_device_type> B0(
+        "B0", m, nrhs);
+      Tines::Copy::invoke(member, Acopy, A0);
+      Tines::Copy::invoke(member, B, B0);
+
+      /// the second pair of tests uses the fixed size kernels
+      for (int itest = 0; itest < 4; ++itest) {
+        const bool is_rank_deficient = (itest % 2) == 1;
+        const bool use_static = (itest / 2) == 1;
+        const std::string label(use_static ? " (static)" : "");
+        if (!is_rank_deficient) {
+          Tines::Copy::invoke(member, A0, Acopy);
+          Tines::Copy::invoke(member, B0, B);
+        } else {
+          Tines::SetMatrix::invoke(member, zero, Acopy);
+          for (int i = 0; i < m; ++i)
+            for (int j = 0; j < m; ++j)
+              for (int l = 0; l < r; ++l)
+                Acopy(i, j) += R(i, l) * R(j, l);
+          for (int i = 0; i < m; ++i)
+            for (int j = 0; j < nrhs; ++j)
+              X(i, j) = i + 1 + j * 10;
+          Tines::Gemm<Trans::NoTranspose, Trans::NoTranspose>::invoke(
+            member, one, Acopy, X, zero, B);
+        }
+        Tines::Copy::invoke(member, Acopy, A);
+        Tines::SetMatrix::invoke(member, zero, X);
+
+        int matrix_rank(0);
+        if (use_static)
+          Tines::SolveLinearSystemStatic<m>::device_invoke_lu(member, A, X, B,
+                                                              w, matrix_rank);
+        else
+          Tines::SolveLinearSystem::device_invoke_lu(member, A, X, B, w,
+                                                     matrix_rank);
+        std::cout << "matrix rank = " << matrix_rank << "\n";
+
+        /// rank deficient solution is checked with normal equations
+        if (is_rank_deficient) {
+          Kokkos::View<real_type **, Kokkos::LayoutRight, host_device_type> R1(
+            "R1", m, nrhs);
+          Tines::Gemm<Trans::NoTranspose, Trans::NoTranspose>::invoke(
+            member, one, Acopy, X, zero, R1);
+          real_type err(0), norm(0);
+          for (int k = 0; k < nrhs; ++k)
+            for (int i = 0; i < m; ++i) {
+              real_type tmp(0);
+              for (int j = 0; j < m; ++j)
+                tmp += Acopy(j, i) * (R1(j, k) - B(j, k));
+              err += tmp * tmp;
+              norm += B(i, k) * B(i, k);
+            }
+          const real_type rel_err = ats::sqrt(err / norm);
+          const real_type margin = 100, threshold = ats::epsilon() * margin;
+          if (matrix_rank == r && rel_err < threshold) {
+            std::cout << "PASS SolveLinearSystem LU fallback" << label << " "
+                      << rel_err << "\n";
+          } else {
+            std::cout << "FAIL SolveLinearSystem LU fallback" << label << " "
+                      << rel_err << "\n";
+          }
+        } else {
+          check_residual("SolveLinearSystem LU" + label);
+        }
+      }
+    }
+  }
+  Kokkos::finalize();
+
+#if defined(TINES_TEST_VIEW_INTERFACE)
+  std::cout << "SolveLU testing View interface\n";
+#elif defined(TINES_TEST_TPL_POINTER_INTERFACE)
+  std::cout << "SolveLU testing Pointer interface\n";
+#else
+  throw std::logic_error("Error: TEST macro is not defined");
+#endif
+
+  return 0;
+}
@@ -21,6 +21,8 @@ Sandia National Laboratories, New Mexico, USA
 #include "Sacado.hpp"
 #include "Tines.hpp"
 #include "Tines_ProblemTestSacadoSimple.hpp"
+#include "Tines_ProblemTestSimple.hpp"
+#include "Tines_ProblemTestSparse.hpp"
 
 int main(int argc, char *argv[]) {
 
@@ -95,6 +97,96 @@ int main(int argc, char *argv[]) {
 
     problem.computeAnalyticJacobianSacado(member, x, J_s);
     compareJacobian(std::string("AnalyticSacado"), J_a, J_s);
+
+    /// SacadoJacobian with SFad; the problem uses it as its jacobian
+    {
+      using problem_simple_type =
+        Tines::ProblemTestSimple<real_type, host_device_type>;
+      problem_simple_type problem_simple;
+      int wlen_simple(0);
+      problem_simple.workspace(wlen_simple);
+      real_type_1d_view_type work_simple("work_simple", wlen_simple);
+      problem_simple.setWorkspace(work_simple);
+
+      Kokkos::deep_copy(J_s, real_type(0));
+      problem_simple.computeAnalyticJacobianUsingSacado(member, x, J_s);
+      compareJacobian(std::string("SacadoJacobianSFad"), J_a, J_s);
+
+      /// columns are seeded in two chunks of two directions
+      using sacado_jacobian_type =
+        Tines::SacadoJacobian<real_type, host_device_type, 2>;
+      int wlen_chunk(0);
+      sacado_jacobian_type::workspace(problem_simple, wlen_chunk);
+      real_type_1d_view_type work_chunk("work_chunk", wlen_chunk);
+
+      Kokkos::deep_copy(J_s, real_type(0));
+      sacado_jacobian_type::invoke(member, problem_simple, x, J_s, work_chunk);
+      compareJacobian(std::string("SacadoJacobianSFadChunk"), J_a, J_s);
+    }
+
+    /// compressed SacadoJacobian using a column coloring
+    {
+      using problem_sparse_type =
+        Tines::ProblemTestSparse<real_type, host_device_type>;
+      using int_type_1d_view_type =
+        typename problem_sparse_type::int_type_1d_view_type;
+      problem_sparse_type problem_sparse;
+      const int n = problem_sparse.getNumberOfEquations(),
+                nnz = problem_sparse.getNumberOfJacobianNonZeros();
+
+      int_type_1d_view_type col_ptr("col_ptr", n + 1),
+        row_idx("row_idx", nnz), color("color", n);
+      problem_sparse.computeJacobianSparsityPattern(member, col_ptr, row_idx);
+      int iwlen(0);
+      Tines::NumericalJacobianColoring::workspace(n, nnz, iwlen);
+      int_type_1d_view_type iwork("iwork", iwlen);
+      const int ncolors = Tines::NumericalJacobianColoring::invoke(
+        col_ptr, row_idx, color, iwork);
+
+      real_type_1d_view_type y("y", n);
+      real_type_2d_view_type J_r("J_reference", n, n), J_c("J_colored", n, n);
+      problem_sparse.computeInitValues(member, y);
+      problem_sparse.computeAnalyticJacobian(member, y, J_r);
+
+      /// two chunks of two colors and one chunk of four colors
+      auto compareSparseJacobian = [&](const std::string &label) {
+        real_type err(0), norm(0);
+        for (int i = 0; i < n; ++i)
+          for (int j = 0; j < n; ++j) {
+            const real_type diff = ats::abs(J_r(i, j) - J_c(i, j));
+            norm += J_r(i, j) * J_r(i, j);
+            err += diff * diff;
+          }
+        const real_type rel_err = ats::sqrt(err / norm);
+        const real_type margin = 1e2, threshold = ats::epsilon() * margin;
+        if (rel_err < threshold)
+          std::cout << "PASS ";
+        else
+          std::cout << "FAIL ";
+        std::cout << label << " relative error " << rel_err
+                  << " within threshold " << threshold << "\n\n";
+      };
+      {
+        using sacado_jacobian_type =
+          Tines::SacadoJacobian<real_type, host_device_type, 2>;
+        int wlen_sparse(0);
+        sacado_jacobian_type::workspace(problem_sparse, wlen_sparse);
+        real_type_1d_view_type work_sparse("work_sparse", wlen_sparse);
+        sacado_jacobian_type::invoke(member, problem_sparse, ncolors, color,
+                                     col_ptr, row_idx, y, J_c, work_sparse);
+        compareSparseJacobian(std::string("SacadoJacobianSFadColoredChunk"));
+      }
+      {
+        using sacado_jacobian_type =
+          Tines::SacadoJacobian<real_type, host_device_type, 4>;
+        int wlen_sparse(0);
+        sacado_jacobian_type::workspace(problem_sparse, wlen_sparse);
+        real_type_1d_view_type work_sparse("work_sparse", wlen_sparse);
+        sacado_jacobian_type::invoke(member, problem_sparse, ncolors, color,
+                                     col_ptr, row_idx, y, J_c, work_sparse);
+        compareSparseJacobian(std::string("SacadoJacobianSFadColored"));
+      }
+    }
   }
   Kokkos::finalize();
 
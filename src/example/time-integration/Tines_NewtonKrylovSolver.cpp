@@ -0,0 +1,147 @@
+/*----------------------------------------------------------------------------------
+Tines - Time Integrator, Newton and Eigen Solver -  version 1.0
+Copyright (2021) NTESS
+https://github.com/sandialabs/Tines
+
+Copyright 2021 National Technology & Engineering Solutions of Sandia, LLC (NTESS). 
+Under the terms of Contract DE-NA0003525 with NTESS, the U.S. Government retains 
+certain rights in this software.
+
+This file is part of Tines. Tines is open-source software: you can redistribute it
+and/or modify it under the terms of BSD 2-Clause License
+(https://opensource.org/licenses/BSD-2-Clause). A copy of the license is also
+provided under the main directory
+Questions? Kyungjoo Kim <kyukim@sandia.gov>, or
+	   Oscar Diaz-Ibarra at <odiazib@sandia.gov>, or
+	   Cosmin Safta at <csafta@sandia.gov>, or
+	   Habib Najm at <hnnajm@sandia.gov>
+
+Sandia National Laboratories, New Mexico, USA
+----------------------------------------------------------------------------------*/
+#include "Tines.hpp"
+#include "Tines_ProblemTestSimple.hpp"
+#include "Tines_ProblemTestSparse.hpp"
+
+int main(int argc, char *argv[]) {
+  Kokkos::initialize(argc, argv);
+  {
+    using real_type = double;
+
+    using host_exec_space = Kokkos::DefaultHostExecutionSpace;
+    using host_memory_space = Kokkos::HostSpace;
+    using host_device_type = Kokkos::Device<host_exec_space, host_memory_space>;
+
+    using ats = Tines::ats<real_type>;
+    using real_type_1d_view_type =
+      Tines::value_type_1d_view<real_type, host_device_type>;
+
+    using jvp_fd_type =
+      Tines::JacobianVectorProductFiniteDifference<real_type, host_device_type>;
+    using jvp_sacado_type =
+      Tines::JacobianVectorProductSacado<real_type, host_device_type>;
+
+    const auto member = Tines::HostSerialTeamMember();
+    const real_type atol(1e-12), rtol(1e-10), linear_rtol(1e-6);
+    const int max_iter = 100, max_restart = 10;
+
+    /// run newton-krylov iterations and compare the solution to x_ref
+    auto run = [&](const std::string &label, auto newton_krylov_solver,
+                   const auto &problem, const int krylov_dim,
+                   const real_type_1d_view_type &x_ref) {
+      using newton_krylov_solver_type = decltype(newton_krylov_solver);
+      const int m = problem.getNumberOfEquations();
+
+      real_type_1d_view_type x("x", m);
+      real_type_1d_view_type dx("dx", m);
+      real_type_1d_view_type f("f", m);
+
+      int wlen(0);
+      newton_krylov_solver_type::workspace(m, krylov_dim, wlen);
+      real_type_1d_view_type work("work", wlen);
+
+      int iter_count(0), converge(0), linear_iter_count(0);
+      newton_krylov_solver_type::invoke(
+        member, problem, atol, rtol, max_iter, krylov_dim, max_restart,
+        linear_rtol, x, dx, f, work, iter_count, converge, linear_iter_count);
+      if (converge) {
+        std::cout << label << " converges with " << iter_count
+                  << " newton iterations and " << linear_iter_count
+                  << " jacobian-vector products\n";
+        real_type err(0), norm(0);
+        for (int i = 0; i < m; ++i) {
+          const real_type diff = ats::abs(x(i) - x_ref(i));
+          const real_type val = ats::abs(x_ref(i));
+          norm += val * val;
+          err += diff * diff;
+        }
+        /// the sparse problem has the trivial solution; the error is measured
+        /// in the absolute sense when |x_ref| is smaller than one
+        const real_type rel_err = ats::sqrt(err / (norm < 1 ? 1 : norm));
+        const real_type threshold(1e-8);
+        if (rel_err < threshold)
+          std::cout << "PASS ";
+        else
+          std::cout << "FAIL ";
+        std::cout << label << " relative error " << rel_err
+                  << " within threshold " << threshold << "\n\n";
+      } else {
+        std::cout << "FAIL " << label
+                  << " does not converge with iteration count " << iter_count
+                  << "; max iteration count is set " << max_iter << "\n";
+      }
+    };
+
+    /// small problem of which the solution is known
+    {
+      using problem_type =
+        Tines::ProblemTestSimple<real_type, host_device_type>;
+      problem_type problem;
+      const int m = problem.getNumberOfEquations();
+
+      real_type_1d_view_type x_ref("x_ref", m);
+      x_ref(0) = 8.332816138167559172e-01;
+      x_ref(1) = 3.533461613948914865e-02;
+      x_ref(2) = -4.985492778110373613e-01;
+
+      run("Simple FD", Tines::NewtonKrylovSolver<real_type, host_device_type>(),
+          problem, m, x_ref);
+      run("Simple Sacado Jacobi",
+          Tines::NewtonKrylovSolver<real_type, host_device_type,
+                                    jvp_sacado_type, 1>(),
+          problem, m, x_ref);
+      run("Simple FD restarted",
+          Tines::NewtonKrylovSolver<real_type, host_device_type, jvp_fd_type,
+                                    1>(),
+          problem, 2, x_ref);
+    }
+
+    /// sparse problem of which the solution is x = 0
+    {
+      using problem_type =
+        Tines::ProblemTestSparse<real_type, host_device_type>;
+      problem_type problem;
+      const int m = problem.getNumberOfEquations();
+
+      real_type_1d_view_type x_ref("x_ref", m);
+      Kokkos::deep_copy(x_ref, real_type(0));
+
+      run("Sparse FD", Tines::NewtonKrylovSolver<real_type, host_device_type>(),
+          problem, m, x_ref);
+      run("Sparse Sacado",
+          Tines::NewtonKrylovSolver<real_type, host_device_type,
+                                    jvp_sacado_type>(),
+          problem, m, x_ref);
+      run("Sparse FD Block Jacobi",
+          Tines::NewtonKrylovSolver<real_type, host_device_type, jvp_fd_type,
+                                    3>(),
+          problem, 20, x_ref);
+      run("Sparse Sacado Block Jacobi restarted",
+          Tines::NewtonKrylovSolver<real_type, host_device_type,
+                                    jvp_sacado_type, 3>(),
+          problem, 15, x_ref);
+    }
+  }
+  Kokkos::finalize();
+
+  return 0;
+}
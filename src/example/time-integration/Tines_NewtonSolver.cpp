@@ -93,6 +93,49 @@ int main(int argc, char *argv[]) {
                   << "\n";
       }
     }
+
+    /// run the modified newton iterations reusing the jacobian
+    {
+      const real_type max_contraction_rate(0.5);
+      int is_jacobian_factorized(false), jacobian_count(0);
+      Kokkos::deep_copy(x, real_type(0));
+      newton_solver_type::invoke(member, problem, atol, rtol, max_iter,
+                                 max_contraction_rate, x, dx, f, J, work,
+                                 is_jacobian_factorized, iter_count, converge,
+                                 jacobian_count);
+      Tines::showVector("x_modified_newton", x);
+      if (converge) {
+        std::cout << "Solution converges with " << iter_count
+                  << " iterations and " << jacobian_count
+                  << " jacobian evaluations\n";
+        real_type_1d_view_type x_ref("x_ref", m);
+        x_ref(0) = 8.332816138167559172e-01;
+        x_ref(1) = 3.533461613948914865e-02;
+        x_ref(2) = -4.985492778110373613e-01;
+
+        real_type err(0), norm(0);
+        for (int i = 0; i < m; ++i) {
+          const real_type diff = ats::abs(x(i) - x_ref(i));
+          const real_type val = ats::abs(x_ref(i));
+          norm += val * val;
+          err += diff * diff;
+        }
+        /// modified newton converges linearly; check against tolerence
+        const real_type rel_err = ats::sqrt(err / norm);
+        const real_type threshold(rtol);
+        if (rel_err < threshold && jacobian_count < iter_count)
+          std::cout << "PASS ";
+        else
+          std::cout << "FAIL ";
+        std::cout << " modified newton relative error " << rel_err
+                  << " within threshold " << threshold << "\n\n";
+      } else {
+        std::cout << "FAIL modified newton does not converge with iteration "
+                     "count "
+                  << iter_count << "; max iteration count is set " << max_iter
+                  << "\n";
+      }
+    }
   }
   Kokkos::finalize();
 
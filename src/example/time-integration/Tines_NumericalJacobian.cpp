@@ -107,6 +107,35 @@ int main(int argc, char *argv[]) {
     Tines::Set::invoke(member, zero, J_n);
     problem.computeNumericalJacobianRichardsonExtrapolation(member, x, J_n);
     compareJacobian(std::string("RichardsonExtrapolation"), J_a, J_n);
+
+    /// columns are computed concurrently by team threads
+    {
+      using jacobian_type =
+        Tines::NumericalJacobianForwardDifferenceTeamThread<real_type,
+                                                            host_device_type>;
+      const int team_size = host_exec_space::concurrency() < 4
+                              ? host_exec_space::concurrency()
+                              : 4;
+      int wlen_team(0);
+      jacobian_type::workspace(problem, team_size, wlen_team);
+      real_type_1d_view_type work_team("work_team", wlen_team);
+
+      Tines::Set::invoke(member, zero, J_n);
+      jacobian_type::invoke(member, problem, fac_min, fac_max, fac, x, J_n,
+                            work_team);
+      compareJacobian(std::string("ForwardDifferenceTeamThread"), J_a, J_n);
+
+      using policy_type = Kokkos::TeamPolicy<host_exec_space>;
+      Tines::Set::invoke(member, zero, J_n);
+      Kokkos::parallel_for(
+        policy_type(1, team_size),
+        [=](const typename policy_type::member_type &team_member) {
+          jacobian_type::invoke(team_member, problem, fac_min, fac_max, fac, x,
+                                J_n, work_team);
+        });
+      compareJacobian(std::string("ForwardDifferenceTeamThreadPolicy"), J_a,
+                      J_n);
+    }
   }
   Kokkos::finalize();
 
@@ -0,0 +1,162 @@
+/*----------------------------------------------------------------------------------
+Tines - Time Integrator, Newton and Eigen Solver -  version 1.0
+Copyright (2021) NTESS
+https://github.com/sandialabs/Tines
+
+Copyright 2021 National Technology & Engineering Solutions of Sandia, LLC (NTESS). 
+Under the terms of Contract DE-NA0003525 with NTESS, the U.S. Government retains 
+certain rights in this software.
+
+This file is part of Tines. Tines is open-source software: you can redistribute it
+and/or modify it under the terms of BSD 2-Clause License
+(https://opensource.org/licenses/BSD-2-Clause). A copy of the license is also
+provided under the main directory
+Questions? Kyungjoo Kim <kyukim@sandia.gov>, or
+	   Oscar Diaz-Ibarra at <odiazib@sandia.gov>, or
+	   Cosmin Safta at <csafta@sandia.gov>, or
+	   Habib Najm at <hnnajm@sandia.gov>
+
+Sandia National Laboratories, New Mexico, USA
+----------------------------------------------------------------------------------*/
+#include "Tines.hpp"
+#include "Tines_ProblemTestSparse.hpp"
+
+int main(int argc, char *argv[]) {
+
+  Kokkos::initialize(argc, argv);
+  {
+    using real_type = double;
+
+    using host_exec_space = Kokkos::DefaultHostExecutionSpace;
+    using host_memory_space = Kokkos::HostSpace;
+    using host_device_type = Kokkos::Device<host_exec_space, host_memory_space>;
+
+    using ats = Tines::ats<real_type>;
+    using problem_type = Tines::ProblemTestSparse<real_type, host_device_type>;
+
+    using real_type_1d_view_type =
+      typename problem_type::real_type_1d_view_type;
+    using real_type_2d_view_type =
+      typename problem_type::real_type_2d_view_type;
+    using int_type_1d_view_type = typename problem_type::int_type_1d_view_type;
+
+    problem_type problem;
+    const int m = problem.getNumberOfEquations();
+    const int nnz = problem.getNumberOfJacobianNonZeros();
+
+    const real_type fac_min(0), fac_max(0);
+    real_type_1d_view_type fac("fac", m);
+
+    real_type_1d_view_type x("x", m);
+
+    int wlen(0);
+    problem.workspace(wlen);
+    real_type_1d_view_type work("work", wlen);
+
+    real_type_2d_view_type J_a("J_analytic", m, m);
+    real_type_2d_view_type J_n("J_numeric", m, m);
+
+    const real_type zero(0);
+    const auto member = Tines::HostSerialTeamMember();
+
+    /// sparsity pattern and its coloring are computed once
+    int_type_1d_view_type col_ptr("col_ptr", m + 1), row_idx("row_idx", nnz),
+      color("color", m);
+    problem.computeJacobianSparsityPattern(member, col_ptr, row_idx);
+    {
+      int iwlen(0);
+      Tines::NumericalJacobianColoring::workspace(m, nnz, iwlen);
+      int_type_1d_view_type iwork("iwork", iwlen);
+      const int ncolors = Tines::NumericalJacobianColoring::invoke(
+        col_ptr, row_idx, color, iwork);
+      problem.setJacobianColoring(ncolors, color, col_ptr, row_idx);
+      std::cout << "Number of equations " << m << ", number of colors "
+                << ncolors << "\n";
+
+      /// columns of the same color do not share a row
+      bool is_valid(ncolors <= 4);
+      for (int j = 0; j < m; ++j)
+        for (int k = j + 1; k < m; ++k)
+          if (color(j) == color(k))
+            for (int p = col_ptr(j); p < col_ptr(j + 1); ++p)
+              for (int q = col_ptr(k); q < col_ptr(k + 1); ++q)
+                is_valid &= (row_idx(p) != row_idx(q));
+      if (is_valid)
+        std::cout << "PASS Coloring\n";
+      else
+        std::cout << "FAIL Coloring\n";
+    }
+
+    /// problem member variable set (not a good way but one way)
+    problem.setFaction(fac_min, fac_max, fac);
+    problem.setWorkspace(work);
+
+    /// set x
+    problem.computeInitValues(member, x);
+
+    /// compute reference
+    problem.computeAnalyticJacobian(member, x, J_a);
+
+    /// numeric tests
+    auto compareJacobian = [m, &x](const std::string &label, auto &A, auto &B,
+                                   const real_type margin) {
+      real_type err(0), norm(0);
+      for (int i = 0; i < m; ++i)
+        for (int j = 0; j < m; ++j) {
+          const real_type diff = ats::abs(A(i, j) - B(i, j));
+          const real_type val = ats::abs(A(i, j));
+          norm += val * val;
+          err += diff * diff;
+        }
+      const real_type rel_err = ats::sqrt(err / norm);
+
+      const real_type threshold = ats::epsilon() * margin;
+      if (rel_err < threshold)
+        std::cout << "PASS ";
+      else
+        std::cout << "FAIL ";
+      std::cout << label << " relative error " << rel_err
+                << " within threshold " << threshold << "\n";
+
+      /// the input vector is rolled back
+      bool is_same(true);
+      for (int i = 0; i < m; ++i)
+        is_same &= (x(i) == real_type(1) + real_type(0.1) * real_type(i) / m);
+      if (!is_same)
+        std::cout << "FAIL " << label << " input vector is modified\n";
+    };
+
+    Tines::Set::invoke(member, zero, J_n);
+    problem.computeNumericalJacobianForwardDifference(member, x, J_n);
+    compareJacobian(std::string("ColoredForwardDifference"), J_a, J_n, 1e8);
+
+    Tines::Set::invoke(member, zero, J_n);
+    problem.computeNumericalJacobianCentralDifference(member, x, J_n);
+    compareJacobian(std::string("ColoredCentralDifference"), J_a, J_n, 1e8);
+
+    Tines::Set::invoke(member, zero, J_n);
+    problem.computeNumericalJacobianRichardsonExtrapolation(member, x, J_n);
+    compareJacobian(std::string("ColoredRichardsonExtrapolation"), J_a, J_n,
+                    1e8);
+
+    /// the colored jacobian is the same as the column by column jacobian
+    {
+      real_type_2d_view_type J_c("J_column", m, m);
+      real_type_1d_view_type f_0("f_0", m), f_h("f_h", m);
+      Kokkos::deep_copy(fac, zero);
+      Tines::NumericalJacobianForwardDifference<
+        real_type, host_device_type>::invoke(member, problem, fac_min, fac_max,
+                                             fac, x, f_0, f_h, J_c);
+      Kokkos::deep_copy(fac, zero);
+      problem.computeNumericalJacobianForwardDifference(member, x, J_n);
+      compareJacobian(std::string("ColoredVersusColumnForwardDifference"), J_c,
+                      J_n, 1e2);
+      std::cout << "Number of function evaluations, colored "
+                << (problem._ncolors + 1) << ", column by column " << (m + 1)
+                << "\n";
+    }
+  }
+  Kokkos::finalize();
+
+  return 0;
+}
@@ -0,0 +1,154 @@
+/*----------------------------------------------------------------------------------
+Tines - Time Integrator, Newton and Eigen Solver -  version 1.0
+Copyright (2021) NTESS
+https://github.com/sandialabs/Tines
+
+Copyright 2021 National Technology & Engineering Solutions of Sandia, LLC (NTESS). 
+Under the terms of Contract DE-NA0003525 with NTESS, the U.S. Government retains 
+certain rights in this software.
+
+This file is part of Tines. Tines is open-source software: you can redistribute it
+and/or modify it under the terms of BSD 2-Clause License
+(https://opensource.org/licenses/BSD-2-Clause). A copy of the license is also
+provided under the main directory
+Questions? Kyungjoo Kim <kyukim@sandia.gov>, or
+	   Oscar Diaz-Ibarra at <odiazib@sandia.gov>, or
+	   Cosmin Safta at <csafta@sandia.gov>, or
+	   Habib Najm at <hnnajm@sandia.gov>
+
+Sandia National Laboratories, New Mexico, USA
+----------------------------------------------------------------------------------*/
+#include "Tines.hpp"
+#include "Tines_ProblemTestTrBDF2.hpp"
+
+int main(int argc, char *argv[]) {
+  Kokkos::initialize(argc, argv);
+  {
+    using real_type = double;
+
+    using host_exec_space = Kokkos::DefaultHostExecutionSpace;
+    using host_memory_space = Kokkos::HostSpace;
+    using host_device_type = Kokkos::Device<host_exec_space, host_memory_space>;
+
+    using ats = Tines::ats<real_type>;
+    using problem_type = Tines::ProblemTestTrBDF2<real_type, host_device_type>;
+
+    using real_type_0d_view_type =
+      typename problem_type::real_type_0d_view_type;
+    using real_type_1d_view_type =
+      typename problem_type::real_type_1d_view_type;
+    using real_type_2d_view_type =
+      typename problem_type::real_type_2d_view_type;
+
+    using time_integrator_type =
+      Tines::TimeIntegratorESDIRK<real_type, host_device_type>;
+    using trbdf2_time_integrator_type =
+      Tines::TimeIntegratorTrBDF2<real_type, host_device_type>;
+    using tableau_type = typename time_integrator_type::tableau_type;
+    using statistics_type = typename time_integrator_type::statistics_type;
+
+    problem_type problem;
+    const int m = problem.getNumberOfEquations();
+
+    real_type_1d_view_type u("u", m);
+    int wlen(0), wlen_trbdf2(0);
+    time_integrator_type::workspace(m, wlen);
+    trbdf2_time_integrator_type::workspace(m, wlen_trbdf2);
+    real_type_1d_view_type work("work",
+                                wlen > wlen_trbdf2 ? wlen : wlen_trbdf2);
+
+    real_type_1d_view_type tol_newton("tol_newton", 2);
+    real_type_2d_view_type tol_time("tol_time", m, 2);
+
+    real_type_0d_view_type t("t");
+    real_type_0d_view_type dt("dt");
+
+    const auto member = Tines::HostSerialTeamMember();
+
+    /// common settings; tight tolerances favor the higher order methods
+    const real_type tbeg(0), tend(10);
+    const real_type dtmin(1e-10), dtmax(1), dt_init(1e-4);
+
+    const int max_num_newton_iterations(10);
+    tol_newton(0) = 1e-12;
+    tol_newton(1) = 1e-10;
+
+    const int max_num_time_iterations(10000);
+    for (int i = 0; i < m; ++i) {
+      tol_time(i, 0) = 1e-12;
+      tol_time(i, 1) = 1e-8;
+    }
+
+    const real_type jacobian_reuse_dt_ratio(0.3);
+    const real_type safety(0.9), factor_min(0.2), factor_max(5);
+    const int use_pi_controller(1);
+
+    /// reference; TrBDF2 with the same tolerances
+    statistics_type stats_trbdf2;
+    {
+      u(0) = 1;
+      u(1) = 0;
+      u(2) = -1;
+      dt() = dt_init;
+
+      trbdf2_time_integrator_type::invoke(
+        member, problem, max_num_newton_iterations, max_num_time_iterations,
+        tol_newton, tol_time, jacobian_reuse_dt_ratio, safety, factor_min,
+        factor_max, use_pi_controller, dt(), dtmin, dtmax, tbeg, tend, u,
+        real_type_1d_view_type(), t, dt, u, real_type_2d_view_type(),
+        stats_trbdf2, work);
+
+      const real_type err = problem.computeError(member, t(), u);
+      printf("TrBDF2, t %e, err %e, accepted %ld, rejected %ld\n", t(), err,
+             long(stats_trbdf2.num_accepted_time_steps),
+             long(stats_trbdf2.num_rejected_time_steps));
+    }
+
+    const int methods[2] = {tableau_type::ESDIRK32, tableau_type::ESDIRK43};
+    const char *labels[2] = {"ESDIRK32", "ESDIRK43"};
+    for (int l = 0; l < 2; ++l) {
+      const tableau_type tableau(methods[l]);
+
+      u(0) = 1;
+      u(1) = 0;
+      u(2) = -1;
+      dt() = dt_init;
+
+      statistics_type stats;
+      const int r_val = time_integrator_type::invoke(
+        member, problem, tableau, max_num_newton_iterations,
+        max_num_time_iterations, tol_newton, tol_time, jacobian_reuse_dt_ratio,
+        safety, factor_min, factor_max, use_pi_controller, dt(), dtmin, dtmax,
+        tbeg, tend, u, t, dt, u, stats, work);
+
+      {
+        const real_type err = problem.computeError(member, t(), u);
+        printf("%s, t %e, err %e, accepted %ld, rejected %ld, newton %ld, "
+               "jacobians %ld, factorizations %ld\n",
+               labels[l], t(), err, long(stats.num_accepted_time_steps),
+               long(stats.num_rejected_time_steps),
+               long(stats.num_newton_iterations),
+               long(stats.num_jacobian_evaluations),
+               long(stats.num_factorizations));
+        if (r_val != 0 || stats.failure_reason != statistics_type::Success ||
+            ats::abs(t() - tend) > 1e-12) {
+          std::cout << "FAIL " << labels[l] << " does not reach the end time\n";
+        } else if (err > 1e-6) {
+          std::cout << "FAIL " << labels[l]
+                    << " time integration error is unusually high\n";
+        } else if (stats.num_accepted_time_steps >=
+                   stats_trbdf2.num_accepted_time_steps) {
+          std::cout << "FAIL " << labels[l]
+                    << " takes more time steps than TrBDF2\n";
+        } else if (stats.num_factorizations >= stats.num_newton_iterations) {
+          std::cout << "FAIL " << labels[l] << " jacobian is not reused\n";
+        } else {
+          std::cout << "PASS TimeIntegratorESDIRK " << labels[l] << "\n";
+        }
+      }
+    }
+  }
+  Kokkos::finalize();
+
+  return 0;
+}
@@ -0,0 +1,168 @@
+/*----------------------------------------------------------------------------------
+Tines - Time Integrator, Newton and Eigen Solver -  version 1.0
+Copyright (2021) NTESS
+https://github.com/sandialabs/Tines
+
+Copyright 2021 National Technology & Engineering Solutions of Sandia, LLC (NTESS). 
+Under the terms of Contract DE-NA0003525 with NTESS, the U.S. Government retains 
+certain rights in this software.
+
+This file is part of Tines. Tines is open-source software: you can redistribute it
+and/or modify it under the terms of BSD 2-Clause License
+(https://opensource.org/licenses/BSD-2-Clause). A copy of the license is also
+provided under the main directory
+Questions? Kyungjoo Kim <kyukim@sandia.gov>, or
+	   Oscar Diaz-Ibarra at <odiazib@sandia.gov>, or
+	   Cosmin Safta at <csafta@sandia.gov>, or
+	   Habib Najm at <hnnajm@sandia.gov>
+
+Sandia National Laboratories, New Mexico, USA
+----------------------------------------------------------------------------------*/
+#include "Tines.hpp"
+#include "Tines_ProblemTestNonlinear.hpp"
+#include "Tines_ProblemTestTrBDF2.hpp"
+
+int main(int argc, char *argv[]) {
+  Kokkos::initialize(argc, argv);
+  {
+    using real_type = double;
+
+    using host_exec_space = Kokkos::DefaultHostExecutionSpace;
+    using host_memory_space = Kokkos::HostSpace;
+    using host_device_type = Kokkos::Device<host_exec_space, host_memory_space>;
+
+    using ats = Tines::ats<real_type>;
+    using problem_type = Tines::ProblemTestTrBDF2<real_type, host_device_type>;
+
+    using real_type_0d_view_type =
+      typename problem_type::real_type_0d_view_type;
+    using real_type_1d_view_type =
+      typename problem_type::real_type_1d_view_type;
+    using real_type_2d_view_type =
+      typename problem_type::real_type_2d_view_type;
+
+    using time_integrator_type =
+      Tines::TimeIntegratorRosenbrockW<real_type, host_device_type>;
+    using tableau_type = typename time_integrator_type::tableau_type;
+    using statistics_type = typename time_integrator_type::statistics_type;
+
+    problem_type problem;
+    const int m = problem.getNumberOfEquations();
+
+    real_type_1d_view_type u("u", m);
+    int wlen(0);
+    time_integrator_type::workspace(m, wlen);
+    real_type_1d_view_type work("work", wlen);
+
+    real_type_2d_view_type tol_time("tol_time", m, 2);
+
+    real_type_0d_view_type t("t");
+    real_type_0d_view_type dt("dt");
+
+    const auto member = Tines::HostSerialTeamMember();
+
+    const tableau_type tableau(tableau_type::ROS34PW2);
+
+    const real_type tbeg(0), tend(10);
+    const real_type dtmin(1e-10), dtmax(1);
+
+    const int max_num_time_iterations(10000);
+    for (int i = 0; i < m; ++i) {
+      tol_time(i, 0) = 1e-12;
+      tol_time(i, 1) = 1e-8;
+    }
+
+    const real_type safety(0.9), factor_min(0.2), factor_max(5);
+    const int use_pi_controller(1);
+
+    /// the jacobian is evaluated every step (interval 1) or every fourth
+    /// step; the W-method keeps its order with the lagged jacobian
+    auto integrate = [&](const auto &problem, const std::string label,
+                         const int jacobian_update_interval) {
+      statistics_type stats;
+      const int r_val = time_integrator_type::invoke(
+        member, problem, tableau, max_num_time_iterations, tol_time,
+        jacobian_update_interval, safety, factor_min, factor_max,
+        use_pi_controller, dt(), dtmin, dtmax, tbeg, tend, u, t, dt, u, stats,
+        work);
+
+      const real_type err = problem.computeError(member, t(), u);
+      printf("ROS34PW2 %s jacobian interval %d, t %e, err %e, accepted %ld, "
+             "rejected %ld, jacobians %ld, factorizations %ld, "
+             "linear solves %ld\n",
+             label.c_str(), jacobian_update_interval, t(), err,
+             long(stats.num_accepted_time_steps),
+             long(stats.num_rejected_time_steps),
+             long(stats.num_jacobian_evaluations),
+             long(stats.num_factorizations), long(stats.num_linear_solves));
+      if (r_val != 0 || stats.failure_reason != statistics_type::Success ||
+          ats::abs(t() - tend) > 1e-12) {
+        std::cout << "FAIL RosenbrockW " << label
+                  << " does not reach the end time\n";
+      } else if (err > 1e-6) {
+        std::cout << "FAIL RosenbrockW " << label
+                  << " time integration error is unusually high\n";
+      } else if (stats.num_newton_iterations != 0 ||
+                 stats.num_factorizations > stats.num_time_iterations ||
+                 stats.num_linear_solves !=
+                   stats.num_time_iterations * tableau.getNumberOfStages()) {
+        std::cout << "FAIL RosenbrockW " << label
+                  << " linear solve counts are not as expected\n";
+      } else if (jacobian_update_interval > 1 &&
+                 stats.num_jacobian_evaluations >=
+                   stats.num_accepted_time_steps) {
+        std::cout << "FAIL RosenbrockW " << label
+                  << " jacobian is not reused\n";
+      } else {
+        std::cout << "PASS TimeIntegratorRosenbrockW " << label
+                  << " interval " << jacobian_update_interval << "\n";
+      }
+    };
+
+    const int jacobian_update_intervals[2] = {1, 4};
+    for (int l = 0; l < 2; ++l) {
+      u(0) = 1;
+      u(1) = 0;
+      u(2) = -1;
+      dt() = 1e-4;
+      integrate(problem, "Linear", jacobian_update_intervals[l]);
+    }
+
+    /// the jacobian of the nonlinear problem depends on the state; the
+    /// lagged jacobian changes the solution but it stays accurate
+    {
+      using nonlinear_problem_type =
+        Tines::ProblemTestNonlinear<real_type, host_device_type>;
+      nonlinear_problem_type nonlinear_problem;
+
+      real_type u_ref[3];
+      for (int l = 0; l < 2; ++l) {
+        u(0) = ats::exp(real_type(1));
+        u(1) = 1;
+        u(2) = ats::exp(real_type(-1));
+        dt() = 1e-4;
+        integrate(nonlinear_problem, "Nonlinear", jacobian_update_intervals[l]);
+        if (l == 0) {
+          for (int k = 0; k < m; ++k)
+            u_ref[k] = u(k);
+        } else {
+          real_type diff(0);
+          for (int k = 0; k < m; ++k)
+            diff += ats::abs(u(k) - u_ref[k]);
+          printf("ROS34PW2 Nonlinear, difference of the lagged jacobian %e\n",
+                 diff);
+          if (diff == real_type(0)) {
+            std::cout << "FAIL RosenbrockW Nonlinear lagged jacobian does not "
+                         "change the solution\n";
+          } else {
+            std::cout << "PASS TimeIntegratorRosenbrockW Nonlinear lagged "
+                         "jacobian\n";
+          }
+        }
+      }
+    }
+  }
+  Kokkos::finalize();
+
+  return 0;
+}
@@ -43,6 +43,7 @@ int main(int argc, char *argv[]) {
 
     using time_integrator_type =
       Tines::TimeIntegratorTrBDF2<real_type, host_device_type>;
+    using statistics_type = typename time_integrator_type::statistics_type;
 
     problem_type problem;
     const int m = problem.getNumberOfEquations();
@@ -88,23 +89,206 @@ int main(int argc, char *argv[]) {
         tol_time(i, 1) = 1e-6;
       }
 
-      time_integrator_type::invoke(member, problem, max_num_newton_iterations,
-                                   max_num_time_iterations, tol_newton,
-                                   tol_time, dt(), dtmin, dtmax, tbeg, tend, u,
-                                   t, dt, u, work);
+      /// reuse the jacobian factorization while dt changes less than 30 %
+      const real_type jacobian_reuse_dt_ratio(0.3);
+      const real_type safety(0.9), factor_min(0.2), factor_max(5);
+      const int use_pi_controller(1);
+      statistics_type stats;
+
+      time_integrator_type::invoke(
+        member, problem, max_num_newton_iterations, max_num_time_iterations,
+        tol_newton, tol_time, jacobian_reuse_dt_ratio, safety, factor_min,
+        factor_max, use_pi_controller, dt(), dtmin, dtmax, tbeg, tend, u,
+        real_type_1d_view_type(), t, dt, u, real_type_2d_view_type(), stats,
+        work);
+
+      /// each newton iteration would evaluate and factorize the jacobian
+      const long num_jacobian_evaluations_saved =
+        stats.num_newton_iterations - stats.num_jacobian_evaluations;
+      const long num_factorizations_saved =
+        stats.num_newton_iterations - stats.num_factorizations;
 
       /// print
       {
         const real_type err = problem.computeError(member, t(), u);
         printf("t %e, dt %e, u(0) %e, u(1) %e u(2) %e, err %e\n", t(), dt(),
                u(0), u(1), u(2), err);
+        printf("time iterations %ld, ", long(stats.num_time_iterations));
+        printf("jacobian evaluations saved %ld, factorizations saved %ld\n",
+               num_jacobian_evaluations_saved, num_factorizations_saved);
         if (err > 1e-4) {
           std::cout << "FAIL time integration error is unusually high\n";
+        } else if (num_jacobian_evaluations_saved <= 0 ||
+                   num_factorizations_saved <= 0) {
+          std::cout << "FAIL jacobian is not reused\n";
         } else {
           std::cout << "PASS TimeIntegratorTrBDF2\n";
         }
       }
     }
+
+    /// error controlled step sizes; elementary and PI controllers
+    for (int use_pi_controller = 0; use_pi_controller < 2;
+         ++use_pi_controller) {
+      const std::string label(use_pi_controller ? "PI" : "Elementary");
+
+      u(0) = 1;
+      u(1) = 0;
+      u(2) = -1;
+
+      const real_type tbeg(0), tend(10);
+      const real_type dtmin(1e-8), dtmax(1);
+
+      /// too large initial dt; the first steps are rejected
+      dt() = 1e-1;
+
+      const int max_num_newton_iterations(10);
+      tol_newton(0) = 1e-10;
+      tol_newton(1) = 1e-8;
+
+      const int max_num_time_iterations(1000);
+      for (int i = 0; i < m; ++i) {
+        tol_time(i, 0) = 1e-10;
+        tol_time(i, 1) = 1e-6;
+      }
+
+      const real_type jacobian_reuse_dt_ratio(0.3);
+      const real_type safety(0.9), factor_min(0.2), factor_max(5);
+      statistics_type stats;
+
+      time_integrator_type::invoke(
+        member, problem, max_num_newton_iterations, max_num_time_iterations,
+        tol_newton, tol_time, jacobian_reuse_dt_ratio, safety, factor_min,
+        factor_max, use_pi_controller, dt(), dtmin, dtmax, tbeg, tend, u,
+        real_type_1d_view_type(), t, dt, u, real_type_2d_view_type(), stats,
+        work);
+
+      {
+        const real_type err = problem.computeError(member, t(), u);
+        printf("%s controller, t %e, err %e, accepted %ld, rejected %ld\n",
+               label.c_str(), t(), err, long(stats.num_accepted_time_steps),
+               long(stats.num_rejected_time_steps));
+        if (err > 1e-4 || ats::abs(t() - tend) > 1e-12) {
+          std::cout << "FAIL " << label
+                    << " controller does not reach the end time accurately\n";
+        } else if (stats.num_accepted_time_steps +
+                       stats.num_rejected_time_steps !=
+                     stats.num_time_iterations ||
+                   stats.num_rejected_time_steps == 0) {
+          std::cout << "FAIL " << label
+                    << " controller step counts are not as expected\n";
+        } else {
+          std::cout << "PASS TimeIntegratorTrBDF2 " << label
+                    << " controller\n";
+        }
+      }
+    }
+
+    /// the first step is rejected and the time iterations run out; the
+    /// output is the last accepted solution, i.e., the initial condition
+    {
+      u(0) = 1;
+      u(1) = 0;
+      u(2) = -1;
+
+      const real_type tbeg(0), tend(10);
+      const real_type dtmin(1e-8), dtmax(1);
+      dt() = 1e-1;
+
+      const int max_num_newton_iterations(10);
+      tol_newton(0) = 1e-10;
+      tol_newton(1) = 1e-8;
+
+      const int max_num_time_iterations(1);
+      for (int i = 0; i < m; ++i) {
+        tol_time(i, 0) = 1e-10;
+        tol_time(i, 1) = 1e-6;
+      }
+
+      const real_type jacobian_reuse_dt_ratio(0.3);
+      const real_type safety(0.9), factor_min(0.2), factor_max(5);
+      const int use_pi_controller(1);
+      statistics_type stats;
+
+      time_integrator_type::invoke(
+        member, problem, max_num_newton_iterations, max_num_time_iterations,
+        tol_newton, tol_time, jacobian_reuse_dt_ratio, safety, factor_min,
+        factor_max, use_pi_controller, dt(), dtmin, dtmax, tbeg, tend, u,
+        real_type_1d_view_type(), t, dt, u, real_type_2d_view_type(), stats,
+        work);
+
+      printf("Rejected step, t %e, u(0) %e, u(1) %e u(2) %e, rejected %ld\n",
+             t(), u(0), u(1), u(2), long(stats.num_rejected_time_steps));
+      if (stats.num_rejected_time_steps != 1 || t() != tbeg) {
+        std::cout << "FAIL the first step is not rejected\n";
+      } else if (u(0) != 1 || u(1) != 0 || u(2) != -1) {
+        std::cout << "FAIL output is not the last accepted solution\n";
+      } else {
+        std::cout << "PASS TimeIntegratorTrBDF2 output after a rejected "
+                     "step\n";
+      }
+    }
+
+    /// dense output at uniform times finer than the time steps; several
+    /// outputs are interpolated on each accepted step
+    {
+      u(0) = 1;
+      u(1) = 0;
+      u(2) = -1;
+
+      const real_type tbeg(0), tend(10);
+      const real_type dtmin(1e-8), dtmax(1);
+      dt() = 1e-3;
+
+      const int max_num_newton_iterations(10);
+      tol_newton(0) = 1e-10;
+      tol_newton(1) = 1e-8;
+
+      const int max_num_time_iterations(1000);
+      for (int i = 0; i < m; ++i) {
+        tol_time(i, 0) = 1e-10;
+        tol_time(i, 1) = 1e-6;
+      }
+
+      const int n_dense(1001);
+      real_type_1d_view_type t_dense("t_dense", n_dense);
+      real_type_2d_view_type vals_dense("vals_dense", n_dense, m);
+      for (int k = 0; k < n_dense; ++k)
+        t_dense(k) =
+          tbeg + (tend - tbeg) * real_type(k) / real_type(n_dense - 1);
+
+      const real_type jacobian_reuse_dt_ratio(0.3);
+      const real_type safety(0.9), factor_min(0.2), factor_max(5);
+      const int use_pi_controller(1);
+      statistics_type stats;
+
+      time_integrator_type::invoke(
+        member, problem, max_num_newton_iterations, max_num_time_iterations,
+        tol_newton, tol_time, jacobian_reuse_dt_ratio, safety, factor_min,
+        factor_max, use_pi_controller, dt(), dtmin, dtmax, tbeg, tend, u,
+        t_dense, t, dt, u, vals_dense, stats, work);
+
+      {
+        real_type_1d_view_type v("v", m);
+        real_type err_max(0);
+        for (int k = 0; k < n_dense; ++k) {
+          for (int i = 0; i < m; ++i)
+            v(i) = vals_dense(k, i);
+          const real_type err = problem.computeError(member, t_dense(k), v);
+          err_max = err > err_max ? err : err_max;
+        }
+        printf("Dense output, %d outputs, accepted %ld, max err %e\n",
+               n_dense, long(stats.num_accepted_time_steps), err_max);
+        if (err_max > 1e-4) {
+          std::cout << "FAIL Dense output is not accurate\n";
+        } else if (stats.num_accepted_time_steps >= n_dense) {
+          std::cout << "FAIL Dense output time steps are restricted by the "
+                       "output times\n";
+        } else {
+          std::cout << "PASS TimeIntegratorTrBDF2 dense output\n";
+        }
+      }
+    }
   }
   Kokkos::finalize();
 
@@ -0,0 +1,347 @@
+/*----------------------------------------------------------------------------------
+Tines - Time Integrator, Newton and Eigen Solver -  version 1.0
+Copyright (2021) NTESS
+https://github.com/sandialabs/Tines
+
+Copyright 2021 National Technology & Engineering Solutions of Sandia, LLC (NTESS). 
+Under the terms of Contract DE-NA0003525 with NTESS, the U.S. Government retains 
+certain rights in this software.
+
+This file is part of Tines. Tines is open-source software: you can redistribute it
+and/or modify it under the terms of BSD 2-Clause License
+(https://opensource.org/licenses/BSD-2-Clause). A copy of the license is also
+provided under the main directory
+Questions? Kyungjoo Kim <kyukim@sandia.gov>, or
+	   Oscar Diaz-Ibarra at <odiazib@sandia.gov>, or
+	   Cosmin Safta at <csafta@sandia.gov>, or
+	   Habib Najm at <hnnajm@sandia.gov>
+
+Sandia National Laboratories, New Mexico, USA
+----------------------------------------------------------------------------------*/
+#include "Tines.hpp"
+#include "Tines_ProblemTestTrBDF2.hpp"
+
+int main(int argc, char *argv[]) {
+  Kokkos::initialize(argc, argv);
+  {
+    using real_type = double;
+
+    using exec_space = Kokkos::DefaultExecutionSpace;
+    using device_type = typename Tines::UseThisDevice<exec_space>::type;
+
+    exec_space::print_configuration(std::cout, false);
+
+    using problem_type = Tines::ProblemTestTrBDF2<real_type, device_type>;
+    using time_integrator_type = Tines::TimeIntegratorTrBDF2Device<exec_space>;
+    using statistics_type = typename time_integrator_type::statistics_type;
+
+    using real_type_1d_view_type =
+      Tines::value_type_1d_view<real_type, device_type>;
+    using real_type_2d_view_type =
+      Tines::value_type_2d_view<real_type, device_type>;
+    using real_type_3d_view_type =
+      Tines::value_type_3d_view<real_type, device_type>;
+
+    problem_type problem;
+    const int np = 64, m = problem.getNumberOfEquations();
+
+    /// samples integrate different time windows
+    real_type_2d_view_type vals("vals", np, m);
+    real_type_2d_view_type vals_out("vals_out", np, m);
+    real_type_1d_view_type t_out("t_out", np), dt_out("dt_out", np);
+    real_type_1d_view_type t_beg("t_beg", np), t_end("t_end", np);
+    real_type_1d_view_type dt_in("dt_in", np), dt_min("dt_min", np),
+      dt_max("dt_max", np);
+
+    /// tolerances are broadcasted to all samples
+    real_type_2d_view_type tol_newton("tol_newton", 1, 2);
+    real_type_3d_view_type tol_time("tol_time", 1, m, 2);
+
+    {
+      const auto vals_host = Kokkos::create_mirror_view(vals);
+      const auto t_beg_host = Kokkos::create_mirror_view(t_beg);
+      const auto t_end_host = Kokkos::create_mirror_view(t_end);
+      const auto dt_in_host = Kokkos::create_mirror_view(dt_in);
+      const auto dt_min_host = Kokkos::create_mirror_view(dt_min);
+      const auto dt_max_host = Kokkos::create_mirror_view(dt_max);
+      const auto tol_newton_host = Kokkos::create_mirror_view(tol_newton);
+      const auto tol_time_host = Kokkos::create_mirror_view(tol_time);
+
+      for (int i = 0; i < np; ++i) {
+        vals_host(i, 0) = 1;
+        vals_host(i, 1) = 0;
+        vals_host(i, 2) = -1;
+        t_beg_host(i) = 0;
+        t_end_host(i) = 0.5 + real_type(i) / real_type(np);
+        dt_min_host(i) = 1e-3;
+        dt_max_host(i) = 1e-3;
+        dt_in_host(i) = 1e-3;
+      }
+      tol_newton_host(0, 0) = 1e-6;
+      tol_newton_host(0, 1) = 1e-5;
+      for (int k = 0; k < m; ++k) {
+        tol_time_host(0, k, 0) = 0;
+        tol_time_host(0, k, 1) = 1e-6;
+      }
+
+      Kokkos::deep_copy(vals, vals_host);
+      Kokkos::deep_copy(t_beg, t_beg_host);
+      Kokkos::deep_copy(t_end, t_end_host);
+      Kokkos::deep_copy(dt_in, dt_in_host);
+      Kokkos::deep_copy(dt_min, dt_min_host);
+      Kokkos::deep_copy(dt_max, dt_max_host);
+      Kokkos::deep_copy(tol_newton, tol_newton_host);
+      Kokkos::deep_copy(tol_time, tol_time_host);
+    }
+
+    const int max_num_newton_iterations(10), max_num_time_iterations(2000);
+    const real_type jacobian_reuse_dt_ratio(0.3);
+
+    /// validation against the exact solution
+    using host_device_type =
+      typename Tines::UseThisDevice<Kokkos::DefaultHostExecutionSpace>::type;
+    Tines::ProblemTestTrBDF2<real_type, host_device_type> problem_host;
+    const auto member = Tines::HostSerialTeamMember();
+
+    const auto t_end_host =
+      Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(), t_end);
+    auto validate = [&](const std::string label, const int num_failures) {
+      const auto vals_out_host =
+        Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(), vals_out);
+      const auto t_out_host =
+        Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(), t_out);
+
+      int num_wrong(0);
+      real_type err_max(0);
+      for (int i = 0; i < np; ++i) {
+        const auto u = Kokkos::subview(vals_out_host, i, Kokkos::ALL());
+        const real_type err =
+          problem_host.computeError(member, t_out_host(i), u);
+        err_max = err > err_max ? err : err_max;
+        if (err > 1e-4 || Tines::ats<real_type>::abs(t_out_host(i) -
+                                                     t_end_host(i)) > 1e-12)
+          ++num_wrong;
+      }
+      printf("%s, np %d, failures %d, max err %e\n", label.c_str(), np,
+             num_failures, err_max);
+      if (num_failures == 0 && num_wrong == 0) {
+        std::cout << "PASS " << label << "\n";
+      } else {
+        std::cout << "FAIL " << label << "\n";
+      }
+    };
+
+    {
+      const int num_failures = time_integrator_type::invoke(
+        exec_space(), problem, max_num_newton_iterations,
+        max_num_time_iterations, tol_newton, tol_time, jacobian_reuse_dt_ratio,
+        dt_in, dt_min, dt_max, t_beg, t_end, vals, t_out, dt_out, vals_out);
+      Kokkos::fence();
+      validate("TimeIntegratorTrBDF2Device", num_failures);
+    }
+
+    /// load balanced integration reports the time steps and the statistics of
+    /// each sample
+    {
+      int wlen(0);
+      time_integrator_type::workspace(m, wlen);
+      real_type_2d_view_type work("work", np, wlen);
+      Tines::value_type_1d_view<int, device_type> num_time_iterations(
+        "num_time_iterations", np);
+      Tines::value_type_1d_view<int, Kokkos::HostSpace> num_time_iterations_ref(
+        "num_time_iterations_ref", np);
+      typename time_integrator_type::statistics_type_1d_view_type stats(
+        "stats", np);
+      auto check_time_iterations = [&](const std::string label,
+                                       const bool is_reference) {
+        const auto iter_host = Kokkos::create_mirror_view_and_copy(
+          Kokkos::HostSpace(), num_time_iterations);
+        const auto dt_min_host =
+          Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(), dt_min);
+        const auto stats_host =
+          Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(), stats);
+        int num_wrong(0);
+        for (int i = 0; i < np; ++i) {
+          /// dt_min = dt_max; round off may add a tiny step at the end
+          const int expected = int(std::ceil(t_end_host(i) / dt_min_host(i)));
+          const int diff = iter_host(i) - expected;
+          num_wrong += (diff < -1 || diff > 1);
+
+          /// statistics of the sample; dt is fixed and no step is rejected
+          const statistics_type &s = stats_host(i);
+          num_wrong += (s.num_samples != 1 || s.num_failures != 0 ||
+                        s.failure_reason != statistics_type::Success);
+          num_wrong += (s.num_time_iterations != iter_host(i) ||
+                        s.num_accepted_time_steps != iter_host(i) ||
+                        s.num_rejected_time_steps != 0);
+          num_wrong += (s.num_linear_solves != s.num_newton_iterations ||
+                        s.num_function_evaluations <
+                          s.num_newton_iterations + 3 * s.num_time_iterations);
+          num_wrong += (s.num_jacobian_evaluations > s.num_newton_iterations ||
+                        s.dt_min > s.dt_max ||
+                        Tines::ats<real_type>::abs(s.dt_max - dt_min_host(i)) >
+                          1e-12);
+          if (is_reference)
+            num_time_iterations_ref(i) = iter_host(i);
+          else
+            num_wrong += (iter_host(i) != num_time_iterations_ref(i));
+        }
+        printf("%s, time iterations of the first and last samples %d, %d\n",
+               label.c_str(), iter_host(0), iter_host(np - 1));
+
+        statistics_type stats_all;
+        time_integrator_type::aggregateStatistics(stats, stats_all);
+        printf("%s, samples %lld, failures %lld, time iterations %lld, newton "
+               "iterations %lld, jacobian evaluations %lld, function "
+               "evaluations %lld, dt in [%e, %e]\n",
+               label.c_str(), (long long)stats_all.num_samples,
+               (long long)stats_all.num_failures,
+               (long long)stats_all.num_time_iterations,
+               (long long)stats_all.num_newton_iterations,
+               (long long)stats_all.num_jacobian_evaluations,
+               (long long)stats_all.num_function_evaluations,
+               stats_all.dt_min, stats_all.dt_max);
+        int64_t num_time_iterations_all(0);
+        for (int i = 0; i < np; ++i)
+          num_time_iterations_all += iter_host(i);
+        num_wrong += (stats_all.num_samples != np ||
+                      stats_all.num_failures != 0 ||
+                      stats_all.num_time_iterations != num_time_iterations_all);
+        if (num_wrong == 0) {
+          std::cout << "PASS " << label << " time iterations\n";
+        } else {
+          std::cout << "FAIL " << label << " time iterations\n";
+        }
+      };
+
+      {
+        const int num_failures = time_integrator_type::invokeDynamic(
+          exec_space(), problem, max_num_newton_iterations,
+          max_num_time_iterations, tol_newton, tol_time,
+          jacobian_reuse_dt_ratio, dt_in, dt_min, dt_max, t_beg, t_end, vals,
+          t_out, dt_out, vals_out, num_time_iterations, work, -1, -1, stats);
+        Kokkos::fence();
+        validate("TimeIntegratorTrBDF2Device::Dynamic", num_failures);
+        check_time_iterations("TimeIntegratorTrBDF2Device::Dynamic", true);
+      }
+      {
+        const int max_num_time_iterations_per_chunk(100);
+        const int num_failures = time_integrator_type::invokeCompacted(
+          exec_space(), problem, max_num_newton_iterations,
+          max_num_time_iterations, max_num_time_iterations_per_chunk,
+          tol_newton, tol_time, jacobian_reuse_dt_ratio, dt_in, dt_min, dt_max,
+          t_beg, t_end, vals, t_out, dt_out, vals_out, num_time_iterations,
+          work, -1, -1, stats);
+        Kokkos::fence();
+        validate("TimeIntegratorTrBDF2Device::Compacted", num_failures);
+        check_time_iterations("TimeIntegratorTrBDF2Device::Compacted", false);
+      }
+    }
+
+    /// error controlled time steps with dt_min << dt_max and a tight tol_time;
+    /// a chunk of the compacted integration restarts the step size controller
+    /// so the time steps differ from the dynamic integration, but the
+    /// solutions agree within the tolerance
+    {
+      {
+        const auto dt_in_host = Kokkos::create_mirror_view(dt_in);
+        const auto dt_min_host = Kokkos::create_mirror_view(dt_min);
+        const auto dt_max_host = Kokkos::create_mirror_view(dt_max);
+        const auto tol_time_host = Kokkos::create_mirror_view(tol_time);
+        for (int i = 0; i < np; ++i) {
+          dt_min_host(i) = 1e-10;
+          dt_max_host(i) = 1e-1;
+          dt_in_host(i) = 1e-6;
+        }
+        for (int k = 0; k < m; ++k) {
+          tol_time_host(0, k, 0) = 1e-12;
+          tol_time_host(0, k, 1) = 1e-8;
+        }
+        Kokkos::deep_copy(dt_in, dt_in_host);
+        Kokkos::deep_copy(dt_min, dt_min_host);
+        Kokkos::deep_copy(dt_max, dt_max_host);
+        Kokkos::deep_copy(tol_time, tol_time_host);
+      }
+      const int max_num_time_iterations_variable_dt(20000);
+
+      int wlen(0);
+      time_integrator_type::workspace(m, wlen);
+      real_type_2d_view_type work("work", np, wlen);
+      Tines::value_type_1d_view<int, device_type> num_time_iterations(
+        "num_time_iterations", np);
+      typename time_integrator_type::statistics_type_1d_view_type stats(
+        "stats", np);
+
+      auto check_statistics = [&](const std::string label) {
+        const auto stats_host =
+          Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(), stats);
+        int num_wrong(0);
+        int64_t num_accepted_time_steps_all(0);
+        for (int i = 0; i < np; ++i) {
+          const statistics_type &s = stats_host(i);
+          num_accepted_time_steps_all += s.num_accepted_time_steps;
+          num_wrong += (s.failure_reason != statistics_type::Success ||
+                        s.num_accepted_time_steps + s.num_rejected_time_steps !=
+                          s.num_time_iterations ||
+                        !(s.dt_min < s.dt_max));
+        }
+        printf("%s variable dt, accepted time steps %lld\n", label.c_str(),
+               (long long)num_accepted_time_steps_all);
+        return num_wrong;
+      };
+
+      Kokkos::View<real_type **, Kokkos::HostSpace> vals_dynamic(
+        "vals_dynamic", np, m);
+      int num_wrong(0);
+      {
+        const int num_failures = time_integrator_type::invokeDynamic(
+          exec_space(), problem, max_num_newton_iterations,
+          max_num_time_iterations_variable_dt, tol_newton, tol_time,
+          jacobian_reuse_dt_ratio, dt_in, dt_min, dt_max, t_beg, t_end, vals,
+          t_out, dt_out, vals_out, num_time_iterations, work, -1, -1, stats);
+        Kokkos::fence();
+        validate("TimeIntegratorTrBDF2Device::Dynamic variable dt",
+                 num_failures);
+        num_wrong += check_statistics("Dynamic");
+        Kokkos::deep_copy(vals_dynamic, vals_out);
+      }
+      {
+        const int max_num_time_iterations_per_chunk(100);
+        const int num_failures = time_integrator_type::invokeCompacted(
+          exec_space(), problem, max_num_newton_iterations,
+          max_num_time_iterations_variable_dt,
+          max_num_time_iterations_per_chunk, tol_newton, tol_time,
+          jacobian_reuse_dt_ratio, dt_in, dt_min, dt_max, t_beg, t_end, vals,
+          t_out, dt_out, vals_out, num_time_iterations, work, -1, -1, stats);
+        Kokkos::fence();
+        validate("TimeIntegratorTrBDF2Device::Compacted variable dt",
+                 num_failures);
+        num_wrong += check_statistics("Compacted");
+      }
+      {
+        const auto vals_out_host =
+          Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(), vals_out);
+        real_type diff_max(0);
+        for (int i = 0; i < np; ++i)
+          for (int k = 0; k < m; ++k) {
+            const real_type diff =
+              Tines::ats<real_type>::abs(vals_out_host(i, k) -
+                                         vals_dynamic(i, k)) /
+              (Tines::ats<real_type>::abs(vals_dynamic(i, k)) + 1e-8);
+            diff_max = diff > diff_max ? diff : diff_max;
+          }
+        printf("Variable dt, max relative difference of Compacted and Dynamic "
+               "%e\n",
+               diff_max);
+        if (num_wrong == 0 && diff_max < 1e-5) {
+          std::cout << "PASS TimeIntegratorTrBDF2Device variable dt\n";
+        } else {
+          std::cout << "FAIL TimeIntegratorTrBDF2Device variable dt\n";
+        }
+      }
+    }
+  }
+  Kokkos::finalize();
+
+  return 0;
+}
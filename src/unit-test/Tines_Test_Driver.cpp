@@ -69,6 +69,9 @@ TEST(LinearAlgebra,InvertMatrix) {
 TEST(LinearAlgebra,QR) {
   TestViewAndPtrExamples("linear-algebra/", "Tines_QR");
 }
+TEST(LinearAlgebra,BlockedHouseholder) {
+  TestViewAndPtrExamples("linear-algebra/", "Tines_BlockedHouseholder");
+}
 TEST(LinearAlgebra,QR_WithColumnPivoting) {
   TestViewAndPtrExamples("linear-algebra/", "Tines_QR_WithColumnPivoting");
 }
@@ -81,9 +84,30 @@ TEST(LinearAlgebra,SolveUTV) {
 TEST(LinearAlgebra,SolveLinearSystemUTV) {
   TestViewAndPtrExamples("linear-algebra/", "Tines_SolveLinearSystem");
 }
+TEST(LinearAlgebra,SolveLU) {
+  TestViewAndPtrExamples("linear-algebra/", "Tines_SolveLU");
+}
+TEST(LinearAlgebra,Balance) {
+  TestViewAndPtrExamples("linear-algebra/", "Tines_Balance");
+}
+TEST(LinearAlgebra,SchurMultiShift) {
+  TestViewAndPtrExamples("linear-algebra/", "Tines_SchurMultiShift");
+}
 TEST(LinearAlgebra,Eigendecomposition) {
   TestViewAndPtrExamples("linear-algebra/", "Tines_Eigendecomposition");
 }
+TEST(LinearAlgebra,SolveEigenvaluesNonSymmetricProblemStagedDevice) {
+  TestExamplesInternal("linear-algebra/", "Tines_SolveEigenvaluesNonSymmetricProblemStagedDevice.x");
+}
+TEST(LinearAlgebra,SolveEigenvaluesSymmetricProblem) {
+  TestViewAndPtrExamples("linear-algebra/", "Tines_SolveEigenvaluesSymmetricProblem");
+}
+TEST(LinearAlgebra,SolveEigenvaluesSymmetricProblemDevice) {
+  TestExamplesInternal("linear-algebra/", "Tines_SolveEigenvaluesSymmetricProblemDevice.x");
+}
+TEST(LinearAlgebra,InterleavedDevice) {
+  TestExamplesInternal("linear-algebra/", "Tines_InterleavedDevice.x");
+}
 
 ///
 /// Sacado basic
@@ -98,15 +122,36 @@ TEST(Sacado,ToySacado) {
 TEST(TimeIntegration,NumericalJacobians) {
   TestExamplesInternal("time-integration/", "Tines_NumericalJacobian.x");
 }
+TEST(TimeIntegration,NumericalJacobiansColored) {
+  TestExamplesInternal("time-integration/", "Tines_NumericalJacobianColored.x");
+}
 TEST(TimeIntegration,NewtonSolver) {
   TestExamplesInternal("time-integration/", "Tines_NewtonSolver.x");
 }
+TEST(TimeIntegration,NewtonKrylovSolver) {
+  TestExamplesInternal("time-integration/", "Tines_NewtonKrylovSolver.x");
+}
 TEST(TimeIntegration,TrBDF2) {
   TestExamplesInternal("time-integration/", "Tines_TrBDF2.x");
 }
 TEST(TimeIntegration,AnalyticJacobians) {
   TestExamplesInternal("time-integration/", "Tines_AnalyticJacobian.x");
 }
+TEST(TimeIntegration,TimeIntegratorTrBDF2) {
+  TestExamplesInternal("time-integration/", "Tines_TimeIntegratorTrBDF2.x");
+}
+TEST(TimeIntegration,TimeIntegratorTrBDF2Device) {
+  TestExamplesInternal("time-integration/", "Tines_TimeIntegratorTrBDF2Device.x");
+}
+TEST(TimeIntegration,TimeIntegratorESDIRK) {
+  TestExamplesInternal("time-integration/", "Tines_TimeIntegratorESDIRK.x");
+}
+TEST(TimeIntegration,TimeIntegratorRosenbrockW) {
+  TestExamplesInternal("time-integration/", "Tines_TimeIntegratorRosenbrockW.x");
+}
+TEST(TimeIntegration,TimeIntegratorBDF) {
+  TestExamplesInternal("time-integration/", "Tines_TimeIntegratorBDF.x");
+}
 
 int
 main(int argc, char* argv[])